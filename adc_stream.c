@@ -0,0 +1,218 @@
+/**
+ * @file adc_stream.c
+ * @brief DMA destekli sürekli (free-running) ADC örnekleme implementasyonu
+ * @see \ref howto_adc_stream
+ *
+ * ADC, LDR_1 (0), POT_1 (1) ve KEYPAD (2) girişlerini `adc_set_round_robin`
+ * ile sırayla örnekler. Her örnek DMA ile halka tampona yazılır; CPU hiçbir
+ * örnek için beklemez. Tampon uzunluğu kanal sayısının katı olduğundan
+ * tampondaki her indeksin kanalı `indeks % ADC_STREAM_CHANNELS` ile bulunur.
+ *
+ * İki DMA kanalı kullanılır:
+ * - Veri kanalı: ADC FIFO'dan tampona `ADC_STREAM_CHANNELS * ADC_STREAM_DEPTH` örnek taşır
+ * - Kontrol kanalı: veri kanalı bitince yazma adresini tampon başına geri yükler
+ */
+
+#include "pico_training_board.h"
+
+/** @brief ADC saat frekansı (Hz); örnekleme periyodu (1 + div) ADC saat çevrimidir */
+#define ADC_CLOCK_HZ 48000000.0f
+
+static uint16_t stream_buffer[ADC_STREAM_LEN] __attribute__((aligned(4)));
+
+// Kontrol kanalı bu işaretçiyi veri kanalının yazma adresine kopyalar
+static uint16_t *stream_buffer_start = stream_buffer;
+
+static int data_chan = -1;
+static int ctrl_chan = -1;
+static volatile bool stream_running = false;
+
+/**
+ * @brief Sürekli ADC örneklemeyi başlatır
+ *
+ * ADC'yi round-robin moduna alır, FIFO'yu DMA isteği üretecek şekilde ayarlar
+ * ve iki DMA kanalını halka tampon oluşturacak şekilde zincirler.
+ *
+ * @return bool Akış çalışıyorsa true, boş DMA kanalı bulunamazsa false
+ *
+ * @note `init_adc()` önce çağrılmış olmalıdır.
+ */
+bool adc_stream_start(void) {
+    if (stream_running) {
+        return true;
+    }
+
+    data_chan = dma_claim_unused_channel(false);
+    ctrl_chan = dma_claim_unused_channel(false);
+    if (data_chan < 0 || ctrl_chan < 0) {
+        if (data_chan >= 0) dma_channel_unclaim(data_chan);
+        if (ctrl_chan >= 0) dma_channel_unclaim(ctrl_chan);
+        data_chan = ctrl_chan = -1;
+        return false;
+    }
+
+    adc_run(false);
+    adc_fifo_drain();
+
+    // Round-robin o anki girişten başlar; tampon hizası için 0'dan başlat
+    adc_select_input(0);
+    adc_set_round_robin((1u << ADC_STREAM_CHANNELS) - 1u);
+    adc_fifo_setup(true,   // Sonuçları FIFO'ya yaz
+                   true,   // DMA isteği (DREQ) üret
+                   1,      // Her örnekte DREQ
+                   false,  // Hata bitini FIFO'ya yazma
+                   false); // 12-bit sonuç, kaydırma yok
+    adc_set_clkdiv(ADC_CLOCK_HZ / (ADC_STREAM_RATE_HZ * ADC_STREAM_CHANNELS) - 1.0f);
+
+    // Veri kanalı: ADC FIFO -> halka tampon, bitince kontrol kanalını tetikler
+    dma_channel_config data_cfg = dma_channel_get_default_config(data_chan);
+    channel_config_set_transfer_data_size(&data_cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&data_cfg, false);
+    channel_config_set_write_increment(&data_cfg, true);
+    channel_config_set_dreq(&data_cfg, DREQ_ADC);
+    channel_config_set_chain_to(&data_cfg, ctrl_chan);
+    dma_channel_configure(data_chan, &data_cfg,
+                          stream_buffer, &adc_hw->fifo,
+                          ADC_STREAM_LEN, false);
+
+    // Kontrol kanalı: yazma adresini tampon başına yükler ve veri kanalını yeniden başlatır
+    dma_channel_config ctrl_cfg = dma_channel_get_default_config(ctrl_chan);
+    channel_config_set_transfer_data_size(&ctrl_cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&ctrl_cfg, false);
+    channel_config_set_write_increment(&ctrl_cfg, false);
+    dma_channel_configure(ctrl_chan, &ctrl_cfg,
+                          &dma_hw->ch[data_chan].al2_write_addr_trig,
+                          &stream_buffer_start, 1, false);
+
+    dma_channel_start(data_chan);
+    adc_run(true);
+    stream_running = true;
+    return true;
+}
+
+/**
+ * @brief Sürekli ADC örneklemeyi durdurur ve DMA kanallarını serbest bırakır
+ *
+ * Sonrasında `read_analog()` yeniden tek seferlik (bloklu) okumaya döner.
+ */
+void adc_stream_stop(void) {
+    if (!stream_running) {
+        return;
+    }
+    stream_running = false;
+
+    adc_run(false);
+    // Kontrol kanalı veri kanalını yeniden tetikleyebileceği için önce onu durdur
+    dma_channel_abort(ctrl_chan);
+    dma_channel_abort(data_chan);
+    dma_channel_abort(ctrl_chan);
+    dma_channel_unclaim(data_chan);
+    dma_channel_unclaim(ctrl_chan);
+    data_chan = ctrl_chan = -1;
+
+    adc_set_round_robin(0);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+}
+
+/**
+ * @brief Sürekli örneklemenin çalışıp çalışmadığını döndürür
+ * @return bool Akış çalışıyorsa true
+ */
+bool adc_stream_is_running(void) {
+    return stream_running;
+}
+
+/**
+ * @brief DMA'nın en son yazdığı tampon indeksini döndürür
+ * @return uint Son yazılan örneğin indeksi (0..ADC_STREAM_LEN-1)
+ */
+static uint last_written_index(void) {
+    uintptr_t write_addr = (uintptr_t)dma_hw->ch[data_chan].write_addr;
+    uint next = (uint)((write_addr - (uintptr_t)stream_buffer) / sizeof(stream_buffer[0]));
+    return (next + ADC_STREAM_LEN - 1) % ADC_STREAM_LEN;
+}
+
+/**
+ * @brief DMA'nın bir sonraki yazacağı tampon indeksini döndürür
+ *
+ * Tüketiciler kendi okuma imleçlerini bu değere kadar ilerleterek yeni
+ * örnekleri kaçırmadan işleyebilir (bkz. analog_filter.c).
+ *
+ * @return uint Bir sonraki yazma indeksi (0..ADC_STREAM_LEN-1), akış kapalıysa 0
+ */
+uint adc_stream_position(void) {
+    if (!stream_running) {
+        return 0;
+    }
+    return (last_written_index() + 1) % ADC_STREAM_LEN;
+}
+
+/**
+ * @brief DMA halka tamponuna salt okunur erişim verir
+ * @return const uint16_t* `ADC_STREAM_LEN` elemanlı tampon; indeks `i` kanalı `i % ADC_STREAM_CHANNELS`
+ */
+const uint16_t *adc_stream_buffer(void) {
+    return stream_buffer;
+}
+
+/**
+ * @brief Bir kanalın en son örneğini döndürür
+ *
+ * Tampon taranmaz; son yazılan indeksten kanal hizasına geri gidilir.
+ *
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @return uint16_t Son 12-bit örnek (0-4095), akış kapalıysa veya kanal geçersizse 0
+ */
+uint16_t adc_stream_latest(uint8_t channel) {
+    if (!stream_running || channel >= ADC_STREAM_CHANNELS) {
+        return 0;
+    }
+    uint last = last_written_index();
+    uint back = (last % ADC_STREAM_CHANNELS + ADC_STREAM_CHANNELS - channel) % ADC_STREAM_CHANNELS;
+    return stream_buffer[(last + ADC_STREAM_LEN - back) % ADC_STREAM_LEN];
+}
+
+/**
+ * @brief Bir kanalın en son ardışık örneklerini kopyalar
+ *
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @param out Örneklerin yazılacağı dizi; en yeni örnek `out[0]`
+ * @param n İstenen örnek sayısı (en çok ADC_STREAM_DEPTH kopyalanır)
+ * @return uint Kopyalanan örnek sayısı, akış kapalıysa 0
+ */
+uint adc_stream_recent(uint8_t channel, uint16_t *out, uint n) {
+    if (!stream_running || channel >= ADC_STREAM_CHANNELS) {
+        return 0;
+    }
+    if (n > ADC_STREAM_DEPTH) {
+        n = ADC_STREAM_DEPTH;
+    }
+    uint last = last_written_index();
+    uint back = (last % ADC_STREAM_CHANNELS + ADC_STREAM_CHANNELS - channel) % ADC_STREAM_CHANNELS;
+    uint idx = (last + ADC_STREAM_LEN - back) % ADC_STREAM_LEN;
+    for (uint i = 0; i < n; i++) {
+        out[i] = stream_buffer[idx];
+        idx = (idx + ADC_STREAM_LEN - ADC_STREAM_CHANNELS) % ADC_STREAM_LEN;
+    }
+    return n;
+}
+
+/**
+ * @brief Bir kanalın tampondaki tüm örneklerinin ortalamasını döndürür
+ *
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @return uint16_t Son `ADC_STREAM_DEPTH` örneğin ortalaması, akış kapalıysa 0
+ *
+ * @note Ortalama, varsayılan ayarlarla yaklaşık son 6.4 ms'yi kapsar.
+ */
+uint16_t adc_stream_average(uint8_t channel) {
+    if (!stream_running || channel >= ADC_STREAM_CHANNELS) {
+        return 0;
+    }
+    uint32_t sum = 0;
+    for (uint i = channel; i < ADC_STREAM_LEN; i += ADC_STREAM_CHANNELS) {
+        sum += stream_buffer[i];
+    }
+    return (uint16_t)(sum / ADC_STREAM_DEPTH);
+}
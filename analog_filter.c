@@ -0,0 +1,261 @@
+/**
+ * @file analog_filter.c
+ * @brief Analog kanallar için sabit noktalı sayısal filtre zinciri
+ * @see \ref howto_analog_filter
+ *
+ * Her kanal için sırasıyla:
+ * 1. Boxcar ondalama: 2^DECIM_SHIFT örneğin toplamı, kaydırma ile ortalama
+ * 2. Kayan medyan: son MEDIAN_LEN ondalanmış örneğin medyanı (tekil sıçramaları bastırır)
+ * 3. EMA: y += (x - y) / 2^EMA_SHIFT, 2^EMA_SHIFT ölçekli akümülatör ile
+ *
+ * Filtre parametreleri pico_training_board.h içindeki derleme zamanı sabitleridir.
+ * `ANALOG_FILTER_CHAIN` makrosu her kanal için sabitleri gömülü ayrı bir
+ * durum yapısı ve güncelleme fonksiyonu üretir; çalışma zamanında fonksiyon
+ * işaretçisi veya parametre tablosu yoktur.
+ *
+ * Zincir, `ANALOG_FILTER_RATE_HZ` hızında çalışan bir tekrarlı zamanlayıcı ile
+ * DMA halka tamponundaki yeni örneklerin tamamı okunarak beslenir.
+ */
+
+#include "pico_training_board.h"
+
+/** @brief Desteklenen en uzun medyan penceresi */
+#define MEDIAN_MAX_LEN 7
+
+/**
+ * @brief Boxcar ondalama adımı
+ * @param sum Akümülatör
+ * @param count Toplanan örnek sayısı
+ * @param x Yeni örnek
+ * @param shift Ondalama oranı 2^shift
+ * @param out Ondalanmış örnek (yalnızca true dönerse geçerli)
+ * @return bool 2^shift örnek tamamlandıysa true
+ */
+static inline bool boxcar_update(uint32_t *sum, uint16_t *count, uint16_t x,
+                                 uint shift, uint16_t *out) {
+    *sum += x;
+    if (++(*count) < (1u << shift)) {
+        return false;
+    }
+    *out = (uint16_t)(*sum >> shift);
+    *sum = 0;
+    *count = 0;
+    return true;
+}
+
+/**
+ * @brief Kayan medyan adımı
+ *
+ * Pencere dolana kadar dolu kısmın medyanı döndürülür. Pencere küçük
+ * olduğundan (en çok birkaç örnek) kopyalayıp ekleme sıralaması yeterlidir.
+ *
+ * @param window Dairesel pencere
+ * @param len Pencere uzunluğu (tek sayı, en çok MEDIAN_MAX_LEN)
+ * @param pos Bir sonraki yazma konumu
+ * @param fill Penceredeki geçerli örnek sayısı
+ * @param x Yeni örnek
+ * @return uint16_t Penceredeki medyan
+ */
+static inline uint16_t median_update(uint16_t *window, uint len, uint8_t *pos,
+                                     uint8_t *fill, uint16_t x) {
+    window[*pos] = x;
+    *pos = (uint8_t)((*pos + 1u) % len);
+    if (*fill < len) {
+        (*fill)++;
+    }
+
+    uint16_t sorted[MEDIAN_MAX_LEN];
+    uint n = *fill;
+    for (uint i = 0; i < n; i++) {
+        uint16_t v = window[i];
+        uint j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    return sorted[n / 2];
+}
+
+/**
+ * @brief Sabit noktalı EMA adımı
+ * @param acc 2^shift ölçekli akümülatör
+ * @param primed İlk örnek alındı mı
+ * @param x Yeni örnek
+ * @param shift alfa = 1/2^shift (0 ise filtre yok)
+ * @return uint16_t Filtrelenmiş değer
+ */
+static inline uint16_t ema_update(uint32_t *acc, bool *primed, uint16_t x, uint shift) {
+    if (!*primed) {
+        *acc = (uint32_t)x << shift;
+        *primed = true;
+    }
+    *acc += x - (*acc >> shift);
+    return (uint16_t)(*acc >> shift);
+}
+
+/**
+ * @brief Sabit parametreli bir filtre zinciri için durum tipi ve güncelleme fonksiyonu üretir
+ *
+ * @param name Üretilecek tip (`name_t`) ve fonksiyon (`name_update`) öneki
+ * @param DECIM_SHIFT Boxcar ondalama oranı 2^DECIM_SHIFT
+ * @param MEDIAN_LEN Medyan pencere uzunluğu
+ * @param EMA_SHIFT EMA alfa = 1/2^EMA_SHIFT
+ */
+#define ANALOG_FILTER_CHAIN(name, DECIM_SHIFT, MEDIAN_LEN, EMA_SHIFT)              \
+    _Static_assert((MEDIAN_LEN) % 2 == 1 && (MEDIAN_LEN) <= MEDIAN_MAX_LEN,        \
+                   #name ": medyan uzunluğu tek ve <= MEDIAN_MAX_LEN olmalı");  \
+    typedef struct {                                                               \
+        uint32_t decim_sum;                                                        \
+        uint16_t decim_count;                                                      \
+        uint16_t median_window[MEDIAN_LEN];                                        \
+        uint8_t median_pos;                                                        \
+        uint8_t median_fill;                                                       \
+        uint32_t ema_acc;                                                          \
+        bool ema_primed;                                                           \
+    } name##_t;                                                                    \
+                                                                                   \
+    static inline bool name##_update(name##_t *f, uint16_t x, uint16_t *out) {     \
+        uint16_t d;                                                                \
+        if (!boxcar_update(&f->decim_sum, &f->decim_count, x, (DECIM_SHIFT), &d)) { \
+            return false;                                                          \
+        }                                                                          \
+        uint16_t m = median_update(f->median_window, (MEDIAN_LEN),                 \
+                                   &f->median_pos, &f->median_fill, d);            \
+        *out = ema_update(&f->ema_acc, &f->ema_primed, m, (EMA_SHIFT));            \
+        return true;                                                               \
+    }
+
+ANALOG_FILTER_CHAIN(ldr_filter, LDR_FILTER_DECIM_SHIFT, LDR_FILTER_MEDIAN_LEN, LDR_FILTER_EMA_SHIFT)
+ANALOG_FILTER_CHAIN(pot_filter, POT_FILTER_DECIM_SHIFT, POT_FILTER_MEDIAN_LEN, POT_FILTER_EMA_SHIFT)
+ANALOG_FILTER_CHAIN(keypad_filter, KEYPAD_FILTER_DECIM_SHIFT, KEYPAD_FILTER_MEDIAN_LEN, KEYPAD_FILTER_EMA_SHIFT)
+
+static ldr_filter_t ldr_state;
+static pot_filter_t pot_state;
+static keypad_filter_t keypad_state;
+
+// Filtre çıkışları; okuyucular için maliyet tek bir bellek okumasıdır
+static volatile uint16_t filtered[ADC_STREAM_CHANNELS];
+
+static repeating_timer_t filter_timer;
+static bool filter_running = false;
+static uint stream_cursor = 0;
+
+/**
+ * @brief Tek bir örneği kanalının filtre zincirine verir
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @param x Ham 12-bit örnek
+ */
+static inline void filter_push(uint channel, uint16_t x) {
+    uint16_t y;
+    switch (channel) {
+        case 0:
+            if (ldr_filter_update(&ldr_state, x, &y)) filtered[0] = y;
+            break;
+        case 1:
+            if (pot_filter_update(&pot_state, x, &y)) filtered[1] = y;
+            break;
+        case 2:
+            if (keypad_filter_update(&keypad_state, x, &y)) filtered[2] = y;
+            break;
+    }
+}
+
+/**
+ * @brief Zamanlayıcı geri çağrısı; son çağrıdan beri gelen tüm örnekleri filtreler
+ *
+ * Akış kapalıysa her kanaldan tek bir bloklu örnek okunur.
+ *
+ * @param rt Tekrarlı zamanlayıcı
+ * @return bool Zamanlayıcının devam etmesi için true
+ */
+static bool filter_timer_callback(repeating_timer_t *rt) {
+    if (adc_stream_is_running()) {
+        const uint16_t *buffer = adc_stream_buffer();
+        uint end = adc_stream_position();
+        while (stream_cursor != end) {
+            filter_push(stream_cursor % ADC_STREAM_CHANNELS, buffer[stream_cursor]);
+            stream_cursor = (stream_cursor + 1) % ADC_STREAM_LEN;
+        }
+    } else {
+        for (uint ch = 0; ch < ADC_STREAM_CHANNELS; ch++) {
+            filter_push(ch, read_analog(ch));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Filtre zamanlayıcısını başlatır
+ *
+ * @return bool Zamanlayıcı çalışıyorsa true, zamanlayıcı kurulamazsa false
+ *
+ * @note DMA tamponu taşmadan boşaltılmalıdır: ANALOG_FILTER_RATE_HZ, ADC_STREAM_RATE_HZ /
+ *       ADC_STREAM_DEPTH değerinden yeterince büyük olmalıdır.
+ */
+bool analog_filter_start(void) {
+    if (filter_running) {
+        return true;
+    }
+    memset(&ldr_state, 0, sizeof(ldr_state));
+    memset(&pot_state, 0, sizeof(pot_state));
+    memset(&keypad_state, 0, sizeof(keypad_state));
+    for (uint ch = 0; ch < ADC_STREAM_CHANNELS; ch++) {
+        filtered[ch] = read_analog(ch);
+    }
+    stream_cursor = adc_stream_position();
+
+    // Negatif gecikme: periyot geri çağrının başlangıcından ölçülür
+    filter_running = add_repeating_timer_us(-(int64_t)(1000000 / ANALOG_FILTER_RATE_HZ),
+                                            filter_timer_callback, NULL, &filter_timer);
+    return filter_running;
+}
+
+/**
+ * @brief Filtre zamanlayıcısını durdurur; son çıkışlar korunur
+ */
+void analog_filter_stop(void) {
+    if (filter_running) {
+        cancel_repeating_timer(&filter_timer);
+        filter_running = false;
+    }
+}
+
+/**
+ * @brief Örnekleri zamanlayıcı ve ADC akışı olmadan doğrudan zincire verir
+ *
+ * Frekans yanıtı ölçümü gibi örneklerin başka kaynaktan geldiği durumlar
+ * içindir; örnekler `ADC_STREAM_RATE_HZ` hızında alınmış kabul edilir.
+ * Zamanlayıcı çalışırken çağrılmamalıdır (durum paylaşılır).
+ *
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @param samples Ham 12-bit örnekler
+ * @param count Örnek sayısı
+ */
+void analog_filter_feed(uint8_t channel, const uint16_t *samples, size_t count) {
+    if (channel >= ADC_STREAM_CHANNELS) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        filter_push(channel, samples[i]);
+    }
+}
+
+/**
+ * @brief Bir kanalın son filtrelenmiş değerini döndürür
+ *
+ * @param channel ADC kanalı (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @return uint16_t Filtrelenmiş 12-bit değer, kanal geçersizse 0
+ *
+ * @code{.c}
+ * analog_filter_start();
+ * uint16_t pot = analog_filter_get(1);
+ * @endcode
+ */
+uint16_t analog_filter_get(uint8_t channel) {
+    if (channel >= ADC_STREAM_CHANNELS) {
+        return 0;
+    }
+    return filtered[channel];
+}
@@ -0,0 +1,140 @@
+/**
+ * @file adc_noise_bench.c
+ * @brief ADC gürültü ve hız karakterizasyonu için ölçüm firmware'i
+ * @see \ref howto_benchmarks
+ *
+ * LDR_1, POT_1 ve KEYPAD kanallarının her biri iki yöntemle en yüksek hızda
+ * örneklenir:
+ * - `blocking`: `adc_select_input()` + `adc_read()` döngüsü (CPU her örneği bekler)
+ * - `dma`: ADC serbest çalışır (clkdiv 0, 500 kS/s), örnekler DMA ile tampona alınır
+ *
+ * Her ölçüm için örnek hızı, ortalama, standart sapma, ENOB ve histogram
+ * stdio üzerinden CSV satırları olarak yazılır. Satırlar `tools/adc_noise_report.py`
+ * ile ayrıştırılır:
+ *
+ * @code
+ * summary,run,channel,mode,samples,elapsed_us,samples_per_s,mean,stddev,enob
+ * hist,run,channel,mode,value,count
+ * @endcode
+ */
+
+#include "pico_training_board.h"
+
+#define BENCH_SAMPLES 8192       /**< Ölçüm başına örnek sayısı */
+#define BENCH_PERIOD_MS 5000     /**< Ölçüm turları arası bekleme */
+#define ADC_MAX_VALUE 4095       /**< 12-bit ADC üst sınırı */
+
+static uint16_t samples[BENCH_SAMPLES];
+static uint32_t histogram[ADC_MAX_VALUE + 1];
+
+static const char *const channel_names[ADC_STREAM_CHANNELS] = {"LDR_1", "POT_1", "KEYPAD"};
+
+/**
+ * @brief CPU ile bloklu okuma; her örnek için ADC dönüşümü beklenir
+ * @param channel ADC kanalı
+ * @return uint64_t Geçen süre (mikrosaniye)
+ */
+static uint64_t capture_blocking(uint channel) {
+    adc_select_input(channel);
+    uint64_t start = time_us_64();
+    for (uint i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = adc_read();
+    }
+    return time_us_64() - start;
+}
+
+/**
+ * @brief ADC serbest çalışırken örnekleri DMA ile toplar
+ * @param channel ADC kanalı
+ * @param dma_chan Kullanılacak DMA kanalı
+ * @return uint64_t Geçen süre (mikrosaniye)
+ */
+static uint64_t capture_dma(uint channel, uint dma_chan) {
+    adc_select_input(channel);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(0);  // Olası en yüksek hız: 96 ADC saat çevrimi / örnek
+    adc_fifo_drain();
+
+    dma_channel_config cfg = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(dma_chan, &cfg, samples, &adc_hw->fifo, BENCH_SAMPLES, true);
+
+    uint64_t start = time_us_64();
+    adc_run(true);
+    dma_channel_wait_for_finish_blocking(dma_chan);
+    uint64_t elapsed = time_us_64() - start;
+
+    adc_run(false);
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+    return elapsed;
+}
+
+/**
+ * @brief Tampondaki örneklerin istatistiklerini ve histogramını CSV olarak yazar
+ * @param run Tur numarası
+ * @param channel ADC kanalı
+ * @param mode Yöntem adı ("blocking" / "dma")
+ * @param elapsed_us Toplama süresi (mikrosaniye)
+ */
+static void report(uint run, uint channel, const char *mode, uint64_t elapsed_us) {
+    memset(histogram, 0, sizeof(histogram));
+    uint64_t sum = 0;
+    for (uint i = 0; i < BENCH_SAMPLES; i++) {
+        sum += samples[i];
+        histogram[samples[i] & ADC_MAX_VALUE]++;
+    }
+    double mean = (double)sum / BENCH_SAMPLES;
+
+    double var = 0.0;
+    for (uint i = 0; i < BENCH_SAMPLES; i++) {
+        double d = samples[i] - mean;
+        var += d * d;
+    }
+    double stddev = sqrt(var / (BENCH_SAMPLES - 1));
+
+    // İdeal 12-bit nicemleme gürültüsü 1/sqrt(12) LSB'dir
+    double enob = 12.0;
+    if (stddev * sqrt(12.0) > 1.0) {
+        enob = 12.0 - log2(stddev * sqrt(12.0));
+    }
+    double rate = elapsed_us ? (double)BENCH_SAMPLES * 1e6 / (double)elapsed_us : 0.0;
+
+    printf("summary,%u,%s,%s,%u,%llu,%.0f,%.2f,%.3f,%.2f\n",
+           run, channel_names[channel], mode, BENCH_SAMPLES,
+           (unsigned long long)elapsed_us, rate, mean, stddev, enob);
+    for (uint v = 0; v <= ADC_MAX_VALUE; v++) {
+        if (histogram[v]) {
+            printf("hist,%u,%s,%s,%u,%lu\n", run, channel_names[channel], mode,
+                   v, (unsigned long)histogram[v]);
+        }
+    }
+}
+
+/**
+ * @brief ADC ölçüm firmware'i giriş noktası
+ * @return int Dönmez
+ */
+int main(void) {
+    stdio_init_all();
+    adc_init();
+    adc_gpio_init(LDR_1);
+    adc_gpio_init(POT_1);
+    adc_gpio_init(KEYPAD);
+    uint dma_chan = dma_claim_unused_channel(true);
+
+    sleep_ms(2000);  // USB CDC bağlantısı için süre tanı
+    printf("# adc_noise_bench samples=%u\n", BENCH_SAMPLES);
+
+    for (uint run = 0;; run++) {
+        for (uint ch = 0; ch < ADC_STREAM_CHANNELS; ch++) {
+            report(run, ch, "blocking", capture_blocking(ch));
+            report(run, ch, "dma", capture_dma(ch, dma_chan));
+        }
+        printf("# end run=%u\n", run);
+        sleep_ms(BENCH_PERIOD_MS);
+    }
+}
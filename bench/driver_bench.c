@@ -0,0 +1,201 @@
+/**
+ * @file driver_bench.c
+ * @brief Sürücü temel işlemleri için mikro ölçüm firmware'i
+ * @see \ref howto_benchmarks
+ *
+ * Her işlem BENCH_ITERATIONS kez (yavaş işlemlerde daha az) çalıştırılır ve
+ * her çalıştırma hem SysTick çevrim sayısıyla hem `time_us_64()` ile ölçülür.
+ * SysTick 24 bittir (125 MHz'de ~134 ms); daha uzun süren ölçümlerde çevrim
+ * sayısı mikrosaniyeden türetilir. Boş ölçümün maliyeti (kalibrasyon) her
+ * çevrim sayısından düşülür.
+ *
+ * Ölçüm tekrarlanabilir olsun diye arka plan motorları (tuş tarayıcı, analog
+ * filtre, ADC akışı, periyodik ultrasonik ölçüm) durdurulur; `read_analog()`
+ * ve `measure_distance()` bloklu yollarını kullanır.
+ *
+ * Sonuçlar stdio üzerinden JSON satırları olarak yazılır ve
+ * `tools/bench_diff.py` ile iki çalıştırma karşılaştırılır:
+ *
+ * @code
+ * {"meta":"driver_bench","run":0,"clk_sys_hz":125000000,"overhead_cycles":31}
+ * {"run":0,"name":"lcd_send_byte","n":32,"cycles_min":...,"cycles_med":...,"cycles_max":...,"us_min":...,"us_med":...,"us_max":...}
+ * # end run=0
+ * @endcode
+ */
+
+#include <stdlib.h>
+
+#include "pico_training_board.h"
+#include "hardware/structs/systick.h"
+
+#define BENCH_ITERATIONS 32      /**< Varsayılan ölçüm tekrarı */
+#define BENCH_MAX_ITERATIONS 64  /**< Tekrar dizisi boyutu */
+#define BENCH_PERIOD_MS 5000     /**< Ölçüm turları arası bekleme */
+#define SYSTICK_MAX 0xFFFFFFu    /**< 24 bit SysTick yeniden yükleme değeri */
+
+/**
+ * @brief Tek bir ölçüm tanımı
+ */
+typedef struct {
+    const char *name;      ///< JSON'daki ad
+    uint iterations;       ///< Tekrar sayısı (0: BENCH_ITERATIONS)
+    uint32_t gap_ms;       ///< Tekrarlar arası ölçülmeyen bekleme
+    void (*setup)(void);   ///< Her tekrardan önce, ölçüm dışında (NULL olabilir)
+    void (*run)(void);     ///< Ölçülen işlem
+} bench_case_t;
+
+static volatile double sink_f;
+static volatile uint32_t sink_u;
+static uint32_t cycles[BENCH_MAX_ITERATIONS];
+static uint32_t micros[BENCH_MAX_ITERATIONS];
+static uint32_t overhead_cycles;
+
+static void setup_cursor(void) { lcd_set_cursor(0, 0); }
+static void run_nothing(void) {}
+static void run_lcd_send_byte(void) { lcd_send_byte('A', LCD_CHARACTER); }
+static void run_lcd_string(void) { lcd_string("0123456789ABCDEF"); }
+static void run_read_analog(void) { sink_u = read_analog(0); }
+static void run_keypad(void) { sink_u = (uint32_t)keypadOku(); }
+static void run_get_frequency(void) { sink_f = get_frequency("A", 4); }
+static void run_set_pwm_frequency(void) { set_pwm_frequency(pwm_gpio_to_slice_num(BUZZER_PIN), 440.0f); }
+static void run_measure_distance(void) { sink_f = measure_distance(); }
+static void run_step(void) { step_turn(CW, 900, 1.0f / 8.0f); }  // 8 yarım adım = 1 "devir"
+static void setup_log(void) { log_discard(); }  // Dolu tamponun kısa düşürme yolu ölçülmesin
+static void run_log_write(void) { LOG_ERROR("bench %u %.1f", sink_u, 1.5f); }
+
+/**
+ * @brief Core 0'dan gelen her kelimeyi geri gönderir
+ */
+static void core1_echo(void) {
+    while (true) {
+        multicore_fifo_push_blocking(multicore_fifo_pop_blocking());
+    }
+}
+
+static void run_fifo_round_trip(void) {
+    multicore_fifo_push_blocking(0x5A5A5A5Au);
+    sink_u = multicore_fifo_pop_blocking();
+}
+
+static const bench_case_t cases[] = {
+    {"lcd_send_byte", 0, 0, setup_cursor, run_lcd_send_byte},
+    {"lcd_string_16", 8, 0, setup_cursor, run_lcd_string},
+    {"read_analog", 0, 0, NULL, run_read_analog},
+    {"keypadOku", 0, 0, NULL, run_keypad},
+    {"get_frequency", 0, 0, NULL, run_get_frequency},
+    {"set_pwm_frequency", 0, 0, NULL, run_set_pwm_frequency},
+    {"measure_distance", 8, 60, NULL, run_measure_distance},
+    {"step_turn_1_step", 8, 0, NULL, run_step},
+    {"fifo_round_trip", 0, 0, NULL, run_fifo_round_trip},
+    {"log_write_2arg", 0, 0, setup_log, run_log_write},
+};
+
+/**
+ * @brief SysTick'i işlemci saatiyle serbest çalışan sayaç olarak başlatır
+ */
+static void systick_start(void) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+/**
+ * @brief Bir işlemi bir kez ölçer
+ * @param fn İşlem
+ * @param us Geçen süre (mikrosaniye)
+ * @return uint32_t Geçen çevrim (kalibrasyon düşülmeden)
+ */
+static uint32_t measure_once(void (*fn)(void), uint32_t *us) {
+    uint64_t t0 = time_us_64();
+    uint32_t c0 = systick_hw->cvr;
+    fn();
+    uint32_t c1 = systick_hw->cvr;
+    uint64_t t1 = time_us_64();
+
+    *us = (uint32_t)(t1 - t0);
+    uint64_t clk_mhz = clock_get_hz(clk_sys) / 1000000u;
+    if ((uint64_t)*us * clk_mhz >= SYSTICK_MAX) {
+        // Sayaç en az bir kez sarmış; mikrosaniyeden türet
+        return (uint32_t)((uint64_t)*us * clk_mhz);
+    }
+    return (c0 - c1) & SYSTICK_MAX;  // SysTick aşağı sayar
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Bir ölçümü çalıştırır ve JSON satırını yazar
+ * @param run Tur numarası
+ * @param c Ölçüm tanımı
+ */
+static void bench_run(uint run, const bench_case_t *c) {
+    uint n = c->iterations ? c->iterations : BENCH_ITERATIONS;
+    for (uint i = 0; i < n; i++) {
+        if (c->setup) {
+            c->setup();
+        }
+        uint32_t raw = measure_once(c->run, &micros[i]);
+        cycles[i] = raw > overhead_cycles ? raw - overhead_cycles : 0;
+        if (c->gap_ms) {
+            sleep_ms(c->gap_ms);
+        }
+    }
+    qsort(cycles, n, sizeof(cycles[0]), compare_u32);
+    qsort(micros, n, sizeof(micros[0]), compare_u32);
+
+    printf("{\"run\":%u,\"name\":\"%s\",\"n\":%u,\"cycles_min\":%lu,\"cycles_med\":%lu,"
+           "\"cycles_max\":%lu,\"us_min\":%lu,\"us_med\":%lu,\"us_max\":%lu}\n",
+           run, c->name, n, (unsigned long)cycles[0], (unsigned long)cycles[n / 2],
+           (unsigned long)cycles[n - 1], (unsigned long)micros[0], (unsigned long)micros[n / 2],
+           (unsigned long)micros[n - 1]);
+}
+
+/**
+ * @brief Boş ölçümün en düşük çevrim sayısını bulur
+ * @return uint32_t Ölçüm maliyeti (çevrim)
+ */
+static uint32_t calibrate(void) {
+    uint32_t best = UINT32_MAX;
+    for (uint i = 0; i < BENCH_MAX_ITERATIONS; i++) {
+        uint32_t us;
+        uint32_t c = measure_once(run_nothing, &us);
+        if (c < best) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Sürücü ölçüm firmware'i giriş noktası
+ * @return int Dönmez
+ */
+int main(void) {
+    stdio_init_all();
+    init_board();
+
+    keypad_scanner_stop();
+    analog_filter_stop();
+    adc_stream_stop();
+    ultrasonic_stop();
+
+    multicore_launch_core1(core1_echo);
+    systick_start();
+    overhead_cycles = calibrate();
+
+    sleep_ms(2000);  // USB CDC bağlantısı için süre tanı
+    for (uint run = 0;; run++) {
+        printf("{\"meta\":\"driver_bench\",\"run\":%u,\"clk_sys_hz\":%lu,\"overhead_cycles\":%lu}\n",
+               run, (unsigned long)clock_get_hz(clk_sys), (unsigned long)overhead_cycles);
+        for (uint i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+            bench_run(run, &cases[i]);
+        }
+        printf("# end run=%u\n", run);
+        sleep_ms(BENCH_PERIOD_MS);
+    }
+}
@@ -0,0 +1,363 @@
+/**
+ * @file bt_uart.c
+ * @brief Bluetooth modülü (BLT_TX/BLT_RX) için DMA halka tamponlu UART sürücüsü
+ * @see \ref howto_bt_uart
+ *
+ * Alma: bir DMA kanalı UART veri yazmacını `BT_UART_RX_LEN` baytlık,
+ * boyutuna hizalı halka tampona yazar (DMA halka sarması). CPU bayt başına
+ * hiçbir iş yapmaz. Gelen veri `bt_uart_rx_peek()` ile tamponun içinden,
+ * kopyalanmadan okunur.
+ *
+ * Gönderme: `bt_uart_write()` veriyi `BT_UART_TX_LEN` baytlık halka tampona
+ * kopyalar; bir DMA kanalı bitişik parçaları UART'a taşır, tamamlanma kesmesi
+ * sonraki parçayı başlatır.
+ *
+ * Boş hat: PL011'in alma zaman aşımı kesmesi DMA FIFO'yu boşalttığı için
+ * tetiklenmez. Bunun yerine `BT_UART_IDLE_BITS` bit süresinde bir çalışan
+ * zamanlayıcı DMA yazma konumuna bakar: veri geldikten sonra bir tur boyunca
+ * yeni bayt yoksa (boş hat) veya tampon yarıdan fazla doluysa
+ * EVENT_LOOP_BT bildirilir.
+ *
+ * Boş DMA kanalı yoksa (ör. bilgisayar simülasyonu) aynı tamponlar UART
+ * kesmesiyle doldurulur/boşaltılır; API ve olaylar aynıdır.
+ *
+ * Akış denetimi: kartta RTS/CTS hattı yoktur. Gönderme tarafı tampon
+ * dolduğunda kabul ettiği kadarını döndürür (bloklamaz); alma tarafında
+ * okunmadan üstüne yazılan baytlar `rx_overrun` ile sayılır.
+ */
+
+#include "pico_training_board.h"
+
+#define BT_UART_RX_MASK (BT_UART_RX_LEN - 1u)
+#define BT_UART_TX_MASK (BT_UART_TX_LEN - 1u)
+#define BT_UART_RX_DMA_COUNT 0xFFFFFFFFu   // RX kanalının her tetiklemede aktaracağı bayt
+
+static uint8_t rx_buf[BT_UART_RX_LEN] __attribute__((aligned(BT_UART_RX_LEN)));
+static uint8_t tx_buf[BT_UART_TX_LEN];
+
+static int rx_chan = -1;
+static int tx_chan = -1;
+static bool running = false;
+
+static volatile uint32_t rx_head;   // Yazılan toplam bayt (DMA yolunda rx_head_now() günceller)
+static volatile uint32_t rx_tail;   // Okunan toplam bayt
+static uint32_t rx_dma_base;        // Son tetiklemeden önce DMA'nın yazdığı toplam bayt
+static uint32_t rx_seen;            // Zamanlayıcının son gördüğü rx_head
+static bool rx_active;              // Son boş hat olayından sonra veri geldi mi
+
+static volatile uint32_t tx_head;   // Kuyruğa alınan toplam bayt
+static volatile uint32_t tx_tail;   // Hatta gönderilen toplam bayt
+static volatile uint32_t tx_dma_len; // Süren DMA aktarımının uzunluğu (0: boşta)
+
+static repeating_timer_t idle_timer;
+static bt_uart_stats_t stats;
+
+/**
+ * @brief DMA yolunda yazılan toplam bayt sayısını günceller ve döndürür
+ * @return uint32_t rx_head
+ */
+static uint32_t rx_head_now(void) {
+    if (rx_chan >= 0) {
+        uint32_t remaining = dma_hw->ch[rx_chan].transfer_count;
+        rx_head = rx_dma_base + (BT_UART_RX_DMA_COUNT - remaining);
+    }
+    return rx_head;
+}
+
+/**
+ * @brief Okunmadan üstüne yazılan veriyi atlar (çağıran kesmeleri kapatır)
+ * @param head Güncel rx_head
+ */
+static void rx_drop_overrun(uint32_t head) {
+    if (head - rx_tail > BT_UART_RX_LEN) {
+        stats.rx_overrun += head - rx_tail - BT_UART_RX_LEN;
+        rx_tail = head - BT_UART_RX_LEN;
+    }
+}
+
+/**
+ * @brief Bekleyen TX verisinin sonraki bitişik parçası için DMA'yı başlatır
+ *
+ * Kesmeler kapalıyken veya DMA tamamlanma kesmesinden çağrılır.
+ */
+static void tx_dma_kick(void) {
+    uint32_t pending = tx_head - tx_tail;
+    if (tx_dma_len != 0 || pending == 0) {
+        return;
+    }
+    uint32_t start = tx_tail & BT_UART_TX_MASK;
+    uint32_t len = MIN(pending, BT_UART_TX_LEN - start);
+    tx_dma_len = len;
+    dma_channel_transfer_from_buffer_now(tx_chan, &tx_buf[start], len);
+}
+
+/**
+ * @brief TX DMA tamamlanma kesmesi
+ */
+static void tx_dma_irq_handler(void) {
+    if (!(dma_hw->ints1 & (1u << tx_chan))) {
+        return;
+    }
+    dma_hw->ints1 = 1u << tx_chan;
+    tx_tail += tx_dma_len;
+    stats.tx_bytes += tx_dma_len;
+    tx_dma_len = 0;
+    tx_dma_kick();
+}
+
+/**
+ * @brief UART kesmesi (yalnızca DMA'sız yol): RX FIFO'yu boşaltır, TX FIFO'yu doldurur
+ */
+static void uart_irq_handler(void) {
+    while (uart_is_readable(BT_UART)) {
+        uint8_t c = (uint8_t)uart_getc(BT_UART);
+        if (rx_head - rx_tail < BT_UART_RX_LEN) {
+            rx_buf[rx_head & BT_UART_RX_MASK] = c;
+            rx_head++;
+        } else {
+            stats.rx_overrun++;
+        }
+    }
+    while (tx_tail != tx_head && uart_is_writable(BT_UART)) {
+        uart_putc_raw(BT_UART, (char)tx_buf[tx_tail & BT_UART_TX_MASK]);
+        tx_tail++;
+        stats.tx_bytes++;
+    }
+    if (tx_tail == tx_head) {
+        uart_set_irq_enables(BT_UART, true, false);
+    }
+}
+
+/**
+ * @brief Boş hat / zaman aşımı zamanlayıcısı
+ *
+ * Yeni veri yarım tamponu aştıysa hemen, aksi halde hat bir tur boyunca
+ * sessiz kaldığında EVENT_LOOP_BT bildirir. DMA yolunda sayacı biten alma
+ * kanalı da burada yeniden tetiklenir.
+ *
+ * @param rt Zamanlayıcı
+ * @return bool Her zaman true (tekrarla)
+ */
+static bool idle_timer_callback(repeating_timer_t *rt) {
+    uint32_t head = rx_head_now();
+    if (head != rx_seen) {
+        rx_seen = head;
+        rx_active = true;
+        if (head - rx_tail >= BT_UART_RX_LEN / 2) {
+            event_loop_post(EVENT_LOOP_BT);
+        }
+    } else if (rx_active) {
+        rx_active = false;
+        stats.idle_events++;
+        event_loop_post(EVENT_LOOP_BT);
+    }
+
+    if (rx_chan >= 0 && !dma_channel_is_busy(rx_chan)) {
+        // 2^32 bayt bitti (115200 baud'da ~4 gün); yazma adresi kaldığı yerden sürer.
+        // Arada gelen baytlar UART FIFO'sunda bekler.
+        rx_dma_base += BT_UART_RX_DMA_COUNT;
+        dma_channel_set_trans_count(rx_chan, BT_UART_RX_DMA_COUNT, true);
+    }
+    return true;
+}
+
+/**
+ * @brief DMA kanallarını kurar
+ * @return bool İki kanal da alındıysa true
+ */
+static bool start_dma(void) {
+    rx_chan = dma_claim_unused_channel(false);
+    tx_chan = dma_claim_unused_channel(false);
+    if (rx_chan < 0 || tx_chan < 0) {
+        if (rx_chan >= 0) dma_channel_unclaim(rx_chan);
+        if (tx_chan >= 0) dma_channel_unclaim(tx_chan);
+        rx_chan = tx_chan = -1;
+        return false;
+    }
+
+    // RX: UART DR -> halka tampon (yazma adresi BT_UART_RX_LEN sınırında sarar)
+    dma_channel_config rx_cfg = dma_channel_get_default_config(rx_chan);
+    channel_config_set_transfer_data_size(&rx_cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx_cfg, false);
+    channel_config_set_write_increment(&rx_cfg, true);
+    channel_config_set_ring(&rx_cfg, true, BT_UART_RX_RING_BITS);
+    channel_config_set_dreq(&rx_cfg, uart_get_dreq(BT_UART, false));
+    rx_dma_base = 0;
+    dma_channel_configure(rx_chan, &rx_cfg, rx_buf, &uart_get_hw(BT_UART)->dr,
+                          BT_UART_RX_DMA_COUNT, true);
+
+    // TX: halka tampondaki bitişik parça -> UART DR; bitince DMA_IRQ_1
+    dma_channel_config tx_cfg = dma_channel_get_default_config(tx_chan);
+    channel_config_set_transfer_data_size(&tx_cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&tx_cfg, true);
+    channel_config_set_write_increment(&tx_cfg, false);
+    channel_config_set_dreq(&tx_cfg, uart_get_dreq(BT_UART, true));
+    dma_channel_configure(tx_chan, &tx_cfg, &uart_get_hw(BT_UART)->dr, tx_buf, 0, false);
+
+    irq_set_exclusive_handler(DMA_IRQ_1, tx_dma_irq_handler);
+    dma_channel_set_irq1_enabled(tx_chan, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+    return true;
+}
+
+/**
+ * @brief Bluetooth UART'ını başlatır
+ *
+ * BLT_TX/BLT_RX pinlerini UART'a bağlar, 8N1 ve FIFO'yu açar, mümkünse DMA
+ * kanallarını, değilse UART kesmesini kurar ve boş hat zamanlayıcısını
+ * başlatır.
+ *
+ * @param baud Baud hızı (modülün ayarıyla aynı olmalı)
+ * @return bool Sürücü çalışıyorsa true; pinler başka bir modüldeyse false
+ *
+ * @note Bu UART stdio için kullanılmamalıdır (`pico_enable_stdio_uart` kapalı).
+ */
+bool bt_uart_init(uint baud) {
+    if (running) {
+        return true;
+    }
+    if (pin_claim(BLT_TX, PIN_FUNC_UART, "bt_uart") == PIN_CLAIM_CONFLICT ||
+        pin_claim(BLT_RX, PIN_FUNC_UART, "bt_uart") == PIN_CLAIM_CONFLICT) {
+        return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    rx_head = rx_tail = rx_seen = 0;
+    tx_head = tx_tail = tx_dma_len = 0;
+    rx_active = false;
+
+    stats.baud = uart_init(BT_UART, baud);
+    gpio_set_function(BLT_TX, GPIO_FUNC_UART);
+    gpio_set_function(BLT_RX, GPIO_FUNC_UART);
+    uart_set_hw_flow(BT_UART, false, false);
+    uart_set_format(BT_UART, 8, 1, UART_PARITY_NONE);
+    uart_set_fifo_enabled(BT_UART, true);
+
+    stats.dma = start_dma();
+    if (!stats.dma) {
+        irq_set_exclusive_handler(BT_UART_IRQ, uart_irq_handler);
+        irq_set_enabled(BT_UART_IRQ, true);
+        uart_set_irq_enables(BT_UART, true, false);
+    }
+
+    // Boş hat: BT_UART_IDLE_BITS bit süresi, en az BT_UART_IDLE_MIN_US
+    int64_t idle_us = (int64_t)BT_UART_IDLE_BITS * 1000000 / stats.baud;
+    if (idle_us < BT_UART_IDLE_MIN_US) {
+        idle_us = BT_UART_IDLE_MIN_US;
+    }
+    running = add_repeating_timer_us(-idle_us, idle_timer_callback, NULL, &idle_timer);
+    return running;
+}
+
+/**
+ * @brief Alınmış verinin ilk bitişik parçasını kopyalamadan verir
+ *
+ * Veri halka tamponun sonunda sarıyorsa önce sona kadar olan kısım döner;
+ * `bt_uart_rx_consume()` sonrasında ikinci çağrı kalanını verir. Gösterilen
+ * bellek, tüketilene kadar (ve tampon taşmadıkça) geçerlidir.
+ *
+ * @param data Parçanın başlangıcı
+ * @return size_t Parçadaki bayt sayısı (0: veri yok)
+ *
+ * @code{.c}
+ * const uint8_t *p;
+ * size_t n;
+ * while ((n = bt_uart_rx_peek(&p)) != 0) {
+ *     parse(p, n);
+ *     bt_uart_rx_consume(n);
+ * }
+ * @endcode
+ */
+size_t bt_uart_rx_peek(const uint8_t **data) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t head = rx_head_now();
+    rx_drop_overrun(head);
+    uint32_t start = rx_tail & BT_UART_RX_MASK;
+    uint32_t len = MIN(head - rx_tail, BT_UART_RX_LEN - start);
+    restore_interrupts(irq_state);
+    *data = &rx_buf[start];
+    return len;
+}
+
+/**
+ * @brief Okunan baytları tampondan çıkarır
+ * @param len Tüketilen bayt sayısı (son peek'in döndürdüğünden fazla olmamalı)
+ */
+void bt_uart_rx_consume(size_t len) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    rx_tail += (uint32_t)len;
+    stats.rx_bytes += (uint32_t)len;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Alınmış veriyi kopyalayarak okur
+ * @param dst Hedef tampon
+ * @param len En fazla okunacak bayt
+ * @return size_t Okunan bayt sayısı
+ */
+size_t bt_uart_read(uint8_t *dst, size_t len) {
+    size_t total = 0;
+    const uint8_t *p;
+    size_t n;
+    while (total < len && (n = bt_uart_rx_peek(&p)) != 0) {
+        n = MIN(n, len - total);
+        memcpy(dst + total, p, n);
+        bt_uart_rx_consume(n);
+        total += n;
+    }
+    return total;
+}
+
+/**
+ * @brief Veriyi gönderme kuyruğuna ekler; beklemez
+ *
+ * @param src Gönderilecek veri
+ * @param len Bayt sayısı
+ * @return size_t Kabul edilen bayt sayısı; tampon doluysa `len`'den az
+ *
+ * @note Yalnızca Core 0'dan çağrılmalıdır.
+ */
+size_t bt_uart_write(const uint8_t *src, size_t len) {
+    if (!running) {
+        return 0;
+    }
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t space = BT_UART_TX_LEN - (tx_head - tx_tail);
+    uint32_t n = (uint32_t)MIN(len, space);
+    for (uint32_t i = 0; i < n; i++) {
+        tx_buf[(tx_head + i) & BT_UART_TX_MASK] = src[i];
+    }
+    tx_head += n;
+    if (n < len) {
+        stats.tx_full++;
+    }
+    if (stats.dma) {
+        tx_dma_kick();
+    } else if (n != 0) {
+        uart_set_irq_enables(BT_UART, true, true);
+    }
+    restore_interrupts(irq_state);
+    return n;
+}
+
+/**
+ * @brief Gönderme tamponundaki boş yer
+ * @return size_t Beklemeden yazılabilecek bayt sayısı
+ */
+size_t bt_uart_tx_free(void) {
+    return BT_UART_TX_LEN - (tx_head - tx_tail);
+}
+
+/**
+ * @brief Sürücü sayaçlarını kopyalar
+ * @param out Sayaçların yazılacağı yapı
+ */
+void bt_uart_get_stats(bt_uart_stats_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    rx_drop_overrun(rx_head_now());
+    *out = stats;
+    out->rx_pending = rx_head - rx_tail;
+    out->tx_pending = tx_head - tx_tail;
+    restore_interrupts(irq_state);
+}
@@ -13,16 +13,201 @@
 
 /**
  * @brief Bir butonun durumunu ve zamanlamasını takip eden yapı tipi
+ *
+ * PIO debounce geri çağrısı (veya kenar kesmesi + debounce alarmı) tarafından
+ * güncellenir; sorgu
+ * fonksiyonları yalnızca okur (gecikme yoktur).
  */
 typedef struct {
     absolute_time_t last_press_time; ///< Son kayıtlı buton basma zamanı
     bool is_pressed;                 ///< Butonun mevcut basılı durumu
     bool was_pressed;                ///< Butonun önceki basılı durumu
     uint32_t hold_duration;          ///< Basılı tutulma süresi (ms)
+    uint gpio;                       ///< Butonun GPIO pini
+    uint64_t edge_time_us;           ///< Debounce penceresini açan ilk kenarın zamanı
+    uint64_t prev_press_us;          ///< Bir önceki basışın zamanı (çift tıklama için)
+    absolute_time_t last_poll_time;  ///< button_pressed() son true dönüş zamanı
+    alarm_id_t hold_alarm;           ///< Basılı tutma alarmı (0: yok)
+    volatile uint8_t latched;        ///< check_button_event() için bekleyen olay bitleri
 } button_state_t;
 
 // YUKARI, TAMAM ve AŞAĞI butonları için durum dizisi
-static button_state_t button_states[3] = {0};
+static button_state_t button_states[3] = {
+    {.gpio = BUTTON_UP}, {.gpio = BUTTON_OK}, {.gpio = BUTTON_DOWN}
+};
+
+static button_event_t event_storage[BUTTON_EVENT_QUEUE_LEN];
+static event_queue_t event_queue;
+
+/**
+ * @brief GPIO pininden buton indeksini al
+ * 
+ * @param gpio GPIO pin numarası
+ * @return int Buton indeksi (YUKARI için 0, TAMAM için 1, AŞAĞI için 2, geçersizse -1)
+ * 
+ * @details GPIO pin numaralarını buton durumu takibi için dizi indekslerine eşler.
+ *          GPIO pini geçerli bir buton pini değilse -1 döndürür.
+ */
+static int get_button_index(uint gpio) {
+    switch (gpio) {
+        case BUTTON_UP: return 0;
+        case BUTTON_OK: return 1;
+        case BUTTON_DOWN: return 2;
+        default: return -1;
+    }
+}
+
+/**
+ * @brief Olay kuyruğuna bir olay ekler ve sorgu API'si için bayrağını kaldırır
+ * @param b Buton durumu
+ * @param type Olay türü
+ * @param timestamp_us Olay zamanı
+ * @param duration_ms Basılı kalma süresi (RELEASED ve HELD için)
+ */
+static void emit_event(button_state_t *b, ButtonEvent type, uint64_t timestamp_us,
+                       uint32_t duration_ms) {
+    button_event_t ev = {
+        .timestamp_us = timestamp_us,
+        .gpio = (uint8_t)b->gpio,
+        .type = type,
+        .duration_ms = duration_ms
+    };
+    b->latched |= (uint8_t)(1u << type);
+    event_queue_push(&event_queue, &ev);
+    event_loop_post(EVENT_LOOP_BUTTON);
+}
+
+/**
+ * @brief Basılı tutma alarmı; buton hâlâ basılıysa BUTTON_HELD üretir
+ * @param id Alarm kimliği
+ * @param user_data Buton durumu
+ * @return int64_t 0 (tekrarlanmaz)
+ */
+static int64_t hold_alarm_callback(alarm_id_t id, void *user_data) {
+    button_state_t *b = (button_state_t *)user_data;
+    b->hold_alarm = 0;
+    if (b->is_pressed) {
+        emit_event(b, BUTTON_HELD, time_us_64(), BUTTON_HOLD_MS);
+    }
+    return 0;
+}
+
+static int64_t debounce_alarm_callback(alarm_id_t id, void *user_data);
+
+/**
+ * @brief Debounce penceresini açar: pinin kesmesini kapatır ve örnekleme alarmı kurar
+ * @param b Buton durumu
+ * @param now_us Kenar zamanı
+ */
+static void start_debounce(button_state_t *b, uint64_t now_us) {
+    gpio_set_irq_enabled(b->gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    b->edge_time_us = now_us;
+    if (add_alarm_in_us(board_config.button_debounce_us, debounce_alarm_callback, b, true) < 0) {
+        // Alarm havuzu dolu; kenar kesmesini geri aç ki buton kilitlenmesin
+        gpio_set_irq_enabled(b->gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    }
+}
+
+/**
+ * @brief Kararlı (debounce edilmiş) seviyeyi durum makinesine uygular
+ *
+ * Seviye kararlı durumdan farklıysa PRESSED/RELEASED (ve gerekirse DOUBLE)
+ * üretir, basılı tutma alarmını kurar veya iptal eder. PIO ve GPIO kesmesi
+ * yolları ortaktır.
+ *
+ * @param b Buton durumu
+ * @param level Kararlı pin seviyesi
+ * @param t Kenar zamanı
+ */
+static void apply_stable_level(button_state_t *b, bool level, uint64_t t) {
+    if (level && !b->is_pressed) {
+        b->was_pressed = false;
+        b->is_pressed = true;
+        update_us_since_boot(&b->last_press_time, t);
+        b->hold_duration = 0;
+        emit_event(b, BUTTON_PRESSED, t, 0);
+        if (b->prev_press_us && t - b->prev_press_us <= BUTTON_DOUBLE_MS * 1000ull) {
+            emit_event(b, BUTTON_DOUBLE, t, 0);
+            b->prev_press_us = 0;  // Üçüncü basış yeni bir çift tıklama başlatır
+        } else {
+            b->prev_press_us = t;
+        }
+        b->hold_alarm = add_alarm_in_ms(BUTTON_HOLD_MS, hold_alarm_callback, b, true);
+        if (b->hold_alarm < 0) b->hold_alarm = 0;
+    } else if (!level && b->is_pressed) {
+        if (b->hold_alarm > 0) {
+            cancel_alarm(b->hold_alarm);
+            b->hold_alarm = 0;
+        }
+        b->was_pressed = true;
+        b->is_pressed = false;
+        b->hold_duration = (uint32_t)((t - to_us_since_boot(b->last_press_time)) / 1000);
+        emit_event(b, BUTTON_RELEASED, t, b->hold_duration);
+    }
+}
+
+/**
+ * @brief Debounce alarmı; pencere sonunda pini örnekler ve durum makinesini ilerletir
+ *
+ * PIO'ya bağlanamayan butonlar için yazılım yoludur. Pencere boyunca pin
+ * kesmesi kapalıdır; sıçramalar kesme üretmez.
+ *
+ * @param id Alarm kimliği
+ * @param user_data Buton durumu
+ * @return int64_t 0 (tekrarlanmaz)
+ */
+static int64_t debounce_alarm_callback(alarm_id_t id, void *user_data) {
+    button_state_t *b = (button_state_t *)user_data;
+    uint64_t entry_us = time_us_64();
+    uint64_t due_us = b->edge_time_us + board_config.button_debounce_us;
+    apply_stable_level(b, gpio_get(b->gpio), b->edge_time_us);
+
+    // Pencere sırasında biriken kenarları at ve kesmeyi yeniden aç
+    gpio_acknowledge_irq(b->gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+    gpio_set_irq_enabled(b->gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+
+    // Kesme kapalıyken seviye değiştiyse yeni bir pencere aç
+    if (gpio_get(b->gpio) != b->is_pressed) {
+        start_debounce(b, time_us_64());
+    }
+    sysmon_button_irq(entry_us > due_us ? (uint32_t)(entry_us - due_us) : 0,
+                      (uint32_t)(time_us_64() - entry_us));
+    return 0;
+}
+
+/**
+ * @brief Buton pinleri için ham GPIO kesme işleyicisi
+ *
+ * Yalnızca kenarı onaylar, zaman damgasını alır ve debounce alarmını kurar;
+ * asıl iş alarmda yapılır. Diğer pinlerin kesmelerine dokunmaz.
+ */
+static void buttons_irq_handler(void) {
+    uint64_t entry_us = time_us_64();
+    for (uint i = 0; i < count_of(button_states); i++) {
+        button_state_t *b = &button_states[i];
+        uint32_t events = gpio_get_irq_event_mask(b->gpio);
+        if (events & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL)) {
+            gpio_acknowledge_irq(b->gpio, events);
+            start_debounce(b, time_us_64());
+        }
+    }
+    sysmon_button_irq(0, (uint32_t)(time_us_64() - entry_us));
+}
+
+/**
+ * @brief PIO debounce sürücüsünden gelen temiz seviye değişimi
+ * @param gpio Buton pini
+ * @param level Yeni kararlı seviye
+ * @param timestamp_us Tahmini kenar zamanı
+ */
+static void buttons_pio_callback(uint gpio, bool level, uint64_t timestamp_us) {
+    uint64_t entry_us = time_us_64();
+    int idx = get_button_index(gpio);
+    if (idx != -1) {
+        apply_stable_level(&button_states[idx], level, timestamp_us);
+    }
+    sysmon_button_irq(0, (uint32_t)(time_us_64() - entry_us));
+}
 
 /**
  * @brief Debounce korumalı temel buton basma kontrolü
@@ -30,19 +215,21 @@ static button_state_t button_states[3] = {0};
  * @param gpio Kontrol edilecek GPIO pini
  * @return bool buton basılıysa (debounce sonrası) true, değilse false
  * 
- * @details Buton sıçramalarından kaynaklanan yanlış tetiklenmeleri önlemek için
- *          100ms debounce süresi uygular. Sadece debounce süresi geçtikten
- *          sonra basma işlemini kaydeder.
+ * @details Kesme ile debounce edilmiş kararlı durumu okur. Buton basılı
+ *          tutulurken en fazla her BUTTON_POLL_INTERVAL_US'de bir true döner.
+ *          Her butonun zamanlaması ayrıdır; bir butona basmak diğerini
+ *          bastırmaz.
  */
 bool button_pressed(uint gpio) {
-    static absolute_time_t last_time;
-    const uint32_t DEBOUNCE_US = 100000; // 100ms debounce süresi
+    int idx = get_button_index(gpio);
+    if (idx == -1) return false;
+    button_state_t *b = &button_states[idx];
     
     absolute_time_t current_time = get_absolute_time();
     
-    if (gpio_get(gpio) && 
-        (absolute_time_diff_us(last_time, current_time) > DEBOUNCE_US)) {
-        last_time = current_time;
+    if (b->is_pressed &&
+        (absolute_time_diff_us(b->last_poll_time, current_time) > BUTTON_POLL_INTERVAL_US)) {
+        b->last_poll_time = current_time;
         return true;
     }
     return false;
@@ -53,9 +240,17 @@ bool button_pressed(uint gpio) {
  * 
  * @details YUKARI, TAMAM ve AŞAĞI butonlarını pull-down dirençli giriş pinleri olarak
  *          yapılandırır. Bu, butonlar basılı değilken bilinen bir durumda
- *          olmalarını sağlar.
+ *          olmalarını sağlar. Debounce öncelikle PIO'da yapılır
+ *          (bkz. input_pio.c); PIO durum makinesi bulunamayan butonlar için
+ *          her iki kenarda kesme açılır ve debounce kesme + alarm ile yapılır.
  */
 void init_buttons(void) {
+    if (pin_claim(BUTTON_UP, PIN_FUNC_SIO_IN, "buttons") != PIN_CLAIM_NEW) {
+        return;  // Zaten başlatıldı; kuyruk ve kesme işleyicisi ikinci kez kurulmaz
+    }
+    pin_claim(BUTTON_OK, PIN_FUNC_SIO_IN, "buttons");
+    pin_claim(BUTTON_DOWN, PIN_FUNC_SIO_IN, "buttons");
+
     // Buton pinlerini başlat
     gpio_init(BUTTON_UP);
     gpio_init(BUTTON_OK);
@@ -69,80 +264,117 @@ void init_buttons(void) {
     gpio_pull_down(BUTTON_UP);
     gpio_pull_down(BUTTON_OK);
     gpio_pull_down(BUTTON_DOWN);
+
+    event_queue_init(&event_queue, event_storage, sizeof(event_storage[0]),
+                     BUTTON_EVENT_QUEUE_LEN);
+
+    uint32_t gpio_irq_mask = 0;
+    for (uint i = 0; i < count_of(button_states); i++) {
+        if (!input_pio_attach(button_states[i].gpio, board_config.button_debounce_us, buttons_pio_callback)) {
+            gpio_irq_mask |= 1u << button_states[i].gpio;
+        }
+    }
+    if (gpio_irq_mask == 0) {
+        return;
+    }
+
+    // Paylaşılan GPIO geri çağrısı yerine yalnızca buton pinlerine ait ham işleyici
+    gpio_add_raw_irq_handler_masked(gpio_irq_mask, buttons_irq_handler);
+    for (uint i = 0; i < count_of(button_states); i++) {
+        if (gpio_irq_mask & (1u << button_states[i].gpio)) {
+            gpio_set_irq_enabled(button_states[i].gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+        }
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
 }
 
 /**
- * @brief GPIO pininden buton indeksini al
- * 
- * @param gpio GPIO pin numarası
- * @return int Buton indeksi (YUKARI için 0, TAMAM için 1, AŞAĞI için 2, geçersizse -1)
- * 
- * @details GPIO pin numaralarını buton durumu takibi için dizi indekslerine eşler.
- *          GPIO pini geçerli bir buton pini değilse -1 döndürür.
+ * @brief Buton olay kuyruğundan en eski olayı alır; beklemez
+ *
+ * @param ev Olayın yazılacağı yapı
+ * @return bool Olay alındıysa true, kuyruk boşsa false
+ *
+ * @code{.c}
+ * button_event_t ev;
+ * while (button_get_event(&ev)) {
+ *   if (ev.gpio == BUTTON_OK && ev.type == BUTTON_DOUBLE) { ... }
+ * }
+ * @endcode
  */
-static int get_button_index(uint gpio) {
-    switch (gpio) {
-        case BUTTON_UP: return 0;
-        case BUTTON_OK: return 1;
-        case BUTTON_DOWN: return 2;
-        default: return -1;
+bool button_get_event(button_event_t *ev) {
+    return event_queue_pop(&event_queue, ev);
+}
+
+/**
+ * @brief Şu anda basılı olan butonların bit maskesini döndürür
+ *
+ * Çoklu buton kombinasyonları (ör. YUKARI + AŞAĞI) için kullanılır.
+ *
+ * @return uint32_t `1u << gpio` bitlerinden oluşan maske
+ */
+uint32_t buttons_pressed_mask(void) {
+    uint32_t mask = 0;
+    for (uint i = 0; i < count_of(button_states); i++) {
+        if (button_states[i].is_pressed) {
+            mask |= 1u << button_states[i].gpio;
+        }
     }
+    return mask;
+}
+
+/**
+ * @brief Butonların anlık durumunu ortak örnek kaydına yazar
+ *
+ * `raw` basılı buton maskesi, `value` basılı buton sayısıdır. Kararlı seviye
+ * debounce sonrası durumdur; zaman damgası okuma anıdır.
+ *
+ * @param out Örneğin yazılacağı kayıt
+ * @return bool Her zaman true
+ */
+bool buttons_sample(sensor_sample_t *out) {
+    out->sensor = SENSOR_BUTTONS;
+    out->raw = buttons_pressed_mask();
+    out->timestamp_us = time_us_64();
+    out->value = (float)__builtin_popcount(out->raw);
+    out->valid = true;
+    return true;
 }
 
 /**
  * @brief Çeşitli zamanlama kontrolleriyle buton basma kontrolü
  * 
  * @param gpio Kontrol edilecek GPIO pini
- * @param event Kontrol edilecek buton olayı türü (BUTTON_PRESSED, BUTTON_RELEASED veya BUTTON_HELD)
+ * @param event Kontrol edilecek buton olayı türü
  * @return bool belirtilen olay gerçekleştiyse true
  * 
  * @details Farklı buton olay türlerini işler:
  *          - BUTTON_PRESSED: Buton ilk basıldığında bir kez tetiklenir
  *          - BUTTON_RELEASED: Buton bırakıldığında bir kez tetiklenir
- *          - BUTTON_HELD: Buton 1 saniyeden fazla basılı tutulduğunda tetiklenir
+ *          - BUTTON_HELD: Buton BUTTON_HOLD_MS'den fazla basılı tutulduğunda tetiklenir
+ *          - BUTTON_DOUBLE: İki basış arası BUTTON_DOUBLE_MS'den kısaysa bir kez tetiklenir
  *          
- * @note Debounce koruması içerir ve her buton için durum bilgisini saklar
+ * @note Olaylar kesme tarafından kaydedilir; sorgu arası kısa basışlar kaybolmaz.
  */
 bool check_button_event(uint gpio, ButtonEvent event) {
     int idx = get_button_index(gpio);
     if (idx == -1) return false;
-    
-    absolute_time_t current_time = get_absolute_time();
-    bool current_state = gpio_get(gpio);
-    bool event_detected = false;
-    
-    // Buton durumunu güncelle
-    if (current_state && !button_states[idx].is_pressed) {
-        // Buton yeni basıldı
-        if (absolute_time_diff_us(button_states[idx].last_press_time, current_time) > 200000) {
-            button_states[idx].is_pressed = true;
-            button_states[idx].last_press_time = current_time;
-            button_states[idx].hold_duration = 0;
-            
-            if (event == BUTTON_PRESSED) {
-                event_detected = true;
-            }
-        }
-    } else if (!current_state && button_states[idx].is_pressed) {
-        // Buton yeni bırakıldı
-        button_states[idx].is_pressed = false;
-        if (event == BUTTON_RELEASED) {
-            event_detected = true;
-        }
-    }
+    button_state_t *b = &button_states[idx];
     
     // Buton hala basılıysa basılı tutma süresini güncelle
-    if (button_states[idx].is_pressed) {
-        button_states[idx].hold_duration = 
-            absolute_time_diff_us(button_states[idx].last_press_time, current_time) / 1000; // ms'ye çevir
-        
-        // Basılı tutma olayını kontrol et
-        if (event == BUTTON_HELD && button_states[idx].hold_duration > 1000) { // 1 saniye basılı tutma
-            event_detected = true;
-        }
+    if (b->is_pressed) {
+        b->hold_duration = 
+            absolute_time_diff_us(b->last_press_time, get_absolute_time()) / 1000; // ms'ye çevir
     }
-    
-    button_states[idx].was_pressed = button_states[idx].is_pressed;
+
+    if (event == BUTTON_HELD) {
+        return b->is_pressed && b->hold_duration > BUTTON_HOLD_MS;
+    }
+
+    uint8_t bit = (uint8_t)(1u << event);
+    uint32_t irq_state = save_and_disable_interrupts();
+    bool event_detected = (b->latched & bit) != 0;
+    b->latched &= (uint8_t)~bit;
+    restore_interrupts(irq_state);
     return event_detected;
 }
 
@@ -159,7 +391,8 @@ uint32_t get_button_hold_duration(uint gpio) {
     if (idx == -1) return 0;
     
     if (button_states[idx].is_pressed) {
-        return button_states[idx].hold_duration;
+        return (uint32_t)(absolute_time_diff_us(button_states[idx].last_press_time,
+                                                get_absolute_time()) / 1000);
     }
     return 0;
 }
@@ -171,25 +404,32 @@ uint32_t get_button_hold_duration(uint gpio) {
  * @return uint Basılan butonun GPIO pini, veya zaman aşımında UINT_MAX
  * 
  * @details Şu durumlardan biri gerçekleşene kadar program akışını bloklar:
- *          1. Herhangi bir butona basılması (GPIO pin numarasını döndürür)
+ *          1. Herhangi bir butona yeni basılması (GPIO pin numarasını döndürür)
  *          2. Zaman aşımı süresinin dolması (UINT_MAX döndürür)
  *          3. timeout_ms 0 ise, sonsuza kadar bekler
+ *
+ *          Çağrıdan önce basılı olan veya önceden kaydedilmiş basışlar sayılmaz.
  * 
- * @note Verimli bekleme için tight_loop_contents() makrosunu kullanır
+ * @note Bekleme sırasında çekirdek `__wfe` ile uyur; buton kesmesi veya
+ *       zaman aşımı alarmı uyandırır.
  */
 uint wait_for_button_press(uint32_t timeout_ms) {
-    absolute_time_t start_time = get_absolute_time();
+    absolute_time_t deadline = timeout_ms > 0 ? make_timeout_time_ms(timeout_ms)
+                                              : at_the_end_of_time;
+
+    // Eski basışları temizle
+    for (uint i = 0; i < count_of(button_states); i++) {
+        check_button_event(button_states[i].gpio, BUTTON_PRESSED);
+    }
     
     while (true) {
-        if (timeout_ms > 0 && 
-            absolute_time_diff_us(start_time, get_absolute_time()) > timeout_ms * 1000) {
+        if (check_button_event(BUTTON_UP, BUTTON_PRESSED)) return BUTTON_UP;
+        if (check_button_event(BUTTON_OK, BUTTON_PRESSED)) return BUTTON_OK;
+        if (check_button_event(BUTTON_DOWN, BUTTON_PRESSED)) return BUTTON_DOWN;
+
+        // Basışlar kesmede kaydedilir; bir kesme veya zaman aşımına kadar uyu
+        if (best_effort_wfe_or_timeout(deadline)) {
             return UINT_MAX;
         }
-        
-        if (button_pressed(BUTTON_UP)) return BUTTON_UP;
-        if (button_pressed(BUTTON_OK)) return BUTTON_OK;
-        if (button_pressed(BUTTON_DOWN)) return BUTTON_DOWN;
-        
-        tight_loop_contents();
     }
 }
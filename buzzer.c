@@ -80,7 +80,9 @@ static const NoteFrequency note_frequencies[] = {
  */
 void init_buzzer_pwm(void)
 {
-    init_pwm_pin(BUZZER_PIN, PWM_FREQ, 0); // 0 görev döngüsü ile başlat
+    if (pin_claim(BUZZER_PIN, PIN_FUNC_PWM, "buzzer") == PIN_CLAIM_NEW) {
+        init_pwm_pin(BUZZER_PIN, PWM_FREQ, 0); // 0 görev döngüsü ile başlat
+    }
 }
 
 /**
@@ -164,12 +166,68 @@ void play_note(float frequency, int duration_ms)
         return; // Geçersiz parametreler
     }
 
+    TRACE_BEGIN(TRACE_PLAY_NOTE);
     uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
     set_pwm_frequency(slice_num, frequency);
     sleep_ms(duration_ms);
     pwm_set_gpio_level(BUZZER_PIN, 0);
     sleep_us(50); // Notaların birbirine karışmasını önlemek için küçük gecikme
+    TRACE_END(TRACE_PLAY_NOTE);
+}
+
+static volatile alarm_id_t beep_alarm = 0; // Susturma alarmı; alarm kesmesi bitince sıfırlar
+
+/**
+ * @brief Bip süresi dolunca buzzer'ı susturan alarm geri çağrısı
+ * @param id Alarm kimliği
+ * @param user_data Kullanılmıyor
+ * @return int64_t 0 (alarm tekrarlanmaz)
+ */
+static int64_t beep_off_callback(alarm_id_t id, void *user_data)
+{
+    pwm_set_gpio_level(BUZZER_PIN, 0);
+    beep_alarm = 0;
+    return 0;
 }
+
+/**
+ * @brief Bloklamadan kısa bir bip sesi çalar
+ *
+ * Buzzer hemen başlatılır ve bir zamanlayıcı alarmı süre dolunca susturur;
+ * çağıran beklemez. Önceki bip hâlâ çalıyorsa süresi yeniden başlatılır.
+ *
+ * @param frequency Frekans (Hz)
+ * @param duration_ms Süre (milisaniye)
+ *
+ * @code{.c}
+ * buzzer_beep_async(NOTE_C4, 25); // tuş geri bildirimi
+ * @endcode
+ */
+void buzzer_beep_async(float frequency, uint32_t duration_ms)
+{
+    if (frequency <= 0)
+    {
+        return;
+    }
+
+    TRACE_INSTANT(TRACE_BEEP, frequency);
+    if (beep_alarm > 0)
+    {
+        cancel_alarm(beep_alarm);
+        beep_alarm = 0;
+    }
+    set_pwm_frequency(pwm_gpio_to_slice_num(BUZZER_PIN), frequency);
+    alarm_id_t id = add_alarm_in_ms(duration_ms, beep_off_callback, NULL, true);
+    if (id > 0)
+    {
+        beep_alarm = id;
+    }
+    else if (id < 0)
+    {
+        pwm_set_gpio_level(BUZZER_PIN, 0); // Alarm kurulamadı, sesi açık bırakma
+    }
+}
+
 /**
  * @brief Bir dizi müzikal notanın çalınmasını sağlar
  *
@@ -192,7 +250,7 @@ void play_notes(const char *notes[][2], int num_notes, int duration) {
         const char *note = notes[i][0];
         int octave = atoi(notes[i][1]);
         double frequency = get_frequency(note, octave);
-        printf("Playing frequency: %.2f Hz for %d ms\n", frequency, duration);
+        LOG_DEBUG("Playing frequency: %.2f Hz for %d ms", frequency, duration);
         play_note(frequency, duration);
     }
 }
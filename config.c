@@ -0,0 +1,343 @@
+/**
+ * @file config.c
+ * @brief Sürümlü, CRC korumalı ve çift sektörlü kalıcı yapılandırma
+ * @see \ref howto_config
+ *
+ * Yapılandırma flash'ın sonundaki iki sektörde (A ve B) tutulur. Her kayıt
+ * tek sayfadır:
+ * @code
+ * imza u32 | nesil u32 | sürüm u16 | boyut u16 | CRC u16 | ayrılmış u16 | config_t (boyut bayt)
+ * @endcode
+ * CRC, başlığın CRC'ye kadar olan kısmı ve yük üzerindendir. Kaydetme her
+ * zaman etkin olmayan sektörü siler ve bir sonraki nesille yazar; etkin kayıt
+ * yazma bitene kadar dokunulmadan kalır. Açılışta iki sektörden geçerli olan
+ * en yeni nesil yüklenir, bu yüzden yazma sırasında güç kesilirse önceki
+ * yapılandırma kullanılır.
+ */
+
+#include "pico_training_board.h"
+
+/**
+ * @brief Flash'taki kaydın başlığı (16 bayt); ardından config_t gelir
+ */
+typedef struct {
+    uint32_t magic;     ///< CONFIG_MAGIC
+    uint32_t seq;       ///< Nesil (her kaydetmede bir artar)
+    uint16_t version;   ///< Yazan firmware'in CONFIG_VERSION değeri
+    uint16_t size;      ///< Yazılan config_t boyutu
+    uint16_t crc;       ///< Başlık (bu alana kadar) ve yük üzerinden CRC-16/CCITT
+    uint16_t reserved;  ///< 0xFFFF
+} config_header_t;
+
+/**
+ * @brief Eski tuş takımı kalibrasyon kaydı (keypad.c, KEYPAD_CAL_FLASH_OFFSET)
+ */
+typedef struct {
+    uint32_t magic;                          ///< KEYPAD_CAL_MAGIC
+    uint16_t thresholds[KEYPAD_KEY_COUNT];   ///< Alt eşikler (azalan)
+    uint16_t crc;                            ///< magic ve eşikler üzerinden CRC-16/CCITT
+} keypad_calibration_t;
+
+#define KEYPAD_CAL_MAGIC 0x4C43504Bu /**< "KPCL" */
+
+_Static_assert(sizeof(config_header_t) + sizeof(config_t) <= FLASH_PAGE_SIZE,
+               "config_t tek flash sayfasına sığmalı");
+_Static_assert(sizeof(config_t) % 4 == 0, "config_t alanları 4 baytın katı olmalı");
+
+#define CONFIG_DEFAULTS {                                                        \
+    .keypad_thresholds = {2090, 1385, 735, 620, 574, 530, 401, 361, 340, 281, 261, 250}, \
+    .button_debounce_us = BUTTON_DEBOUNCE_US,                                    \
+    .pir_debounce_us = PIR_DEBOUNCE_US,                                          \
+    .sound_speed = ULTRASONIC_SOUND_SPEED,                                       \
+    .i2c_baud = CONFIG_I2C_BAUD_DEFAULT,                                         \
+    .motor_speed = CONFIG_MOTOR_SPEED_DEFAULT,                                   \
+}
+
+static const config_t config_default = CONFIG_DEFAULTS;
+
+/**
+ * @brief Etkin yapılandırma
+ *
+ * Varsayılanlarla ilklenir; config_load() çağrılmadan da (ölçüm firmware'i,
+ * simülasyon) geçerlidir. Yalnızca Core 0'dan config_set() ile değiştirilir.
+ */
+config_t board_config = CONFIG_DEFAULTS;
+
+#define KEYPAD_FIELD(i, name) \
+    {name, offsetof(config_t, keypad_thresholds) + (i) * sizeof(uint16_t), CONFIG_U16, false, 1, 4095}
+
+static const config_field_t fields[] = {
+    KEYPAD_FIELD(0, "keypad_1"),
+    KEYPAD_FIELD(1, "keypad_2"),
+    KEYPAD_FIELD(2, "keypad_3"),
+    KEYPAD_FIELD(3, "keypad_4"),
+    KEYPAD_FIELD(4, "keypad_5"),
+    KEYPAD_FIELD(5, "keypad_6"),
+    KEYPAD_FIELD(6, "keypad_7"),
+    KEYPAD_FIELD(7, "keypad_8"),
+    KEYPAD_FIELD(8, "keypad_9"),
+    KEYPAD_FIELD(9, "keypad_*"),
+    KEYPAD_FIELD(10, "keypad_0"),
+    KEYPAD_FIELD(11, "keypad_#"),
+    {"button_debounce_us", offsetof(config_t, button_debounce_us), CONFIG_U32, true, 1000, 200000},
+    {"pir_debounce_us", offsetof(config_t, pir_debounce_us), CONFIG_U32, true, 1000, 1000000},
+    {"sound_speed", offsetof(config_t, sound_speed), CONFIG_F32, false, 300.0f, 380.0f},
+    {"i2c_baud", offsetof(config_t, i2c_baud), CONFIG_U32, true, 10000, 1000000},
+    {"motor_speed", offsetof(config_t, motor_speed), CONFIG_U32, false,
+     1000000 / STEP_DELAY_MAX, 1000000 / STEP_DELAY_MIN},
+};
+
+#define CONFIG_FIELD_COUNT (sizeof(fields) / sizeof(fields[0]))
+
+static config_status_t status = {.slot = -1};
+
+/**
+ * @brief Bir sektördeki kaydın adresi
+ */
+static inline const config_header_t *slot_header(uint slot) {
+    return (const config_header_t *)(XIP_BASE + CONFIG_FLASH_OFFSET + slot * FLASH_SECTOR_SIZE);
+}
+
+static uint16_t record_crc(const config_header_t *h, const void *payload) {
+    uint16_t crc = crc16_ccitt((const uint8_t *)h, offsetof(config_header_t, crc), CRC16_INIT);
+    return crc16_ccitt((const uint8_t *)payload, h->size, crc);
+}
+
+/**
+ * @brief Sektördeki kayıt geçerli mi
+ */
+static bool slot_valid(uint slot) {
+    const config_header_t *h = slot_header(slot);
+    return h->magic == CONFIG_MAGIC && h->size % 4 == 0 &&
+           h->size <= FLASH_PAGE_SIZE - sizeof(config_header_t) && record_crc(h, h + 1) == h->crc;
+}
+
+static float field_read(const config_t *c, const config_field_t *f) {
+    const uint8_t *p = (const uint8_t *)c + f->offset;
+    switch (f->type) {
+        case CONFIG_U16: return (float)*(const uint16_t *)p;
+        case CONFIG_U32: return (float)*(const uint32_t *)p;
+        default: return *(const float *)p;
+    }
+}
+
+static void field_write(config_t *c, const config_field_t *f, float value) {
+    uint8_t *p = (uint8_t *)c + f->offset;
+    switch (f->type) {
+        case CONFIG_U16: *(uint16_t *)p = (uint16_t)lroundf(value); break;
+        case CONFIG_U32: *(uint32_t *)p = (uint32_t)lroundf(value); break;
+        default: *(float *)p = value; break;
+    }
+}
+
+static bool thresholds_descending(const uint16_t *t) {
+    for (int i = 1; i < KEYPAD_KEY_COUNT; i++) {
+        if (t[i] >= t[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Aralık dışı alanları ve sırası bozuk eşik tablosunu varsayılana çeker
+ * @return uint Düzeltilen alan sayısı
+ */
+static uint sanitize(config_t *c) {
+    uint fixed = 0;
+    for (uint i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        float v = field_read(c, &fields[i]);
+        if (!(v >= fields[i].min && v <= fields[i].max)) {  // NaN dahil
+            field_write(c, &fields[i], field_read(&config_default, &fields[i]));
+            fixed++;
+        }
+    }
+    if (!thresholds_descending(c->keypad_thresholds)) {
+        memcpy(c->keypad_thresholds, config_default.keypad_thresholds, sizeof(c->keypad_thresholds));
+        fixed++;
+    }
+    return fixed;
+}
+
+/**
+ * @brief Eski (tek sektörlü) tuş takımı kalibrasyonunu okur
+ */
+static bool load_legacy_keypad(config_t *c) {
+    const keypad_calibration_t *cal = (const keypad_calibration_t *)(XIP_BASE + KEYPAD_CAL_FLASH_OFFSET);
+    if (cal->magic != KEYPAD_CAL_MAGIC ||
+        cal->crc != crc16_ccitt((const uint8_t *)cal, offsetof(keypad_calibration_t, crc), CRC16_INIT) ||
+        !thresholds_descending(cal->thresholds)) {
+        return false;
+    }
+    memcpy(c->keypad_thresholds, cal->thresholds, sizeof(c->keypad_thresholds));
+    return true;
+}
+
+/**
+ * @brief Yapılandırmayı flash'tan `board_config`'e yükler (açılışta bir kez)
+ *
+ * İki sektörden geçerli olan en yeni nesil seçilir. Kayıt bu firmware'den
+ * kısaysa (eski şema) eksik alanlar varsayılan kalır, uzunsa (yeni şema)
+ * bilinmeyen alanlar yok sayılır. Geçerli kayıt yoksa eski tuş takımı
+ * kalibrasyonu taşınır; sonraki config_save() onu A sektörüne yazar.
+ *
+ * @return bool Flash'tan (kayıt veya eski kalibrasyon) veri yüklendiyse true
+ *
+ * @note Core 1 başlamadan önce çağrılır; flash yalnızca okunur.
+ */
+bool config_load(void) {
+    config_t c = config_default;
+    bool valid[2] = {slot_valid(0), slot_valid(1)};
+    int slot = -1;
+
+    if (valid[0] && valid[1]) {
+        slot = (int32_t)(slot_header(1)->seq - slot_header(0)->seq) > 0 ? 1 : 0;
+    } else if (valid[0] || valid[1]) {
+        slot = valid[0] ? 0 : 1;
+    }
+
+    memset(&status, 0, sizeof(status));
+    status.slot = (int8_t)slot;
+    if (slot >= 0) {
+        const config_header_t *h = slot_header((uint)slot);
+        memcpy(&c, h + 1, h->size < sizeof(c) ? h->size : sizeof(c));
+        // Şemada alan anlamı değişirse dönüşüm burada h->version'a göre yapılır
+        status.seq = h->seq;
+        status.version = (uint8_t)h->version;
+    } else {
+        status.legacy_keypad = load_legacy_keypad(&c);
+        status.dirty = status.legacy_keypad;
+    }
+
+    if (sanitize(&c) != 0) {
+        status.dirty = true;
+    }
+    board_config = c;
+    return slot >= 0 || status.legacy_keypad;
+}
+
+/**
+ * @brief Flash yazımı; diğer çekirdek ve kesmeler durdurulmuşken çalışır
+ * @param param Yazılacak sayfa; ilk sözcükten önce hedef ofset (bkz. config_save())
+ */
+static void config_flash_write(void *param) {
+    const uint32_t *offs = (const uint32_t *)param;
+    flash_range_erase(*offs, FLASH_SECTOR_SIZE);
+    flash_range_program(*offs, (const uint8_t *)(offs + 1), FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief `board_config`'i etkin olmayan sektöre bir sonraki nesille yazar
+ *
+ * Silme ve programlama ~46 ms sürer; bu sürede Core 1 durdurulur. Motor
+ * dönerken adım zamanlaması bozulacağı için yazmaz.
+ *
+ * @return bool Yazıldı ve geri okunarak doğrulandıysa true
+ */
+bool config_save(void) {
+    static uint32_t buf[1 + FLASH_PAGE_SIZE / sizeof(uint32_t)];
+    uint8_t *page = (uint8_t *)&buf[1];
+
+    if (get_motor_state() == MOTOR_RUNNING) {
+        return false;
+    }
+    uint slot = status.slot == 0 ? 1 : 0;
+    memset(page, 0xFF, FLASH_PAGE_SIZE);
+    config_header_t *h = (config_header_t *)page;
+    h->magic = CONFIG_MAGIC;
+    h->seq = status.seq + 1;
+    h->version = CONFIG_VERSION;
+    h->size = sizeof(config_t);
+    memcpy(h + 1, &board_config, sizeof(config_t));
+    h->crc = record_crc(h, h + 1);
+
+    buf[0] = CONFIG_FLASH_OFFSET + slot * FLASH_SECTOR_SIZE;
+    if (flash_safe_execute(config_flash_write, buf, 100) != PICO_OK || !slot_valid(slot) ||
+        slot_header(slot)->seq != h->seq) {
+        return false;
+    }
+    status.slot = (int8_t)slot;
+    status.seq = h->seq;
+    status.version = CONFIG_VERSION;
+    status.dirty = false;
+    return true;
+}
+
+/**
+ * @brief `board_config`'i varsayılan değerlere döndürür (flash'a yazmaz)
+ */
+void config_defaults(void) {
+    board_config = config_default;
+    status.dirty = true;
+}
+
+/**
+ * @brief Tanımlı alan sayısı
+ */
+uint config_field_count(void) {
+    return CONFIG_FIELD_COUNT;
+}
+
+/**
+ * @brief Alan tanımını döndürür
+ * @param index Alan indeksi (protokoldeki alan numarası)
+ * @return const config_field_t* İndeks geçersizse NULL
+ */
+const config_field_t *config_field(uint index) {
+    return index < CONFIG_FIELD_COUNT ? &fields[index] : NULL;
+}
+
+/**
+ * @brief Alanı adıyla bulur
+ * @return int Alan indeksi, bulunamazsa -1
+ */
+int config_find(const char *name) {
+    for (uint i = 0; i < CONFIG_FIELD_COUNT; i++) {
+        if (strcmp(fields[i].name, name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Alanın RAM'deki değeri (tamsayılar 2^24'e kadar kesin)
+ * @param index Alan indeksi
+ * @return float Değer; indeks geçersizse 0
+ */
+float config_get(uint index) {
+    return index < CONFIG_FIELD_COUNT ? field_read(&board_config, &fields[index]) : 0.0f;
+}
+
+/**
+ * @brief Bir alanı RAM'de değiştirir (Core 0; flash'a config_save() yazar)
+ *
+ * Değer aralık dışındaysa veya tuş takımı eşiklerinin azalan sırasını
+ * bozuyorsa reddedilir. Tamsayı alanlar yuvarlanır. `reboot` alanları
+ * yeniden açılışta, diğerleri hemen etkinleşir.
+ *
+ * @param index Alan indeksi
+ * @param value Yeni değer
+ * @return bool Uygulandıysa true
+ */
+bool config_set(uint index, float value) {
+    if (index >= CONFIG_FIELD_COUNT || !(value >= fields[index].min && value <= fields[index].max)) {
+        return false;
+    }
+    config_t c = board_config;
+    field_write(&c, &fields[index], value);
+    if (!thresholds_descending(c.keypad_thresholds)) {
+        return false;
+    }
+    field_write(&board_config, &fields[index], value);
+    status.dirty = true;
+    return true;
+}
+
+/**
+ * @brief Yükleme ve kayıt durumunu kopyalar
+ * @param out Durumun yazılacağı yapı
+ */
+void config_get_status(config_status_t *out) {
+    *out = status;
+}
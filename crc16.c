@@ -0,0 +1,30 @@
+/**
+ * @file crc16.c
+ * @brief Flash kayıtları ve haberleşme çerçeveleri için CRC-16/CCITT hesabı
+ */
+
+#include "pico_training_board.h"
+
+/**
+ * @brief CRC-16/CCITT (polinom 0x1021) hesaplar
+ *
+ * Parçalı veriler için önceki dönüş değeri `crc` olarak tekrar verilebilir.
+ *
+ * @param data Veri
+ * @param len Veri uzunluğu (byte)
+ * @param crc Başlangıç değeri (yeni hesap için CRC16_INIT)
+ * @return uint16_t Güncellenmiş CRC
+ *
+ * @code{.c}
+ * uint16_t crc = crc16_ccitt(buf, len, CRC16_INIT);
+ * @endcode
+ */
+uint16_t crc16_ccitt(const uint8_t *data, size_t len, uint16_t crc) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,526 @@
+/**
+ * @file datalog.c
+ * @brief Flash'ın sonundaki bölgede halka yapılı, sıkıştırılmış sensör zaman serisi kaydı
+ * @see \ref howto_datalog
+ *
+ * Bölge (DATALOG_FLASH_OFFSET, DATALOG_FLASH_SECTORS) sayfa sayfa bir halka
+ * olarak yazılır. Her sayfa kendi başına çözülebilir: başlıkta sıra numarası,
+ * açılış sayacı ve zaman referansı, ardından kayıtlar vardır. Yazma konumu
+ * bir sektörün başına geldiğinde o sektör (en eski veri) silinir; böylece her
+ * sektör tur başına bir kez silinir ve aşınma bölgeye eşit yayılır.
+ *
+ * Kayıt biçimi (sayfa içinde):
+ * @code
+ * sensör u8 | zaman farkı varint (ms) | değer farkı zigzag varint
+ * @endcode
+ * Farklar sayfadaki önceki kayda (zaman) ve aynı sensörün önceki değerine
+ * (değer) göredir; sayfanın ilk değerleri 0'a göre yazılır. 1 Hz örnekte kayıt
+ * ~4 bayttır (ham sensor_sample_t: 24 bayt).
+ *
+ * Örnekler önce RAM'deki sayfada birikir; dolan sayfa DATALOG_RAM_PAGES
+ * uzunluğundaki kuyruğa geçer ve datalog_task() her çalışmada en fazla bir
+ * flash işlemi (bir sayfa programlama ~1 ms veya bir sektör silme ~45 ms)
+ * yapar. Flash işlemi sırasında XIP durur ve Core 1 flash_safe_execute() ile
+ * bekletilir; bu yüzden motor dönerken işlem ertelenir, step_turn()
+ * zamanlaması bozulmaz.
+ */
+
+#include "pico_training_board.h"
+
+#define DATALOG_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+
+/**
+ * @brief Periyodik örneklenen bir sensör
+ */
+typedef struct {
+    uint32_t period_ms; ///< 0: kapalı
+    uint64_t next_us;   ///< Sonraki örneğin zamanı
+} datalog_channel_t;
+
+static datalog_channel_t channels[SENSOR_COUNT];
+
+// Doldurulan sayfa
+static uint8_t cur_page[FLASH_PAGE_SIZE];
+static uint16_t cur_len;
+static bool cur_open;
+static uint64_t cur_last_ms;
+static int32_t cur_prev[SENSOR_COUNT];
+
+// Flash'a yazılmayı bekleyen dolu sayfalar
+static uint8_t ram_pages[DATALOG_RAM_PAGES][FLASH_PAGE_SIZE];
+static uint32_t ram_head;
+static uint32_t ram_tail;
+
+static uint32_t write_page;  // Sıradaki yazma konumu (sayfa indeksi)
+static uint32_t erase_pending;  // datalog_erase_all(): silinecek sektör (baştan sona)
+static uint32_t next_seq;
+static uint16_t boot_id;
+static datalog_stats_t stats;
+
+/**
+ * @brief Bölgedeki bir sayfanın XIP adresi
+ */
+static inline const uint8_t *page_ptr(uint32_t page) {
+    return (const uint8_t *)(XIP_BASE + DATALOG_FLASH_OFFSET + page * FLASH_PAGE_SIZE);
+}
+
+static inline uint16_t header_crc(const datalog_page_header_t *h) {
+    return crc16_ccitt((const uint8_t *)h, offsetof(datalog_page_header_t, header_crc), CRC16_INIT);
+}
+
+/**
+ * @brief Sayfa başlığı geçerli mi (yük CRC'si okurken ayrıca denetlenir)
+ */
+static bool header_valid(const datalog_page_header_t *h) {
+    return h->magic == DATALOG_MAGIC && h->len <= DATALOG_PAGE_PAYLOAD && header_crc(h) == h->header_crc;
+}
+
+/**
+ * @brief Sayfa silinmiş durumda mı (tüm bitler 1)
+ */
+static bool page_blank(uint32_t page) {
+    const uint32_t *w = (const uint32_t *)page_ptr(page);
+    for (uint i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (w[i] != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t put_varint(uint8_t *out, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/**
+ * @brief varint okur
+ * @return bool Sayfa sonuna kadar tamamlanmadıysa false
+ */
+static bool get_varint(const uint8_t **p, const uint8_t *end, uint64_t *v) {
+    uint64_t r = 0;
+    for (uint shift = 0; *p < end && shift < 64; shift += 7) {
+        uint8_t b = *(*p)++;
+        r |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *v = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+/**
+ * @brief Bölgeyi tarar; en yeni sayfadan sonrasını yazma konumu yapar
+ *
+ * Yalnızca başlıklar (CRC dahil) okunur. Yarım yazılmış bir sayfanın başlığı
+ * geçersiz görünür ve atlanır; yazma konumu ondan sonraki boş sayfaya
+ * datalog_task() içinde ilerler.
+ */
+void datalog_init(void) {
+    memset(channels, 0, sizeof(channels));
+    memset(&stats, 0, sizeof(stats));
+    cur_open = false;
+    ram_head = ram_tail = 0;
+    erase_pending = 0;
+
+    bool found = false;
+    uint32_t newest = 0;
+    uint32_t newest_seq = 0;
+    uint16_t newest_boot = 0;
+    for (uint32_t page = 0; page < DATALOG_PAGES; page++) {
+        const datalog_page_header_t *h = (const datalog_page_header_t *)page_ptr(page);
+        if (!header_valid(h)) {
+            continue;
+        }
+        stats.pages_used++;
+        if (!found || h->seq > newest_seq) {
+            found = true;
+            newest = page;
+            newest_seq = h->seq;
+            newest_boot = h->boot;
+        }
+    }
+    write_page = found ? (newest + 1) % DATALOG_PAGES : 0;
+    next_seq = found ? newest_seq + 1 : 1;
+    boot_id = found ? (uint16_t)(newest_boot + 1) : 0;
+}
+
+/**
+ * @brief Doldurulan sayfayı kapatır ve yazma kuyruğuna ekler
+ * @return bool Kuyruk doluysa false (sayfa açık kalır)
+ */
+static bool close_page(void) {
+    if (ram_head - ram_tail >= DATALOG_RAM_PAGES) {
+        return false;
+    }
+    datalog_page_header_t *h = (datalog_page_header_t *)cur_page;
+    h->magic = DATALOG_MAGIC;
+    h->boot = boot_id;
+    h->len = cur_len;
+    h->payload_crc = crc16_ccitt(&cur_page[sizeof(*h)], cur_len, CRC16_INIT);
+    memset(&cur_page[sizeof(*h) + cur_len], 0xFF, DATALOG_PAGE_PAYLOAD - cur_len);
+    memcpy(ram_pages[ram_head % DATALOG_RAM_PAGES], cur_page, FLASH_PAGE_SIZE);
+    ram_head++;
+    cur_open = false;
+    return true;
+}
+
+/**
+ * @brief Kaydı sayfa durumuna göre kodlar
+ * @return size_t Kodlanmış uzunluk
+ */
+static size_t encode_record(uint8_t *out, sensor_id_t sensor, uint64_t t_ms, int32_t value) {
+    size_t n = 0;
+    out[n++] = (uint8_t)sensor;
+    n += put_varint(&out[n], t_ms - cur_last_ms);
+    n += put_varint(&out[n], zigzag(value - cur_prev[sensor]));
+    return n;
+}
+
+/**
+ * @brief Bir kaydı RAM sayfasına ekler (Core 0 ana döngü bağlamı)
+ *
+ * Sayfa içinde zaman geri gidemez; önceki kayıttan eski bir zaman damgası
+ * önceki kaydın zamanına çekilir.
+ *
+ * @param sensor Sensör kimliği
+ * @param timestamp_us Ölçüm zamanı (time_us_64)
+ * @param value Değer (ölçek sensöre göre; bkz. \ref howto_datalog)
+ * @return bool Yazma kuyruğu dolu olduğu için düştüyse false
+ */
+bool datalog_append(sensor_id_t sensor, uint64_t timestamp_us, int32_t value) {
+    uint8_t rec[1 + 10 + 5];
+    uint64_t t_ms = timestamp_us / 1000;
+
+    if (sensor >= SENSOR_COUNT) {
+        return false;
+    }
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!cur_open) {
+            datalog_page_header_t *h = (datalog_page_header_t *)cur_page;
+            h->base_ms = t_ms;
+            cur_last_ms = t_ms;
+            cur_len = 0;
+            memset(cur_prev, 0, sizeof(cur_prev));
+            cur_open = true;
+        }
+        if (t_ms < cur_last_ms) {
+            t_ms = cur_last_ms;
+        }
+        size_t n = encode_record(rec, sensor, t_ms, value);
+        if (cur_len + n <= DATALOG_PAGE_PAYLOAD) {
+            memcpy(&cur_page[sizeof(datalog_page_header_t) + cur_len], rec, n);
+            cur_len += (uint16_t)n;
+            cur_last_ms = t_ms;
+            cur_prev[sensor] = value;
+            stats.records++;
+            return true;
+        }
+        if (!close_page()) {
+            break;
+        }
+    }
+    stats.dropped++;
+    return false;
+}
+
+/**
+ * @brief Flash'ta çalışan sektör silme (diğer çekirdek ve kesmeler durmuşken)
+ */
+static void flash_erase_op(void *param) {
+    flash_range_erase(*(const uint32_t *)param, FLASH_SECTOR_SIZE);
+}
+
+/**
+ * @brief Flash'ta çalışan sayfa programlama
+ */
+static void flash_program_op(void *param) {
+    flash_range_program(DATALOG_FLASH_OFFSET + write_page * FLASH_PAGE_SIZE, (const uint8_t *)param,
+                        FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief Bir sektörü siler
+ *
+ * Sayaçlar yalnızca flash_safe_execute() PICO_OK döndürürse güncellenir;
+ * hata durumunda sektör olduğu gibi kalır ve işlem sonraki çağrıda yeniden
+ * denenir.
+ *
+ * @param sector Bölgedeki sektör indeksi
+ * @return bool Silindiyse true
+ */
+static bool erase_sector(uint32_t sector) {
+    uint32_t first = sector * DATALOG_PAGES_PER_SECTOR;
+    uint32_t valid = 0;
+    for (uint32_t p = first; p < first + DATALOG_PAGES_PER_SECTOR; p++) {
+        if (header_valid((const datalog_page_header_t *)page_ptr(p))) {
+            valid++;
+        }
+    }
+    uint32_t offs = DATALOG_FLASH_OFFSET + sector * FLASH_SECTOR_SIZE;
+    if (flash_safe_execute(flash_erase_op, &offs, 100) != PICO_OK) {
+        stats.flash_errors++;
+        return false;
+    }
+    stats.erases++;
+    stats.pages_used -= valid;
+    return true;
+}
+
+/**
+ * @brief Bekleyen tam silmenin bir sektörünü veya kuyruktaki en eski sayfa için tek bir flash işlemi yapar
+ *
+ * datalog_erase_all() sonrası önce sektörler sırayla silinir; zaten boş
+ * sektör flash işlemi yapılmadan geçilir. Yazma konumu bir sektörün
+ * başındaysa ve sektör boş değilse önce sektör silinir (bu çağrıda yalnızca
+ * silme yapılır). Sektör ortasında boş olmayan bir sayfa (yarım yazılmış)
+ * atlanır.
+ *
+ * @param force Motor dönerken de yaz (datalog_sync)
+ * @return bool Bir flash işlemi yapıldıysa veya sayfa/sektör atlandıysa true
+ */
+static bool service_one(bool force) {
+    if (ram_head == ram_tail && erase_pending == 0) {
+        return false;
+    }
+    if (!force && get_motor_state() == MOTOR_RUNNING) {
+        stats.deferred++;
+        return false;
+    }
+
+    if (erase_pending != 0) {
+        uint32_t sector = DATALOG_FLASH_SECTORS - erase_pending;
+        bool blank = true;
+        for (uint32_t p = 0; blank && p < DATALOG_PAGES_PER_SECTOR; p++) {
+            blank = page_blank(sector * DATALOG_PAGES_PER_SECTOR + p);
+        }
+        if (!blank && !erase_sector(sector)) {
+            return false;
+        }
+        erase_pending--;
+        return true;
+    }
+
+    if (!page_blank(write_page)) {
+        if (write_page % DATALOG_PAGES_PER_SECTOR == 0) {
+            return erase_sector(write_page / DATALOG_PAGES_PER_SECTOR);
+        }
+        write_page = (write_page + 1) % DATALOG_PAGES;
+        return true;
+    }
+
+    uint8_t *page = ram_pages[ram_tail % DATALOG_RAM_PAGES];
+    datalog_page_header_t *h = (datalog_page_header_t *)page;
+    h->seq = next_seq;
+    h->header_crc = header_crc(h);
+    if (flash_safe_execute(flash_program_op, page, 100) != PICO_OK) {
+        stats.flash_errors++;
+        return false;
+    }
+    next_seq++;
+    ram_tail++;
+    stats.pages_used++;
+    write_page = (write_page + 1) % DATALOG_PAGES;
+    return true;
+}
+
+/**
+ * @brief Periyodik örneklemeyi başlatır veya durdurur
+ *
+ * Değer ölçeği: LDR/POT/KEYPAD ADC sayımı, DISTANCE mm (zaman aşımında -1),
+ * PIR 0/1, BUTTONS `buttons_pressed_mask()`.
+ *
+ * @param sensor Sensör
+ * @param period_ms Örnek periyodu (0: durdur; en kısa DATALOG_TASK_PERIOD_MS)
+ * @return bool Sensör geçersizse false
+ */
+bool datalog_start(sensor_id_t sensor, uint32_t period_ms) {
+    if (sensor >= SENSOR_COUNT) {
+        return false;
+    }
+    channels[sensor].period_ms = period_ms;
+    channels[sensor].next_us = time_us_64();
+    return true;
+}
+
+/**
+ * @brief Zamanlayıcı görevi: zamanı gelen sensörleri ekler, bir flash işlemi yapar
+ */
+void datalog_task(void) {
+    uint64_t now = time_us_64();
+    for (uint i = 0; i < SENSOR_COUNT; i++) {
+        datalog_channel_t *ch = &channels[i];
+        if (ch->period_ms == 0 || now < ch->next_us) {
+            continue;
+        }
+        sensor_sample_t s;
+        if (sensor_read((sensor_id_t)i, &s)) {
+            int32_t value;
+            if (i == SENSOR_DISTANCE) {
+                value = s.value >= 0.0f ? (int32_t)lroundf(s.value * 10.0f) : -1;
+            } else if (i == SENSOR_BUTTONS) {
+                value = (int32_t)s.raw;
+            } else {
+                value = (int32_t)lroundf(s.value);
+            }
+            datalog_append((sensor_id_t)i, s.timestamp_us, value);
+        } else if (i == SENSOR_DISTANCE) {
+            datalog_append(SENSOR_DISTANCE, now, -1);  // Ölçüm yok: boşluk da kayda geçer
+        }
+        ch->next_us += (uint64_t)ch->period_ms * 1000u;
+        if (ch->next_us <= now) {
+            ch->next_us = now + (uint64_t)ch->period_ms * 1000u;
+        }
+    }
+    service_one(false);
+}
+
+/**
+ * @brief Açık sayfayı kapatır ve kuyruktaki tüm sayfaları hemen yazar
+ *
+ * Dışa aktarmadan ve kapanıştan önce çağrılır. Motor dönüyor olsa da yazar
+ * (her işlemde Core 1 kısa süre durur). Kısmi sayfanın boş kalan kısmı
+ * kullanılmaz.
+ *
+ * @return bool Bekleyen sayfa kalmadıysa true
+ */
+bool datalog_sync(void) {
+    if (cur_open && cur_len != 0) {
+        close_page();
+    }
+    for (uint guard = 0; ram_head != ram_tail && guard < 4 * DATALOG_PAGES; guard++) {
+        service_one(true);
+    }
+    return ram_head == ram_tail;
+}
+
+/**
+ * @brief Tüm bölgeyi silmeyi başlatır ve RAM tamponlarını boşaltır (konsolda `datalog erase`)
+ *
+ * Sektörler burada silinmez: datalog_task() her çalışmada bir sektör siler
+ * (~45 ms) ve motor dönerken diğer flash işlemleri gibi bekler. Silme
+ * bitene kadar yeni dolan sayfalar kuyrukta kalır; ilerleme
+ * datalog_stats_t::erase_pending ile izlenir. Silme bitmeden kapanırsa
+ * kalan sektörlerdeki kayıtlar açılışta yeniden görünür.
+ */
+void datalog_erase_all(void) {
+    cur_open = false;
+    ram_head = ram_tail = 0;
+    write_page = 0;
+    erase_pending = DATALOG_FLASH_SECTORS;
+}
+
+/**
+ * @brief Okuyucuyu en eski sayfaya konumlar
+ *
+ * Halkada yazma konumundan başlayan tur, sayfaları sıra numarasına göre
+ * eskiden yeniye verir. RAM'de bekleyen sayfalar okunmaz (önce datalog_sync()).
+ *
+ * @param c Okuyucu
+ */
+void datalog_cursor_init(datalog_cursor_t *c) {
+    memset(c, 0, sizeof(*c));
+    c->page = write_page;
+}
+
+/**
+ * @brief Sıradaki kaydı çözer
+ *
+ * Başlığı veya yük CRC'si bozuk sayfalar atlanır.
+ *
+ * @param c Okuyucu
+ * @param out Kaydın yazılacağı yapı
+ * @return bool Kayıt kalmadıysa false
+ */
+bool datalog_next(datalog_cursor_t *c, datalog_record_t *out) {
+    while (true) {
+        if (c->p != NULL && c->p < c->end) {
+            uint8_t sensor = *c->p++;
+            uint64_t dt, dv;
+            if (sensor < SENSOR_COUNT && get_varint(&c->p, c->end, &dt) && get_varint(&c->p, c->end, &dv)) {
+                c->t_ms += dt;
+                c->prev[sensor] += unzigzag((uint32_t)dv);
+                out->timestamp_ms = c->t_ms;
+                out->value = c->prev[sensor];
+                out->boot = c->boot;
+                out->sensor = sensor;
+                return true;
+            }
+            c->p = c->end;  // Bozuk kayıt: sayfanın kalanı atlanır
+        }
+
+        if (c->visited >= DATALOG_PAGES) {
+            return false;
+        }
+        const uint8_t *page = page_ptr(c->page);
+        const datalog_page_header_t *h = (const datalog_page_header_t *)page;
+        c->page = (c->page + 1) % DATALOG_PAGES;
+        c->visited++;
+        if (!header_valid(h) ||
+            crc16_ccitt(&page[sizeof(*h)], h->len, CRC16_INIT) != h->payload_crc) {
+            c->p = NULL;
+            continue;
+        }
+        c->p = &page[sizeof(*h)];
+        c->end = c->p + h->len;
+        c->t_ms = h->base_ms;
+        c->boot = h->boot;
+        memset(c->prev, 0, sizeof(c->prev));
+    }
+}
+
+/**
+ * @brief Geçerli sayfaları eskiden yeniye ham olarak stdio'ya döker (`datalog dump`)
+ *
+ * Biçim (tools/datalog_export.py okur):
+ * @code
+ * # datalog v1 pages=<n> page=256
+ * <n × 256 bayt ham sayfa, CR/LF dönüşümü yok>
+ * # datalog end
+ * @endcode
+ * Sıkıştırılmış sayfalar olduğu gibi gönderildiği için 256 KB bölge USB'de
+ * birkaç saniyede aktarılır; çözme bilgisayarda yapılır.
+ */
+void datalog_export(void) {
+    datalog_sync();
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < DATALOG_PAGES; i++) {
+        if (header_valid((const datalog_page_header_t *)page_ptr(i))) {
+            count++;
+        }
+    }
+    printf("# datalog v1 pages=%lu page=%u\n", (unsigned long)count, (unsigned)FLASH_PAGE_SIZE);
+    fflush(stdout);
+    for (uint32_t i = 0, page = write_page; i < DATALOG_PAGES; i++, page = (page + 1) % DATALOG_PAGES) {
+        if (header_valid((const datalog_page_header_t *)page_ptr(page))) {
+            stdio_put_string((const char *)page_ptr(page), FLASH_PAGE_SIZE, false, false);
+        }
+    }
+    printf("# datalog end\n");
+}
+
+/**
+ * @brief Sayaçları kopyalar
+ * @param out Sayaçların yazılacağı yapı
+ */
+void datalog_get_stats(datalog_stats_t *out) {
+    *out = stats;
+    out->pages_ram = ram_head - ram_tail;
+    out->erase_pending = erase_pending;
+    out->next_seq = next_seq;
+    out->boot = boot_id;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file distance_filter.c
+ * @brief Ultrasonik ölçümler için akan (streaming) mesafe filtresi
+ * @see \ref howto_sensors
+ *
+ * Her ölçüm örneği için:
+ * 1. Zaman aşımları atlanır; art arda çok zaman aşımı tahmini geçersiz yapar
+ * 2. Kayan medyan: son DISTANCE_MEDIAN_LEN geçerli ölçümün medyanı (tekil yankı hatalarını bastırır)
+ * 3. Alfa-beta filtresi: mesafe ve hız tahmini; örnekler arası süre zaman damgalarından alınır
+ *
+ * Tahmin her ölçümde (ULTRASONIC_RATE_HZ) güncellenir; okuyucular beklemez.
+ * `distance_filter_update()` ultrasonik motorun geri çağrısı olarak kesme
+ * bağlamında çalışır.
+ */
+
+#include "pico_training_board.h"
+
+static float window[DISTANCE_MEDIAN_LEN];
+static uint window_pos = 0;
+static uint window_fill = 0;
+
+static float est_cm = 0.0f;          // Alfa-beta mesafe durumu
+static float est_v = 0.0f;           // Alfa-beta hız durumu (cm/s)
+static uint64_t last_update_us = 0;  // Son filtre güncellemesi
+static uint timeout_run = 0;         // Art arda zaman aşımı sayısı
+static uint reject_run = 0;          // Art arda kapı dışı kalan ölçüm sayısı
+
+static volatile distance_estimate_t latest;
+
+/**
+ * @brief Penceredeki geçerli ölçümlerin medyanını döndürür
+ * @return float Medyan (cm)
+ */
+static float window_median(void) {
+    float sorted[DISTANCE_MEDIAN_LEN];
+    for (uint i = 0; i < window_fill; i++) {
+        float v = window[i];
+        uint j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    return sorted[window_fill / 2];
+}
+
+/**
+ * @brief Filtre durumunu sıfırlar; sonraki geçerli ölçüm yeni başlangıçtır
+ */
+void distance_filter_reset(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    window_pos = window_fill = 0;
+    est_v = 0.0f;
+    last_update_us = 0;
+    timeout_run = reject_run = 0;
+    latest.valid = false;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Filtreye bir ultrasonik ölçüm örneği verir
+ *
+ * `ultrasonic_start()` için geri çağrı olarak tasarlanmıştır.
+ *
+ * @param s Ölçüm örneği
+ *
+ * @code{.c}
+ * ultrasonic_start(ULTRASONIC_RATE_HZ, distance_filter_update);
+ * @endcode
+ */
+void distance_filter_update(const ultrasonic_sample_t *s) {
+    distance_estimate_t out = latest;
+    out.timestamp_us = s->timestamp_us;
+    out.raw_cm = s->distance_cm;
+
+    if (s->distance_cm < 0.0f) {
+        if (++timeout_run >= DISTANCE_TIMEOUT_LIMIT) {
+            out.valid = false;  // Menzil dışı veya sensör yok
+            window_pos = window_fill = 0;
+            last_update_us = 0;
+        }
+        latest = out;
+        return;
+    }
+    timeout_run = 0;
+
+    window[window_pos] = s->distance_cm;
+    window_pos = (window_pos + 1) % DISTANCE_MEDIAN_LEN;
+    if (window_fill < DISTANCE_MEDIAN_LEN) {
+        window_fill++;
+    }
+    float z = window_median();
+
+    if (last_update_us == 0) {
+        // İlk ölçüm: durumu doğrudan başlat
+        est_cm = z;
+        est_v = 0.0f;
+    } else {
+        float dt = (float)(s->timestamp_us - last_update_us) * 1e-6f;
+        float predicted = est_cm + est_v * dt;
+        float residual = z - predicted;
+
+        if (fabsf(residual) > DISTANCE_GATE_CM && ++reject_run < DISTANCE_GATE_LIMIT) {
+            // Kapı dışı: tahmini yalnızca ilerlet; sürekli tekrarlanırsa hedef gerçekten değişmiştir
+            est_cm = predicted;
+        } else if (reject_run >= DISTANCE_GATE_LIMIT) {
+            est_cm = z;
+            est_v = 0.0f;
+            reject_run = 0;
+        } else {
+            reject_run = 0;
+            est_cm = predicted + DISTANCE_FILTER_ALPHA * residual;
+            if (dt > 0.0f) {
+                est_v += DISTANCE_FILTER_BETA * residual / dt;
+            }
+        }
+    }
+    last_update_us = s->timestamp_us;
+
+    out.distance_cm = est_cm;
+    out.velocity_cm_s = est_v;
+    out.valid = true;
+    latest = out;
+}
+
+/**
+ * @brief En son filtrelenmiş mesafe tahminini kopyalar
+ *
+ * @param out Tahminin yazılacağı yapı
+ * @return bool Tahmin geçerliyse true
+ *
+ * @code{.c}
+ * distance_estimate_t d;
+ * if (distance_filter_get(&d)) {
+ *   printf("%.1f cm, %.1f cm/s\n", d.distance_cm, d.velocity_cm_s);
+ * }
+ * @endcode
+ */
+bool distance_filter_get(distance_estimate_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    *out = latest;
+    restore_interrupts(irq_state);
+    return out->valid;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file event_loop.c
+ * @brief Core 0 için düşük güçlü, olay güdümlü ana döngü
+ * @see \ref howto_event_loop
+ *
+ * Kesmeler (buton/PIR PIO kesmesi, tuş tarayıcı zamanlayıcısı, kullanıcı
+ * zamanlayıcıları) `event_loop_post()` ile bekleyen olay bitlerini kaldırır.
+ * Core 1 mesajları kesmesiz gelir: `event_loop_core1_post()` kuyruğa ekler ve
+ * `__sev` ile Core 0'ı uyandırır; döngü kuyruk boş değilse EVENT_LOOP_CORE1
+ * bitini kendisi kaldırır. Döngü bekleyen bit yoksa `__wfe` ile çekirdeği
+ * uyutur; herhangi bir kesme veya SEV çekirdeği uyandırır. Bekleyen bitler
+ * kayıtlı işleyicilere ana döngü bağlamında dağıtılır.
+ *
+ * SIO FIFO'su kullanılmaz: flash_safe_execute() kilit kurbanı olan çekirdekte
+ * SDK'nın kilit kesmesi FIFO'yu boşaltır ve kilit dışı sözcükleri atar.
+ *
+ * Kontrol ile uyku arasındaki yarış zararsızdır: o aralıkta gelen bir kesmenin
+ * dönüşü olay yazmacını kurar ve `__wfe` hemen geri döner.
+ *
+ * Dormant (uyku) modu kullanılmaz: DMA ile ADC akışı, PIO debounce ve
+ * zamanlayıcılar saat gerektirir. `__wfe` yalnızca çekirdek saatini durdurur.
+ */
+
+#include "pico_training_board.h"
+
+#define EVENT_LOOP_MAX_HANDLERS 8
+#define CORE1_MSG_QUEUE_LEN 8
+
+/**
+ * @brief Kayıtlı bir olay işleyicisi
+ */
+typedef struct {
+    uint32_t mask;           ///< İşleyicinin ilgilendiği olay bitleri
+    event_handler_t handler; ///< Çağrılacak fonksiyon
+} event_handler_entry_t;
+
+static event_handler_entry_t handlers[EVENT_LOOP_MAX_HANDLERS];
+static uint handler_count = 0;
+
+static volatile uint32_t pending_events = 0;
+static volatile uint32_t first_post_us = 0;  // Bekleyen ilk olayın zamanı (gecikme ölçümü)
+
+static queue_t core1_msg_queue;  // Core 1 -> Core 0 (çekirdekler arası kilitli)
+
+static event_loop_stats_t stats;
+
+/**
+ * @brief Olay döngüsünü ve Core 1 mesaj kuyruğunu başlatır
+ *
+ * @note `multicore_launch_core1()` öncesinde çağrılmalıdır; Core 1 ilk
+ *       mesajını bu kuyruğa yazar.
+ */
+void event_loop_init(void) {
+    queue_init(&core1_msg_queue, sizeof(uint32_t), CORE1_MSG_QUEUE_LEN);
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief Bir olay işleyicisi kaydeder
+ *
+ * @param mask İşleyicinin çağrılacağı olay bitleri (EVENT_LOOP_*)
+ * @param handler Bekleyen bitlerin `mask` ile kesişimiyle çağrılır
+ * @return bool Kaydedildiyse true, tablo doluysa false
+ *
+ * @code{.c}
+ * event_loop_register(EVENT_LOOP_BUTTON, on_buttons);
+ * @endcode
+ */
+bool event_loop_register(uint32_t mask, event_handler_t handler) {
+    if (handler_count >= EVENT_LOOP_MAX_HANDLERS) {
+        return false;
+    }
+    handlers[handler_count].mask = mask;
+    handlers[handler_count].handler = handler;
+    handler_count++;
+    return true;
+}
+
+/**
+ * @brief Olay bitlerini bekleyenlere ekler ve döngüyü uyandırır
+ *
+ * Core 0 üzerindeki kesmelerden ve ana döngüden çağrılabilir.
+ *
+ * @param events EVENT_LOOP_* bitleri
+ */
+void event_loop_post(uint32_t events) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (pending_events == 0) {
+        first_post_us = time_us_32();
+    }
+    pending_events |= events;
+    restore_interrupts(irq_state);
+    __sev();
+}
+
+/**
+ * @brief Core 1'den Core 0'a mesaj gönderir (Core 1'den çağrılır)
+ *
+ * Kuyruk doluysa Core 0 boşaltana kadar bekler; mesaj kaybolmaz.
+ *
+ * @param msg Mesaj (ör. CORE1_MSG_MOTOR_DONE)
+ */
+void event_loop_core1_post(uint32_t msg) {
+    queue_add_blocking(&core1_msg_queue, &msg);
+    __sev();  // WFE'deki Core 0'ı uyandır
+}
+
+/**
+ * @brief Core 1'den gelen en eski mesajı alır
+ * @param msg Mesajın yazılacağı değişken
+ * @return bool Mesaj alındıysa true
+ */
+bool event_loop_core1_pop(uint32_t *msg) {
+    return queue_try_remove(&core1_msg_queue, msg);
+}
+
+/**
+ * @brief Bekleyen olayları dağıtır; yoksa bir olay veya zaman aşımına kadar uyur
+ *
+ * @param until Uykunun en geç biteceği zaman (sınırsız için at_the_end_of_time)
+ * @return bool En az bir olay dağıtıldıysa true
+ */
+bool event_loop_poll(absolute_time_t until) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t events = pending_events;
+    uint32_t posted_us = first_post_us;
+    pending_events = 0;
+    restore_interrupts(irq_state);
+
+    // Core 1 kesme değil SEV gönderir; kuyruğu uyumadan önce denetle
+    if (!queue_is_empty(&core1_msg_queue)) {
+        if (events == 0) {
+            posted_us = time_us_32();
+        }
+        events |= EVENT_LOOP_CORE1;
+    }
+
+    if (events == 0) {
+        uint64_t sleep_start = time_us_64();
+        sysmon_idle_enter();
+        best_effort_wfe_or_timeout(until);
+        sysmon_idle_exit();
+        stats.idle_us += time_us_64() - sleep_start;
+        stats.wakeups++;
+        return false;
+    }
+
+    uint32_t latency = time_us_32() - posted_us;
+    if (latency > stats.max_latency_us) {
+        stats.max_latency_us = latency;
+    }
+    for (uint i = 0; i < handler_count; i++) {
+        uint32_t hit = events & handlers[i].mask;
+        if (hit) {
+            handlers[i].handler(hit);
+        }
+    }
+    stats.dispatches++;
+    return true;
+}
+
+/**
+ * @brief Olay döngüsünü sonsuza kadar çalıştırır
+ */
+void event_loop_run(void) {
+    while (true) {
+        event_loop_poll(at_the_end_of_time);
+    }
+}
+
+/**
+ * @brief Döngü istatistiklerini kopyalar
+ *
+ * `idle_us` çekirdeğin `__wfe` içinde geçirdiği süredir; boşta akım ölçümü
+ * bu oranla birlikte raporlanabilir.
+ *
+ * @param out İstatistiklerin yazılacağı yapı
+ */
+void event_loop_get_stats(event_loop_stats_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    *out = stats;
+    restore_interrupts(irq_state);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file event_queue.c
+ * @brief Kesme ve çekirdekler arası kullanım için kilitsiz tek üretici / tek tüketici kuyruğu
+ *
+ * Kuyruk sabit boyutlu elemanları, çağıranın sağladığı bir dizide tutar.
+ * Üretici yalnızca `head`, tüketici yalnızca `tail` indeksini yazar; bu nedenle
+ * bir kesme (veya Core 1) üretici, ana döngü tüketici olduğunda kilit gerekmez.
+ * İndeksler serbestçe artar ve kapasite 2'nin kuvveti olduğundan maske ile
+ * sarılır.
+ */
+
+#include "pico_training_board.h"
+
+/**
+ * @brief Kuyruğu başlatır
+ *
+ * @param q Kuyruk
+ * @param storage En az `elem_size * capacity` byte'lık depolama
+ * @param elem_size Eleman boyutu (byte)
+ * @param capacity Eleman sayısı (2'nin kuvveti olmalı)
+ *
+ * @code{.c}
+ * static keypad_event_t storage[16];
+ * static event_queue_t queue;
+ * event_queue_init(&queue, storage, sizeof(storage[0]), 16);
+ * @endcode
+ */
+void event_queue_init(event_queue_t *q, void *storage, uint16_t elem_size, uint16_t capacity) {
+    q->storage = (uint8_t *)storage;
+    q->elem_size = elem_size;
+    q->mask = (uint16_t)(capacity - 1u);
+    q->head = 0;
+    q->tail = 0;
+    q->dropped = 0;
+}
+
+/**
+ * @brief Kuyruğa bir eleman ekler (üretici tarafı)
+ *
+ * @param q Kuyruk
+ * @param elem Kopyalanacak eleman
+ * @return bool Eklendiyse true; kuyruk doluysa false (eleman düşürülür ve sayılır)
+ */
+bool event_queue_push(event_queue_t *q, const void *elem) {
+    uint16_t head = q->head;
+    if ((uint16_t)(head - q->tail) > q->mask) {
+        q->dropped++;
+        return false;
+    }
+    memcpy(q->storage + (size_t)(head & q->mask) * q->elem_size, elem, q->elem_size);
+    __dmb();  // Veri, indeks görünmeden önce yazılmış olmalı
+    q->head = (uint16_t)(head + 1u);
+    return true;
+}
+
+/**
+ * @brief Kuyruktan en eski elemanı alır (tüketici tarafı)
+ *
+ * @param q Kuyruk
+ * @param elem Elemanın kopyalanacağı hedef
+ * @return bool Eleman alındıysa true, kuyruk boşsa false
+ */
+bool event_queue_pop(event_queue_t *q, void *elem) {
+    uint16_t tail = q->tail;
+    if (tail == q->head) {
+        return false;
+    }
+    __dmb();  // İndeksi gördükten sonra veriyi oku
+    memcpy(elem, q->storage + (size_t)(tail & q->mask) * q->elem_size, q->elem_size);
+    __dmb();
+    q->tail = (uint16_t)(tail + 1u);
+    return true;
+}
+
+/**
+ * @brief Kuyruktaki eleman sayısını döndürür
+ * @param q Kuyruk
+ * @return uint Bekleyen eleman sayısı
+ */
+uint event_queue_count(const event_queue_t *q) {
+    return (uint16_t)(q->head - q->tail);
+}
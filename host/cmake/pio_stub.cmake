@@ -0,0 +1,42 @@
+# .pio dosyasından bilgisayar derlemesi için başlık üretir.
+#
+# pioasm çalıştırılmaz: program komutları yerine tek bir boş komut konur ve
+# dosyadaki `% c-sdk { ... %}` bloğu olduğu gibi kopyalanır. Simüle edilen HAL
+# PIO kaynağı sunmadığı için program hiçbir zaman yüklenmez; başlık yalnızca
+# modüllerin (input_pio.c, ultrasonic.c) derlenmesi için gereklidir.
+#
+# Kullanım: cmake -DPIO_SOURCE=<dosya.pio> -DPIO_HEADER=<dosya.pio.h> -P pio_stub.cmake
+
+file(READ "${PIO_SOURCE}" pio_text)
+
+string(REGEX MATCH "\\.program[ \t]+([A-Za-z0-9_]+)" _ "${pio_text}")
+set(program "${CMAKE_MATCH_1}")
+if (NOT program)
+    message(FATAL_ERROR "${PIO_SOURCE}: .program bulunamadı")
+endif()
+
+set(c_sdk "")
+string(FIND "${pio_text}" "% c-sdk {" block_start)
+if (block_start GREATER -1)
+    string(SUBSTRING "${pio_text}" ${block_start} -1 block)
+    string(FIND "${block}" "\n" first_newline)
+    math(EXPR body_start "${first_newline} + 1")
+    string(SUBSTRING "${block}" ${body_start} -1 block)
+    string(FIND "${block}" "%}" block_end)
+    string(SUBSTRING "${block}" 0 ${block_end} c_sdk)
+endif()
+
+file(WRITE "${PIO_HEADER}"
+"/* ${PIO_SOURCE} için bilgisayar derlemesi başlığı (host/cmake/pio_stub.cmake) */
+#pragma once
+#include \"hardware/pio.h\"
+
+static const uint16_t ${program}_program_instructions[1] = {0};
+static const pio_program_t ${program}_program = {${program}_program_instructions, 1, -1};
+
+static inline pio_sm_config ${program}_program_get_default_config(uint offset) {
+    (void)offset;
+    return pio_get_default_sm_config();
+}
+
+${c_sdk}")
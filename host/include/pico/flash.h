@@ -0,0 +1,2 @@
+/* Bilgisayar derlemesi: SDK başlığı yerine simüle edilen API (bkz. sim_sdk.h) */
+#include "sim_sdk.h"
@@ -0,0 +1,342 @@
+/**
+ * @file sim_sdk.h
+ * @brief Bilgisayarda derleme için Pico SDK API'sinin simüle edilen alt kümesi
+ * @see \ref howto_host_sim
+ *
+ * `hardware/...` ve `pico/...` başlıklarının tamamı bu dosyayı içerir. Yalnızca
+ * firmware'in kullandığı fonksiyonlar bildirilir; imzalar SDK 2.1.0 ile
+ * aynıdır. Uygulama host/sim_hal.c içindedir, simülasyon denetimi host/sim.h
+ * üzerinden yapılır.
+ *
+ * Bilerek eksik olanlar: PIO ve DMA kaynakları hiç yoktur (talep eden modüller
+ * yazılım yollarına düşer), stdio girişi her zaman zaman aşımı döndürür.
+ */
+
+#ifndef SIM_SDK_H
+#define SIM_SDK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifndef PICO_ON_DEVICE
+#define PICO_ON_DEVICE 0
+#endif
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#ifndef MIN
+#define MIN(a, b) ((b) > (a) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+
+#define PICO_OK 0
+#define PICO_ERROR_TIMEOUT -1
+#define PICO_ERROR_GENERIC -2
+#define PICO_ERROR_NOT_PERMITTED -4
+
+/* Zaman (sanal saat) */
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t get_absolute_time(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void busy_wait_us(uint64_t us);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout);
+
+#define nil_time ((absolute_time_t)0)
+#define at_the_end_of_time ((absolute_time_t)INT64_MAX)
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline void update_us_since_boot(absolute_time_t *t, uint64_t us) { *t = us; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+static inline absolute_time_t absolute_time_min(absolute_time_t a, absolute_time_t b) { return a < b ? a : b; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return t + (uint64_t)ms * 1000u; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return get_absolute_time() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return get_absolute_time() + (uint64_t)ms * 1000u; }
+static inline bool time_reached(absolute_time_t t) { return get_absolute_time() >= t; }
+static inline void tight_loop_contents(void) {}
+
+/* Zamanlayıcılar (alarm havuzu Core 0'da çalışır) */
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer {
+    int64_t delay_us;
+    void *pool;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+static inline alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us((uint64_t)ms * 1000u, callback, user_data, fire_if_past);
+}
+bool cancel_alarm(alarm_id_t id);
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+static inline bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    return add_repeating_timer_us((int64_t)delay_ms * 1000, callback, user_data, out);
+}
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+/* Kesmeler */
+typedef void (*irq_handler_t)(void);
+#define IO_IRQ_BANK0 13
+#define SIO_IRQ_PROC0 15
+#define SIO_IRQ_PROC1 16
+#define PIO0_IRQ_0 7
+#define PIO0_IRQ_1 8
+#define PIO1_IRQ_0 9
+#define PIO1_IRQ_1 10
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define UART0_IRQ 20
+#define UART1_IRQ 21
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+static inline void __dmb(void) { __sync_synchronize(); }
+static inline void __dsb(void) { __sync_synchronize(); }
+static inline void __nop(void) {}
+void __sev(void);
+void __wfe(void);
+
+/* GPIO */
+#define GPIO_IN 0
+#define GPIO_OUT 1
+enum gpio_function {
+    GPIO_FUNC_XIP = 0, GPIO_FUNC_SPI, GPIO_FUNC_UART, GPIO_FUNC_I2C, GPIO_FUNC_PWM,
+    GPIO_FUNC_SIO, GPIO_FUNC_PIO0, GPIO_FUNC_PIO1, GPIO_FUNC_GPCK, GPIO_FUNC_USB,
+    GPIO_FUNC_NULL = 0x1f
+};
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 1, GPIO_IRQ_LEVEL_HIGH = 2, GPIO_IRQ_EDGE_FALL = 4, GPIO_IRQ_EDGE_RISE = 8
+};
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+enum gpio_function gpio_get_function(uint gpio);
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback);
+void gpio_add_raw_irq_handler_masked(uint32_t gpio_mask, irq_handler_t handler);
+uint32_t gpio_get_irq_event_mask(uint gpio);
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask);
+
+/* PWM */
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
+uint pwm_gpio_to_slice_num(uint gpio);
+pwm_config pwm_get_default_config(void);
+void pwm_config_set_clkdiv(pwm_config *c, float div);
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap);
+void pwm_init(uint slice_num, pwm_config *c, bool start);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+void pwm_set_enabled(uint slice_num, bool enabled);
+
+/* ADC */
+typedef struct {
+    volatile uint32_t cs, result, fcs, fifo, div, intr, inte, intf, ints;
+} adc_hw_t;
+extern adc_hw_t *const adc_hw;
+#define DREQ_ADC 36
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint16_t adc_read(void);
+void adc_set_round_robin(uint input_mask);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+
+/* I2C */
+typedef struct i2c_inst i2c_inst_t;
+extern i2c_inst_t *const sim_i2c0;
+extern i2c_inst_t *const sim_i2c1;
+#define i2c0 sim_i2c0
+#define i2c1 sim_i2c1
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+/* DMA (kanal yok: dma_claim_unused_channel() -1 döner) */
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+typedef struct {
+    volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+    volatile uint32_t al1_ctrl, al1_read_addr, al1_write_addr, al1_transfer_count_trig;
+    volatile uint32_t al2_ctrl, al2_transfer_count, al2_read_addr, al2_write_addr_trig;
+    volatile uint32_t al3_ctrl, al3_write_addr, al3_transfer_count, al3_read_addr_trig;
+} dma_channel_hw_t;
+typedef struct {
+    dma_channel_hw_t ch[12];
+    volatile uint32_t intr, inte0, intf0, ints0, pad, inte1, intf1, ints1;
+} dma_hw_t;
+extern dma_hw_t *const dma_hw;
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_set_irq1_enabled(uint channel, bool enabled);
+
+/* UART (RX/TX FIFO'ları baud hızında; hat sim_uart_* ile sürülür, bkz. sim.h) */
+typedef struct uart_inst uart_inst_t;
+typedef struct {
+    volatile uint32_t dr, rsr;
+} uart_hw_t;
+typedef enum { UART_PARITY_NONE, UART_PARITY_EVEN, UART_PARITY_ODD } uart_parity_t;
+extern uart_inst_t *const sim_uart0;
+extern uart_inst_t *const sim_uart1;
+#define uart0 sim_uart0
+#define uart1 sim_uart1
+#define UART_FIFO_DEPTH 32
+uint uart_init(uart_inst_t *uart, uint baudrate);
+void uart_deinit(uart_inst_t *uart);
+uint uart_get_index(uart_inst_t *uart);
+uart_hw_t *uart_get_hw(uart_inst_t *uart);
+static inline uint uart_get_dreq(uart_inst_t *uart, bool is_tx) { return 20u + 2u * uart_get_index(uart) + (is_tx ? 0u : 1u); }
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity);
+void uart_set_hw_flow(uart_inst_t *uart, bool cts, bool rts);
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled);
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data);
+bool uart_is_readable(uart_inst_t *uart);
+bool uart_is_writable(uart_inst_t *uart);
+char uart_getc(uart_inst_t *uart);
+void uart_putc_raw(uart_inst_t *uart, char c);
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len);
+
+/* PIO (durum makinesi yok: pio_can_add_program() false döner) */
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t *const sim_pio0;
+extern pio_hw_t *const sim_pio1;
+#define pio0 sim_pio0
+#define pio1 sim_pio1
+typedef struct {
+    uint32_t clkdiv, execctrl, shiftctrl, pinctrl;
+} pio_sm_config;
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+enum pio_src_dest { pio_pins = 0, pio_x = 1, pio_y = 2, pio_null = 3, pio_pindirs = 4, pio_isr = 6, pio_osr = 7 };
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint offset);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_unclaim(PIO pio, uint sm);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm);
+uint32_t pio_sm_get(PIO pio, uint sm);
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+uint pio_get_rx_fifo_not_empty_interrupt_source(uint sm);
+void pio_set_irq0_source_enabled(PIO pio, uint source, bool enabled);
+static inline pio_sm_config pio_get_default_sm_config(void) { pio_sm_config c = {0}; return c; }
+static inline void sm_config_set_in_pins(pio_sm_config *c, uint base) { (void)c; (void)base; }
+static inline void sm_config_set_jmp_pin(pio_sm_config *c, uint pin) { (void)c; (void)pin; }
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint base, uint count) { (void)c; (void)base; (void)count; }
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) { (void)c; (void)join; }
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void)c; (void)div; }
+static inline void sm_config_set_wrap(pio_sm_config *c, uint target, uint wrap) { (void)c; (void)target; (void)wrap; }
+static inline int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint base, uint count, bool out) {
+    (void)pio; (void)sm; (void)base; (void)count; (void)out; return PICO_OK;
+}
+static inline void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t values, uint32_t mask) {
+    (void)pio; (void)sm; (void)values; (void)mask;
+}
+static inline int pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config *c) {
+    (void)pio; (void)sm; (void)offset; (void)c; return PICO_OK;
+}
+static inline void pio_sm_exec(PIO pio, uint sm, uint instr) { (void)pio; (void)sm; (void)instr; }
+static inline uint pio_encode_set(enum pio_src_dest dest, uint value) { (void)dest; return value; }
+static inline void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+
+/* Saatler */
+enum clock_index { clk_gpout0 = 0, clk_ref = 4, clk_sys = 5, clk_peri = 6, clk_usb = 7, clk_adc = 8 };
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+/* Flash (2 MB görüntü bellekte tutulur) */
+#define FLASH_PAGE_SIZE 256u
+#define FLASH_SECTOR_SIZE 4096u
+#define PICO_FLASH_SIZE_BYTES (2u * 1024u * 1024u)
+extern uint8_t sim_flash_image[];
+#define XIP_BASE ((uintptr_t)sim_flash_image)
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+bool flash_safe_execute_core_init(void);
+
+/* Çoklu çekirdek (Core 1 ayrı bir iş parçacığıdır) */
+void multicore_launch_core1(void (*entry)(void));
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+void multicore_fifo_clear_irq(void);
+void multicore_fifo_drain(void);
+uint get_core_num(void);
+
+/* Çekirdekler arası kuyruk (pico/util/queue.h); eleman ekleyenin zaman damgasını taşır */
+typedef struct {
+    uint8_t *data;
+    uint64_t *at_ns;
+    uint element_size;
+    uint element_count;
+    uint head;
+    uint count;
+} queue_t;
+void queue_init(queue_t *q, uint element_size, uint element_count);
+bool queue_try_add(queue_t *q, const void *data);
+bool queue_try_remove(queue_t *q, void *data);
+void queue_add_blocking(queue_t *q, const void *data);
+void queue_remove_blocking(queue_t *q, void *data);
+uint queue_get_level(queue_t *q);
+static inline bool queue_is_empty(queue_t *q) { return queue_get_level(q) == 0; }
+
+/* stdio */
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param);
+
+#endif // SIM_SDK_H
@@ -0,0 +1,401 @@
+/**
+ * @file pio_emu.c
+ * @brief .pio kaynağını doğrudan okuyan, tek durum makineli çevrim düzeyinde PIO öykünücüsü
+ * @see pio_emu.h
+ *
+ * Zamanlama RP2040 ile aynıdır: her komut 1 çevrim + gecikme sürer; koşulu
+ * sağlanmayan `wait`, dolu FIFO'ya `push block` ve boş FIFO'dan `pull block`
+ * her çevrim yeniden denenir ve gecikme komut tamamlanınca başlar.
+ */
+
+#include "pio_emu.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum { OP_JMP, OP_WAIT, OP_SET, OP_MOV, OP_PUSH, OP_PULL };
+enum { JMP_ALWAYS, JMP_NOT_X, JMP_X_DEC, JMP_NOT_Y, JMP_Y_DEC, JMP_X_NE_Y, JMP_PIN };
+enum { REG_X, REG_Y, REG_ISR, REG_OSR, REG_NULL, REG_PINS };
+
+#define PIO_EMU_MAX_LABELS 32
+#define PIO_EMU_NAME_LEN 32
+
+typedef struct {
+    char name[PIO_EMU_NAME_LEN];
+    unsigned addr;
+} label_t;
+
+/**
+ * @brief Yazmaç adını çözer
+ * @return int REG_* veya -1
+ */
+static int parse_reg(const char *s) {
+    static const char *names[] = {"x", "y", "isr", "osr", "null", "pins"};
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) {
+        if (strcmp(s, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Satırı boşluk ve virgüllerden sözcüklere böler
+ * @return int Sözcük sayısı
+ */
+static int split_words(char *line, char **words, int max) {
+    int n = 0;
+    for (char *tok = strtok(line, " \t,"); tok && n < max; tok = strtok(NULL, " \t,")) {
+        words[n++] = tok;
+    }
+    return n;
+}
+
+/**
+ * @brief Tek bir komut satırını ayrıştırır; jmp hedefi adıyla `target_name`'e yazılır
+ */
+static bool parse_instr(char *text, pio_emu_instr_t *in, char *target_name, char *err, size_t err_len) {
+    memset(in, 0, sizeof(*in));
+    target_name[0] = '\0';
+
+    char *bracket = strchr(text, '[');
+    if (bracket) {
+        in->delay = (uint8_t)strtoul(bracket + 1, NULL, 0);
+        *bracket = '\0';
+        if (in->delay > 31) {
+            snprintf(err, err_len, "gecikme > 31");
+            return false;
+        }
+    }
+
+    char *w[6];
+    int n = split_words(text, w, 6);
+    if (n == 0) {
+        snprintf(err, err_len, "bos komut");
+        return false;
+    }
+
+    if (strcmp(w[0], "jmp") == 0) {
+        static const char *conds[] = {"", "!x", "x--", "!y", "y--", "x!=y", "pin"};
+        in->op = OP_JMP;
+        in->cond = JMP_ALWAYS;
+        if (n == 3) {
+            bool found = false;
+            for (int c = 1; c < (int)(sizeof(conds) / sizeof(conds[0])); c++) {
+                if (strcmp(w[1], conds[c]) == 0) {
+                    in->cond = (uint8_t)c;
+                    found = true;
+                }
+            }
+            if (!found) {
+                snprintf(err, err_len, "jmp kosulu: %s", w[1]);
+                return false;
+            }
+        } else if (n != 2) {
+            snprintf(err, err_len, "jmp bicimi");
+            return false;
+        }
+        snprintf(target_name, PIO_EMU_NAME_LEN, "%s", w[n - 1]);
+        return true;
+    }
+    if (strcmp(w[0], "wait") == 0) {
+        // Yalnızca tek giriş pini: wait <0|1> pin 0
+        if (n != 4 || strcmp(w[2], "pin") != 0 || strcmp(w[3], "0") != 0) {
+            snprintf(err, err_len, "yalnizca 'wait <0|1> pin 0'");
+            return false;
+        }
+        in->op = OP_WAIT;
+        in->cond = (uint8_t)(atoi(w[1]) != 0);
+        return true;
+    }
+    if (strcmp(w[0], "set") == 0) {
+        int reg = n == 3 ? parse_reg(w[1]) : -1;
+        if (reg != REG_X && reg != REG_Y && reg != REG_PINS) {
+            snprintf(err, err_len, "set hedefi");
+            return false;
+        }
+        in->op = OP_SET;
+        in->dst = (uint8_t)reg;
+        in->value = (uint32_t)strtoul(w[2], NULL, 0) & 31u;
+        return true;
+    }
+    if (strcmp(w[0], "mov") == 0 || strcmp(w[0], "nop") == 0) {
+        in->op = OP_MOV;
+        if (w[0][0] == 'n') {
+            in->dst = REG_Y;
+            in->src = REG_Y;
+            return true;
+        }
+        if (n != 3) {
+            snprintf(err, err_len, "mov bicimi");
+            return false;
+        }
+        const char *src = w[2];
+        if (src[0] == '~' || src[0] == '!') {
+            in->invert = true;
+            src++;
+        }
+        int dst = parse_reg(w[1]);
+        int s = parse_reg(src);
+        if (dst < 0 || dst == REG_NULL || dst == REG_PINS || s < 0) {
+            snprintf(err, err_len, "mov yazmaci");
+            return false;
+        }
+        in->dst = (uint8_t)dst;
+        in->src = (uint8_t)s;
+        return true;
+    }
+    if (strcmp(w[0], "push") == 0 || strcmp(w[0], "pull") == 0) {
+        in->op = w[0][1] == 'u' && w[0][2] == 's' ? OP_PUSH : OP_PULL;
+        in->cond = 1;   // Varsayılan block
+        if (n == 2) {
+            if (strcmp(w[1], "noblock") == 0) {
+                in->cond = 0;
+            } else if (strcmp(w[1], "block") != 0) {
+                snprintf(err, err_len, "%s secenegi: %s", w[0], w[1]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    snprintf(err, err_len, "desteklenmeyen komut: %s", w[0]);
+    return false;
+}
+
+/**
+ * @brief Boşlukları baştan ve sondan kırpar
+ */
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) *--end = '\0';
+    return s;
+}
+
+/**
+ * @brief .pio dosyasındaki ilk programı yükler ve SM'yi sıfırlar
+ *
+ * `% c-sdk` bloğu ve sonrası okunmaz. Hatada `sm->error` doldurulur.
+ *
+ * @param sm Durum makinesi
+ * @param path .pio dosyası
+ * @param join_rx RX FIFO birleştirilsin mi (`PIO_FIFO_JOIN_RX`, 8 derinlik)
+ * @return bool Başarılı ise true
+ */
+bool pio_emu_load(pio_emu_t *sm, const char *path, bool join_rx) {
+    memset(sm, 0, sizeof(*sm));
+    sm->rx_depth = join_rx ? 8 : 4;
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        snprintf(sm->error, sizeof(sm->error), "%s acilamadi", path);
+        return false;
+    }
+
+    label_t labels[PIO_EMU_MAX_LABELS];
+    unsigned label_count = 0;
+    char targets[PIO_EMU_MAX_INSTR][PIO_EMU_NAME_LEN];
+    bool wrap_set = false;
+    bool ok = true;
+    char buf[256];
+    unsigned line_no = 0;
+    char err[64] = "";
+
+    while (ok && fgets(buf, sizeof(buf), f)) {
+        line_no++;
+        if (buf[0] == '%') break;
+        char *semi = strchr(buf, ';');
+        if (semi) *semi = '\0';
+        char *line = trim(buf);
+        if (*line == '\0') continue;
+
+        if (line[0] == '.') {
+            if (strncmp(line, ".wrap_target", 12) == 0) {
+                sm->wrap_target = sm->len;
+            } else if (strncmp(line, ".wrap", 5) == 0) {
+                sm->wrap = sm->len - 1;
+                wrap_set = true;
+            } else if (strncmp(line, ".program", 8) == 0) {
+                if (sm->len > 0) break;   // Yalnızca ilk program
+            } else {
+                snprintf(err, sizeof(err), "desteklenmeyen yonerge: %s", line);
+                ok = false;
+            }
+            continue;
+        }
+
+        char *colon = strchr(line, ':');
+        if (colon) {
+            *colon = '\0';
+            if (label_count == PIO_EMU_MAX_LABELS) {
+                snprintf(err, sizeof(err), "cok fazla etiket");
+                ok = false;
+                continue;
+            }
+            snprintf(labels[label_count].name, PIO_EMU_NAME_LEN, "%s", trim(line));
+            labels[label_count++].addr = sm->len;
+            line = trim(colon + 1);
+            if (*line == '\0') continue;
+        }
+
+        if (sm->len == PIO_EMU_MAX_INSTR) {
+            snprintf(err, sizeof(err), "program 32 komuttan uzun");
+            ok = false;
+            continue;
+        }
+        ok = parse_instr(line, &sm->prog[sm->len], targets[sm->len], err, sizeof(err));
+        if (ok) sm->len++;
+    }
+    fclose(f);
+
+    for (unsigned i = 0; ok && i < sm->len; i++) {
+        if (sm->prog[i].op != OP_JMP) continue;
+        bool found = false;
+        for (unsigned l = 0; l < label_count; l++) {
+            if (strcmp(labels[l].name, targets[i]) == 0) {
+                sm->prog[i].target = (uint8_t)labels[l].addr;
+                found = true;
+            }
+        }
+        if (!found) {
+            snprintf(err, sizeof(err), "etiket yok: %s", targets[i]);
+            line_no = 0;
+            ok = false;
+        }
+    }
+    if (ok && sm->len == 0) {
+        snprintf(err, sizeof(err), "komut yok");
+        ok = false;
+    }
+    if (!ok) {
+        snprintf(sm->error, sizeof(sm->error), "%s:%u: %s", path, line_no, err);
+        return false;
+    }
+    if (!wrap_set) sm->wrap = sm->len - 1;
+    return true;
+}
+
+static uint32_t read_reg(const pio_emu_t *sm, uint8_t reg) {
+    switch (reg) {
+    case REG_X: return sm->x;
+    case REG_Y: return sm->y;
+    case REG_ISR: return sm->isr;
+    case REG_OSR: return sm->osr;
+    case REG_PINS: return sm->pin ? 1u : 0u;
+    default: return 0;
+    }
+}
+
+static void write_reg(pio_emu_t *sm, uint8_t reg, uint32_t value) {
+    switch (reg) {
+    case REG_X: sm->x = value; break;
+    case REG_Y: sm->y = value; break;
+    case REG_ISR: sm->isr = value; break;
+    case REG_OSR: sm->osr = value; break;
+    case REG_PINS: sm->set_pin = value & 1u; break;
+    default: break;
+    }
+}
+
+/**
+ * @brief pc'deki komutu bir kez çalıştırır
+ * @return bool Komut tamamlandı ise true (false: takıldı, aynı komut yeniden denenir)
+ */
+static bool execute(pio_emu_t *sm) {
+    const pio_emu_instr_t *in = &sm->prog[sm->pc];
+    bool jump = false;
+
+    switch (in->op) {
+    case OP_JMP:
+        switch (in->cond) {
+        case JMP_ALWAYS: jump = true; break;
+        case JMP_NOT_X: jump = sm->x == 0; break;
+        case JMP_X_DEC: jump = sm->x != 0; sm->x--; break;
+        case JMP_NOT_Y: jump = sm->y == 0; break;
+        case JMP_Y_DEC: jump = sm->y != 0; sm->y--; break;
+        case JMP_X_NE_Y: jump = sm->x != sm->y; break;
+        case JMP_PIN: jump = sm->pin; break;
+        default: break;
+        }
+        break;
+    case OP_WAIT:
+        if (sm->pin != (bool)in->cond) return false;
+        break;
+    case OP_SET:
+        write_reg(sm, in->dst, in->value);
+        break;
+    case OP_MOV: {
+        uint32_t v = read_reg(sm, in->src);
+        write_reg(sm, in->dst, in->invert ? ~v : v);
+        break;
+    }
+    case OP_PUSH:
+        if (sm->rx_count == sm->rx_depth) {
+            if (in->cond) return false;
+        } else {
+            sm->rx[(sm->rx_head + sm->rx_count++) % PIO_EMU_FIFO_DEPTH] = sm->isr;
+        }
+        sm->isr = 0;
+        break;
+    case OP_PULL:
+        if (sm->tx_count == 0) {
+            if (in->cond) return false;
+            sm->osr = sm->x;
+        } else {
+            sm->osr = sm->tx[sm->tx_head];
+            sm->tx_head = (sm->tx_head + 1) % PIO_EMU_FIFO_DEPTH;
+            sm->tx_count--;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (jump) {
+        sm->pc = in->target;
+    } else {
+        sm->pc = sm->pc == sm->wrap ? sm->wrap_target : sm->pc + 1;
+    }
+    sm->delay_left = in->delay;
+    return true;
+}
+
+/**
+ * @brief SM'yi verilen çevrim kadar çalıştırır
+ *
+ * Giriş pini (`sm->pin`) çağrılar arasında değiştirilir; çevrim çevrim
+ * uyarı vermek için `cycles` = 1 kullanılır.
+ */
+void pio_emu_step(pio_emu_t *sm, uint64_t cycles) {
+    for (uint64_t i = 0; i < cycles; i++) {
+        sm->cycles++;
+        if (sm->delay_left > 0) {
+            sm->delay_left--;
+            continue;
+        }
+        execute(sm);
+    }
+}
+
+/**
+ * @brief RX FIFO'dan bir sözcük okur
+ * @return bool FIFO boş ise false
+ */
+bool pio_emu_get(pio_emu_t *sm, uint32_t *value) {
+    if (sm->rx_count == 0) return false;
+    *value = sm->rx[sm->rx_head];
+    sm->rx_head = (sm->rx_head + 1) % PIO_EMU_FIFO_DEPTH;
+    sm->rx_count--;
+    return true;
+}
+
+/**
+ * @brief TX FIFO'ya bir sözcük yazar
+ * @return bool FIFO dolu ise false
+ */
+bool pio_emu_put(pio_emu_t *sm, uint32_t value) {
+    if (sm->tx_count == 4) return false;
+    sm->tx[(sm->tx_head + sm->tx_count++) % PIO_EMU_FIFO_DEPTH] = value;
+    return true;
+}
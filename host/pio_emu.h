@@ -0,0 +1,67 @@
+/**
+ * @file pio_emu.h
+ * @brief .pio kaynağını doğrudan okuyan, tek durum makineli çevrim düzeyinde PIO öykünücüsü
+ * @see \ref howto_host_sim
+ *
+ * Simüle edilen HAL PIO kaynağı sunmaz; bu öykünücü yalnızca PIO
+ * programlarının kendisini (input_debounce.pio, ultrasonic_echo.pio) bilgisayarda
+ * sınamak içindir. pioasm gerekmez: program metni satır satır ayrıştırılır.
+ *
+ * Desteklenen alt küme: `jmp` (koşulsuz, `!x`, `x--`, `!y`, `y--`, `x!=y`,
+ * `pin`), `wait 0|1 pin 0`, `set x|y|pins`, `mov` (x, y, isr, osr, null;
+ * `~` tersleme), `push`/`pull` (`block`/`noblock`), gecikme `[n]`,
+ * `.wrap_target`/`.wrap`. Tek bir giriş pini vardır: `wait ... pin 0` ve
+ * `jmp pin` aynı pini okur. SET pini tek bittir. FIFO'lar 4 derinliktir
+ * (`join_rx` ile RX 8).
+ */
+
+#ifndef PIO_EMU_H
+#define PIO_EMU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PIO_EMU_MAX_INSTR 32   /**< PIO komut belleği */
+#define PIO_EMU_FIFO_DEPTH 8   /**< Birleştirilmiş FIFO derinliği */
+
+/**
+ * @brief Ayrıştırılmış tek bir komut
+ */
+typedef struct {
+    uint8_t op;        /**< Komut türü (pio_emu.c) */
+    uint8_t cond;      /**< jmp koşulu, wait kutbu, push/pull block */
+    uint8_t dst;       /**< Hedef (set/mov) */
+    uint8_t src;       /**< Kaynak (mov) */
+    bool invert;       /**< mov ~ */
+    uint8_t target;    /**< jmp adresi */
+    uint32_t value;    /**< set değeri */
+    uint8_t delay;     /**< [n] */
+} pio_emu_instr_t;
+
+/**
+ * @brief Bir durum makinesinin durumu
+ */
+typedef struct {
+    pio_emu_instr_t prog[PIO_EMU_MAX_INSTR];
+    unsigned len;                            /**< Komut sayısı */
+    unsigned wrap_target;                    /**< .wrap_target adresi */
+    unsigned wrap;                           /**< .wrap adresi (son komut) */
+    unsigned pc;
+    uint32_t x, y, isr, osr;
+    unsigned delay_left;                     /**< Kalan gecikme çevrimi */
+    bool pin;                            /**< Giriş pini (wait/jmp pin) */
+    bool set_pin;                        /**< SET pini çıkışı */
+    uint32_t rx[PIO_EMU_FIFO_DEPTH];
+    unsigned rx_head, rx_count, rx_depth;
+    uint32_t tx[PIO_EMU_FIFO_DEPTH];
+    unsigned tx_head, tx_count;
+    uint64_t cycles;                     /**< Çalışılan çevrim */
+    char error[96];                      /**< Ayrıştırma hatası */
+} pio_emu_t;
+
+bool pio_emu_load(pio_emu_t *sm, const char *path, bool join_rx);
+void pio_emu_step(pio_emu_t *sm, uint64_t cycles);
+bool pio_emu_get(pio_emu_t *sm, uint32_t *value);
+bool pio_emu_put(pio_emu_t *sm, uint32_t value);
+
+#endif // PIO_EMU_H
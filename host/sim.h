@@ -0,0 +1,98 @@
+/**
+ * @file sim.h
+ * @brief Bilgisayar simülasyonu denetim API'si (sanal saat, betikli girişler, kayıtlar)
+ * @see \ref howto_host_sim
+ *
+ * Firmware modülleri bu dosyayı görmez; yalnızca simülasyonu süren program
+ * (örnek: host/sim_demo.c) kullanır. Zaman mikrosaniye cinsindendir ve
+ * firmware'in `time_us_64()` ile gördüğü saatle aynıdır.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "sim_sdk.h"
+
+/**
+ * @defgroup sim Simülasyon Ayarları
+ * @{
+ */
+#define SIM_GPIO_COUNT 30         /**< Simüle edilen GPIO sayısı */
+#define SIM_ADC_CHANNELS 5        /**< ADC kanalları (4: sıcaklık) */
+#define SIM_MAX_EVENTS 64         /**< Aynı anda bekleyen zamanlı olay (alarm + betik) */
+#define SIM_I2C_LOG_LEN 4096      /**< I2C işlem kaydı uzunluğu (halka) */
+#define SIM_I2C_MAX_DATA 16       /**< Kayıt başına saklanan en fazla bayt */
+#define SIM_ADC_CONVERSION_NS 2000u  /**< Tek adc_read() süresi (96 ADC saati @ 48 MHz) */
+#define SIM_TIME_READ_COST_NS 100u   /**< Varsayılan time_us_64() maliyeti (bekleme döngüleri ilerlesin diye) */
+#define SIM_UART_LINE_LEN 4096    /**< UART alma hattında bekleyebilecek bayt */
+/** @} */
+
+/**
+ * @brief Kaydedilen tek bir I2C yazma işlemi
+ */
+typedef struct {
+    uint64_t timestamp_us;            /**< İşlemin başladığı an */
+    uint8_t addr;                     /**< 7 bit adres */
+    uint8_t len;                      /**< Yazılan bayt sayısı (kesilmeden önce) */
+    uint32_t duration_ns;             /**< Modellenen veri yolu süresi (son bayt bu sürede oturur) */
+    uint8_t data[SIM_I2C_MAX_DATA];   /**< İlk SIM_I2C_MAX_DATA bayt */
+} sim_i2c_record_t;
+
+/**
+ * @brief Bir PWM çıkışının anlık durumu
+ */
+typedef struct {
+    bool enabled;     /**< Dilim çalışıyor mu */
+    uint16_t wrap;    /**< TOP değeri */
+    float clkdiv;     /**< Saat bölücü */
+    uint16_t level;   /**< Kanalın karşılaştırma değeri */
+    float freq_hz;    /**< clk_sys / (clkdiv * (wrap + 1)) */
+} sim_pwm_state_t;
+
+/** @brief Bir çıkış pini değiştiğinde çağrılır (cihaz modelleri için) */
+typedef void (*sim_gpio_listener_t)(uint gpio, bool level, uint64_t timestamp_us);
+
+/** @brief Her I2C yazmasında çağrılır (cihaz modelleri için) */
+typedef void (*sim_i2c_listener_t)(const sim_i2c_record_t *record);
+
+/** @brief UART'tan her bayt gönderildiğinde çağrılır */
+typedef void (*sim_uart_listener_t)(uint uart, uint8_t byte, uint64_t timestamp_us);
+
+// Sanal saat
+uint64_t sim_now_us(void);
+void sim_run_for_us(uint64_t us);
+void sim_set_time_read_cost_ns(uint32_t ns);
+
+// Betikli girişler
+void sim_gpio_set_input(uint gpio, bool level);
+bool sim_gpio_schedule(uint64_t at_us, uint gpio, bool level);
+bool sim_gpio_pulse(uint64_t at_us, uint gpio, bool level, uint64_t width_us);
+bool sim_gpio_output(uint gpio);
+bool sim_gpio_is_output(uint gpio);
+void sim_gpio_set_listener(sim_gpio_listener_t listener);
+void sim_adc_set(uint channel, uint16_t value);
+bool sim_adc_schedule(uint64_t at_us, uint channel, uint16_t value);
+
+// Kayıtlar
+uint32_t sim_i2c_count(void);
+bool sim_i2c_get(uint32_t index, sim_i2c_record_t *out);
+void sim_i2c_clear(void);
+void sim_i2c_set_listener(sim_i2c_listener_t listener);
+bool sim_pwm_get(uint gpio, sim_pwm_state_t *out);
+
+// UART hattı
+size_t sim_uart_inject(uint uart, const uint8_t *data, size_t len);
+uint32_t sim_uart_rx_overruns(uint uart);
+void sim_uart_set_listener(sim_uart_listener_t listener);
+bool sim_uart_open_pty(uint uart, char *name, size_t name_len);
+size_t sim_uart_poll_pty(uint uart);
+
+// Flash görüntüsü (açılışlar arası kalıcılık)
+bool sim_flash_load(const char *path);
+bool sim_flash_save(const char *path);
+void sim_flash_fail_next(uint32_t count);   // Sonraki count flash_safe_execute() PICO_ERROR_TIMEOUT döner
+
+// Çoklu çekirdek: flash kilidi kurbanına FIFO'dan gelip atılan sözcükler
+uint32_t sim_fifo_dropped(uint core);
+
+#endif // SIM_H
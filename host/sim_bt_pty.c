@@ -0,0 +1,334 @@
+/**
+ * @file sim_bt_pty.c
+ * @brief Bluetooth UART sürücüsünü bir pty'ye bağlayan yankı (loopback) sunucusu
+ * @see \ref howto_bt_uart
+ *
+ * bt_uart.c simüle edilen UART0 üzerinde çalışır; UART0 hattı bir sözde
+ * terminale bağlanır. Boş hat olayı (EVENT_LOOP_BT) geldiğinde alınan veri
+ * kopyalanmadan okunur ve aynen geri gönderilir. Sanal saat gerçek zamana
+ * bağlıdır, böylece baud hızı karşı uçtan da gözlenir.
+ *
+ * `--selftest` pty açmaz: hatta parça parça veri verir, yankıyı dinleyiciyle
+ * toplar ve girdiyle karşılaştırır (deterministik, çıkış kodu 1 = hata).
+ * `--remote --selftest` hat hızını aşan aboneliğin reddedildiğini ve hat
+ * dolu akışlarla doluyken her PING'in cevap aldığını denetler.
+ *
+ * `--remote` yankı yerine kartı başlatır ve pty üzerinde ikili protokolü
+ * (remote.c) çalıştırır; tools/remote_client.py ve tools/remote_loadtest.py
+ * donanımsız denenir. Motor komutları yalnızca yazdırılır.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_bt_pty                  # pty yolunu yazar, Ctrl+C ile çıkılır
+ * picocom -b 9600 /dev/pts/3                         # başka bir terminalde
+ * ./build-host/host/rppicods_bt_pty --selftest
+ * ./build-host/host/rppicods_bt_pty --remote --selftest
+ * ./build-host/host/rppicods_bt_pty --remote
+ * python3 tools/remote_loadtest.py /dev/pts/3 --baud 9600
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "pico_training_board.h"
+#include "sim.h"
+#include "sim_check.h"
+
+#define SELFTEST_LEN 3000  // Kendi kendine test verisi (alma tamponundan büyük)
+#define SELFTEST_BURST 200 // Hatta bir seferde verilen bayt
+#define REMOTE_TEST_PINGS 40 // Akışlar hattı doldururken gönderilen PING
+
+static uint8_t echo_buf[SELFTEST_LEN];
+static size_t echo_len = 0;
+static uint32_t frames = 0;
+static bool verbose = true;
+
+/**
+ * @brief Gönderilen baytları toplar (kendi kendine test)
+ */
+static void on_tx(uint uart, uint8_t byte, uint64_t timestamp_us) {
+    (void)uart;
+    (void)timestamp_us;
+    if (echo_len < sizeof(echo_buf)) {
+        echo_buf[echo_len++] = byte;
+    }
+}
+
+/**
+ * @brief Boş hat olayı: alınan her parçayı kopyalamadan geri gönderir
+ */
+static void on_bt(uint32_t events) {
+    (void)events;
+    const uint8_t *p;
+    size_t n;
+    size_t total = 0;
+    while ((n = bt_uart_rx_peek(&p)) != 0) {
+        size_t sent = bt_uart_write(p, n);
+        bt_uart_rx_consume(sent);
+        total += sent;
+        if (sent < n) {
+            break;  // TX tamponu dolu; kalan bir sonraki olayda
+        }
+    }
+    frames++;
+    if (verbose && total != 0) {
+        printf("[%8llu us] %zu bayt yankilandi\n", (unsigned long long)sim_now_us(), total);
+    }
+}
+
+/**
+ * @brief Sürücü sayaçlarını yazar
+ */
+static void print_stats(void) {
+    bt_uart_stats_t s;
+    bt_uart_get_stats(&s);
+    printf("baud %u (%s), alinan %lu, gonderilen %lu, tasma %lu+%lu, dolu %lu, bos hat %lu\n",
+           s.baud, s.dma ? "dma" : "kesme", (unsigned long)s.rx_bytes, (unsigned long)s.tx_bytes,
+           (unsigned long)s.rx_overrun, (unsigned long)sim_uart_rx_overruns(0),
+           (unsigned long)s.tx_full, (unsigned long)s.idle_events);
+}
+
+/**
+ * @brief Uzaktan motor komutu: Core 1 olmadığı için yalnızca yazdırır
+ */
+static remote_status_t on_remote_motor(remote_port_t port, const uint8_t *payload, size_t len) {
+    (void)port;
+    float revs;
+    if (len != 7) {
+        return REMOTE_INVALID;
+    }
+    memcpy(&revs, &payload[3], sizeof(revs));
+    printf("[%8llu us] motor: yon %u, hiz %u, devir %.1f\n", (unsigned long long)sim_now_us(),
+           payload[0], (unsigned)(payload[1] | (payload[2] << 8)), revs);
+    return REMOTE_OK;
+}
+
+/**
+ * @brief Hatta veri verir, yankıyı girdiyle karşılaştırır
+ * @return int 0: yankı birebir aynı
+ */
+static int selftest(void) {
+    static uint8_t data[SELFTEST_LEN];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7u + (i >> 8));
+    }
+    verbose = false;
+    sim_uart_set_listener(on_tx);
+
+    // Parçalar arasında hat boş kalır; her parça bir boş hat olayı üretmeli
+    uint64_t byte_us = 10000000u / BT_UART_BAUD;
+    for (size_t off = 0; off < sizeof(data); off += SELFTEST_BURST) {
+        size_t n = MIN((size_t)SELFTEST_BURST, sizeof(data) - off);
+        sim_uart_inject(0, &data[off], n);
+        absolute_time_t until = make_timeout_time_us(n * byte_us * 2 + 20000);
+        while (!time_reached(until)) {
+            event_loop_poll(until);
+        }
+    }
+    absolute_time_t until = make_timeout_time_ms(500);
+    while (!time_reached(until)) {
+        event_loop_poll(until);
+    }
+
+    print_stats();
+    bool same = echo_len == sizeof(data) && memcmp(echo_buf, data, sizeof(data)) == 0;
+    printf("yanki: %zu/%zu bayt %s, %lu olay\n", echo_len, sizeof(data),
+           same ? "ayni" : "FARKLI", (unsigned long)frames);
+    return same ? 0 : 1;
+}
+
+/**
+ * @brief Karttan gelen çerçevelerin çözücüsü ve son cevaplar (uzaktan test)
+ */
+static struct {
+    uint8_t buf[REMOTE_WIRE_MAX];
+    size_t len;
+    int ack_seq;          /**< Son ACK'in sırası (-1: yok) */
+    uint8_t ack_status;   /**< Son ACK'in durumu */
+    int pong_seq;         /**< Son PONG'un sırası (-1: yok) */
+    uint32_t samples;     /**< Alınan SAMPLE */
+    uint32_t bad;         /**< Çözülemeyen çerçeve */
+} rx = {.ack_seq = -1, .pong_seq = -1};
+
+/**
+ * @brief Gönderilen baytları ayraçlarda çerçeveye böler ve COBS çözer
+ */
+static void on_remote_tx(uint uart, uint8_t byte, uint64_t timestamp_us) {
+    (void)uart;
+    (void)timestamp_us;
+    if (byte != 0x00) {
+        if (rx.len < sizeof(rx.buf)) {
+            rx.buf[rx.len++] = byte;
+        }
+        return;
+    }
+    if (rx.len == 0) {
+        return;
+    }
+    uint8_t frame[REMOTE_WIRE_MAX];
+    size_t n = 0;
+    for (size_t i = 0; i < rx.len;) {
+        uint8_t code = rx.buf[i++];
+        for (uint8_t k = 1; k < code && i < rx.len; k++) {
+            frame[n++] = rx.buf[i++];
+        }
+        if (code != 0xFF && i < rx.len) {
+            frame[n++] = 0x00;
+        }
+    }
+    rx.len = 0;
+    if (n < 4 || crc16_ccitt(frame, n - 2, CRC16_INIT) != (frame[n - 2] | (frame[n - 1] << 8))) {
+        rx.bad++;
+    } else if (frame[0] == REMOTE_MSG_ACK) {
+        rx.ack_seq = frame[1];
+        rx.ack_status = frame[3];
+    } else if (frame[0] == REMOTE_MSG_PONG) {
+        rx.pong_seq = frame[1];
+    } else if (frame[0] == REMOTE_MSG_SAMPLE) {
+        rx.samples++;
+    }
+}
+
+/**
+ * @brief İsteği COBS çerçevesi olarak hatta verir
+ */
+static void remote_inject(uint8_t type, uint8_t seq, const uint8_t *payload, size_t len) {
+    uint8_t frame[REMOTE_FRAME_MAX];
+    uint8_t wire[REMOTE_WIRE_MAX];
+    frame[0] = type;
+    frame[1] = seq;
+    memcpy(&frame[2], payload, len);
+    uint16_t crc = crc16_ccitt(frame, len + 2, CRC16_INIT);
+    frame[len + 2] = (uint8_t)crc;
+    frame[len + 3] = (uint8_t)(crc >> 8);
+
+    size_t n = 0;
+    wire[n++] = 0x00;
+    size_t code_pos = n++;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len + 4; i++) {
+        if (frame[i] == 0x00) {
+            wire[code_pos] = code;
+            code_pos = n++;
+            code = 1;
+        } else {
+            wire[n++] = frame[i];
+            code++;
+        }
+    }
+    wire[code_pos] = code;
+    wire[n++] = 0x00;
+    sim_uart_inject(0, wire, n);
+}
+
+/**
+ * @brief Görevleri ve olayları verilen süre (veya koşul sağlanana kadar) çalıştırır
+ */
+static void remote_run_until(uint32_t timeout_ms, const int *seq_field, int want_seq) {
+    absolute_time_t until = make_timeout_time_ms(timeout_ms);
+    while (!time_reached(until) && (seq_field == NULL || *seq_field != want_seq)) {
+        absolute_time_t step = make_timeout_time_ms(1);
+        scheduler_run_due();
+        event_loop_poll(step);
+    }
+}
+
+/**
+ * @brief Abonelik bütçesini ve akışlar hattı doldururken cevapları denetler
+ * @return int sim_check_summary()
+ */
+static int remote_selftest(void) {
+    uint8_t seq = 0;
+    uint8_t sub[3];
+    sim_uart_set_listener(on_remote_tx);
+
+    // Hat 960 B/s, SAMPLE 25 B: 4 akış x 9 Hz sığar, beşinci sensör sığmaz
+    uint32_t per_stream = (BT_UART_BAUD / 10) / 25 / 4;
+    for (uint i = 0; i < 5; i++) {
+        sub[0] = (uint8_t)i;
+        sub[1] = (uint8_t)(i < 4 ? per_stream : 10);
+        sub[2] = 0;
+        remote_inject(REMOTE_MSG_SUBSCRIBE, ++seq, sub, sizeof(sub));
+        remote_run_until(500, &rx.ack_seq, seq);
+        remote_status_t want = i < 4 ? REMOTE_OK : REMOTE_BUSY;
+        CHECK(rx.ack_seq == seq && rx.ack_status == want, "abonelik %u: ACK sira %d durum %u, beklenen %u",
+              i, rx.ack_seq, rx.ack_status, want);
+    }
+
+    // Akışlar hattı doldururken PING'ler; her biri cevap almalı
+    uint8_t ping[REMOTE_MAX_PAYLOAD];
+    memset(ping, 0x5A, sizeof(ping));
+    uint lost = 0;
+    for (uint i = 0; i < REMOTE_TEST_PINGS; i++) {
+        remote_inject(REMOTE_MSG_PING, ++seq, ping, sizeof(ping));
+        remote_run_until(2000, &rx.pong_seq, seq);
+        if (rx.pong_seq != seq) {
+            lost++;
+        }
+    }
+    CHECK(lost == 0, "%u/%u PING cevapsiz", lost, REMOTE_TEST_PINGS);
+    CHECK(rx.samples != 0 && rx.bad == 0, "%lu ornek, %lu bozuk cerceve", (unsigned long)rx.samples,
+          (unsigned long)rx.bad);
+
+    remote_stats_t st;
+    remote_get_stats(&st);
+    printf("abonelik %lu Hz x 4, %u ping cevaplandi, %lu ornek, tx_dropped %lu\n",
+           (unsigned long)per_stream, REMOTE_TEST_PINGS - lost, (unsigned long)rx.samples,
+           (unsigned long)st.tx_dropped);
+    return sim_check_summary();
+}
+
+int main(int argc, char **argv) {
+    bool self = false;
+    bool remote = false;
+    for (int i = 1; i < argc; i++) {
+        self |= strcmp(argv[i], "--selftest") == 0;
+        remote |= strcmp(argv[i], "--remote") == 0;
+    }
+
+    stdio_init_all();
+    if (remote) {
+        init_board();  // bt_uart_init() dahil; LCD ve buzzer istekleri için
+        event_loop_init();
+        remote_init();
+        remote_register(REMOTE_MSG_MOTOR, on_remote_motor);
+        event_loop_register(EVENT_LOOP_BT, remote_on_bt_event);
+        scheduler_add_task("uzaktan", remote_task, REMOTE_TASK_PERIOD_MS, REMOTE_TASK_PERIOD_MS);
+    } else {
+        event_loop_init();
+        event_loop_register(EVENT_LOOP_BT, on_bt);
+        if (!bt_uart_init(BT_UART_BAUD)) {
+            fprintf(stderr, "bt_uart_init basarisiz\n");
+            return 1;
+        }
+    }
+    if (self) {
+        return remote ? remote_selftest() : selftest();
+    }
+
+    char name[64];
+    if (!sim_uart_open_pty(0, name, sizeof(name))) {
+        perror("pty");
+        return 1;
+    }
+    printf("BT UART (%u baud) -> %s\n", BT_UART_BAUD, name);
+
+    // Sanal saat gerçek zamanla 1 ms adımlarla ilerler
+    uint64_t ticks = 0;
+    while (true) {
+        sim_uart_poll_pty(0);
+        absolute_time_t until = make_timeout_time_ms(1);
+        while (!time_reached(until)) {
+            if (remote) {
+                scheduler_run_due();
+            }
+            event_loop_poll(until);
+        }
+        usleep(1000);
+        if (!remote && ++ticks % 10000 == 0) {
+            print_stats();
+        }
+    }
+}
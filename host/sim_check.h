@@ -0,0 +1,63 @@
+/**
+ * @file sim_check.h
+ * @brief Bilgisayar kendi kendine testleri (`--selftest`) için ortak denetim yardımcıları
+ * @see \ref howto_host_sim
+ *
+ * Her test programı tek bir çeviri birimidir; sayaç bu yüzden dosyaya özeldir.
+ * Başarısız denetim `HATA: ...` satırı yazar ve testi durdurmaz, böylece bir
+ * çalıştırma tüm hataları gösterir. Sonuç `sim_check_summary()` ile yazılır:
+ * `TAMAM` (çıkış kodu 0) veya `BASARISIZ` (çıkış kodu 1).
+ *
+ * @code{.c}
+ * static int selftest(void) {
+ *     CHECK(config_load(), "yuklenemedi");
+ *     return sim_check_summary();
+ * }
+ *
+ * int main(int argc, char **argv) {
+ *     if (sim_check_selftest_arg(argc, argv)) {
+ *         return selftest();
+ *     }
+ *     ...
+ * }
+ * @endcode
+ */
+
+#ifndef SIM_CHECK_H
+#define SIM_CHECK_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+static int sim_check_failures;
+
+/**
+ * @brief Koşul yanlışsa printf biçimli mesajla hatayı yazar ve sayar
+ */
+#define CHECK(cond, ...)                      \
+    do {                                      \
+        if (!(cond)) {                        \
+            printf("HATA: " __VA_ARGS__);     \
+            printf("\n");                     \
+            sim_check_failures++;             \
+        }                                     \
+    } while (0)
+
+/**
+ * @brief Sonucu yazar ve çıkış kodunu döndürür
+ * @return int 0: tüm denetimler geçti, 1: en az bir hata
+ */
+static inline int sim_check_summary(void) {
+    printf("%s\n", sim_check_failures ? "BASARISIZ" : "TAMAM");
+    return sim_check_failures ? 1 : 0;
+}
+
+/**
+ * @brief İlk argüman `--selftest` mi
+ */
+static inline bool sim_check_selftest_arg(int argc, char **argv) {
+    return argc > 1 && strcmp(argv[1], "--selftest") == 0;
+}
+
+#endif // SIM_CHECK_H
@@ -0,0 +1,238 @@
+/**
+ * @file sim_config.c
+ * @brief Kalıcı yapılandırmayı (config.c) simüle edilen flash üzerinde sınayan araç
+ * @see \ref howto_config
+ *
+ * `--selftest` kartı başlatmaz; kayıtları doğrudan flash görüntüsüne yazarak
+ * veya bozarak şunları denetler:
+ * - boş flash'ta varsayılanlar kullanılır,
+ * - eski tuş takımı kalibrasyonu taşınır ve ilk kayıt A sektörüne gider,
+ * - kaydetmeler A/B sektörleri arasında nesil artarak gidip gelir,
+ * - yazma yarıda kalırsa (en yeni kayıt bozuk) önceki nesil yüklenir,
+ * - eski şemalı kısa kayıtta eksik alanlar varsayılan kalır, yeni şemalı
+ *   uzun kayıtta bilinmeyen alanlar yok sayılır,
+ * - aralık dışı değerler ve azalmayan eşikler reddedilir veya düzeltilir,
+ * - ultrasonic_set_temperature() ses hızını alanın aralığıyla sınırlar.
+ * Çıkış kodu 1 = hata. `--image` kalıcı bir görüntüde yapılandırmayı yazar.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_config --selftest
+ * ./build-host/host/rppicods_config --image flash.bin motor_speed=600 sound_speed=346.5
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico_training_board.h"
+#include "sim.h"
+#include "sim_check.h"
+
+/**
+ * @brief Belgelenen kayıt biçimiyle (config.c) bir sektöre kayıt yazar
+ */
+static void write_record(uint slot, uint32_t seq, uint16_t version, uint16_t size, const void *payload) {
+    uint8_t page[FLASH_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    memcpy(&page[0], &(uint32_t){CONFIG_MAGIC}, 4);
+    memcpy(&page[4], &seq, 4);
+    memcpy(&page[8], &version, 2);
+    memcpy(&page[10], &size, 2);
+    memcpy(&page[16], payload, size);
+    uint16_t crc = crc16_ccitt(page, 12, CRC16_INIT);
+    crc = crc16_ccitt(&page[16], size, crc);
+    memcpy(&page[12], &crc, 2);
+    uint32_t offs = CONFIG_FLASH_OFFSET + slot * FLASH_SECTOR_SIZE;
+    flash_range_erase(offs, FLASH_SECTOR_SIZE);
+    flash_range_program(offs, page, FLASH_PAGE_SIZE);
+}
+
+static void erase_config(void) {
+    flash_range_erase(CONFIG_FLASH_OFFSET, 2 * FLASH_SECTOR_SIZE);
+}
+
+static bool set(const char *name, float value) {
+    int idx = config_find(name);
+    return idx >= 0 && config_set((uint)idx, value);
+}
+
+static int selftest(void) {
+    config_status_t st;
+    config_t defaults;
+
+    // Boş flash: varsayılanlar
+    erase_config();
+    CHECK(!config_load(), "bos flash'ta kayit bulundu");
+    config_get_status(&st);
+    CHECK(st.slot == -1 && st.seq == 0 && !st.dirty, "bos flash durumu");
+    defaults = board_config;
+    CHECK(board_config.motor_speed == CONFIG_MOTOR_SPEED_DEFAULT && board_config.i2c_baud == CONFIG_I2C_BAUD_DEFAULT &&
+              board_config.button_debounce_us == BUTTON_DEBOUNCE_US,
+          "varsayilanlar");
+    printf("%-28s tamam (%u alan, config_t %zu bayt)\n", "bos flash", config_field_count(), sizeof(config_t));
+
+    // Eski tuş takımı kalibrasyonu (B sektöründe) taşınır
+    uint8_t legacy[FLASH_PAGE_SIZE];
+    uint16_t thresholds[KEYPAD_KEY_COUNT];
+    memset(legacy, 0xFF, sizeof(legacy));
+    for (int i = 0; i < KEYPAD_KEY_COUNT; i++) {
+        thresholds[i] = (uint16_t)(3000 - 200 * i);
+    }
+    memcpy(&legacy[0], &(uint32_t){0x4C43504Bu}, 4);
+    memcpy(&legacy[4], thresholds, sizeof(thresholds));
+    uint16_t crc = crc16_ccitt(legacy, 4 + sizeof(thresholds), CRC16_INIT);
+    memcpy(&legacy[4 + sizeof(thresholds)], &crc, 2);
+    flash_range_erase(KEYPAD_CAL_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(KEYPAD_CAL_FLASH_OFFSET, legacy, FLASH_PAGE_SIZE);
+    CHECK(config_load(), "eski kalibrasyon okunmadi");
+    config_get_status(&st);
+    CHECK(st.legacy_keypad && st.dirty && st.slot == -1, "eski kalibrasyon durumu");
+    CHECK(memcmp(board_config.keypad_thresholds, thresholds, sizeof(thresholds)) == 0, "esikler tasinmadi");
+    CHECK(keypad_decode(2700) == '3', "tasinan esikle tus cozumu: %c", keypad_decode(2700));
+    CHECK(config_save(), "ilk kayit");
+    config_get_status(&st);
+    CHECK(st.slot == 0 && st.seq == 1, "ilk kayit A sektorune gitmeli (sektor %d nesil %lu)", st.slot,
+          (unsigned long)st.seq);
+    CHECK(memcmp((const void *)(XIP_BASE + KEYPAD_CAL_FLASH_OFFSET), legacy, 16) == 0,
+          "ilk kayit eski kalibrasyonu silmemeli");
+    printf("%-28s tamam\n", "eski kalibrasyon tasima");
+
+    // Çift sektör: kaydetmeler A/B arasında gider, en yeni nesil yüklenir
+    for (uint32_t n = 2; n <= 5; n++) {
+        CHECK(set("motor_speed", (float)(100 * n)), "motor_speed ayarlanamadi");
+        uint64_t t0 = sim_now_us();
+        CHECK(config_save(), "kayit %lu", (unsigned long)n);
+        if (n == 2) {
+            printf("%-28s %llu us (sanal)\n", "kaydetme suresi", (unsigned long long)(sim_now_us() - t0));
+        }
+        config_get_status(&st);
+        CHECK(st.slot == (int8_t)((n - 1) % 2) && st.seq == n, "kayit %lu: sektor %d nesil %lu", (unsigned long)n,
+              st.slot, (unsigned long)st.seq);
+    }
+    board_config = defaults;
+    CHECK(config_load(), "yeniden yukleme");
+    config_get_status(&st);
+    CHECK(st.seq == 5 && st.slot == 0 && !st.dirty && board_config.motor_speed == 500,
+          "en yeni nesil yuklenmeli (nesil %lu, hiz %lu)", (unsigned long)st.seq,
+          (unsigned long)board_config.motor_speed);
+    CHECK(memcmp(board_config.keypad_thresholds, thresholds, sizeof(thresholds)) == 0, "esikler korunmadi");
+    printf("%-28s tamam\n", "A/B nesilleri");
+
+    // Yazma yarıda kaldı: en yeni kayıt (A, nesil 5) bozulur, B (nesil 4) kullanılır
+    sim_flash_image[CONFIG_FLASH_OFFSET + 16 + offsetof(config_t, motor_speed)] ^= 0x01;
+    config_load();
+    config_get_status(&st);
+    CHECK(st.slot == 1 && st.seq == 4 && board_config.motor_speed == 400,
+          "bozuk kayitta onceki nesil (sektor %d nesil %lu hiz %lu)", st.slot, (unsigned long)st.seq,
+          (unsigned long)board_config.motor_speed);
+    CHECK(config_save(), "bozuk kayittan sonra kaydetme");
+    config_get_status(&st);
+    CHECK(st.slot == 0 && st.seq == 5, "bozuk sektorun ustune yazilmali");
+    printf("%-28s tamam\n", "yarim yazma");
+
+    // Şema: eski (kısa) kayıtta sonraki alanlar varsayılan, yeni (uzun) kayıtta fazlası yok sayılır
+    config_t c = defaults;
+    c.button_debounce_us = 5000;
+    c.i2c_baud = 400000;
+    c.motor_speed = 700;
+    erase_config();
+    write_record(0, 10, 0, offsetof(config_t, i2c_baud), &c);
+    config_load();
+    CHECK(board_config.button_debounce_us == 5000 && board_config.i2c_baud == CONFIG_I2C_BAUD_DEFAULT &&
+              board_config.motor_speed == CONFIG_MOTOR_SPEED_DEFAULT,
+          "eski sema");
+    uint8_t wide[sizeof(config_t) + 8];
+    memset(wide, 0x5A, sizeof(wide));
+    memcpy(wide, &c, sizeof(c));
+    write_record(1, 11, CONFIG_VERSION + 1, sizeof(wide), wide);
+    config_load();
+    config_get_status(&st);
+    CHECK(st.slot == 1 && st.version == CONFIG_VERSION + 1 && board_config.i2c_baud == 400000 &&
+              board_config.motor_speed == 700,
+          "yeni sema");
+    printf("%-28s tamam\n", "sema surumleri");
+
+    // Nesil taşması: 0xFFFFFFFF'ten sonra 0 daha yenidir
+    write_record(0, 0xFFFFFFFFu, CONFIG_VERSION, sizeof(c), &c);
+    c.motor_speed = 800;
+    write_record(1, 0, CONFIG_VERSION, sizeof(c), &c);
+    config_load();
+    CHECK(board_config.motor_speed == 800, "nesil tasmasi");
+
+    // Doğrulama: aralık dışı set reddedilir, flash'taki aralık dışı değer düzeltilir
+    CHECK(!set("motor_speed", 5000), "aralik disi kabul edildi");
+    CHECK(!set("keypad_2", (float)board_config.keypad_thresholds[0] + 1), "azalmayan esik kabul edildi");
+    CHECK(set("keypad_2", (float)board_config.keypad_thresholds[0] - 1), "gecerli esik reddedildi");
+    CHECK(!set("yok", 1), "bilinmeyen alan");
+    c.sound_speed = 1000.0f;
+    c.keypad_thresholds[5] = c.keypad_thresholds[4];
+    erase_config();
+    write_record(0, 1, CONFIG_VERSION, sizeof(c), &c);
+    config_load();
+    config_get_status(&st);
+    CHECK(board_config.sound_speed == ULTRASONIC_SOUND_SPEED && st.dirty &&
+              memcmp(board_config.keypad_thresholds, defaults.keypad_thresholds, sizeof(thresholds)) == 0 &&
+              board_config.motor_speed == 800,
+          "bozuk alanlar duzeltilmeli, digerleri korunmali");
+
+    // Sıcaklıktan ses hızı aynı aralıkla sınırlanır
+    CHECK(ultrasonic_set_temperature(26.0f) && fabsf(board_config.sound_speed - 347.056f) < 0.01f,
+          "26 C: %.3f m/s", (double)board_config.sound_speed);
+    CHECK(!ultrasonic_set_temperature(200.0f) && !ultrasonic_set_temperature(-100.0f) &&
+              !ultrasonic_set_temperature(NAN) && fabsf(board_config.sound_speed - 347.056f) < 0.01f,
+          "aralik disi sicaklik kabul edildi: %.3f m/s", (double)board_config.sound_speed);
+    printf("%-28s tamam\n", "dogrulama");
+
+    return sim_check_summary();
+}
+
+/**
+ * @brief Görüntüdeki yapılandırmayı yükler, `ad=deger` atamalarını uygular ve kaydeder
+ */
+static int run_image(const char *path, int argc, char **argv) {
+    bool loaded = sim_flash_load(path);
+    config_load();
+    for (int i = 0; i < argc; i++) {
+        char *eq = strchr(argv[i], '=');
+        int idx = -1;
+        if (eq != NULL) {
+            *eq = '\0';
+            idx = config_find(argv[i]);
+        }
+        if (idx < 0 || !config_set((uint)idx, strtof(eq + 1, NULL))) {
+            fprintf(stderr, "gecersiz atama: %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (argc > 0 && !config_save()) {
+        fprintf(stderr, "kaydedilemedi\n");
+        return 1;
+    }
+
+    config_status_t st;
+    config_get_status(&st);
+    printf("%s: %s, surum %u, nesil %lu, sektor %c\n", path, loaded ? "yuklendi" : "yeni", st.version,
+           (unsigned long)st.seq, st.slot < 0 ? '-' : 'A' + st.slot);
+    for (uint i = 0; i < config_field_count(); i++) {
+        printf("%2u %-20s %g\n", i, config_field(i)->name, (double)config_get(i));
+    }
+    if (!sim_flash_save(path)) {
+        perror(path);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    stdio_init_all();
+    if (sim_check_selftest_arg(argc, argv)) {
+        return selftest();
+    }
+    if (argc > 2 && strcmp(argv[1], "--image") == 0) {
+        return run_image(argv[2], argc - 3, &argv[3]);
+    }
+    fprintf(stderr, "kullanim: %s --selftest | --image DOSYA [alan=deger ...]\n", argv[0]);
+    return 2;
+}
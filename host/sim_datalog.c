@@ -0,0 +1,325 @@
+/**
+ * @file sim_datalog.c
+ * @brief Flash veri kaydını (datalog.c) simüle edilen flash üzerinde sınayan araç
+ * @see \ref howto_datalog
+ *
+ * `--selftest` kartı başlatmaz; datalog_append() ile bölgenin iki katından
+ * fazla deterministik kayıt ekler ve şunları denetler:
+ * - okunan kayıtlar eklenenlerin son kısmıyla birebir aynıdır (halka sarması),
+ * - yeniden açılışta (datalog_init) yazma konumu ve kayıtlar korunur,
+ *   açılış sayacı artar,
+ * - bozulan bir sayfa yük CRC'si ile atlanır, diğerleri okunur,
+ * - görüntü dosyaya yazılıp geri yüklendiğinde aynı kayıtlar okunur,
+ * - `datalog erase` motor dönerken ertelenir, görev başına bir sektör siler,
+ *   reddedilen flash işlemi sayaçları değiştirmez ve yeniden denenir.
+ * Çıkış kodu 1 = hata.
+ *
+ * `--image` kalıcı bir görüntüyle kartı başlatır, sensörleri sanal zamanda
+ * `--seconds` boyunca kaydeder ve görüntüyü geri yazar; her çalıştırma bir
+ * açılıştır. `--dump` kaydı `datalog dump` biçiminde stdout'a yazar.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_datalog --selftest
+ * ./build-host/host/rppicods_datalog --image flash.bin --seconds 600
+ * ./build-host/host/rppicods_datalog --image flash.bin --dump > dump.bin
+ * python3 tools/datalog_export.py dump.bin > kayit.csv
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico_training_board.h"
+#include "sim.h"
+#include "sim_check.h"
+
+#define SELFTEST_ROUNDS 2.5f  // Bölge kapasitesinin kaç katı kayıt eklenir
+#define SELFTEST_IMAGE "rppicods_datalog_selftest.bin"
+
+static datalog_record_t *expected;
+static size_t expected_len;
+static size_t expected_cap;
+
+/**
+ * @brief Deterministik sözde rastgele sayı (xorshift32)
+ */
+static uint32_t rnd(void) {
+    static uint32_t x = 0x2545F491u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+/**
+ * @brief Bir kaydı ekler ve beklenen listeye yazar; görev her kayıttan sonra çalışır
+ */
+static void append(uint64_t t_ms, sensor_id_t sensor, int32_t value, uint16_t boot) {
+    CHECK(datalog_append(sensor, t_ms * 1000u, value), "kayit dustu (t=%llu)", (unsigned long long)t_ms);
+    if (expected_len == expected_cap) {
+        expected_cap = expected_cap ? expected_cap * 2 : 4096;
+        expected = realloc(expected, expected_cap * sizeof(*expected));
+        if (expected == NULL) {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    expected[expected_len++] = (datalog_record_t){t_ms, value, boot, (uint8_t)sensor};
+    datalog_task();
+}
+
+/**
+ * @brief Sensör benzeri bir seri üretir: yavaş ADC, ara sıra zaman aşımı, PIR
+ */
+static void append_series(size_t count, uint64_t *t_ms, uint16_t boot) {
+    static int32_t ldr = 2000, pot = 1000;
+    for (size_t i = 0; i < count; i++) {
+        *t_ms += 200 + rnd() % 900;
+        switch (i % 4) {
+            case 0:
+                ldr += (int32_t)(rnd() % 41) - 20;
+                append(*t_ms, SENSOR_LDR, ldr, boot);
+                break;
+            case 1:
+                pot = (rnd() % 50 == 0) ? (int32_t)(rnd() % 4096) : pot;
+                append(*t_ms, SENSOR_POT, pot, boot);
+                break;
+            case 2:
+                append(*t_ms, SENSOR_DISTANCE, rnd() % 10 == 0 ? -1 : (int32_t)(300 + rnd() % 3700), boot);
+                break;
+            default:
+                append(*t_ms, SENSOR_PIR, (int32_t)(rnd() % 8 == 0), boot);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Flash'taki kayıtları okur ve beklenen listenin son kısmıyla karşılaştırır
+ * @return size_t Okunan kayıt
+ */
+static size_t verify_tail(const char *what) {
+    datalog_cursor_t c;
+    datalog_record_t r;
+    size_t n = 0;
+
+    datalog_cursor_init(&c);
+    while (datalog_next(&c, &r)) {
+        n++;
+    }
+    CHECK(n > 0 && n <= expected_len, "%s: %zu kayit okundu", what, n);
+    if (n == 0 || n > expected_len) {
+        return n;
+    }
+
+    size_t i = expected_len - n;
+    size_t mismatches = 0;
+    datalog_cursor_init(&c);
+    while (datalog_next(&c, &r)) {
+        const datalog_record_t *e = &expected[i++];
+        if (r.timestamp_ms != e->timestamp_ms || r.value != e->value || r.sensor != e->sensor ||
+            r.boot != e->boot) {
+            if (mismatches++ == 0) {
+                printf("  %s: kayit %zu: t=%llu s=%u v=%ld b=%u, beklenen t=%llu s=%u v=%ld b=%u\n", what,
+                       i - 1, (unsigned long long)r.timestamp_ms, r.sensor, (long)r.value, r.boot,
+                       (unsigned long long)e->timestamp_ms, e->sensor, (long)e->value, e->boot);
+            }
+        }
+    }
+    CHECK(mismatches == 0, "%s: %zu kayit farkli", what, mismatches);
+    printf("%-22s %6zu kayit okundu (son kisim)\n", what, n);
+    return n;
+}
+
+/**
+ * @brief Tam silmeyi Core 1'de dönen gerçek motor döngüsüyle ve flash hatasıyla sınar
+ */
+static void check_erase_all(void) {
+    datalog_stats_t st;
+    datalog_get_stats(&st);
+    uint32_t erases = st.erases;
+    uint32_t used = st.pages_used;
+    uint32_t deferred = st.deferred;
+
+    // Motor dönerken hiçbir sektör silinmez
+    init_step_motor();
+    event_loop_init();
+    multicore_launch_core1(core1_main);
+    send_motor_parameters(CW, 100, 8.0f);
+    sim_run_for_us(1000);
+    CHECK(get_motor_state() == MOTOR_RUNNING, "motor donmuyor");
+    datalog_erase_all();
+    for (uint i = 0; i < 1000 && get_motor_state() == MOTOR_RUNNING; i++) {
+        datalog_task();
+        sim_run_for_us(DATALOG_TASK_PERIOD_MS * 1000u);
+    }
+    datalog_get_stats(&st);
+    CHECK(st.erase_pending == DATALOG_FLASH_SECTORS && st.erases == erases,
+          "motor donerken %lu sektor silindi", (unsigned long)(st.erases - erases));
+    CHECK(st.deferred > deferred, "silme ertelenmedi");
+
+    // Reddedilen silme: sayaçlar değişmez, sektör sonraki çalışmada silinir
+    sim_flash_fail_next(1);
+    datalog_task();
+    datalog_get_stats(&st);
+    CHECK(st.erase_pending == DATALOG_FLASH_SECTORS && st.erases == erases && st.pages_used == used &&
+              st.flash_errors == 1,
+          "basarisiz silme sayaclari degistirdi (bekleyen %lu, silme %lu, sayfa %lu)",
+          (unsigned long)st.erase_pending, (unsigned long)(st.erases - erases), (unsigned long)st.pages_used);
+
+    // Her görev çalışması en çok bir sektör siler
+    uint ticks = 0;
+    uint64_t longest_us = 0;
+    while (st.erase_pending > 0 && ticks < 2 * DATALOG_FLASH_SECTORS) {
+        uint64_t t0 = sim_now_us();
+        datalog_task();
+        if (sim_now_us() - t0 > longest_us) {
+            longest_us = sim_now_us() - t0;
+        }
+        sim_run_for_us(DATALOG_TASK_PERIOD_MS * 1000u);
+        datalog_get_stats(&st);
+        ticks++;
+    }
+    CHECK(ticks == DATALOG_FLASH_SECTORS, "silme %u calismada bitti", ticks);
+    CHECK(st.pages_used == 0 && st.erases == erases + DATALOG_FLASH_SECTORS,
+          "silme sonrasi %lu sayfa, %lu silme", (unsigned long)st.pages_used,
+          (unsigned long)(st.erases - erases));
+    printf("tam silme: %u gorev calismasi, en uzun %llu us\n", ticks, (unsigned long long)longest_us);
+}
+
+static int selftest(void) {
+    datalog_stats_t st;
+    uint64_t t_ms = 0;
+
+    datalog_init();
+    datalog_get_stats(&st);
+    CHECK(st.pages_used == 0 && st.boot == 0, "bos bolgede %lu sayfa", (unsigned long)st.pages_used);
+
+    // Sayfa başına ~60 kayıt: bölgeyi SELFTEST_ROUNDS kez doldur
+    size_t count = (size_t)(SELFTEST_ROUNDS * DATALOG_PAGES * (DATALOG_PAGE_PAYLOAD / 4));
+    uint64_t t0 = sim_now_us();
+    append_series(count, &t_ms, 0);
+    CHECK(datalog_sync(), "sync: bekleyen sayfa kaldi");
+    datalog_get_stats(&st);
+    printf("%zu kayit eklendi: %lu sayfa, %lu silme, sanal flash suresi %llu ms\n", count,
+           (unsigned long)st.pages_used, (unsigned long)st.erases,
+           (unsigned long long)((sim_now_us() - t0) / 1000));
+    CHECK(st.erases >= DATALOG_FLASH_SECTORS, "halka sarmadi (%lu silme)", (unsigned long)st.erases);
+    CHECK(st.pages_used >= DATALOG_PAGES - DATALOG_PAGES / DATALOG_FLASH_SECTORS,
+          "kullanilan sayfa %lu", (unsigned long)st.pages_used);
+    size_t n = verify_tail("ilk acilis");
+    printf("ortalama kayit %.2f bayt (ham sensor_sample_t: %zu)\n",
+           (double)st.pages_used * DATALOG_PAGE_PAYLOAD / (double)(n ? n : 1), sizeof(sensor_sample_t));
+
+    // Yeniden açılış: konum ve kayıtlar korunur, yeni kayıtlar yeni açılış sayacıyla eklenir
+    datalog_init();
+    datalog_get_stats(&st);
+    CHECK(st.boot == 1, "acilis sayaci %u", st.boot);
+    verify_tail("yeniden acilis");
+    append_series(1000, &t_ms, 1);
+    CHECK(datalog_sync(), "sync: bekleyen sayfa kaldi");
+    n = verify_tail("ek kayit");
+
+    // Görüntü dosyası: kaydet, bölgeyi sil, geri yükle
+    CHECK(sim_flash_save(SELFTEST_IMAGE), "goruntu yazilamadi");
+    check_erase_all();
+    datalog_cursor_t c;
+    datalog_record_t r;
+    datalog_cursor_init(&c);
+    CHECK(!datalog_next(&c, &r), "silinen bolgede kayit var");
+    CHECK(sim_flash_load(SELFTEST_IMAGE), "goruntu okunamadi");
+    remove(SELFTEST_IMAGE);
+    datalog_init();
+    CHECK(verify_tail("dosyadan yukleme") == n, "dosyadan farkli sayida kayit");
+
+    // En eski sayfanın yükü bozulur: sayfa atlanır, kalan kayıtlar yine son kısımdır
+    datalog_cursor_init(&c);
+    uint32_t oldest = c.page;
+    for (uint32_t i = 0; i < DATALOG_PAGES; i++) {
+        uint32_t page = (oldest + i) % DATALOG_PAGES;
+        uint8_t *p = &sim_flash_image[DATALOG_FLASH_OFFSET + page * FLASH_PAGE_SIZE];
+        if (((datalog_page_header_t *)p)->magic == DATALOG_MAGIC) {
+            p[sizeof(datalog_page_header_t)] ^= 0x01;
+            break;
+        }
+    }
+    size_t after = verify_tail("bozuk sayfa");
+    CHECK(after < n, "bozuk sayfa atlanmadi");
+
+    free(expected);
+    return sim_check_summary();
+}
+
+/**
+ * @brief Kalıcı görüntüyle bir açılışı sanal zamanda çalıştırır
+ */
+static int run_image(const char *path, uint32_t seconds, uint32_t period_ms, bool dump) {
+    bool loaded = sim_flash_load(path);
+    FILE *info = dump ? stderr : stdout;
+
+    init_board();  // datalog_init() dahil
+    for (uint i = SENSOR_LDR; i <= SENSOR_PIR; i++) {
+        if (i != SENSOR_KEYPAD) {
+            datalog_start((sensor_id_t)i, period_ms);
+        }
+    }
+
+    // LDR gün ışığı gibi yavaşça, potansiyometre adım adım değişir
+    for (uint64_t t = 0; t < (uint64_t)seconds * 1000u; t += DATALOG_TASK_PERIOD_MS) {
+        if (t % 1000 == 0) {
+            sim_adc_set(0, (uint16_t)(2048 + 1500 * sin((double)t / 60000.0)));
+            sim_adc_set(1, (uint16_t)((t / 15000) % 8 * 500));
+        }
+        sim_run_for_us(DATALOG_TASK_PERIOD_MS * 1000u);
+        datalog_task();
+    }
+    datalog_sync();
+
+    datalog_stats_t st;
+    datalog_get_stats(&st);
+    fprintf(info, "%s: %s, acilis %u, %lu kayit eklendi, %lu/%u sayfa, %lu silme\n", path,
+            loaded ? "yuklendi" : "yeni", st.boot, (unsigned long)st.records,
+            (unsigned long)st.pages_used, (unsigned)DATALOG_PAGES, (unsigned long)st.erases);
+    if (dump) {
+        datalog_export();
+    }
+    if (!sim_flash_save(path)) {
+        perror(path);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *image = NULL;
+    uint32_t seconds = 0;
+    uint32_t period_ms = 1000;
+    bool dump = false;
+
+    stdio_init_all();
+    if (sim_check_selftest_arg(argc, argv)) {
+        return selftest();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--image") == 0 && i + 1 < argc) {
+            image = argv[++i];
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--period") == 0 && i + 1 < argc) {
+            period_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--dump") == 0) {
+            dump = true;
+        } else {
+            image = NULL;
+            break;
+        }
+    }
+    if (image == NULL) {
+        fprintf(stderr, "kullanim: %s --selftest | --image DOSYA [--seconds N] [--period MS] [--dump]\n",
+                argv[0]);
+        return 2;
+    }
+    return run_image(image, seconds, period_ms, dump);
+}
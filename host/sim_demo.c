@@ -0,0 +1,180 @@
+/**
+ * @file sim_demo.c
+ * @brief Firmware modüllerini simüle edilen HAL üzerinde süren örnek program
+ * @see \ref howto_host_sim
+ *
+ * Kartı başlatır, LCD/buton/PIR/tuş takımı/step motor yollarını betikli girişlerle
+ * sanal zamanda çalıştırır ve her adımın sanal süresini yazar. Çıktı
+ * deterministiktir; aynı kaynakla her çalıştırmada aynı sayılar çıkar.
+ *
+ * Motor yolu firmware'in kendi core1_main() / send_motor_parameters()
+ * fonksiyonlarıyla çalışır. Core 1 flash kilidi kurbanıyken bir flash yazması
+ * ve ardından bir motor komutu yürütülür; komut tamamlanmazsa, FIFO'dan
+ * sözcük atılırsa veya flash yazması reddedilirse çıkış kodu 1'dir. PIR
+ * parazit darbesi veya sıçraması kayda geçerse, ya da ultrasonik ölçüm
+ * duraklatılıp sürdürüldükten sonra mesafe filtresi duraklama öncesi
+ * hareketten tahmin üretirse de çıkış kodu 1'dir.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pico_training_board.h"
+#include "sim.h"
+
+#define MOTOR_TIMEOUT_US 10000000u  // 2 devir @500 adım/s ~32 ms sürer
+
+static int failures;
+
+/**
+ * @brief Core 1'den tamamlanma mesajını olay döngüsüyle bekler (main.c gibi)
+ * @return bool Zaman aşımından önce CORE1_MSG_MOTOR_DONE geldiyse true
+ */
+static bool wait_motor_done(void) {
+    absolute_time_t deadline = make_timeout_time_us(MOTOR_TIMEOUT_US);
+    uint32_t msg;
+    while (!time_reached(deadline)) {
+        while (event_loop_core1_pop(&msg)) {
+            if (msg == CORE1_MSG_MOTOR_DONE) {
+                return true;
+            }
+        }
+        event_loop_poll(deadline);
+    }
+    return false;
+}
+
+/**
+ * @brief Bir adımın sanal süresini ve I2C işlem sayısını yazar
+ */
+static void report(const char *what, uint64_t start_us, uint32_t i2c_start) {
+    printf("%-24s %10llu us  i2c=%lu\n", what, (unsigned long long)(sim_now_us() - start_us),
+           (unsigned long)(sim_i2c_count() - i2c_start));
+}
+
+int main(void) {
+    stdio_init_all();
+
+    uint64_t t0 = sim_now_us();
+    uint32_t i0 = sim_i2c_count();
+    init_board();
+    report("init_board", t0, i0);
+    peripherals_print_report();
+
+    t0 = sim_now_us();
+    i0 = sim_i2c_count();
+    lcd_clear();
+    lcd_set_cursor(0, 0);
+    lcd_string("Merhaba sim");
+    report("lcd_clear + 11 karakter", t0, i0);
+
+    // OK butonuna 80 ms basılır; debounce ve kuyruk gerçek kodla çalışır
+    sim_gpio_pulse(sim_now_us() + 1000, BUTTON_OK, true, 80000);
+    sim_run_for_us(200000);
+    button_event_t bev;
+    while (button_get_event(&bev)) {
+        printf("buton gpio=%u tur=%d t=%llu us sure=%lu ms\n", bev.gpio, bev.type,
+               (unsigned long long)bev.timestamp_us, (unsigned long)bev.duration_ms);
+    }
+
+    // PIR (PIO yok, GPIO yedek yolu): 5 ms parazit kayda geçmez, sıçramalı hareket tek kenar olur
+    uint64_t t_pir = sim_now_us() + 1000;
+    sim_gpio_pulse(t_pir, PIR_DETECTOR, true, 5000);
+    for (uint i = 0; i < 6; i++) {
+        sim_gpio_schedule(t_pir + 100000 + i * 1500, PIR_DETECTOR, i % 2 == 0);
+    }
+    sim_gpio_schedule(t_pir + 110000, PIR_DETECTOR, true);
+    sim_gpio_schedule(t_pir + 400000, PIR_DETECTOR, false);
+    sim_run_for_us(600000);
+    pir_event_t pev[4];
+    uint pn = pir_history(pev, 4);
+    pir_stats_t pst;
+    pir_get_stats(&pst);
+    printf("pir: %u kenar, hareket %lu\n", pn, (unsigned long)pst.total_motion_events);
+    if (pn != 2 || !pev[1].motion || pev[0].motion || pst.total_motion_events != 1 ||
+        pev[0].timestamp_us - pev[1].timestamp_us < board_config.pir_debounce_us) {
+        printf("HATA: PIR parazit veya sicramasi kayda gecti\n");
+        failures++;
+    }
+
+    // Mesafe filtresi: yaklaşan hedef (-40 cm/s), 10 s duraklama, sürdürünce hedef 150 cm'de sabit.
+    // Duraklama öncesi hız ve medyan penceresi sürdürmede sıfırlanmalı; aksi halde ilk tahminler
+    // est_cm + est_v * 10 s'den (negatif mesafe) gelir.
+    uint64_t t_us = sim_now_us();
+    ultrasonic_sample_t us = {0};
+    for (uint i = 0; i < 40; i++) {
+        us.timestamp_us = t_us += 1000000u / ULTRASONIC_RATE_HZ;
+        us.distance_cm = 200.0f - 40.0f * (float)i / ULTRASONIC_RATE_HZ;
+        distance_filter_update(&us);
+    }
+    ultrasonic_pause(true);
+    t_us += 10000000u;
+    ultrasonic_pause(false);
+    distance_estimate_t dest;
+    bool fresh = !distance_filter_get(&dest);
+    float worst = 0.0f;
+    for (uint i = 0; i < DISTANCE_MEDIAN_LEN; i++) {
+        us.timestamp_us = t_us += 1000000u / ULTRASONIC_RATE_HZ;
+        us.distance_cm = 150.0f;
+        distance_filter_update(&us);
+        if (distance_filter_get(&dest) && fabsf(dest.distance_cm - 150.0f) > worst) {
+            worst = fabsf(dest.distance_cm - 150.0f);
+        }
+    }
+    printf("mesafe filtresi surdurme: en buyuk sapma %.1f cm\n", worst);
+    if (!fresh || worst > 1.0f) {
+        printf("HATA: mesafe filtresi duraklamadan sonra sifirlanmadi\n");
+        failures++;
+    }
+
+    // '2' tuşunun bölücü seviyesi (tuş yokken kanal 0'a yakındır); tarayıcı okuyup çözer
+    sim_adc_set(2, 1700);
+    sim_run_for_us(100000);
+    sim_adc_set(2, 0);
+    sim_run_for_us(100000);
+    keypad_event_t kev;
+    while (keypad_get_event(&kev)) {
+        printf("tus '%c' tur=%d t=%llu us\n", kev.key, kev.type,
+               (unsigned long long)kev.timestamp_us);
+    }
+
+    // Step motor Core 1'de kendi sanal saatiyle döner; Core 0 olay döngüsünde bekler
+    sysmon_init();
+    event_loop_init();
+    multicore_launch_core1(core1_main);
+    sim_run_for_us(1000);  // Core 1 kilit kurbanı olarak kaydolur
+
+    // Core 1 kurbanken flash yazması; motor komutu bundan sonra da gitmeli
+    if (!config_save()) {
+        printf("HATA: Core 1 kilit kurbaniyken flash yazilamadi\n");
+        failures++;
+    }
+    t0 = sim_now_us();
+    send_motor_parameters(CW, 500, 2.0f);
+    bool done = wait_motor_done();
+    printf("motor yaniti: %s\n", done ? "tamamlandi" : "yok");
+    if (!done) {
+        printf("HATA: motor komutu %u us icinde tamamlanmadi\n", MOTOR_TIMEOUT_US);
+        failures++;
+    }
+    if (sim_fifo_dropped(1) != 0 || sim_fifo_dropped(0) != 0) {
+        printf("HATA: kilit kesmesi FIFO sozcuklerini atti\n");
+        failures++;
+    }
+    log_flush(0);  // Core 1'in step_turn() günlük kayıtları
+    report("step_turn 2 devir", t0, sim_i2c_count());
+    if (done && !config_save()) {
+        printf("HATA: motor durduktan sonra flash yazilamadi\n");
+        failures++;
+    }
+
+    sim_pwm_state_t pwm;
+    if (sim_pwm_get(BUZZER_PIN, &pwm)) {
+        printf("buzzer pwm: %s wrap=%u clkdiv=%.2f seviye=%u %.1f Hz\n",
+               pwm.enabled ? "acik" : "kapali", pwm.wrap, pwm.clkdiv, pwm.level, pwm.freq_hz);
+    }
+    sysmon_print_report();
+    printf("toplam sanal sure: %llu us\n", (unsigned long long)sim_now_us());
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,448 @@
+/**
+ * @file sim_devices.c
+ * @brief HD44780/PCF8574, HC-SR04 ve 28BYJ-48 modelleri (zamanlama denetimli)
+ * @see \ref howto_host_sim
+ *
+ * Modeller simülasyonun dinleyici noktalarına bağlanır:
+ * - LCD: LCD_ADDR'e giden her I2C baytı PCF8574 çıkışlarına yazılır
+ *   (P0 RS, P1 RW, P2 E, P3 arka ışık, P4-P7 D4-D7). E'nin düşen kenarında
+ *   yarım bayt okunur; komut yürütülürken (meşgul) gelen E darbesi ihlaldir.
+ * - HC-SR04: ULTRA_SONIC_TR'nin düşen kenarı, SIM_HCSR04_BURST_US sonra
+ *   ULTRA_SONIC_EC üzerinde mesafeye karşılık gelen yankı darbesi planlar.
+ * - 28BYJ-48: dört bobin pininin aynı andaki değişimleri tek desen sayılır;
+ *   her desen bir öncekinin komşu yarım adımı olmalı ve en az
+ *   SIM_STEPPER_MIN_STEP_US sürmelidir.
+ *
+ * Modeller hangi çekirdekten sürülürse sürülsün tek kilitle korunur.
+ */
+
+#include "sim_devices.h"
+#include "pico_training_board.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PCF_RS 0x01
+#define PCF_E 0x04
+#define PCF_BUS 0xF3   // RS, RW ve D4-D7: E kenarında kararlı olması gereken bitler
+#define LCD_DDRAM_SIZE 0x80
+
+/**
+ * @brief HD44780 + PCF8574 durumu
+ */
+typedef struct {
+    uint8_t pins;              ///< PCF8574 çıkışları
+    uint64_t enable_rise_ns;   ///< E'nin son yükselişi
+    uint64_t busy_until_ns;    ///< Yürütülen komutun bitişi
+    bool started;              ///< İlk E darbesi görüldü mü
+    bool four_bit;             ///< 4 bit arayüze geçildi mi
+    bool have_high;            ///< 4 bitte üst yarım bayt alındı
+    uint8_t high;              ///< Alınan üst yarım bayt
+    uint8_t init_sets;         ///< 8 bit modda alınan function set sayısı
+    uint8_t addr;              ///< DDRAM adres sayacı
+    bool decrement;            ///< Entry mode: adres azalır
+    char ddram[LCD_DDRAM_SIZE];
+} lcd_model_t;
+
+/**
+ * @brief HC-SR04 durumu
+ */
+typedef struct {
+    float distance_cm;         ///< Hedef mesafesi (< 0: hedef yok)
+    uint64_t rise_us;          ///< TRIG'in son yükselişi
+    bool pinged;               ///< En az bir ölçüm yapıldı
+    uint64_t last_ping_us;     ///< Son kabul edilen tetikleme
+    uint64_t echo_end_us;      ///< Planlanan yankının bitişi
+} hcsr04_model_t;
+
+/**
+ * @brief 28BYJ-48 durumu
+ */
+typedef struct {
+    uint8_t pattern;           ///< Oturmuş bobin deseni (bit0 A1 ... bit3 B2)
+    uint64_t since_us;         ///< Desenin başladığı an
+    bool has_pending;          ///< Aynı anda gelen değişimler birikiyor
+    uint8_t pending;           ///< Biriken desen
+    uint64_t pending_us;       ///< Biriken değişimlerin zamanı
+    int32_t position;          ///< Yarım adım konumu (CW pozitif)
+} stepper_model_t;
+
+static const uint8_t half_step_patterns[8] = {0x1, 0x3, 0x2, 0x6, 0x4, 0xC, 0x8, 0x9};
+static const uint coil_pins[4] = {STEP_MOTOR_A1, STEP_MOTOR_A2, STEP_MOTOR_B1, STEP_MOTOR_B2};
+
+static pthread_mutex_t dev_lock = PTHREAD_MUTEX_INITIALIZER;
+static lcd_model_t lcd;
+static hcsr04_model_t hcsr04 = {.distance_cm = 100.0f};
+static stepper_model_t stepper;
+static sim_device_counters_t counters;
+static sim_violation_t violations[SIM_VIOLATION_LOG_LEN];
+static uint32_t violation_total;
+
+/**
+ * @brief Bir ihlali kaydeder (kilit tutulurken)
+ */
+static void violation(uint64_t t_us, const char *device, const char *fmt, ...) {
+    if (violation_total < SIM_VIOLATION_LOG_LEN) {
+        sim_violation_t *v = &violations[violation_total];
+        v->timestamp_us = t_us;
+        v->device = device;
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(v->message, sizeof(v->message), fmt, ap);
+        va_end(ap);
+    }
+    violation_total++;
+}
+
+/* ---------------------------------------------------------------------------
+ * HD44780 (PCF8574 üzerinden)
+ * ------------------------------------------------------------------------- */
+
+static void lcd_reset(void) {
+    memset(&lcd, 0, sizeof(lcd));
+    memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+}
+
+/**
+ * @brief Adres sayacını 2 satır düzenine göre ilerletir (0x00-0x27, 0x40-0x67)
+ */
+static void lcd_step_address(void) {
+    if (lcd.decrement) {
+        lcd.addr = lcd.addr == 0x00 ? 0x67 : (lcd.addr == 0x40 ? 0x27 : lcd.addr - 1);
+    } else {
+        lcd.addr = lcd.addr == 0x27 ? 0x40 : (lcd.addr == 0x67 ? 0x00 : lcd.addr + 1);
+    }
+}
+
+/**
+ * @brief Tam bir komut veya veri baytını yürütür
+ */
+static void lcd_execute(bool rs, uint8_t v, uint64_t t_ns) {
+    uint32_t exec_us = SIM_LCD_EXEC_US;
+    if (rs) {
+        lcd.ddram[lcd.addr & (LCD_DDRAM_SIZE - 1)] = (char)v;
+        lcd_step_address();
+    } else if (v & 0x80) {
+        lcd.addr = v & 0x7F;
+    } else if (v & 0x20) {
+        bool eight_bit = (v & 0x10) != 0;
+        if (!lcd.four_bit && eight_bit) {
+            // Komutla başlatma: ilk iki 8 bit function set'ten sonra uzun bekleme gerekir
+            lcd.init_sets++;
+            exec_us = lcd.init_sets == 1 ? SIM_LCD_INIT_FIRST_US
+                    : lcd.init_sets == 2 ? SIM_LCD_INIT_SECOND_US : SIM_LCD_EXEC_US;
+        }
+        lcd.four_bit = !eight_bit;
+        lcd.have_high = false;
+    } else if ((v & 0xFC) == 0x04) {
+        lcd.decrement = !(v & 0x02);
+    } else if ((v & 0xFE) == 0x02) {
+        lcd.addr = 0;
+        exec_us = SIM_LCD_HOME_US;
+    } else if (v == 0x01) {
+        memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+        lcd.addr = 0;
+        lcd.decrement = false;
+        exec_us = SIM_LCD_HOME_US;
+    }
+    // Ekran/imleç kontrolü, kaydırma ve CGRAM adresi yalnızca süre tüketir
+    lcd.busy_until_ns = t_ns + exec_us * 1000ull;
+    counters.lcd_commands++;
+    counters.lcd_required_us += exec_us;
+}
+
+/**
+ * @brief E'nin düşen kenarında veri yolundaki yarım baytı okur
+ */
+static void lcd_latch(uint8_t bus, uint64_t t_ns) {
+    bool rs = (bus & PCF_RS) != 0;
+    uint8_t nibble = bus >> 4;
+    if (!lcd.four_bit) {
+        lcd_execute(rs, (uint8_t)(nibble << 4), t_ns);
+    } else if (!lcd.have_high) {
+        lcd.high = nibble;
+        lcd.have_high = true;
+    } else {
+        lcd.have_high = false;
+        lcd_execute(rs, (uint8_t)((lcd.high << 4) | nibble), t_ns);
+    }
+}
+
+/**
+ * @brief PCF8574 çıkışları değiştiğinde E kenarlarını ve zamanlamayı denetler
+ */
+static void lcd_pins(uint8_t value, uint64_t t_ns) {
+    uint8_t old = lcd.pins;
+    lcd.pins = value;
+    bool bus_changed = ((old ^ value) & PCF_BUS) != 0;
+    uint64_t t_us = t_ns / 1000u;
+
+    if (!(old & PCF_E) && (value & PCF_E)) {
+        if (!lcd.started) {
+            lcd.started = true;
+            if (t_us < SIM_LCD_POWER_ON_US) {
+                violation(t_us, "lcd", "ilk komut guc acilisindan %llu us sonra (en az %u)",
+                          (unsigned long long)t_us, SIM_LCD_POWER_ON_US);
+            }
+        }
+        if (bus_changed) {
+            violation(t_us, "lcd", "RS/veri E ile ayni anda degisti (kurulum suresi yok)");
+        }
+        if (t_ns < lcd.busy_until_ns) {
+            violation(t_us, "lcd", "mesgulken yazma: %llu us erken",
+                      (unsigned long long)((lcd.busy_until_ns - t_ns + 999u) / 1000u));
+        }
+        lcd.enable_rise_ns = t_ns;
+    } else if ((old & PCF_E) && !(value & PCF_E)) {
+        if (t_ns - lcd.enable_rise_ns < SIM_LCD_ENABLE_MIN_NS) {
+            violation(t_us, "lcd", "E darbesi %llu ns (en az %u)",
+                      (unsigned long long)(t_ns - lcd.enable_rise_ns), SIM_LCD_ENABLE_MIN_NS);
+        }
+        if (bus_changed) {
+            violation(t_us, "lcd", "veri E ile ayni anda degisti (tutma suresi yok)");
+        }
+        lcd_latch(old, t_ns);
+    }
+}
+
+/**
+ * @brief I2C dinleyicisi: LCD adresine yazılan baytları sırayla çıkışlara uygular
+ */
+static void devices_i2c(const sim_i2c_record_t *r) {
+    if (r->addr != LCD_ADDR || r->len == 0) {
+        return;
+    }
+    uint n = r->len < SIM_I2C_MAX_DATA ? r->len : SIM_I2C_MAX_DATA;
+    pthread_mutex_lock(&dev_lock);
+    for (uint i = 0; i < n; i++) {
+        // Her bayt kendi ACK'inde çıkışa yansır
+        uint64_t t_ns = r->timestamp_us * 1000u + (uint64_t)r->duration_ns * (i + 1u) / r->len;
+        lcd_pins(r->data[i], t_ns);
+    }
+    pthread_mutex_unlock(&dev_lock);
+}
+
+/* ---------------------------------------------------------------------------
+ * HC-SR04
+ * ------------------------------------------------------------------------- */
+
+static void hcsr04_trigger(bool level, uint64_t t_us) {
+    if (level) {
+        hcsr04.rise_us = t_us;
+        return;
+    }
+    uint64_t width = t_us - hcsr04.rise_us;
+    if (width < SIM_HCSR04_TRIGGER_MIN_US) {
+        violation(t_us, "hcsr04", "TRIG darbesi %llu us (en az %u); yok sayildi",
+                  (unsigned long long)width, SIM_HCSR04_TRIGGER_MIN_US);
+        return;
+    }
+    if (t_us < hcsr04.echo_end_us) {
+        violation(t_us, "hcsr04", "yanki surerken tetikleme; yok sayildi");
+        return;
+    }
+    if (hcsr04.pinged && t_us - hcsr04.last_ping_us < SIM_HCSR04_CYCLE_US) {
+        violation(t_us, "hcsr04", "olcum araligi %llu us (en az %u): onceki yanki karisabilir",
+                  (unsigned long long)(t_us - hcsr04.last_ping_us), SIM_HCSR04_CYCLE_US);
+    }
+
+    uint64_t echo_us = hcsr04.distance_cm < 0.0f
+                           ? SIM_HCSR04_NO_ECHO_US
+                           : (uint64_t)(hcsr04.distance_cm * SIM_HCSR04_US_PER_CM + 0.5f);
+    uint64_t start_us = t_us + SIM_HCSR04_BURST_US;
+    sim_gpio_pulse(start_us, ULTRA_SONIC_EC, true, echo_us);
+    hcsr04.echo_end_us = start_us + echo_us;
+    hcsr04.pinged = true;
+    hcsr04.last_ping_us = t_us;
+    counters.pings++;
+    counters.ping_required_us += width + SIM_HCSR04_BURST_US + echo_us;
+}
+
+/* ---------------------------------------------------------------------------
+ * 28BYJ-48
+ * ------------------------------------------------------------------------- */
+
+static int phase_index(uint8_t pattern) {
+    for (int i = 0; i < 8; i++) {
+        if (half_step_patterns[i] == pattern) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Biriken bobin desenini oturtur ve adımı denetler
+ */
+static void stepper_commit(void) {
+    if (!stepper.has_pending) {
+        return;
+    }
+    stepper.has_pending = false;
+    uint8_t next = stepper.pending;
+    uint64_t t_us = stepper.pending_us;
+    if (next == stepper.pattern) {
+        return;
+    }
+
+    int from = phase_index(stepper.pattern);
+    int to = phase_index(next);
+    if (next != 0 && to < 0) {
+        violation(t_us, "stepper", "gecersiz bobin deseni 0x%X", next);
+    } else if (from >= 0 && to >= 0) {
+        int diff = (to - from + 8) % 8;
+        uint64_t held = t_us - stepper.since_us;
+        if (diff != 1 && diff != 7) {
+            violation(t_us, "stepper", "faz atlandi (%d -> %d)", from, to);
+        } else {
+            if (held < SIM_STEPPER_MIN_STEP_US) {
+                violation(t_us, "stepper", "yarim adim %llu us (en az %u): rotor adim kacirir",
+                          (unsigned long long)held, SIM_STEPPER_MIN_STEP_US);
+            }
+            stepper.position += diff == 1 ? 1 : -1;
+            counters.steps++;
+            counters.step_required_us += SIM_STEPPER_MIN_STEP_US;
+        }
+    }
+    stepper.pattern = next;
+    stepper.since_us = t_us;
+}
+
+static void stepper_coil(uint coil, bool level, uint64_t t_us) {
+    if (stepper.has_pending && t_us != stepper.pending_us) {
+        stepper_commit();
+    }
+    if (!stepper.has_pending) {
+        stepper.pending = stepper.pattern;
+        stepper.has_pending = true;
+    }
+    stepper.pending_us = t_us;
+    stepper.pending = level ? (uint8_t)(stepper.pending | (1u << coil))
+                            : (uint8_t)(stepper.pending & ~(1u << coil));
+}
+
+/**
+ * @brief GPIO dinleyicisi: çıkış pinlerini ilgili modele yönlendirir
+ */
+static void devices_gpio(uint gpio, bool level, uint64_t t_us) {
+    pthread_mutex_lock(&dev_lock);
+    if (gpio == ULTRA_SONIC_TR) {
+        hcsr04_trigger(level, t_us);
+    }
+    for (uint i = 0; i < 4; i++) {
+        if (gpio == coil_pins[i]) {
+            stepper_coil(i, level, t_us);
+        }
+    }
+    pthread_mutex_unlock(&dev_lock);
+}
+
+/* ---------------------------------------------------------------------------
+ * Genel API
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Modelleri sıfırlar ve simülasyonun dinleyici noktalarına bağlar
+ *
+ * `init_board()`'dan önce çağrılmalıdır; aksi halde LCD başlatma dizisi
+ * kaçırılır ve model 8 bit modda kalır.
+ */
+void sim_devices_attach(void) {
+    pthread_mutex_lock(&dev_lock);
+    lcd_reset();
+    float distance = hcsr04.distance_cm;
+    memset(&hcsr04, 0, sizeof(hcsr04));
+    hcsr04.distance_cm = distance;
+    memset(&stepper, 0, sizeof(stepper));
+    memset(&counters, 0, sizeof(counters));
+    violation_total = 0;
+    pthread_mutex_unlock(&dev_lock);
+    sim_i2c_set_listener(devices_i2c);
+    sim_gpio_set_listener(devices_gpio);
+}
+
+/**
+ * @brief Bekleyen (aynı anda gelmiş) bobin değişimlerini oturtur
+ *
+ * Bir işlemin sonunda sayaçlar okunmadan önce çağrılır.
+ */
+void sim_devices_flush(void) {
+    pthread_mutex_lock(&dev_lock);
+    stepper_commit();
+    pthread_mutex_unlock(&dev_lock);
+}
+
+/**
+ * @brief Model sayaçlarını kopyalar (işlem öncesi/sonrası farkı için)
+ * @param out Hedef
+ */
+void sim_devices_counters(sim_device_counters_t *out) {
+    pthread_mutex_lock(&dev_lock);
+    *out = counters;
+    pthread_mutex_unlock(&dev_lock);
+}
+
+/**
+ * @brief Toplam ihlal sayısı (kayda sığmayanlar dahil)
+ */
+uint32_t sim_violation_count(void) {
+    pthread_mutex_lock(&dev_lock);
+    uint32_t n = violation_total;
+    pthread_mutex_unlock(&dev_lock);
+    return n;
+}
+
+/**
+ * @brief Kaydedilen bir ihlali okur
+ * @param index 0 en eski
+ * @param out Hedef
+ * @return bool Kayıt varsa true
+ */
+bool sim_violation_get(uint32_t index, sim_violation_t *out) {
+    pthread_mutex_lock(&dev_lock);
+    bool ok = index < violation_total && index < SIM_VIOLATION_LOG_LEN;
+    if (ok) {
+        *out = violations[index];
+    }
+    pthread_mutex_unlock(&dev_lock);
+    return ok;
+}
+
+/**
+ * @brief LCD'de görünen satırı döndürür (ilk 16 sütun)
+ * @param line 0 veya 1
+ * @param out Hedef
+ * @param len Hedef boyutu (en az 17 önerilir)
+ */
+void sim_lcd_get_line(uint line, char *out, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    size_t n = len - 1 < 16 ? len - 1 : 16;
+    pthread_mutex_lock(&dev_lock);
+    memcpy(out, &lcd.ddram[line ? 0x40 : 0x00], n);
+    pthread_mutex_unlock(&dev_lock);
+    out[n] = '\0';
+}
+
+/**
+ * @brief HC-SR04'ün göreceği hedef mesafesini ayarlar
+ * @param cm Mesafe; negatifse hedef yok (SIM_HCSR04_NO_ECHO_US yankı)
+ */
+void sim_hcsr04_set_distance(float cm) {
+    pthread_mutex_lock(&dev_lock);
+    hcsr04.distance_cm = cm;
+    pthread_mutex_unlock(&dev_lock);
+}
+
+/**
+ * @brief Motorun yarım adım konumu (SIM_STEPPER_HALF_STEPS_REV = bir çıkış turu)
+ */
+int32_t sim_stepper_position(void) {
+    pthread_mutex_lock(&dev_lock);
+    int32_t p = stepper.position;
+    pthread_mutex_unlock(&dev_lock);
+    return p;
+}
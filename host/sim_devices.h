@@ -0,0 +1,81 @@
+/**
+ * @file sim_devices.h
+ * @brief Simülasyonda karta bağlı cihaz modelleri ve zamanlama denetimi
+ * @see \ref howto_host_sim
+ *
+ * Modeller firmware'in ürettiği pin ve I2C trafiğini sanal zamanda dinler,
+ * cihazın veri sayfasındaki zamanlama kurallarını denetler ve ihlalleri kaydeder:
+ * - HD44780 LCD (PCF8574 I2C genişletici üzerinden, 4 bit arayüz)
+ * - HC-SR04 ultrasonik sensör (TRIG darbesine yankı darbesi üretir)
+ * - 28BYJ-48 step motor (ULN2003 üzerinden dört bobin, yarım adım)
+ *
+ * Her model ayrıca cihazın gerçekten ihtiyaç duyduğu süreyi ("gereken")
+ * toplar; firmware'in harcadığı sanal süreyle karşılaştırılınca sabit
+ * beklemelerin payı görülür.
+ */
+
+#ifndef SIM_DEVICES_H
+#define SIM_DEVICES_H
+
+#include "sim.h"
+
+/**
+ * @defgroup sim_devices Cihaz Modeli Ayarları
+ * @{
+ */
+#define SIM_VIOLATION_LOG_LEN 64         /**< Saklanan ihlal kaydı sayısı (sonrakiler yalnızca sayılır) */
+#define SIM_VIOLATION_MSG_LEN 96         /**< İhlal mesajı uzunluğu */
+
+#define SIM_LCD_POWER_ON_US 40000u       /**< Vcc sonrası ilk komuta kadar en az süre */
+#define SIM_LCD_INIT_FIRST_US 4100u      /**< İlk 8 bit function set sonrası bekleme */
+#define SIM_LCD_INIT_SECOND_US 100u      /**< İkinci 8 bit function set sonrası bekleme */
+#define SIM_LCD_EXEC_US 37u              /**< Komut/veri yürütme süresi (fosc = 270 kHz) */
+#define SIM_LCD_HOME_US 1520u            /**< Clear display ve return home yürütme süresi */
+#define SIM_LCD_ENABLE_MIN_NS 450u       /**< E darbe genişliği (PWEH) */
+
+#define SIM_HCSR04_TRIGGER_MIN_US 10u    /**< TRIG darbesinin en kısa genişliği */
+#define SIM_HCSR04_BURST_US 250u         /**< TRIG düşüşünden yankı başlangıcına (8 x 40 kHz patlama) */
+#define SIM_HCSR04_CYCLE_US 60000u       /**< Önerilen en kısa ölçüm aralığı */
+#define SIM_HCSR04_NO_ECHO_US 38000u     /**< Hedef yokken yankı darbesi genişliği */
+#define SIM_HCSR04_US_PER_CM 58.3f       /**< Gidiş-dönüş süresi (343 m/s, 20 °C) */
+
+#define SIM_STEPPER_MIN_STEP_US 1000u    /**< Rotorun takip edebildiği en kısa yarım adım süresi */
+#define SIM_STEPPER_HALF_STEPS_REV 4096  /**< Çıkış milinin bir turu (64:1 dişli, yarım adım) */
+/** @} */
+
+/**
+ * @brief Kaydedilen tek bir zamanlama/protokol ihlali
+ */
+typedef struct {
+    uint64_t timestamp_us;                 /**< İhlal anı */
+    const char *device;                    /**< "lcd", "hcsr04" veya "stepper" */
+    char message[SIM_VIOLATION_MSG_LEN];   /**< Açıklama */
+} sim_violation_t;
+
+/**
+ * @brief Bir modelin işlem sayaçları (sim_devices_counters() ile okunur)
+ */
+typedef struct {
+    uint32_t lcd_commands;     /**< Yürütülen LCD komutu/veri yazması */
+    uint64_t lcd_required_us;  /**< LCD'nin yürütmeye harcadığı süre */
+    uint32_t pings;            /**< Kabul edilen HC-SR04 tetiklemesi */
+    uint64_t ping_required_us; /**< Tetikleme + patlama + yankı süresi */
+    uint32_t steps;            /**< Geçerli yarım adım sayısı */
+    uint64_t step_required_us; /**< Adım sayısı x SIM_STEPPER_MIN_STEP_US */
+} sim_device_counters_t;
+
+// Kurulum
+void sim_devices_attach(void);
+void sim_devices_flush(void);
+void sim_devices_counters(sim_device_counters_t *out);
+
+// İhlal kaydı
+uint32_t sim_violation_count(void);
+bool sim_violation_get(uint32_t index, sim_violation_t *out);
+
+// Model durumları
+void sim_lcd_get_line(uint line, char *out, size_t len);
+void sim_hcsr04_set_distance(float cm);
+int32_t sim_stepper_position(void);
+
+#endif // SIM_DEVICES_H
@@ -0,0 +1,89 @@
+/**
+ * @file sim_filter.c
+ * @brief Analog filtre zincirlerinin (analog_filter.c) frekans yanıtını ölçen araç
+ * @see \ref howto_analog_filter
+ *
+ * Her kanala `ADC_STREAM_RATE_HZ` hızında 1, 10 ve 100 Hz sinüs örnekleri
+ * analog_filter_feed() ile verilir; oturma süresinden sonra çıkışın tepe-tepe
+ * genliği girişinkiyle karşılaştırılır ve zayıflama dB olarak yazılır.
+ * `--selftest` varsayılan zincirler için sınırları denetler:
+ * - POT_1: 1 Hz neredeyse geçer, 10 Hz ve 100 Hz belgelenen aralıkta zayıflar,
+ * - LDR_1: 100 Hz POT_1'den daha çok zayıflar,
+ * - KEYPAD: EMA olmadığı için 10 Hz neredeyse geçer.
+ * Çıkış kodu 1 = hata. Argümansız çalıştırıldığında yalnızca tabloyu yazar.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_filter --selftest
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "pico_training_board.h"
+#include "sim_check.h"
+
+#define SINE_MID 2048.0
+#define SINE_AMPLITUDE 1000.0
+
+static const char *const channel_names[ADC_STREAM_CHANNELS] = {"LDR_1", "POT_1", "KEYPAD"};
+static const double test_freqs[] = {1.0, 10.0, 100.0};
+#define FREQ_COUNT (sizeof(test_freqs) / sizeof(test_freqs[0]))
+
+/**
+ * @brief Bir kanala sinüs verir ve çıkış genliğinin girişe oranını dB olarak döndürür
+ */
+static double measure_gain_db(uint8_t channel, double freq_hz) {
+    // Zincir durumunu sıfırla (zamanlayıcı hemen durdurulur; örnekler yalnızca feed ile gelir)
+    analog_filter_start();
+    analog_filter_stop();
+
+    double period_s = 1.0 / freq_hz;
+    uint32_t settle = (uint32_t)(fmax(1.0, 5.0 * period_s) * ADC_STREAM_RATE_HZ);
+    uint32_t window = (uint32_t)(fmax(1.0, 5.0 * period_s) * ADC_STREAM_RATE_HZ);
+    uint16_t lo = UINT16_MAX;
+    uint16_t hi = 0;
+
+    for (uint32_t n = 0; n < settle + window; n++) {
+        double t = (double)n / ADC_STREAM_RATE_HZ;
+        uint16_t x = (uint16_t)lround(SINE_MID + SINE_AMPLITUDE * sin(2.0 * M_PI * freq_hz * t));
+        analog_filter_feed(channel, &x, 1);
+        if (n >= settle) {
+            uint16_t y = analog_filter_get(channel);
+            if (y < lo) lo = y;
+            if (y > hi) hi = y;
+        }
+    }
+    double out = (double)(hi - lo) / 2.0;
+    return out > 0.0 ? 20.0 * log10(out / SINE_AMPLITUDE) : -120.0;
+}
+
+int main(int argc, char **argv) {
+    stdio_init_all();
+    double gain[ADC_STREAM_CHANNELS][FREQ_COUNT];
+
+    printf("%-8s", "kanal");
+    for (uint f = 0; f < FREQ_COUNT; f++) {
+        printf("  %6.0f Hz", test_freqs[f]);
+    }
+    printf("\n");
+    for (uint8_t ch = 0; ch < ADC_STREAM_CHANNELS; ch++) {
+        printf("%-8s", channel_names[ch]);
+        for (uint f = 0; f < FREQ_COUNT; f++) {
+            gain[ch][f] = measure_gain_db(ch, test_freqs[f]);
+            printf("  %6.1f dB", gain[ch][f]);
+        }
+        printf("\n");
+    }
+
+    if (!sim_check_selftest_arg(argc, argv)) {
+        return 0;
+    }
+    // Sınırlar docs/howto/analog_filter.md'deki değerlerle aynıdır
+    CHECK(gain[1][0] > -0.5, "POT_1 1 Hz: %.1f dB", gain[1][0]);
+    CHECK(gain[1][1] > -3.0 && gain[1][1] < -1.0, "POT_1 10 Hz: %.1f dB", gain[1][1]);
+    CHECK(gain[1][2] > -22.0 && gain[1][2] < -19.0, "POT_1 100 Hz: %.1f dB", gain[1][2]);
+    CHECK(gain[0][2] < gain[1][2], "LDR_1 100 Hz POT_1'den az zayifliyor: %.1f dB", gain[0][2]);
+    CHECK(gain[2][1] > -0.5, "KEYPAD 10 Hz: %.1f dB", gain[2][1]);
+    return sim_check_summary();
+}
@@ -0,0 +1,1786 @@
+/**
+ * @file sim_hal.c
+ * @brief Pico SDK alt kümesinin sanal saatli bilgisayar uygulaması
+ * @see \ref howto_host_sim
+ *
+ * Zaman modeli:
+ * - Her çekirdeğin kendi sanal saati (ns) vardır; `sleep_*`, `busy_wait_us`,
+ *   `adc_read`, I2C yazmaları ve flash işlemleri saati süreleri kadar ilerletir.
+ *   `time_us_64()` her okumada SIM_TIME_READ_COST_NS ekler, böylece bekleme
+ *   döngüleri de ilerler.
+ * - Core 1, `multicore_launch_core1()` ile açılan ayrı bir iş parçacığıdır.
+ *   Çekirdekler adım kilitlidir: bir çekirdek saatini yalnızca diğeri (FIFO'da
+ *   veya kuyrukta bloklu değilse) aynı ana yetiştiğinde ilerletir. FIFO ve
+ *   `queue_t` elemanları gönderenin zaman damgasını taşır. Diğer çekirdeğin
+ *   `__sev()`'i `__wfe` / `best_effort_wfe_or_timeout()` uykusunu bitirir.
+ * - `flash_safe_execute_core_init()` çağıran çekirdek kilit kurbanı olur:
+ *   SDK'nın kilit kesmesi gibi ona FIFO'dan gelen sözcükler atılır. Core 1
+ *   çalışırken kurban değilse `flash_safe_execute()` reddedilir.
+ *   `sim_flash_fail_next()` sonraki çağrıları zaman aşımıyla reddettirir.
+ * - Alarmlar, tekrarlı zamanlayıcılar, betikli GPIO/ADC değişimleri ve kesme
+ *   işleyicileri Core 0 iş parçacığında, saat ilgili ana geldiğinde çalışır.
+ *   `save_and_disable_interrupts()` açıkken ertelenir.
+ *
+ * PIO ve DMA kaynağı yoktur; modüller yazılım yollarını (GPIO kesmesi,
+ * bloklu ADC okuma, UART kesmesi) kullanır.
+ *
+ * UART'lar bayt başına 10 bit süresiyle modellenir: alma hattı
+ * `sim_uart_inject()` veya bir pty'den beslenir, gönderilen baytlar
+ * dinleyiciye ve (açıksa) pty'ye gider.
+ */
+
+#define _GNU_SOURCE  // posix_openpt, ptsname_r
+
+#include "sim.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define CLK_SYS_HZ 125000000u
+#define FIFO_DEPTH 8
+#define IRQ_COUNT 32
+#define MAX_RAW_HANDLERS 8
+#define END_NS UINT64_MAX
+#define FLASH_ERASE_NS 45000000u   // 4 KB sektör silme (tipik)
+#define FLASH_PROGRAM_NS 700000u   // 256 B sayfa programlama (tipik)
+#define SIM_LOCKOUT_MAGIC_START 0x73a8831eu  // pico_multicore kilit el sıkışması
+#define SIM_LOCKOUT_MAGIC_END (~SIM_LOCKOUT_MAGIC_START)
+
+/**
+ * @brief Zamanlı olay türleri
+ */
+typedef enum {
+    EV_FREE,   ///< Boş yuva
+    EV_ALARM,  ///< add_alarm_*()
+    EV_TIMER,  ///< add_repeating_timer_*()
+    EV_GPIO,   ///< Betikli giriş seviyesi
+    EV_ADC,    ///< Betikli ADC değeri
+    EV_UART_RX, ///< Alma hattından bir baytın FIFO'ya oturması
+    EV_UART_TX  ///< TX FIFO'nun kesme eşiğine inmesi
+} ev_kind_t;
+
+/**
+ * @brief Zamanlı olay yuvası
+ */
+typedef struct {
+    ev_kind_t kind;
+    uint64_t at_ns;          ///< Olayın zamanı
+    uint64_t seq;            ///< Aynı andaki olaylar için ekleme sırası
+    alarm_id_t id;           ///< Alarm kimliği (EV_ALARM / EV_TIMER)
+    alarm_callback_t alarm;  ///< EV_ALARM geri çağrısı
+    repeating_timer_t *rt;   ///< EV_TIMER yapısı
+    void *user_data;
+    uint8_t target;          ///< GPIO pini veya ADC kanalı
+    uint16_t value;          ///< GPIO seviyesi veya ADC değeri
+} sim_event_t;
+
+/**
+ * @brief Bir GPIO pininin durumu
+ */
+typedef struct {
+    bool out;                 ///< Çıkış mı
+    bool out_level;           ///< Çıkış seviyesi
+    bool driven;              ///< Giriş betikle sürülüyor mu
+    bool in_level;            ///< Betikli giriş seviyesi
+    bool pull_up;
+    bool pull_down;
+    enum gpio_function fn;
+    uint32_t irq_mask;        ///< Açık kesme olayları
+    uint32_t irq_events;      ///< Onaylanmamış kenar olayları
+} sim_pin_t;
+
+/**
+ * @brief Bir çekirdekten diğerine giden FIFO
+ */
+typedef struct {
+    uint32_t data[FIFO_DEPTH];
+    uint64_t at_ns[FIFO_DEPTH];
+    uint head;
+    uint count;
+} sim_fifo_t;
+
+/**
+ * @brief Bir PWM diliminin durumu
+ */
+typedef struct {
+    bool enabled;
+    uint16_t wrap;
+    float clkdiv;
+    uint16_t level[2];
+} sim_slice_t;
+
+struct i2c_inst {
+    uint baudrate;
+};
+struct pio_hw {
+    int unused;
+};
+
+/**
+ * @brief Bir UART'ın durumu
+ */
+struct uart_inst {
+    uint index;
+    uint baudrate;
+    bool rx_irq;                        ///< RX (ve zaman aşımı) kesmesi açık
+    bool tx_irq;                        ///< TX kesmesi açık
+    bool tx_event;                      ///< EV_UART_TX planlı
+    uint8_t rx_fifo[UART_FIFO_DEPTH];
+    uint rx_head;
+    uint rx_count;
+    uint8_t line[SIM_UART_LINE_LEN];    ///< Hatta gelmeyi bekleyen baytlar
+    uint line_head;
+    uint line_count;
+    bool line_event;                    ///< EV_UART_RX planlı
+    uint64_t tx_free_ns;                ///< Son gönderilen baytın hattan çıktığı an
+    uint32_t rx_overruns;               ///< FIFO doluyken gelen bayt
+    int pty_fd;                         ///< pty ana ucu (-1: yok)
+    uart_hw_t regs;
+};
+
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+static __thread uint this_core = 0;
+static __thread bool irqs_off = false;
+
+static uint64_t core_ns[2];
+static bool core_active[2] = {true, false};
+static bool sev_flag[2];
+static uint64_t sev_ns[2];       // Diğer çekirdekten gelen son SEV'in zamanı
+static bool wfe_waiting[2];      // Çekirdek WFE uykusunda (SEV uyandırır)
+static bool lockout_victim[2];   // flash_safe_execute_core_init() çağrıldı
+static uint32_t fifo_dropped[2]; // Kilit kesmesinin attığı FIFO sözcükleri
+static bool core1_launched;
+static uint32_t flash_fail_count;  // sim_flash_fail_next(): reddedilecek flash_safe_execute() çağrısı
+static uint32_t time_read_cost_ns = SIM_TIME_READ_COST_NS;
+
+static sim_event_t events[SIM_MAX_EVENTS];
+static uint64_t event_seq = 0;
+static alarm_id_t next_alarm_id = 1;
+static repeating_timer_t *firing_timer = NULL;
+static bool firing_timer_cancelled = false;
+
+static irq_handler_t irq_handlers[IRQ_COUNT];
+static bool irq_enabled[IRQ_COUNT];
+static uint32_t irq_pending = 0;
+static uint64_t irq_pending_ns = 0;  // En erken bekleyen kesmenin zamanı (Core 1'den)
+
+static sim_pin_t pins[SIM_GPIO_COUNT];
+static gpio_irq_callback_t gpio_callback = NULL;
+static struct {
+    uint32_t mask;
+    irq_handler_t handler;
+} raw_handlers[MAX_RAW_HANDLERS];
+static uint raw_handler_count = 0;
+static sim_gpio_listener_t gpio_listener = NULL;
+
+static uint16_t adc_values[SIM_ADC_CHANNELS];
+static uint adc_channel = 0;
+
+static sim_slice_t slices[8];
+
+static struct uart_inst uart_insts[2] = {{.index = 0, .pty_fd = -1}, {.index = 1, .pty_fd = -1}};
+uart_inst_t *const sim_uart0 = &uart_insts[0];
+uart_inst_t *const sim_uart1 = &uart_insts[1];
+static sim_uart_listener_t uart_listener = NULL;
+
+static struct i2c_inst i2c_insts[2];
+i2c_inst_t *const sim_i2c0 = &i2c_insts[0];
+i2c_inst_t *const sim_i2c1 = &i2c_insts[1];
+static sim_i2c_record_t i2c_log[SIM_I2C_LOG_LEN];
+static uint32_t i2c_total = 0;
+static sim_i2c_listener_t i2c_listener = NULL;
+
+static sim_fifo_t fifo_to[2];  // fifo_to[c]: c çekirdeğinin okuduğu FIFO
+
+static struct pio_hw pio_blocks[2];
+pio_hw_t *const sim_pio0 = &pio_blocks[0];
+pio_hw_t *const sim_pio1 = &pio_blocks[1];
+static adc_hw_t adc_regs;
+adc_hw_t *const adc_hw = &adc_regs;
+static dma_hw_t dma_regs;
+dma_hw_t *const dma_hw = &dma_regs;
+
+uint8_t sim_flash_image[PICO_FLASH_SIZE_BYTES];
+
+/**
+ * @brief Program başında flash görüntüsünü silinmiş duruma getirir
+ */
+__attribute__((constructor)) static void sim_init(void) {
+    memset(sim_flash_image, 0xFF, sizeof(sim_flash_image));
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+/**
+ * @brief Kurtarılamaz simülasyon hatası
+ */
+static void sim_fatal(const char *msg) {
+    fprintf(stderr, "sim: %s\n", msg);
+    abort();
+}
+
+static inline uint64_t us_to_ns(uint64_t us) {
+    return us >= END_NS / 1000u ? END_NS : us * 1000u;
+}
+
+static inline uint64_t max_u64(uint64_t a, uint64_t b) {
+    return a > b ? a : b;
+}
+
+/* ---------------------------------------------------------------------------
+ * Olay tablosu (kilit tutulurken)
+ * ------------------------------------------------------------------------- */
+
+static sim_event_t *event_alloc(ev_kind_t kind, uint64_t at_ns) {
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        if (events[i].kind == EV_FREE) {
+            memset(&events[i], 0, sizeof(events[i]));
+            events[i].kind = kind;
+            events[i].at_ns = at_ns;
+            events[i].seq = event_seq++;
+            return &events[i];
+        }
+    }
+    return NULL;
+}
+
+static sim_event_t *event_next(void) {
+    sim_event_t *best = NULL;
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        sim_event_t *e = &events[i];
+        if (e->kind != EV_FREE &&
+            (!best || e->at_ns < best->at_ns || (e->at_ns == best->at_ns && e->seq < best->seq))) {
+            best = e;
+        }
+    }
+    return best;
+}
+
+/* ---------------------------------------------------------------------------
+ * Kesmeler (Core 0, kilit tutulurken çağrılır; işleyiciler kilitsiz çalışır)
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Kilidi bırakıp bir kesme işleyicisini kesmeler kapalıyken çalıştırır
+ */
+static void run_handler(irq_handler_t handler) {
+    irqs_off = true;
+    pthread_mutex_unlock(&sim_lock);
+    handler();
+    pthread_mutex_lock(&sim_lock);
+    irqs_off = false;
+}
+
+/**
+ * @brief GPIO bank kesmesini dağıtır: önce ham işleyiciler, sonra geri çağrı
+ */
+static void dispatch_gpio_bank(void) {
+    for (uint h = 0; h < raw_handler_count; h++) {
+        for (uint g = 0; g < SIM_GPIO_COUNT; g++) {
+            if ((raw_handlers[h].mask & (1u << g)) && (pins[g].irq_events & pins[g].irq_mask)) {
+                run_handler(raw_handlers[h].handler);
+                break;
+            }
+        }
+    }
+    if (!gpio_callback) {
+        return;
+    }
+    for (uint g = 0; g < SIM_GPIO_COUNT; g++) {
+        uint32_t ev = pins[g].irq_events & pins[g].irq_mask;
+        if (ev) {
+            pins[g].irq_events &= ~ev;
+            gpio_irq_callback_t cb = gpio_callback;
+            irqs_off = true;
+            pthread_mutex_unlock(&sim_lock);
+            cb(g, ev);
+            pthread_mutex_lock(&sim_lock);
+            irqs_off = false;
+        }
+    }
+}
+
+/**
+ * @brief Bekleyen kesmeleri çalıştırır
+ * @return bool En az bir işleyici çalıştıysa true
+ */
+static bool service_irqs(void) {
+    bool ran = false;
+    if (this_core != 0 || irqs_off) {
+        return false;
+    }
+    while (irq_pending) {
+        uint num = (uint)__builtin_ctz(irq_pending);
+        irq_pending &= ~(1u << num);
+        if (!irq_enabled[num]) {
+            continue;
+        }
+        if (num == IO_IRQ_BANK0) {
+            dispatch_gpio_bank();
+        } else if (irq_handlers[num]) {
+            run_handler(irq_handlers[num]);
+        }
+        ran = true;
+    }
+    sev_flag[0] = sev_flag[0] || ran;
+    return ran;
+}
+
+/**
+ * @brief Bir kesmeyi bekleyenlere ekler
+ * @param num Kesme numarası
+ * @param at_ns Kesmenin oluştuğu an
+ */
+static void raise_irq(uint num, uint64_t at_ns) {
+    if (!irq_pending) {
+        irq_pending_ns = at_ns;
+    }
+    irq_pending |= 1u << num;
+    pthread_cond_broadcast(&sim_cond);
+}
+
+/**
+ * @brief Bir giriş pininin seviyesini değiştirir ve kenar kesmesi üretir
+ */
+static void set_input_level(uint gpio, bool level) {
+    sim_pin_t *p = &pins[gpio];
+    bool old = p->driven ? p->in_level : p->pull_up;
+    p->driven = true;
+    p->in_level = level;
+    if (p->out || old == level) {
+        return;
+    }
+    uint32_t edge = level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if (p->irq_mask & edge) {
+        p->irq_events |= edge;
+        raise_irq(IO_IRQ_BANK0, core_ns[0]);
+    }
+}
+
+static inline uint64_t uart_byte_ns(const struct uart_inst *u) {
+    return 10000000000ull / (u->baudrate ? u->baudrate : 115200u);
+}
+
+/**
+ * @brief TX FIFO'daki (henüz hattan çıkmamış) bayt sayısı (kilit tutulurken)
+ */
+static uint uart_tx_level(const struct uart_inst *u) {
+    uint64_t now = core_ns[this_core];
+    if (u->tx_free_ns <= now) {
+        return 0;
+    }
+    uint64_t byte_ns = uart_byte_ns(u);
+    return (uint)((u->tx_free_ns - now + byte_ns - 1) / byte_ns);
+}
+
+/**
+ * @brief TX kesmesi açıksa FIFO eşikteyse kesme üretir, değilse eşik anını planlar
+ *
+ * SDK, TX kesme eşiğini en düşük seviyeye (FIFO'da <= 4 bayt) kurar.
+ */
+static void uart_tx_check(struct uart_inst *u) {
+    if (!u->tx_irq || u->tx_event) {
+        return;
+    }
+    uint64_t byte_ns = uart_byte_ns(u);
+    if (uart_tx_level(u) <= UART_FIFO_DEPTH / 8) {
+        raise_irq(UART0_IRQ + u->index, core_ns[0]);
+        return;
+    }
+    sim_event_t *e = event_alloc(EV_UART_TX, u->tx_free_ns - (UART_FIFO_DEPTH / 8) * byte_ns);
+    if (e) {
+        e->target = (uint8_t)u->index;
+        u->tx_event = true;
+    }
+}
+
+/**
+ * @brief Hattaki sıradaki baytı RX FIFO'ya alır ve sonrakini planlar (kilit tutulurken)
+ * @param u UART
+ * @param at_ns Baytın oturduğu an
+ */
+static void uart_line_step(struct uart_inst *u, uint64_t at_ns) {
+    u->line_event = false;
+    if (u->line_count == 0) {
+        return;
+    }
+    uint8_t c = u->line[u->line_head];
+    u->line_head = (u->line_head + 1) % SIM_UART_LINE_LEN;
+    u->line_count--;
+    if (u->rx_count < UART_FIFO_DEPTH) {
+        u->rx_fifo[(u->rx_head + u->rx_count) % UART_FIFO_DEPTH] = c;
+        u->rx_count++;
+    } else {
+        u->rx_overruns++;
+    }
+    if (u->rx_irq) {
+        raise_irq(UART0_IRQ + u->index, at_ns);
+    }
+    if (u->line_count != 0) {
+        sim_event_t *e = event_alloc(EV_UART_RX, at_ns + uart_byte_ns(u));
+        if (e) {
+            e->target = (uint8_t)u->index;
+            u->line_event = true;
+        }
+    }
+}
+
+/**
+ * @brief Bir zamanlı olayı çalıştırır (Core 0, kilit tutulurken)
+ */
+static void fire_event(sim_event_t *e) {
+    sim_event_t ev = *e;
+    e->kind = EV_FREE;
+
+    switch (ev.kind) {
+        case EV_GPIO:
+            set_input_level(ev.target, ev.value != 0);
+            break;
+
+        case EV_ADC:
+            adc_values[ev.target] = ev.value;
+            break;
+
+        case EV_UART_RX:
+            uart_line_step(&uart_insts[ev.target], ev.at_ns);
+            break;
+
+        case EV_UART_TX: {
+            struct uart_inst *u = &uart_insts[ev.target];
+            u->tx_event = false;
+            uart_tx_check(u);
+            break;
+        }
+
+        case EV_ALARM: {
+            irqs_off = true;
+            pthread_mutex_unlock(&sim_lock);
+            int64_t r = ev.alarm(ev.id, ev.user_data);
+            pthread_mutex_lock(&sim_lock);
+            irqs_off = false;
+            if (r != 0) {
+                // < 0: planlanan zamana göre, > 0: geri çağrının döndüğü ana göre
+                uint64_t at = r < 0 ? ev.at_ns + us_to_ns((uint64_t)-r) : core_ns[0] + us_to_ns((uint64_t)r);
+                sim_event_t *n = event_alloc(EV_ALARM, at);
+                if (n) {
+                    n->id = ev.id;
+                    n->alarm = ev.alarm;
+                    n->user_data = ev.user_data;
+                }
+            }
+            break;
+        }
+
+        case EV_TIMER: {
+            repeating_timer_t *rt = ev.rt;
+            firing_timer = rt;
+            firing_timer_cancelled = false;
+            irqs_off = true;
+            pthread_mutex_unlock(&sim_lock);
+            bool keep = rt->callback(rt);
+            pthread_mutex_lock(&sim_lock);
+            irqs_off = false;
+            firing_timer = NULL;
+            if (keep && !firing_timer_cancelled) {
+                uint64_t at = rt->delay_us < 0 ? ev.at_ns + us_to_ns((uint64_t)-rt->delay_us)
+                                               : core_ns[0] + us_to_ns((uint64_t)rt->delay_us);
+                sim_event_t *n = event_alloc(EV_TIMER, at);
+                if (n) {
+                    n->id = ev.id;
+                    n->rt = rt;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Sanal saat
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Diğer çekirdeğin verilen ana yetişmesini bekler
+ *
+ * Bekleyen çekirdek saatini `t` olarak yayınlar; böylece daha geride olan
+ * çekirdek ilerleyebilir. Core 0 beklerken Core 1'den kesme gelirse veya WFE
+ * uykusundaki çekirdeğe diğerinden SEV gelirse saat o ana çekilir ve false
+ * döner.
+ *
+ * @return bool Diğer çekirdek `t`'ye ulaştıysa veya bloklu ise true
+ */
+static bool wait_other(uint64_t t) {
+    uint me = this_core;
+    uint other = me ^ 1u;
+    uint64_t start = core_ns[me];
+    if (t > start) {
+        core_ns[me] = t;
+        pthread_cond_broadcast(&sim_cond);
+    }
+    while (core_active[other] && core_ns[other] < t) {
+        if (me == 0 && irq_pending && !irqs_off) {
+            core_ns[0] = max_u64(start, irq_pending_ns);
+            pthread_cond_broadcast(&sim_cond);
+            return false;
+        }
+        if (wfe_waiting[me] && sev_flag[me]) {
+            core_ns[me] = max_u64(start, sev_ns[me]);
+            pthread_cond_broadcast(&sim_cond);
+            return false;
+        }
+        pthread_cond_wait(&sim_cond, &sim_lock);
+    }
+    return true;
+}
+
+/**
+ * @brief Çağıran çekirdeğin saatini ilerletir; arada kalan olayları çalıştırır
+ *
+ * @param target_ns Hedef zaman
+ * @param wake true ise bir kesme/olay çalıştığında hedefe varmadan döner (WFE)
+ * @return bool Hedefe ulaşıldıysa true
+ */
+static bool advance_to(uint64_t target_ns, bool wake) {
+    uint me = this_core;
+    while (true) {
+        if (me == 0 && service_irqs() && wake) {
+            return core_ns[0] >= target_ns;
+        }
+        if (wake && sev_flag[me]) {
+            return core_ns[me] >= target_ns;
+        }
+        sim_event_t *e = me == 0 && !irqs_off ? event_next() : NULL;
+        bool fire = e && e->at_ns <= target_ns;
+        uint64_t seq = fire ? e->seq : 0;
+        uint64_t step = fire ? max_u64(e->at_ns, core_ns[me]) : target_ns;
+        if (step == END_NS && !core_active[me ^ 1u] && !irq_pending) {
+            sim_fatal("Core 0 sonsuza kadar uyuyor: bekleyen olay yok");
+        }
+        if (!wait_other(step)) {
+            continue;  // Kesme geldi; önce o çalışır
+        }
+        core_ns[me] = max_u64(core_ns[me], step);
+        pthread_cond_broadcast(&sim_cond);
+
+        if (!fire) {
+            return true;
+        }
+        if (e->kind != EV_FREE && e->seq == seq) {  // Beklerken iptal edilmiş olabilir
+            fire_event(e);
+            service_irqs();
+            if (wake) {
+                return core_ns[me] >= target_ns;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Saati belirli bir süre ilerletir (kilitsiz çağrılır)
+ */
+static void advance_ns(uint64_t ns) {
+    pthread_mutex_lock(&sim_lock);
+    advance_to(core_ns[this_core] + ns, false);
+    pthread_mutex_unlock(&sim_lock);
+}
+
+uint64_t time_us_64(void) {
+    pthread_mutex_lock(&sim_lock);
+    advance_to(core_ns[this_core] + time_read_cost_ns, false);
+    uint64_t t = core_ns[this_core] / 1000u;
+    pthread_mutex_unlock(&sim_lock);
+    return t;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+    advance_ns(us_to_ns(us));
+}
+
+void sleep_ms(uint32_t ms) {
+    advance_ns(us_to_ns((uint64_t)ms * 1000u));
+}
+
+void busy_wait_us(uint64_t us) {
+    advance_ns(us_to_ns(us));
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout) {
+    pthread_mutex_lock(&sim_lock);
+    bool reached;
+    if (sev_flag[this_core]) {
+        sev_flag[this_core] = false;
+        reached = core_ns[this_core] >= us_to_ns(timeout);
+    } else {
+        wfe_waiting[this_core] = true;
+        reached = advance_to(us_to_ns(timeout), true);
+        wfe_waiting[this_core] = false;
+        sev_flag[this_core] = false;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return reached;
+}
+
+void __wfe(void) {
+    best_effort_wfe_or_timeout(at_the_end_of_time);
+}
+
+/**
+ * @brief İki çekirdeğin olay yazmacını kurar (kilit tutulurken)
+ */
+static void send_event(void) {
+    uint me = this_core;
+    sev_flag[0] = sev_flag[1] = true;
+    sev_ns[me ^ 1u] = core_ns[me];
+    pthread_cond_broadcast(&sim_cond);
+}
+
+void __sev(void) {
+    pthread_mutex_lock(&sim_lock);
+    send_event();
+    pthread_mutex_unlock(&sim_lock);
+}
+
+/* ---------------------------------------------------------------------------
+ * Zamanlayıcılar
+ * ------------------------------------------------------------------------- */
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    pthread_mutex_lock(&sim_lock);
+    uint64_t at = us_to_ns(time);
+    alarm_id_t id = 0;
+    if (at > core_ns[0] || fire_if_past) {
+        sim_event_t *e = event_alloc(EV_ALARM, max_u64(at, core_ns[0]));
+        if (e) {
+            e->id = id = next_alarm_id++;
+            e->alarm = callback;
+            e->user_data = user_data;
+        } else {
+            id = -1;
+        }
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return id;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    pthread_mutex_lock(&sim_lock);
+    uint64_t now_us = core_ns[this_core] / 1000u;
+    pthread_mutex_unlock(&sim_lock);
+    return add_alarm_at(now_us + us, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    bool found = false;
+    pthread_mutex_lock(&sim_lock);
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        if (events[i].kind == EV_ALARM && events[i].id == id) {
+            events[i].kind = EV_FREE;
+            found = true;
+        }
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return found;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    if (delay_us == 0) {
+        delay_us = 1;
+    }
+    pthread_mutex_lock(&sim_lock);
+    uint64_t period = us_to_ns((uint64_t)(delay_us < 0 ? -delay_us : delay_us));
+    sim_event_t *e = event_alloc(EV_TIMER, core_ns[this_core] + period);
+    if (e) {
+        out->delay_us = delay_us;
+        out->callback = callback;
+        out->user_data = user_data;
+        out->pool = NULL;
+        out->alarm_id = e->id = next_alarm_id++;
+        e->rt = out;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return e != NULL;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    bool found = false;
+    pthread_mutex_lock(&sim_lock);
+    for (uint i = 0; i < SIM_MAX_EVENTS; i++) {
+        if (events[i].kind == EV_TIMER && events[i].rt == timer) {
+            events[i].kind = EV_FREE;
+            found = true;
+        }
+    }
+    if (firing_timer == timer) {
+        firing_timer_cancelled = true;
+        found = true;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return found;
+}
+
+/* ---------------------------------------------------------------------------
+ * Kesme denetimi
+ * ------------------------------------------------------------------------- */
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num < IRQ_COUNT) {
+        irq_handlers[num] = handler;
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num < IRQ_COUNT) {
+        pthread_mutex_lock(&sim_lock);
+        irq_enabled[num] = enabled;
+        pthread_mutex_unlock(&sim_lock);
+    }
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    uint32_t was_on = irqs_off ? 0u : 1u;
+    irqs_off = true;
+    return was_on;
+}
+
+void restore_interrupts(uint32_t status) {
+    irqs_off = status == 0;
+    if (!irqs_off && this_core == 0) {
+        pthread_mutex_lock(&sim_lock);
+        service_irqs();
+        pthread_mutex_unlock(&sim_lock);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * GPIO
+ * ------------------------------------------------------------------------- */
+
+void gpio_init(uint gpio) {
+    pthread_mutex_lock(&sim_lock);
+    sim_pin_t *p = &pins[gpio];
+    p->out = false;
+    p->out_level = false;
+    p->fn = GPIO_FUNC_SIO;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    pins[gpio].out = out;
+}
+
+void gpio_put(uint gpio, bool value) {
+    pthread_mutex_lock(&sim_lock);
+    sim_pin_t *p = &pins[gpio];
+    bool changed = p->out_level != value;
+    p->out_level = value;
+    sim_gpio_listener_t listener = p->out && changed ? gpio_listener : NULL;
+    uint64_t t_us = core_ns[this_core] / 1000u;
+    pthread_mutex_unlock(&sim_lock);
+    if (listener) {
+        listener(gpio, value, t_us);
+    }
+}
+
+bool gpio_get(uint gpio) {
+    const sim_pin_t *p = &pins[gpio];
+    if (p->out) {
+        return p->out_level;
+    }
+    return p->driven ? p->in_level : p->pull_up;
+}
+
+void gpio_pull_up(uint gpio) {
+    pins[gpio].pull_up = true;
+    pins[gpio].pull_down = false;
+}
+
+void gpio_pull_down(uint gpio) {
+    pins[gpio].pull_up = false;
+    pins[gpio].pull_down = true;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    pins[gpio].fn = fn;
+}
+
+enum gpio_function gpio_get_function(uint gpio) {
+    return pins[gpio].fn;
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    pthread_mutex_lock(&sim_lock);
+    if (enabled) {
+        pins[gpio].irq_mask |= event_mask;
+    } else {
+        pins[gpio].irq_mask &= ~event_mask;
+    }
+    pins[gpio].irq_events &= ~event_mask;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback) {
+    gpio_callback = callback;
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+void gpio_add_raw_irq_handler_masked(uint32_t gpio_mask, irq_handler_t handler) {
+    if (raw_handler_count >= MAX_RAW_HANDLERS) {
+        sim_fatal("ham GPIO kesme işleyicisi tablosu dolu");
+    }
+    raw_handlers[raw_handler_count].mask = gpio_mask;
+    raw_handlers[raw_handler_count].handler = handler;
+    raw_handler_count++;
+}
+
+uint32_t gpio_get_irq_event_mask(uint gpio) {
+    return pins[gpio].irq_events & pins[gpio].irq_mask;
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask) {
+    pins[gpio].irq_events &= ~event_mask;
+}
+
+/* ---------------------------------------------------------------------------
+ * PWM
+ * ------------------------------------------------------------------------- */
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+pwm_config pwm_get_default_config(void) {
+    pwm_config c = {.csr = 0, .div = 1u << 4, .top = 0xffff};
+    return c;
+}
+
+void pwm_config_set_clkdiv(pwm_config *c, float div) {
+    c->div = (uint32_t)(div * 16.0f);
+}
+
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) {
+    c->top = wrap;
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    slices[slice_num].wrap = (uint16_t)c->top;
+    slices[slice_num].clkdiv = (float)c->div / 16.0f;
+    slices[slice_num].level[0] = slices[slice_num].level[1] = 0;
+    slices[slice_num].enabled = start;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    slices[slice_num].wrap = wrap;
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    slices[slice_num].clkdiv = (float)integer + (float)fract / 16.0f;
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    slices[pwm_gpio_to_slice_num(gpio)].level[gpio & 1u] = level;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    slices[slice_num].enabled = enabled;
+}
+
+/* ---------------------------------------------------------------------------
+ * ADC
+ * ------------------------------------------------------------------------- */
+
+void adc_init(void) {}
+void adc_gpio_init(uint gpio) {
+    pins[gpio].fn = GPIO_FUNC_NULL;
+}
+
+void adc_select_input(uint input) {
+    adc_channel = input < SIM_ADC_CHANNELS ? input : 0;
+}
+
+uint16_t adc_read(void) {
+    advance_ns(SIM_ADC_CONVERSION_NS);
+    return adc_values[adc_channel];
+}
+
+void adc_set_round_robin(uint input_mask) { (void)input_mask; }
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)en; (void)dreq_en; (void)dreq_thresh; (void)err_in_fifo; (void)byte_shift;
+}
+void adc_set_clkdiv(float clkdiv) { (void)clkdiv; }
+void adc_run(bool run) { (void)run; }
+void adc_fifo_drain(void) {}
+
+/* ---------------------------------------------------------------------------
+ * I2C
+ * ------------------------------------------------------------------------- */
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)nostop;
+    // Başlangıç + adres + veri baytları (her biri 8 bit + ACK) + bitiş
+    uint baud = i2c->baudrate ? i2c->baudrate : 100000u;
+    uint64_t bits = 2u + 9u * (len + 1u);
+    uint64_t duration_ns = bits * 1000000000ull / baud;
+
+    pthread_mutex_lock(&sim_lock);
+    sim_i2c_record_t *r = &i2c_log[i2c_total % SIM_I2C_LOG_LEN];
+    r->timestamp_us = core_ns[this_core] / 1000u;
+    r->addr = addr;
+    r->len = (uint8_t)(len > 255 ? 255 : len);
+    r->duration_ns = (uint32_t)duration_ns;
+    memcpy(r->data, src, len < SIM_I2C_MAX_DATA ? len : SIM_I2C_MAX_DATA);
+    i2c_total++;
+    sim_i2c_record_t copy = *r;
+    sim_i2c_listener_t listener = i2c_listener;
+    pthread_mutex_unlock(&sim_lock);
+
+    if (listener) {
+        listener(&copy);
+    }
+    advance_ns(duration_ns);
+    return (int)len;
+}
+
+/* ---------------------------------------------------------------------------
+ * UART
+ * ------------------------------------------------------------------------- */
+
+uint uart_init(uart_inst_t *uart, uint baudrate) {
+    pthread_mutex_lock(&sim_lock);
+    uart->baudrate = baudrate;
+    uart->rx_count = 0;
+    uart->tx_free_ns = 0;
+    pthread_mutex_unlock(&sim_lock);
+    return baudrate;
+}
+
+void uart_deinit(uart_inst_t *uart) {
+    uart_set_irq_enables(uart, false, false);
+}
+
+uint uart_get_index(uart_inst_t *uart) {
+    return uart->index;
+}
+
+uart_hw_t *uart_get_hw(uart_inst_t *uart) {
+    return &uart->regs;
+}
+
+void uart_set_format(uart_inst_t *uart, uint data_bits, uint stop_bits, uart_parity_t parity) {
+    (void)uart; (void)data_bits; (void)stop_bits; (void)parity;
+}
+
+void uart_set_hw_flow(uart_inst_t *uart, bool cts, bool rts) {
+    (void)uart; (void)cts; (void)rts;
+}
+
+void uart_set_fifo_enabled(uart_inst_t *uart, bool enabled) {
+    (void)uart; (void)enabled;
+}
+
+void uart_set_irq_enables(uart_inst_t *uart, bool rx_has_data, bool tx_needs_data) {
+    pthread_mutex_lock(&sim_lock);
+    uart->rx_irq = rx_has_data;
+    uart->tx_irq = tx_needs_data;
+    if (rx_has_data && uart->rx_count != 0) {
+        raise_irq(UART0_IRQ + uart->index, core_ns[0]);
+    }
+    uart_tx_check(uart);
+    pthread_mutex_unlock(&sim_lock);
+}
+
+bool uart_is_readable(uart_inst_t *uart) {
+    pthread_mutex_lock(&sim_lock);
+    bool r = uart->rx_count != 0;
+    pthread_mutex_unlock(&sim_lock);
+    return r;
+}
+
+bool uart_is_writable(uart_inst_t *uart) {
+    pthread_mutex_lock(&sim_lock);
+    bool w = uart_tx_level(uart) < UART_FIFO_DEPTH;
+    pthread_mutex_unlock(&sim_lock);
+    return w;
+}
+
+char uart_getc(uart_inst_t *uart) {
+    pthread_mutex_lock(&sim_lock);
+    uint8_t c = 0;
+    if (uart->rx_count != 0) {
+        c = uart->rx_fifo[uart->rx_head];
+        uart->rx_head = (uart->rx_head + 1) % UART_FIFO_DEPTH;
+        uart->rx_count--;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return (char)c;
+}
+
+void uart_putc_raw(uart_inst_t *uart, char c) {
+    pthread_mutex_lock(&sim_lock);
+    uint64_t byte_ns = uart_byte_ns(uart);
+    if (uart_tx_level(uart) >= UART_FIFO_DEPTH) {
+        // FIFO dolu: SDK gibi bir yer açılana kadar bekle
+        advance_to(uart->tx_free_ns - (UART_FIFO_DEPTH - 1) * byte_ns, false);
+    }
+    uint64_t now = core_ns[this_core];
+    uart->tx_free_ns = max_u64(uart->tx_free_ns, now) + byte_ns;
+    uart_tx_check(uart);
+    uint64_t timestamp_us = now / 1000u;
+    int fd = uart->pty_fd;
+    sim_uart_listener_t listener = uart_listener;
+    pthread_mutex_unlock(&sim_lock);
+
+    if (fd >= 0 && write(fd, &c, 1) < 0 && errno != EAGAIN && errno != EIO) {
+        sim_fatal("pty yazılamadı");
+    }
+    if (listener) {
+        listener(uart->index, (uint8_t)c, timestamp_us);
+    }
+}
+
+void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uart_putc_raw(uart, (char)src[i]);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * DMA ve PIO: kaynak yok
+ * ------------------------------------------------------------------------- */
+
+int dma_claim_unused_channel(bool required) {
+    if (required) {
+        sim_fatal("DMA kanalı simüle edilmiyor");
+    }
+    return -1;
+}
+void dma_channel_unclaim(uint channel) { (void)channel; }
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    dma_channel_config c = {0};
+    return c;
+}
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    (void)c; (void)size;
+}
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) { (void)c; (void)chain_to; }
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+void dma_channel_start(uint channel) { (void)channel; }
+void dma_channel_abort(uint channel) { (void)channel; }
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    (void)c; (void)write; (void)size_bits;
+}
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    (void)channel; (void)read_addr; (void)transfer_count;
+}
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    (void)channel; (void)trans_count; (void)trigger;
+}
+bool dma_channel_is_busy(uint channel) {
+    (void)channel;
+    return false;
+}
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) { (void)channel; (void)enabled; }
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio; (void)program;
+    return false;
+}
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio; (void)program;
+    sim_fatal("PIO simüle edilmiyor");
+    return 0;
+}
+void pio_remove_program(PIO pio, const pio_program_t *program, uint offset) {
+    (void)pio; (void)program; (void)offset;
+}
+int pio_claim_unused_sm(PIO pio, bool required) {
+    (void)pio;
+    if (required) {
+        sim_fatal("PIO simüle edilmiyor");
+    }
+    return -1;
+}
+void pio_sm_unclaim(PIO pio, uint sm) { (void)pio; (void)sm; }
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm) {
+    (void)pio; (void)sm;
+    return true;
+}
+uint32_t pio_sm_get(PIO pio, uint sm) {
+    (void)pio; (void)sm;
+    return 0;
+}
+void pio_sm_put(PIO pio, uint sm, uint32_t data) { (void)pio; (void)sm; (void)data; }
+uint pio_get_rx_fifo_not_empty_interrupt_source(uint sm) {
+    return sm;
+}
+void pio_set_irq0_source_enabled(PIO pio, uint source, bool enabled) {
+    (void)pio; (void)source; (void)enabled;
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    switch (clk_index) {
+        case clk_ref: return 12000000u;
+        case clk_usb:
+        case clk_adc: return 48000000u;
+        default: return CLK_SYS_HZ;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Flash
+ * ------------------------------------------------------------------------- */
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE ||
+        flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        sim_fatal("flash_range_erase: hizasız veya sınır dışı aralık");
+    }
+    memset(&sim_flash_image[flash_offs], 0xFF, count);
+    advance_ns((uint64_t)(count / FLASH_SECTOR_SIZE) * FLASH_ERASE_NS);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE ||
+        flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        sim_fatal("flash_range_program: hizasız veya sınır dışı aralık");
+    }
+    // Flash yalnızca 1 bitleri 0 yapabilir; silinmemiş alana yazma bozuk veri üretir
+    for (size_t i = 0; i < count; i++) {
+        sim_flash_image[flash_offs + i] &= data[i];
+    }
+    advance_ns((uint64_t)(count / FLASH_PAGE_SIZE) * FLASH_PROGRAM_NS);
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    uint other = this_core ^ 1u;
+    pthread_mutex_lock(&sim_lock);
+    bool permitted = lockout_victim[other] || (other == 1 && !core1_launched);
+    bool fail = flash_fail_count > 0;
+    if (fail) {
+        flash_fail_count--;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    if (!permitted) {
+        return PICO_ERROR_NOT_PERMITTED;  // SDK: diğer çekirdek durdurulamaz
+    }
+    if (fail) {
+        return PICO_ERROR_TIMEOUT;  // Diğer çekirdek zamanında durmadı
+    }
+    uint32_t irq_state = save_and_disable_interrupts();
+    func(param);
+    restore_interrupts(irq_state);
+    return PICO_OK;
+}
+
+bool flash_safe_execute_core_init(void) {
+    pthread_mutex_lock(&sim_lock);
+    lockout_victim[this_core] = true;
+    pthread_mutex_unlock(&sim_lock);
+    return true;
+}
+
+/**
+ * @brief Sonraki flash_safe_execute() çağrılarını PICO_ERROR_TIMEOUT ile reddettirir
+ *
+ * İşlev çalışmaz, flash değişmez; hata yolunu sınamak içindir.
+ *
+ * @param count Reddedilecek çağrı sayısı
+ */
+void sim_flash_fail_next(uint32_t count) {
+    pthread_mutex_lock(&sim_lock);
+    flash_fail_count = count;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+/**
+ * @brief Flash görüntüsünü dosyadan yükler (yeniden açılışı simüle etmek için)
+ *
+ * Dosya görüntüden kısaysa kalan kısım silinmiş (0xFF) kalır.
+ *
+ * @param path Görüntü dosyası
+ * @return bool Dosya açılamadıysa false (görüntü değişmez)
+ */
+bool sim_flash_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    memset(sim_flash_image, 0xFF, sizeof(sim_flash_image));
+    size_t n = fread(sim_flash_image, 1, sizeof(sim_flash_image), f);
+    fclose(f);
+    (void)n;
+    return true;
+}
+
+/**
+ * @brief Flash görüntüsünün tamamını dosyaya yazar
+ * @param path Görüntü dosyası
+ * @return bool Yazma başarılıysa true
+ */
+bool sim_flash_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    bool ok = fwrite(sim_flash_image, 1, sizeof(sim_flash_image), f) == sizeof(sim_flash_image);
+    return fclose(f) == 0 && ok;
+}
+
+/* ---------------------------------------------------------------------------
+ * Çoklu çekirdek
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Core 1 iş parçacığı gövdesi
+ */
+static void *core1_thread(void *arg) {
+    void (*entry)(void) = (void (*)(void))arg;
+    this_core = 1;
+    entry();
+    pthread_mutex_lock(&sim_lock);
+    core_active[1] = false;
+    pthread_cond_broadcast(&sim_cond);
+    pthread_mutex_unlock(&sim_lock);
+    return NULL;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    pthread_t thread;
+    pthread_mutex_lock(&sim_lock);
+    core_ns[1] = core_ns[0];
+    core_active[1] = true;
+    core1_launched = true;
+    pthread_mutex_unlock(&sim_lock);
+    if (pthread_create(&thread, NULL, core1_thread, (void *)entry) != 0) {
+        sim_fatal("Core 1 iş parçacığı açılamadı");
+    }
+    pthread_detach(thread);
+}
+
+/**
+ * @brief Bloklu bir FIFO işleminden sonra diğer çekirdeği uyandırır (kilit tutulurken)
+ */
+static void wake_core(uint core, uint64_t at_ns) {
+    if (!core_active[core]) {
+        core_active[core] = true;
+        core_ns[core] = max_u64(core_ns[core], at_ns);
+    }
+    pthread_cond_broadcast(&sim_cond);
+}
+
+bool multicore_fifo_rvalid(void) {
+    pthread_mutex_lock(&sim_lock);
+    bool valid = fifo_to[this_core].count > 0;
+    pthread_mutex_unlock(&sim_lock);
+    return valid;
+}
+
+bool multicore_fifo_wready(void) {
+    pthread_mutex_lock(&sim_lock);
+    bool ready = fifo_to[this_core ^ 1u].count < FIFO_DEPTH;
+    pthread_mutex_unlock(&sim_lock);
+    return ready;
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    uint me = this_core;
+    uint other = me ^ 1u;
+    pthread_mutex_lock(&sim_lock);
+    sim_fifo_t *f = &fifo_to[other];
+    while (f->count == FIFO_DEPTH) {
+        core_active[me] = false;
+        pthread_cond_broadcast(&sim_cond);
+        pthread_cond_wait(&sim_cond, &sim_lock);
+    }
+    core_active[me] = true;
+    if (lockout_victim[other] && data != SIM_LOCKOUT_MAGIC_START && data != SIM_LOCKOUT_MAGIC_END) {
+        // SDK'nın multicore_lockout_handler'ı FIFO'yu boşaltır, kilit dışı sözcükleri atar
+        fifo_dropped[other]++;
+        pthread_mutex_unlock(&sim_lock);
+        return;
+    }
+    uint idx = (f->head + f->count) % FIFO_DEPTH;
+    f->data[idx] = data;
+    f->at_ns[idx] = core_ns[me];
+    f->count++;
+    wake_core(other, core_ns[me]);
+    if (other == 0) {
+        raise_irq(SIO_IRQ_PROC0, core_ns[me]);
+    }
+    pthread_mutex_unlock(&sim_lock);
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    uint me = this_core;
+    pthread_mutex_lock(&sim_lock);
+    sim_fifo_t *f = &fifo_to[me];
+    while (f->count == 0) {
+        core_active[me] = false;
+        pthread_cond_broadcast(&sim_cond);
+        pthread_cond_wait(&sim_cond, &sim_lock);
+    }
+    core_active[me] = true;
+    uint32_t data = f->data[f->head];
+    core_ns[me] = max_u64(core_ns[me], f->at_ns[f->head]);
+    f->head = (f->head + 1) % FIFO_DEPTH;
+    f->count--;
+    wake_core(me ^ 1u, core_ns[me]);
+    pthread_mutex_unlock(&sim_lock);
+    return data;
+}
+
+void multicore_fifo_clear_irq(void) {}
+
+void multicore_fifo_drain(void) {
+    pthread_mutex_lock(&sim_lock);
+    fifo_to[this_core].count = 0;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+uint get_core_num(void) {
+    return this_core;
+}
+
+/**
+ * @brief Kilit kesmesinin attığı FIFO sözcüklerini döndürür
+ * @param core Kurban çekirdek
+ */
+uint32_t sim_fifo_dropped(uint core) {
+    pthread_mutex_lock(&sim_lock);
+    uint32_t n = fifo_dropped[core & 1u];
+    pthread_mutex_unlock(&sim_lock);
+    return n;
+}
+
+void queue_init(queue_t *q, uint element_size, uint element_count) {
+    q->data = calloc(element_count, element_size);
+    q->at_ns = calloc(element_count, sizeof(uint64_t));
+    if (q->data == NULL || q->at_ns == NULL) {
+        sim_fatal("queue_init: bellek yok");
+    }
+    q->element_size = element_size;
+    q->element_count = element_count;
+    q->head = 0;
+    q->count = 0;
+}
+
+/**
+ * @brief Kuyruğa eleman ekler; SDK gibi SEV ile bekleyeni uyandırır (kilit tutulurken)
+ */
+static bool queue_add_locked(queue_t *q, const void *data) {
+    if (q->count == q->element_count) {
+        return false;
+    }
+    uint me = this_core;
+    uint idx = (q->head + q->count) % q->element_count;
+    memcpy(&q->data[idx * q->element_size], data, q->element_size);
+    q->at_ns[idx] = core_ns[me];
+    q->count++;
+    wake_core(me ^ 1u, core_ns[me]);
+    send_event();
+    return true;
+}
+
+/**
+ * @brief Kuyruktan eleman alır; saat elemanın eklendiği ana ilerler (kilit tutulurken)
+ */
+static bool queue_remove_locked(queue_t *q, void *data) {
+    if (q->count == 0) {
+        return false;
+    }
+    uint me = this_core;
+    memcpy(data, &q->data[q->head * q->element_size], q->element_size);
+    core_ns[me] = max_u64(core_ns[me], q->at_ns[q->head]);
+    q->head = (q->head + 1) % q->element_count;
+    q->count--;
+    wake_core(me ^ 1u, core_ns[me]);
+    send_event();
+    return true;
+}
+
+/**
+ * @brief Kuyruk koşulu sağlanana kadar çağıran çekirdeği bloklar (kilit tutulurken)
+ */
+static void queue_block(void) {
+    core_active[this_core] = false;
+    pthread_cond_broadcast(&sim_cond);
+    pthread_cond_wait(&sim_cond, &sim_lock);
+}
+
+bool queue_try_add(queue_t *q, const void *data) {
+    pthread_mutex_lock(&sim_lock);
+    bool ok = queue_add_locked(q, data);
+    pthread_mutex_unlock(&sim_lock);
+    return ok;
+}
+
+bool queue_try_remove(queue_t *q, void *data) {
+    pthread_mutex_lock(&sim_lock);
+    bool ok = queue_remove_locked(q, data);
+    pthread_mutex_unlock(&sim_lock);
+    return ok;
+}
+
+void queue_add_blocking(queue_t *q, const void *data) {
+    pthread_mutex_lock(&sim_lock);
+    while (!queue_add_locked(q, data)) {
+        queue_block();
+    }
+    core_active[this_core] = true;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+void queue_remove_blocking(queue_t *q, void *data) {
+    pthread_mutex_lock(&sim_lock);
+    while (!queue_remove_locked(q, data)) {
+        queue_block();
+    }
+    core_active[this_core] = true;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+uint queue_get_level(queue_t *q) {
+    pthread_mutex_lock(&sim_lock);
+    uint n = q->count;
+    pthread_mutex_unlock(&sim_lock);
+    return n;
+}
+
+/* ---------------------------------------------------------------------------
+ * stdio
+ * ------------------------------------------------------------------------- */
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    if (timeout_us) {
+        advance_ns(us_to_ns(timeout_us));
+    }
+    return PICO_ERROR_TIMEOUT;
+}
+
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation) {
+    (void)cr_translation;
+    fwrite(s, 1, (size_t)len, stdout);
+    if (newline) {
+        fputc('\n', stdout);
+    }
+    return len;
+}
+
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param) {
+    (void)fn;  // stdio girişi yok; callback hiç çağrılmaz
+    (void)param;
+}
+
+/* ---------------------------------------------------------------------------
+ * Simülasyon denetimi (sim.h)
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Çağıran çekirdeğin sanal saatini döndürür; saati ilerletmez
+ * @return uint64_t Mikrosaniye
+ */
+uint64_t sim_now_us(void) {
+    pthread_mutex_lock(&sim_lock);
+    uint64_t t = core_ns[this_core] / 1000u;
+    pthread_mutex_unlock(&sim_lock);
+    return t;
+}
+
+/**
+ * @brief Saati ilerletir; arada kalan alarmlar, betikli girişler ve kesmeler çalışır
+ * @param us Süre (µs)
+ */
+void sim_run_for_us(uint64_t us) {
+    advance_ns(us_to_ns(us));
+}
+
+/**
+ * @brief `time_us_64()` okuma maliyetini ayarlar
+ * @param ns Okuma başına eklenen süre; 0 ise saat yalnızca bekleme ile ilerler
+ */
+void sim_set_time_read_cost_ns(uint32_t ns) {
+    time_read_cost_ns = ns;
+}
+
+/**
+ * @brief Bir giriş pinini hemen sürer; kenar kesmesi hemen çalışır
+ * @param gpio Pin
+ * @param level Seviye
+ */
+void sim_gpio_set_input(uint gpio, bool level) {
+    pthread_mutex_lock(&sim_lock);
+    set_input_level(gpio, level);
+    service_irqs();
+    pthread_mutex_unlock(&sim_lock);
+}
+
+/**
+ * @brief Bir giriş seviyesi değişimini ileri bir zamana planlar
+ * @param at_us Mutlak zaman (µs)
+ * @param gpio Pin
+ * @param level Seviye
+ * @return bool Olay tablosunda yer varsa true
+ */
+bool sim_gpio_schedule(uint64_t at_us, uint gpio, bool level) {
+    pthread_mutex_lock(&sim_lock);
+    sim_event_t *e = event_alloc(EV_GPIO, max_u64(us_to_ns(at_us), core_ns[0]));
+    if (e) {
+        e->target = (uint8_t)gpio;
+        e->value = level;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return e != NULL;
+}
+
+/**
+ * @brief Bir giriş darbesi planlar (ör. buton basışı, yankı darbesi)
+ * @param at_us Darbenin başladığı mutlak zaman (µs)
+ * @param gpio Pin
+ * @param level Darbe seviyesi; bitişte tersine döner
+ * @param width_us Darbe genişliği (µs)
+ * @return bool İki olay da planlandıysa true
+ */
+bool sim_gpio_pulse(uint64_t at_us, uint gpio, bool level, uint64_t width_us) {
+    return sim_gpio_schedule(at_us, gpio, level) && sim_gpio_schedule(at_us + width_us, gpio, !level);
+}
+
+/**
+ * @brief Bir çıkış pininin seviyesini döndürür
+ */
+bool sim_gpio_output(uint gpio) {
+    return pins[gpio].out_level;
+}
+
+/**
+ * @brief Pin çıkış olarak mı ayarlı
+ */
+bool sim_gpio_is_output(uint gpio) {
+    return pins[gpio].out;
+}
+
+/**
+ * @brief Çıkış pini değişimlerini dinleyecek fonksiyonu ayarlar
+ * @param listener Geri çağrı (NULL: kapalı); değişimi yapan çekirdeğin iş parçacığında çalışır
+ */
+void sim_gpio_set_listener(sim_gpio_listener_t listener) {
+    gpio_listener = listener;
+}
+
+/**
+ * @brief Bir ADC kanalının değerini hemen değiştirir
+ * @param channel Kanal (0: LDR_1, 1: POT_1, 2: KEYPAD)
+ * @param value 12 bit değer
+ */
+void sim_adc_set(uint channel, uint16_t value) {
+    if (channel < SIM_ADC_CHANNELS) {
+        adc_values[channel] = value & 0x0FFFu;
+    }
+}
+
+/**
+ * @brief Bir ADC değer değişimini ileri bir zamana planlar
+ * @return bool Olay tablosunda yer varsa true
+ */
+bool sim_adc_schedule(uint64_t at_us, uint channel, uint16_t value) {
+    if (channel >= SIM_ADC_CHANNELS) {
+        return false;
+    }
+    pthread_mutex_lock(&sim_lock);
+    sim_event_t *e = event_alloc(EV_ADC, max_u64(us_to_ns(at_us), core_ns[0]));
+    if (e) {
+        e->target = (uint8_t)channel;
+        e->value = value & 0x0FFFu;
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return e != NULL;
+}
+
+/**
+ * @brief Açılıştan (veya son temizlemeden) beri kaydedilen I2C yazma sayısı
+ */
+uint32_t sim_i2c_count(void) {
+    return i2c_total;
+}
+
+/**
+ * @brief Kaydedilen bir I2C yazmasını kopyalar
+ * @param index 0 tabanlı işlem sırası
+ * @param out Kaydın yazılacağı yapı
+ * @return bool Kayıt halkada hâlâ duruyorsa true
+ */
+bool sim_i2c_get(uint32_t index, sim_i2c_record_t *out) {
+    pthread_mutex_lock(&sim_lock);
+    bool ok = index < i2c_total && i2c_total - index <= SIM_I2C_LOG_LEN;
+    if (ok) {
+        *out = i2c_log[index % SIM_I2C_LOG_LEN];
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return ok;
+}
+
+/**
+ * @brief I2C kaydını temizler
+ */
+void sim_i2c_clear(void) {
+    pthread_mutex_lock(&sim_lock);
+    i2c_total = 0;
+    pthread_mutex_unlock(&sim_lock);
+}
+
+/**
+ * @brief Her I2C yazmasında çağrılacak fonksiyonu ayarlar
+ * @param listener Geri çağrı (NULL: kapalı)
+ */
+void sim_i2c_set_listener(sim_i2c_listener_t listener) {
+    i2c_listener = listener;
+}
+
+/**
+ * @brief Bir PWM çıkışının durumunu döndürür
+ * @param gpio Pin
+ * @param out Durumun yazılacağı yapı
+ * @return bool Pin PWM işlevindeyse true
+ */
+bool sim_pwm_get(uint gpio, sim_pwm_state_t *out) {
+    const sim_slice_t *s = &slices[pwm_gpio_to_slice_num(gpio)];
+    out->enabled = s->enabled;
+    out->wrap = s->wrap;
+    out->clkdiv = s->clkdiv;
+    out->level = s->level[gpio & 1u];
+    out->freq_hz = s->clkdiv > 0.0f ? (float)CLK_SYS_HZ / (s->clkdiv * ((float)s->wrap + 1.0f)) : 0.0f;
+    return pins[gpio].fn == GPIO_FUNC_PWM;
+}
+
+/**
+ * @brief Bir UART'ın alma hattına bayt ekler
+ *
+ * Baytlar şu andan başlayarak bayt başına 10 bit süresiyle RX FIFO'ya oturur;
+ * FIFO doluyken gelenler taşma sayılır.
+ *
+ * @param uart UART numarası (0/1)
+ * @param data Baytlar
+ * @param len Bayt sayısı
+ * @return size_t Hat kuyruğuna sığan bayt sayısı
+ */
+size_t sim_uart_inject(uint uart, const uint8_t *data, size_t len) {
+    struct uart_inst *u = &uart_insts[uart & 1u];
+    pthread_mutex_lock(&sim_lock);
+    size_t n = 0;
+    while (n < len && u->line_count < SIM_UART_LINE_LEN) {
+        u->line[(u->line_head + u->line_count) % SIM_UART_LINE_LEN] = data[n++];
+        u->line_count++;
+    }
+    if (n != 0 && !u->line_event) {
+        sim_event_t *e = event_alloc(EV_UART_RX, core_ns[this_core] + uart_byte_ns(u));
+        if (e) {
+            e->target = (uint8_t)u->index;
+            u->line_event = true;
+        }
+    }
+    pthread_mutex_unlock(&sim_lock);
+    return n;
+}
+
+/**
+ * @brief Bir UART'ın RX FIFO taşma sayısını döndürür
+ * @param uart UART numarası
+ * @return uint32_t FIFO doluyken gelen bayt sayısı
+ */
+uint32_t sim_uart_rx_overruns(uint uart) {
+    pthread_mutex_lock(&sim_lock);
+    uint32_t n = uart_insts[uart & 1u].rx_overruns;
+    pthread_mutex_unlock(&sim_lock);
+    return n;
+}
+
+/**
+ * @brief UART'tan gönderilen her baytta çağrılacak fonksiyonu ayarlar
+ * @param listener Geri çağrı (NULL: kapalı)
+ */
+void sim_uart_set_listener(sim_uart_listener_t listener) {
+    uart_listener = listener;
+}
+
+/**
+ * @brief UART'ı bir sözde terminale (pty) bağlar
+ *
+ * Gönderilen baytlar pty'ye yazılır; pty'den gelenler `sim_uart_poll_pty()`
+ * çağrıldığında alma hattına eklenir. Karşı uç (`name`) ham modda açılır,
+ * ör. `screen`, `picocom` veya pyserial ile.
+ *
+ * @param uart UART numarası
+ * @param name Karşı ucun yolu (ör. /dev/pts/3)
+ * @param name_len `name` boyutu
+ * @return bool pty açıldıysa true
+ */
+bool sim_uart_open_pty(uint uart, char *name, size_t name_len) {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0 || ptsname_r(fd, name, name_len) != 0) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    pthread_mutex_lock(&sim_lock);
+    uart_insts[uart & 1u].pty_fd = fd;
+    pthread_mutex_unlock(&sim_lock);
+    return true;
+}
+
+/**
+ * @brief pty'de bekleyen baytları okuyup alma hattına ekler; beklemez
+ * @param uart UART numarası
+ * @return size_t Eklenen bayt sayısı
+ */
+size_t sim_uart_poll_pty(uint uart) {
+    struct uart_inst *u = &uart_insts[uart & 1u];
+    uint8_t buf[256];
+    pthread_mutex_lock(&sim_lock);
+    size_t room = SIM_UART_LINE_LEN - u->line_count;
+    pthread_mutex_unlock(&sim_lock);
+    if (u->pty_fd < 0 || room == 0) {
+        return 0;
+    }
+    ssize_t n = read(u->pty_fd, buf, room < sizeof(buf) ? room : sizeof(buf));
+    return n > 0 ? sim_uart_inject(uart, buf, (size_t)n) : 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file sim_logger.c
+ * @brief Ertelenmiş günlüğün (logger.c) argüman saklama ve biçimlendirme kendi kendine testi
+ * @see \ref howto_logger
+ *
+ * Bilinen argümanlarla `LOG_INFO` kayıtları yazılır, log_flush() çıktısı
+ * geçici dosyaya yönlendirilip satır satır beklenen metinle karşılaştırılır.
+ * Özellikle 64 bit tamsayıların (int64_t, uint64_t, `%lld`, PRIu64) iki
+ * sözcük saklanıp kesilmeden yazıldığı denetlenir. Sözcük sınırını aşan
+ * çağrılar (ör. iki 64 bit + iki 32 bit argüman) derleme hatasıdır; bu
+ * çalışma zamanında sınanamaz.
+ * Çıkış kodu 1 = hata. Argümansız çalıştırıldığında yalnızca çıktıyı yazar.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_logger --selftest
+ * @endcode
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "pico_training_board.h"
+#include "sim_check.h"
+
+#define MAX_LINES 16
+
+static char lines[MAX_LINES][160];
+
+/**
+ * @brief Bekleyen kayıtları boşaltır ve iletileri (zaman ve seviye öneki olmadan) toplar
+ * @return uint Toplanan satır
+ */
+static uint flush_captured(void) {
+    FILE *tmp = tmpfile();
+    if (tmp == NULL) {
+        return 0;
+    }
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    dup2(fileno(tmp), STDOUT_FILENO);
+    log_flush(MAX_LINES);
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    rewind(tmp);
+    char line[160];
+    uint count = 0;
+    while (count < MAX_LINES && fgets(line, sizeof(line), tmp) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+        const char *msg = strstr(line, "] ");
+        msg = msg != NULL ? msg + 5 : line;  // "] I0 " atlanır
+        snprintf(lines[count], sizeof(lines[count]), "%s", msg);
+        printf("%s\n", lines[count]);
+        count++;
+    }
+    fclose(tmp);
+    return count;
+}
+
+int main(int argc, char **argv) {
+    stdio_init_all();
+
+    int64_t big_neg = INT64_MIN;
+    uint64_t big = UINT64_MAX;
+    uint64_t uptime = 5000000000ull;  // 32 bite sığmaz
+    int32_t small_neg = -42;
+    long long ll_neg = -1234567890123ll;
+
+    static const char *const expected[] = {
+        "int64 -9223372036854775808",
+        "uint64 18446744073709551615",
+        "pri 5000000000 12a05f200",
+        "karisik -42 5000000000 7",
+        "ll -1234567890123 x 2.5",
+        "dar %ld -42 %u 7",
+        "dar64 5000000000",
+    };
+
+    LOG_INFO("int64 %" PRId64, big_neg);
+    LOG_INFO("uint64 %llu", (unsigned long long)big);
+    LOG_INFO("pri %" PRIu64 " %" PRIx64, uptime, uptime);
+    LOG_INFO("karisik %d %" PRIu64 " %u", small_neg, uptime, 7u);
+    LOG_INFO("ll %lld %s %.1f", ll_neg, "x", 2.5f);
+    LOG_INFO("dar %%ld %ld %%u %u", (long)small_neg, 7u);
+    LOG_INFO("dar64 %u", uptime);  // Belirteç 32 bit, argüman 64 bit: kesilmez
+
+    uint count = flush_captured();
+
+    if (!sim_check_selftest_arg(argc, argv)) {
+        return 0;
+    }
+    uint want = (uint)(sizeof(expected) / sizeof(expected[0]));
+    CHECK(count == want, "%u satir bekleniyordu, %u yazildi", want, count);
+    for (uint i = 0; i < want && i < count; i++) {
+        CHECK(strcmp(lines[i], expected[i]) == 0, "satir %u: '%s' != '%s'", i, lines[i], expected[i]);
+    }
+    log_stats_t st;
+    log_get_stats(&st);
+    CHECK(st.dropped == 0, "%lu kayit dustu", (unsigned long)st.dropped);
+    return sim_check_summary();
+}
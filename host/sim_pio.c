@@ -0,0 +1,242 @@
+/**
+ * @file sim_pio.c
+ * @brief PIO programlarını (input_debounce.pio, ultrasonic_echo.pio) öykünücüde çevrim çevrim sınayan araç
+ * @see \ref howto_host_sim
+ * @see pio_emu.h
+ *
+ * Simüle edilen HAL PIO sunmadığı için firmware bilgisayarda yazılım yollarına
+ * düşer; PIO programlarının kendisi burada, kaynak .pio dosyası doğrudan
+ * okunarak denetlenir. `--selftest` şunları denetler:
+ * - temiz basışta yükselme THRESHOLD örnekte bildirilir,
+ * - sıçramalı basış tek olay üretir, eşiğe ulaşmayan darbe hiç üretmez,
+ * - 2 s basılı tutma sırasında bir çevrimlik düşük darbeler sayacı eşiğin
+ *   üstüne taşımaz ve bırakma yine THRESHOLD örnekte bildirilir,
+ * - ultrasonik ölçümde tetikleme 10 µs sürer, yankı genişliği 0.2 µs
+ *   çözünürlükle okunur, yankısız ve yüksekte takılı pinde SM zaman aşımı
+ *   yazıp sonraki isteğe döner.
+ * Çıkış kodu 1 = hata.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_pio --selftest
+ * @endcode
+ */
+
+#include <stdio.h>
+
+#include "pico_training_board.h"
+#include "input_debounce.pio.h"
+#include "ultrasonic_echo.pio.h"
+#include "pio_emu.h"
+#include "sim_check.h"
+
+#define DEBOUNCE_PIO FIRMWARE_DIR "/input_debounce.pio"
+#define ECHO_PIO FIRMWARE_DIR "/ultrasonic_echo.pio"
+
+/** @brief ultrasonic.c ile aynı: SM'ye yazılan zaman aşımı (2 çevrimlik adım) */
+#define ECHO_TIMEOUT_STEPS ((uint32_t)((uint64_t)ULTRASONIC_TIMEOUT_US * ULTRASONIC_PIO_CLOCK_HZ / 2000000u))
+#define ECHO_CYCLES_PER_US (ULTRASONIC_PIO_CLOCK_HZ / 1000000u)
+
+/** @brief Varsayılan buton debounce süresinde SM frekansı (input_pio_attach() ile aynı hesap) */
+#define DEBOUNCE_SM_HZ ((uint64_t)INPUT_DEBOUNCE_THRESHOLD * INPUT_DEBOUNCE_SAMPLE_CYCLES * 1000000u / BUTTON_DEBOUNCE_US)
+
+/** @brief Temiz bir kenarın en geç bildirilmesi gereken çevrim (bir örnek pay) */
+#define EDGE_MAX_CYCLES ((INPUT_DEBOUNCE_THRESHOLD + 1u) * INPUT_DEBOUNCE_SAMPLE_CYCLES)
+
+/**
+ * @brief Programı yükler ve input_debounce_program_init()'teki `set y, THRESHOLD`'u uygular
+ */
+static bool debounce_setup(pio_emu_t *sm) {
+    if (!pio_emu_load(sm, DEBOUNCE_PIO, true)) {
+        printf("HATA: %s\n", sm->error);
+        return false;
+    }
+    sm->y = INPUT_DEBOUNCE_THRESHOLD;
+    pio_emu_step(sm, 100);   // stable_low: wait 1 pin
+    return true;
+}
+
+/**
+ * @brief RX FIFO'ya sözcük gelene kadar çalıştırır
+ * @return int64_t Geçen çevrim, `max_cycles` içinde gelmezse -1
+ */
+static int64_t run_until_event(pio_emu_t *sm, uint64_t max_cycles, uint32_t *value) {
+    for (uint64_t c = 1; c <= max_cycles; c++) {
+        pio_emu_step(sm, 1);
+        if (pio_emu_get(sm, value)) return (int64_t)c;
+    }
+    return -1;
+}
+
+static double cycles_to_ms(int64_t cycles) {
+    return (double)cycles * 1000.0 / (double)DEBOUNCE_SM_HZ;
+}
+
+static void test_clean_edges(void) {
+    pio_emu_t sm;
+    if (!debounce_setup(&sm)) {
+        sim_check_failures++;
+        return;
+    }
+    uint32_t v = 0;
+
+    sm.pin = true;
+    int64_t rise = run_until_event(&sm, 4 * EDGE_MAX_CYCLES, &v);
+    CHECK(rise >= (int64_t)(INPUT_DEBOUNCE_THRESHOLD * 32u) && rise <= (int64_t)EDGE_MAX_CYCLES,
+          "temiz basis %lld cevrim (beklenen <= %u)", (long long)rise, EDGE_MAX_CYCLES);
+    CHECK(v == 0xFFFFFFFFu, "basis sozcugu 0x%08x", (unsigned)v);
+
+    sm.pin = false;
+    int64_t fall = run_until_event(&sm, 4 * EDGE_MAX_CYCLES, &v);
+    CHECK(fall >= (int64_t)(INPUT_DEBOUNCE_THRESHOLD * 32u) && fall <= (int64_t)EDGE_MAX_CYCLES,
+          "temiz birakma %lld cevrim (beklenen <= %u)", (long long)fall, EDGE_MAX_CYCLES);
+    CHECK(v == 0, "birakma sozcugu 0x%08x", (unsigned)v);
+    printf("temiz kenar: basis %.2f ms, birakma %.2f ms\n", cycles_to_ms(rise), cycles_to_ms(fall));
+}
+
+static void test_bounce(void) {
+    pio_emu_t sm;
+    if (!debounce_setup(&sm)) {
+        sim_check_failures++;
+        return;
+    }
+    uint32_t v;
+
+    // Eşiğin yarısı kadar süren darbe: olay yok
+    sm.pin = true;
+    pio_emu_step(&sm, INPUT_DEBOUNCE_THRESHOLD / 2 * 32u);
+    sm.pin = false;
+    CHECK(run_until_event(&sm, 4 * EDGE_MAX_CYCLES, &v) < 0, "kisa darbe olay uretti");
+
+    // Sıçramalı basış: örnek periyodundan kısa aralıklarla 40 geçiş, sonra yüksek
+    for (int i = 0; i < 40; i++) {
+        sm.pin = !sm.pin;
+        pio_emu_step(&sm, 7 + (uint64_t)(i % 5) * 11);
+    }
+    sm.pin = true;
+    int events = 0;
+    while (run_until_event(&sm, 4 * EDGE_MAX_CYCLES, &v) >= 0) {
+        events++;
+        CHECK(v == 0xFFFFFFFFu, "sicramali basista dusme olayi");
+    }
+    CHECK(events == 1, "sicramali basis %d olay uretti", events);
+}
+
+static void test_long_hold(void) {
+    pio_emu_t sm;
+    if (!debounce_setup(&sm)) {
+        sim_check_failures++;
+        return;
+    }
+    uint32_t v;
+
+    sm.pin = true;
+    CHECK(run_until_event(&sm, 4 * EDGE_MAX_CYCLES, &v) >= 0 && v == 0xFFFFFFFFu, "basis bildirilmedi");
+
+    // 2 s basılı; her 1000 çevrimde bir çevrimlik düşük darbe (stable_high'daki wait'i uyandırır)
+    uint64_t hold = 2 * DEBOUNCE_SM_HZ;
+    uint32_t max_x = 0;
+    int events = 0;
+    for (uint64_t c = 0; c < hold; c++) {
+        sm.pin = c % 1000 != 999;
+        pio_emu_step(&sm, 1);
+        // Artırma sırasındaki `mov x, ~x` ara değerleri (üst bit 1) sayılmaz
+        if (sm.x < 0x80000000u && sm.x > max_x) max_x = sm.x;
+        while (pio_emu_get(&sm, &v)) events++;
+    }
+    CHECK(events == 0, "basili tutarken %d olay", events);
+    CHECK(max_x <= INPUT_DEBOUNCE_THRESHOLD, "sayac esigi asti: X=%u", (unsigned)max_x);
+
+    sm.pin = false;
+    int64_t fall = run_until_event(&sm, 100 * EDGE_MAX_CYCLES, &v);
+    CHECK(fall >= 0 && fall <= (int64_t)EDGE_MAX_CYCLES,
+          "2 s sonra birakma %lld cevrim (beklenen <= %u)", (long long)fall, EDGE_MAX_CYCLES);
+    CHECK(v == 0, "birakma sozcugu 0x%08x", (unsigned)v);
+    printf("2 s basili tutma: en buyuk X %u, birakma %.2f ms\n", (unsigned)max_x, cycles_to_ms(fall));
+}
+
+/**
+ * @brief Bir ölçüm isteği yazar; yankı `delay_us` sonra yükselip `width_us` yüksek kalır
+ *
+ * `width_us` < 0 ise yankı hiç gelmez; `delay_us` < 0 ise pin baştan yüksektir
+ * ve hiç düşmez.
+ *
+ * @param trig_us Ölçülen tetikleme darbesi (µs)
+ * @param result RX FIFO'ya yazılan sözcük
+ * @return int64_t Sonucun geldiği çevrim, gelmezse -1
+ */
+static int64_t echo_measure(pio_emu_t *sm, int32_t delay_us, int32_t width_us, double *trig_us,
+                            uint32_t *result) {
+    CHECK(pio_emu_put(sm, ECHO_TIMEOUT_STEPS), "TX FIFO dolu");
+    uint64_t limit = 3ull * ULTRASONIC_TIMEOUT_US * ECHO_CYCLES_PER_US;
+    uint64_t rise = delay_us < 0 ? 0 : (uint64_t)delay_us * ECHO_CYCLES_PER_US;
+    uint64_t fall = width_us < 0 ? UINT64_MAX : rise + (uint64_t)width_us * ECHO_CYCLES_PER_US;
+    uint64_t trig_cycles = 0;
+
+    for (uint64_t c = 0; c < limit; c++) {
+        sm->pin = delay_us < 0 || (width_us >= 0 && c >= rise && c < fall);
+        pio_emu_step(sm, 1);
+        trig_cycles += sm->set_pin;
+        if (pio_emu_get(sm, result)) {
+            *trig_us = (double)trig_cycles / ECHO_CYCLES_PER_US;
+            return (int64_t)c;
+        }
+    }
+    return -1;
+}
+
+static void test_ultrasonic(void) {
+    pio_emu_t sm;
+    if (!pio_emu_load(&sm, ECHO_PIO, false)) {
+        printf("HATA: %s\n", sm.error);
+        sim_check_failures++;
+        return;
+    }
+    double trig_us;
+    uint32_t r;
+
+    // 10 cm: yankı tetiklemeden 450 µs sonra, 583 µs
+    int64_t done = echo_measure(&sm, 450, 583, &trig_us, &r);
+    uint32_t steps = ECHO_TIMEOUT_STEPS - r;
+    CHECK(done >= 0 && r != ULTRASONIC_PIO_TIMEOUT, "yankili olcum sonuc vermedi");
+    CHECK(trig_us >= 10.0 && trig_us <= 10.5, "tetikleme %.1f us", trig_us);
+    CHECK(steps >= 583 * 5 - 1 && steps <= 583 * 5 + 1, "yanki %u adim (beklenen %u)", (unsigned)steps,
+          583u * 5u);
+
+    // Hedef yok: yankı hiç yükselmez
+    done = echo_measure(&sm, 0, -1, &trig_us, &r);
+    CHECK(done >= 0 && r == ULTRASONIC_PIO_TIMEOUT, "yankisiz olcum zaman asimi yazmadi (0x%08x)", (unsigned)r);
+
+    // Yankı pini yüksekte takılı: SM en çok bir zaman aşımı sonra döner
+    done = echo_measure(&sm, -1, 0, &trig_us, &r);
+    CHECK(done >= 0 && r == ULTRASONIC_PIO_TIMEOUT, "takili pinde sonuc 0x%08x", (unsigned)r);
+    CHECK(done >= 0 && done <= (int64_t)(ULTRASONIC_TIMEOUT_US + 20) * ECHO_CYCLES_PER_US,
+          "takili pinde %lld cevrim", (long long)done);
+    double stuck_ms = done >= 0 ? (double)done / ECHO_CYCLES_PER_US / 1000.0 : -1.0;
+
+    // Menzil dışı (zaman aşımından uzun) yankı da geçersizdir; sonraki ölçüm normaldir
+    done = echo_measure(&sm, 450, ULTRASONIC_TIMEOUT_US + 5000, &trig_us, &r);
+    CHECK(done >= 0 && r == ULTRASONIC_PIO_TIMEOUT, "uzun yankida sonuc 0x%08x", (unsigned)r);
+    sm.pin = false;
+    pio_emu_step(&sm, 10000u * ECHO_CYCLES_PER_US);
+    done = echo_measure(&sm, 450, 1000, &trig_us, &r);
+    steps = ECHO_TIMEOUT_STEPS - r;
+    CHECK(done >= 0 && steps >= 4999u && steps <= 5001u, "zaman asimi sonrasi yanki %u adim",
+          (unsigned)steps);
+    printf("ultrasonik: tetikleme %.1f us, takili pinde %.2f ms sonra zaman asimi\n", trig_us, stuck_ms);
+}
+
+static int selftest(void) {
+    test_clean_edges();
+    test_bounce();
+    test_long_hold();
+    test_ultrasonic();
+    return sim_check_summary();
+}
+
+int main(int argc, char **argv) {
+    if (sim_check_selftest_arg(argc, argv)) {
+        return selftest();
+    }
+    fprintf(stderr, "kullanim: %s --selftest\n", argv[0]);
+    return 2;
+}
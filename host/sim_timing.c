@@ -0,0 +1,113 @@
+/**
+ * @file sim_timing.c
+ * @brief Zamanlamaya duyarlı sürücü işlemlerinin sanal süre ve ihlal raporu
+ * @see \ref howto_host_sim
+ *
+ * Cihaz modellerini (sim_devices.h) bağlar, kartı başlatır ve her işlem için
+ * şunları yazar:
+ * - gecen_us: firmware'in harcadığı sanal süre
+ * - gereken_us: cihazların gerçekten meşgul olduğu süre (model toplamı)
+ * - ihlal: veri sayfası zamanlama/protokol ihlali sayısı
+ *
+ * Çıktı deterministiktir; bir sürücüdeki bekleme değiştirildiğinde önce/sonra
+ * çıktıları doğrudan karşılaştırılabilir.
+ *
+ * @code{.sh}
+ * ./build-host/host/rppicods_sim_timing            # tablo + ihlal listesi
+ * ./build-host/host/rppicods_sim_timing --strict   # ihlal varsa çıkış kodu 1
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico_training_board.h"
+#include "sim_devices.h"
+
+#define OP_GAP_US 100000 // İşlemler arası boşta süre (HC-SR04 ölçüm aralığından uzun)
+
+static float last_distance;
+
+static void op_init_board(void) { init_board(); }
+static void op_lcd_clear(void) { lcd_clear(); }
+static void op_lcd_cursor(void) { lcd_set_cursor(1, 0); }
+static void op_lcd_string(void) { lcd_string("0123456789ABCDEF"); }
+static void op_distance(void) { last_distance = measure_distance(); }
+static void op_distance_avg(void) { last_distance = get_average_distance(5, 60); }
+static void op_step(void) { step_turn(CW, 900, 8.0f); }
+
+/**
+ * @brief Ölçülen işlem
+ */
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} timing_op_t;
+
+static const timing_op_t ops[] = {
+    {"init_board", op_init_board},
+    {"lcd_clear", op_lcd_clear},
+    {"lcd_set_cursor", op_lcd_cursor},
+    {"lcd_string x16", op_lcd_string},
+    {"measure_distance", op_distance},
+    {"get_average_distance x5", op_distance_avg},
+    {"step_turn 8 tur @900", op_step},
+};
+
+int main(int argc, char **argv) {
+    bool strict = argc > 1 && strcmp(argv[1], "--strict") == 0;
+
+    stdio_init_all();
+    sim_devices_attach();
+    sim_hcsr04_set_distance(100.0f);
+
+    printf("%-24s %10s %10s %6s %5s %5s\n", "islem", "gecen_us", "gereken_us", "oran", "i2c",
+           "ihlal");
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        // İşlemler birbirinden bağımsız çağrılmış gibi araya boşluk bırakılır
+        if (i > 0) {
+            sim_run_for_us(OP_GAP_US);
+        }
+
+        sim_device_counters_t before, after;
+        sim_devices_counters(&before);
+        uint32_t violations = sim_violation_count();
+        uint32_t i2c = sim_i2c_count();
+        uint64_t start = sim_now_us();
+
+        ops[i].run();
+        sim_devices_flush();
+
+        uint64_t elapsed = sim_now_us() - start;
+        sim_devices_counters(&after);
+        uint64_t required = (after.lcd_required_us - before.lcd_required_us) +
+                            (after.ping_required_us - before.ping_required_us) +
+                            (after.step_required_us - before.step_required_us);
+        printf("%-24s %10llu %10llu %6.1f %5lu %5lu\n", ops[i].name,
+               (unsigned long long)elapsed, (unsigned long long)required,
+               required ? (double)elapsed / (double)required : 0.0,
+               (unsigned long)(sim_i2c_count() - i2c),
+               (unsigned long)(sim_violation_count() - violations));
+    }
+
+    char line[17];
+    sim_lcd_get_line(0, line, sizeof(line));
+    printf("\nlcd[0] \"%s\"\n", line);
+    sim_lcd_get_line(1, line, sizeof(line));
+    printf("lcd[1] \"%s\"\n", line);
+    printf("mesafe %.1f cm (model 100.0)\n", last_distance);
+    int32_t pos = sim_stepper_position();
+    printf("motor %ld yarim adim (%.2f derece)\n", (long)pos,
+           360.0 * pos / SIM_STEPPER_HALF_STEPS_REV);
+
+    uint32_t total = sim_violation_count();
+    printf("\nihlal: %lu\n", (unsigned long)total);
+    sim_violation_t v;
+    for (uint32_t i = 0; sim_violation_get(i, &v); i++) {
+        printf("%10llu us  %-8s %s\n", (unsigned long long)v.timestamp_us, v.device, v.message);
+    }
+    if (total > SIM_VIOLATION_LOG_LEN) {
+        printf("... %lu kayit daha\n", (unsigned long)(total - SIM_VIOLATION_LOG_LEN));
+    }
+    return strict && total > 0 ? 1 : 0;
+}
@@ -15,6 +15,12 @@
  * - Işık sensörü (GPIO26)
  */
 void init_adc(void) {
+    if (pin_claim(LDR_1, PIN_FUNC_ADC, "adc") != PIN_CLAIM_NEW) {
+        return;  // Zaten başlatıldı (veya pin başka modülde)
+    }
+    pin_claim(POT_1, PIN_FUNC_ADC, "adc");
+    pin_claim(KEYPAD, PIN_FUNC_ADC, "adc");
+
     adc_init();
     adc_gpio_init(LDR_1);    // Işık sensörü 0
     adc_gpio_init(POT_1);    // Potansiyometre 1
@@ -27,12 +33,14 @@ void init_adc(void) {
  * Aşağıdakiler için PWM kanallarını yapılandırır:
  * - Buzzer
  * - RGB LED çıkışları
+ *
+ * @note Basit LED'ler SIO çıkışı olarak `init_leds()` ile başlatılır; PWM
+ *       parlaklık kontrolü için `init_led_pwm()` ayrıca çağrılabilir.
  */
 void init_pwm(void) {
     // Buzzer PWM'ini başlat
     init_buzzer_pwm();
     init_rgb_pwm();
-    init_led_pwm();
 }
 
 /**
@@ -75,8 +83,13 @@ uint init_pwm_pin(uint gpio, float frequency, uint16_t duty) {
  * standart 16x2 yapılandırması ile başlatır
  */
 void init_lcd(void) {
+    if (pin_claim(I2C_SDA, PIN_FUNC_I2C, "lcd") != PIN_CLAIM_NEW ||
+        pin_claim(I2C_SCL, PIN_FUNC_I2C, "lcd") != PIN_CLAIM_NEW) {
+        return;
+    }
+
     // LCD için I2C'yi başlat
-    i2c_init(I2C_PORT, 100 * 1000);  // 100 kHz
+    i2c_init(I2C_PORT, board_config.i2c_baud);  // Varsayılan 100 kHz
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA);
@@ -103,40 +116,48 @@ void init_lcd(void) {
     sleep_ms(2);  // Ekranı temizleme için daha uzun gecikme gerekli
 }
 
+/**
+ * @brief Bir başlatma adımını çalıştırır ve süresini açılış raporuna kaydeder
+ */
+#define BOOT_STEP(name, call)                                               \
+    do {                                                                    \
+        uint64_t boot_t0 = time_us_64();                                    \
+        call;                                                               \
+        peripherals_record_boot(name, (uint32_t)(time_us_64() - boot_t0));  \
+    } while (0)
+
 /**
  * @brief Tüm kart bileşenlerini başlatır
  * 
  * Diğer tüm başlatma fonksiyonlarını çağıran ve butonlar ve LED'ler için
- * GPIO pinlerini ayarlayan ana başlatma fonksiyonu
+ * GPIO pinlerini ayarlayan ana başlatma fonksiyonu. Her çevre birimi pin
+ * kaydı üzerinden tam olarak bir kez yapılandırılır; adım süreleri
+ * `peripherals_print_report()` ile raporlanır.
  */
 void init_board(void) {
     // stdio'yu başlat
-    stdio_init_all();
+    BOOT_STEP("stdio", stdio_init_all());
+
+    // Kalıcı yapılandırma (debounce, I2C hızı, tuş eşikleri ...) diğer adımlardan önce
+    BOOT_STEP("config", config_load());
     
     // Tüm alt sistemleri başlat
-    init_adc();
-    init_pwm();
-    init_lcd();
-    init_buzzer_pwm();
-    init_buttons();
-    init_ultrasonic();
-    init_pir(); // Yeni eklenen fonksiyon çağrısı
-    
-    // Basit LED'ler
-    gpio_init(LED_RED);
-    gpio_init(LED_YELLOW);
-    gpio_init(LED_GREEN);
-    gpio_set_dir(LED_RED, GPIO_OUT);
-    gpio_set_dir(LED_YELLOW, GPIO_OUT);
-    gpio_set_dir(LED_GREEN, GPIO_OUT);
+    BOOT_STEP("adc", init_adc());
+    BOOT_STEP("adc_stream", adc_stream_start()); // ADC'yi DMA ile sürekli örnekle
+    BOOT_STEP("analog_filter", analog_filter_start()); // Analog kanalları filtrele
+    BOOT_STEP("datalog", datalog_init()); // Flash veri kaydının yazma konumunu bul
+    BOOT_STEP("keypad_scan", keypad_scanner_start()); // Tuş olaylarını arka planda topla
+    BOOT_STEP("pwm", init_pwm());
+    BOOT_STEP("lcd", init_lcd());
+    BOOT_STEP("buttons", init_buttons());
+    BOOT_STEP("ultrasonic", init_ultrasonic());
+    BOOT_STEP("ultrasonic_pio", ultrasonic_start(ULTRASONIC_RATE_HZ, distance_filter_update)); // Mesafeyi PIO ile ölç ve filtrele
+    BOOT_STEP("pir", init_pir());
+    BOOT_STEP("stepper", init_step_motor());
+    BOOT_STEP("bt_uart", bt_uart_init(BT_UART_BAUD)); // Bluetooth modülü (UART0, DMA)
     
-    // Tüm çıkışları bilinen duruma başlat
-    gpio_put(LED_RED, LOW);
-    gpio_put(LED_YELLOW, LOW);
-    gpio_put(LED_GREEN, LOW);
-    gpio_put(RGB_B, LOW);
-    gpio_put(RGB_G, LOW);
-    gpio_put(RGB_R, LOW);
+    // Basit LED'ler (SIO çıkışı, kapalı)
+    BOOT_STEP("leds", init_leds());
     
     // Tüm bileşenlerin hazır olduğundan emin olmak için küçük bir gecikme
     sleep_ms(100);
@@ -0,0 +1,108 @@
+/**
+ * @file input_pio.c
+ * @brief Dijital girişler (butonlar, PIR) için PIO tabanlı donanım debounce sürücüsü
+ * @see \ref howto_buttons
+ *
+ * Her giriş pini pio0 üzerinde ayrı bir durum makinesine bağlanır ve
+ * input_debounce.pio programı ile entegre eden debounce uygulanır. CPU'ya
+ * yalnızca temiz seviye değişimleri ulaşır: RX FIFO boş değilken PIO0_IRQ_0
+ * tetiklenir, işleyici FIFO'ları boşaltıp pinin geri çağrısını çalıştırır.
+ * Sıçrama sırasında hiç kesme oluşmaz.
+ *
+ * pio0'da 4 durum makinesi vardır; bağlanamayan girişler için çağıran
+ * kendi GPIO kesmesi yoluna döner.
+ */
+
+#include "pico_training_board.h"
+#include "input_debounce.pio.h"
+
+#define INPUT_PIO pio0
+#define INPUT_PIO_IRQ PIO0_IRQ_0
+#define INPUT_PIO_MAX_CHANNELS 4
+
+/**
+ * @brief Bir durum makinesine bağlı girişin bilgileri
+ */
+typedef struct {
+    uint gpio;                       ///< İzlenen GPIO
+    uint sm;                         ///< Durum makinesi
+    uint32_t debounce_us;            ///< Temiz bir kenarın bildirilme gecikmesi
+    input_level_callback_t callback; ///< Seviye değişiminde çağrılır
+} input_channel_t;
+
+static input_channel_t channels[INPUT_PIO_MAX_CHANNELS];
+static uint channel_count = 0;
+static int program_offset = -1;
+
+/**
+ * @brief PIO RX FIFO kesme işleyicisi; tüm kanalların FIFO'larını boşaltır
+ *
+ * Kenar zamanı, bildirim anından debounce süresi çıkarılarak tahmin edilir.
+ */
+static void input_pio_irq_handler(void) {
+    uint64_t now = time_us_64();
+    for (uint i = 0; i < channel_count; i++) {
+        input_channel_t *ch = &channels[i];
+        while (!pio_sm_is_rx_fifo_empty(INPUT_PIO, ch->sm)) {
+            bool level = pio_sm_get(INPUT_PIO, ch->sm) != 0;
+            ch->callback(ch->gpio, level, now - ch->debounce_us);
+        }
+    }
+}
+
+/**
+ * @brief Bir giriş pinini PIO debounce durum makinesine bağlar
+ *
+ * İlk çağrıda program yüklenir ve kesme işleyicisi kurulur. Pin önceden
+ * giriş olarak yapılandırılmış olmalıdır (pull direnci dahil); PIO pinin
+ * fonksiyonunu değiştirmez, `gpio_get()` çalışmaya devam eder.
+ *
+ * @param gpio İzlenecek GPIO
+ * @param debounce_us Seviyenin kararlı sayılması için gereken süre
+ *                    (en çok ~300 ms; saat bölücü sınırı)
+ * @param callback Temiz seviye değişiminde kesme bağlamında çağrılır
+ * @return bool Bağlandıysa true; boş durum makinesi veya program alanı yoksa false
+ *
+ * @code{.c}
+ * if (!input_pio_attach(BUTTON_OK, BUTTON_DEBOUNCE_US, on_level)) {
+ *   // GPIO kesmesi ile yazılım debounce'a dön
+ * }
+ * @endcode
+ */
+bool input_pio_attach(uint gpio, uint32_t debounce_us, input_level_callback_t callback) {
+    if (channel_count >= INPUT_PIO_MAX_CHANNELS) {
+        return false;
+    }
+    if (program_offset < 0) {
+        if (!pio_can_add_program(INPUT_PIO, &input_debounce_program)) {
+            return false;
+        }
+        program_offset = (int)pio_add_program(INPUT_PIO, &input_debounce_program);
+        irq_set_exclusive_handler(INPUT_PIO_IRQ, input_pio_irq_handler);
+        irq_set_enabled(INPUT_PIO_IRQ, true);
+    }
+
+    int sm = pio_claim_unused_sm(INPUT_PIO, false);
+    if (sm < 0) {
+        return false;
+    }
+
+    // Temiz bir kenar INPUT_DEBOUNCE_THRESHOLD örnek sürer; örnek periyodunu buna göre seç
+    float sm_hz = (float)INPUT_DEBOUNCE_THRESHOLD * INPUT_DEBOUNCE_SAMPLE_CYCLES * 1e6f / debounce_us;
+    float clkdiv = (float)clock_get_hz(clk_sys) / sm_hz;
+    if (clkdiv > 65535.0f) clkdiv = 65535.0f;
+    if (clkdiv < 1.0f) clkdiv = 1.0f;
+
+    input_channel_t *ch = &channels[channel_count];
+    ch->gpio = gpio;
+    ch->sm = (uint)sm;
+    ch->debounce_us = debounce_us;
+    ch->callback = callback;
+
+    input_debounce_program_init(INPUT_PIO, ch->sm, (uint)program_offset, gpio, clkdiv);
+    // Kanal, kesme işleyicisi görmeden önce tamamen doldurulmuş olmalı
+    __dmb();
+    channel_count++;
+    pio_set_irq0_source_enabled(INPUT_PIO, pio_get_rx_fifo_not_empty_interrupt_source(ch->sm), true);
+    return true;
+}
@@ -6,6 +6,134 @@
 
 #include "pico_training_board.h"
 
+/**
+ * @brief Eşik tablosundaki tuşlar; `board_config.keypad_thresholds` ile aynı
+ *        sırada (azalan ADC seviyesi)
+ *
+ * Tuş `i`, `esik[i] < deger <= esik[i-1]` aralığında tanınır. Son eşiğin
+ * altı "tuş yok" bölgesidir. Eşikler kalıcı yapılandırmada (\ref howto_config)
+ * tutulur; varsayılanlar config.c'dedir.
+ */
+static const char key_chars[KEYPAD_KEY_COUNT] = {
+    '1', '2', '3', '4', '5', '6', '7', '8', '9', '*', '0', '#'
+};
+
+// Kalibrasyon sırasında yakalanan seviyeler; indeks KEYPAD_KEY_COUNT boşta seviyesidir
+static uint16_t captured_levels[KEYPAD_KEY_COUNT + 1];
+static uint16_t captured_mask = 0;
+
+// Son kararlı tuş (hysteresis referansı)
+static char stable_key = 0;
+
+/**
+ * @brief Tuş karakterinin tablo indeksini bulur
+ * @param key Tuş karakteri
+ * @return int Tablo indeksi, bulunamazsa -1
+ */
+static int key_index(char key) {
+    for (int i = 0; i < KEYPAD_KEY_COUNT; i++) {
+        if (key_chars[i] == key) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Bir ADC değerini ikili arama ile tuş indeksine çevirir
+ *
+ * Eşikler azalan sırada olduğundan `deger > esik[i]` koşulunu
+ * sağlayan en küçük `i` aranır. 12 tuş için her zaman 4 karşılaştırma yapılır.
+ *
+ * @param deger 12-bit ADC değeri
+ * @return int Tuş indeksi, tuş yoksa KEYPAD_KEY_COUNT
+ */
+static int decode_index(uint16_t deger) {
+    uint lo = 0, hi = KEYPAD_KEY_COUNT;
+    while (lo < hi) {
+        uint mid = (lo + hi) / 2;
+        if (deger > board_config.keypad_thresholds[mid]) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return (int)lo;
+}
+
+/**
+ * @brief Tek bir ADC değerini verilen referans tuşa göre hysteresis ile çözer
+ *
+ * Referans tuşun bandı her iki yönde KEYPAD_HYSTERESIS kadar genişletilir;
+ * eşik sınırındaki gürültü tuşu titretmez.
+ *
+ * @param deger 12-bit ADC değeri
+ * @param reference Önceki kararlı tuş (yoksa 0)
+ * @return char Tuş karakteri, tuş yoksa 0
+ */
+static char decode_with_reference(uint16_t deger, char reference) {
+    int prev = key_index(reference);
+    if (prev >= 0) {
+        uint32_t low = board_config.keypad_thresholds[prev];
+        low = (low > KEYPAD_HYSTERESIS) ? low - KEYPAD_HYSTERESIS : 0;
+        uint32_t high = (prev == 0) ? UINT32_MAX
+                                    : (uint32_t)board_config.keypad_thresholds[prev - 1] + KEYPAD_HYSTERESIS;
+        if (deger > low && deger <= high) {
+            return reference;
+        }
+    }
+
+    int idx = decode_index(deger);
+    return (idx < KEYPAD_KEY_COUNT) ? key_chars[idx] : 0;
+}
+
+/**
+ * @brief Tek bir ADC değerini `keypadOku()` ile aynı hysteresis referansına göre çözer
+ *
+ * @param deger 12-bit ADC değeri
+ * @return char Tuş karakteri, tuş yoksa 0
+ */
+char keypad_decode(uint16_t deger) {
+    return decode_with_reference(deger, stable_key);
+}
+
+/**
+ * @brief KEYPAD kanalının en son ardışık örneklerini alır
+ *
+ * Akış çalışıyorsa örnekler DMA tamponundan beklemeden kopyalanır; aksi halde
+ * ADC'den bloklu olarak okunur.
+ *
+ * @param out Örneklerin yazılacağı dizi (en yeni örnek başta)
+ * @param n Örnek sayısı (en çok ADC_STREAM_DEPTH)
+ */
+static void read_recent_samples(uint16_t *out, uint n) {
+    if (adc_stream_recent(2, out, n) == n) {
+        return;
+    }
+    for (uint i = 0; i < n; i++) {
+        out[i] = read_analog(2);
+    }
+}
+
+/**
+ * @brief Son KEYPAD_STABLE_SAMPLES örneği çözer
+ *
+ * @param reference Hysteresis referans tuşu
+ * @param key Tüm örnekler aynı tuşa çözüldüyse o tuş (tuş yoksa 0)
+ * @return bool Örnekler kararlıysa true
+ */
+static bool sample_stable_key(char reference, char *key) {
+    uint16_t samples[KEYPAD_STABLE_SAMPLES];
+    read_recent_samples(samples, KEYPAD_STABLE_SAMPLES);
+
+    char first = decode_with_reference(samples[0], reference);
+    for (uint i = 1; i < KEYPAD_STABLE_SAMPLES; i++) {
+        if (decode_with_reference(samples[i], reference) != first) {
+            return false;
+        }
+    }
+    *key = first;
+    return true;
+}
+
 /**
  * @brief Analog tuş takımını okur ve basılan tuşu döndürür
  * 
@@ -17,6 +145,10 @@
  * | 7 | 8 | 9 |
  * | * | 0 | # |
  *
+ * Eşikler azalan sıralı bir tablodan ikili arama ile aranır (bkz. keypad_decode()).
+ * Son KEYPAD_STABLE_SAMPLES ardışık örneğin tamamı aynı tuşa çözülmedikçe
+ * sonuç değişmez; geçiş anındaki örnekler yanlış tuş üretmez.
+ *
  * @return char Basılan tuşa karşılık gelen karakter, hiçbir tuşa basılmamışsa 0
  *
  * @code{.c}
@@ -31,43 +163,265 @@
  * @endcode
  */
 char keypadOku(void) {
-    // Tuş takımı için ADC girişini seç (GPIO28)
-    adc_select_input(2);
-    
-    // ADC değerini oku (12-bit çözünürlük: 0-4095)
-    uint16_t deger = adc_read();
-    
-    // Hiçbir tuşa basılmadığını kontrol et
-    if (deger > 0 && deger < 251) {
-        return 0;
+    // Tüm örnekler aynı tuşa çözülmezse son kararlı tuş korunur
+    char key;
+    if (!sample_stable_key(stable_key, &key)) {
+        return stable_key;
     }
-    
-    // ADC değerlerini tuş takımı karakterlerine eşle
-    // Değerler verimli kontrol için azalan sırada düzenlenmiştir
-    char key = 0;
-    
-    if      (deger > 2090) key = '1';
-    else if (deger > 1385) key = '2';
-    else if (deger > 735)  key = '3';
-    else if (deger > 620)  key = '4';
-    else if (deger > 574)  key = '5';
-    else if (deger > 530)  key = '6';
-    else if (deger > 401)  key = '7';
-    else if (deger > 361)  key = '8';
-    else if (deger > 340)  key = '9';
-    else if (deger > 281)  key = '*';
-    else if (deger > 261)  key = '0';
-    else if (deger > 248)  key = '#';
+    stable_key = key;
     
     if (key != 0) {
-        // Dokunsal geri bildirim için kısa bir bip sesi çal
-        uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-        play_note(NOTE_C4, 25); // Önceden tanımlanmış nota frekansını kullan
+        // Dokunsal geri bildirim için kısa, bloklamayan bir bip sesi çal
+        buzzer_beep_async(NOTE_C4, 25);
     }
     
     return key;
 }
 
+// Arka plan tuş tarayıcısı durumu
+static keypad_event_t scanner_storage[KEYPAD_EVENT_QUEUE_LEN];
+static event_queue_t scanner_queue;
+static repeating_timer_t scanner_timer;
+static bool scanner_running = false;
+
+static char scan_key = 0;          ///< Tarayıcının bildirdiği basılı tuş
+static char scan_candidate = 0;    ///< Onay bekleyen aday tuş
+static uint8_t scan_count = 0;     ///< Adayın art arda görüldüğü tarama sayısı
+static uint64_t next_repeat_us = 0;
+
+/**
+ * @brief Tarayıcı kuyruğuna bir olay ekler
+ * @param type Olay türü
+ * @param key Tuş karakteri
+ * @param now_us Zaman damgası (mikrosaniye)
+ */
+static void scanner_emit(keypad_event_type_t type, char key, uint64_t now_us) {
+    keypad_event_t ev = {
+        .timestamp_us = now_us,
+        .key = key,
+        .type = type
+    };
+    event_queue_push(&scanner_queue, &ev);
+    event_loop_post(EVENT_LOOP_KEYPAD);
+}
+
+/**
+ * @brief Tarayıcı zamanlayıcısı; her taramada tuş durum makinesini ilerletir
+ *
+ * Aday tuş KEYPAD_DEBOUNCE_SCANS tarama boyunca değişmezse kabul edilir.
+ * Kabul edilen tuş değişiminde RELEASE/PRESS, basılı tutulan tuş için
+ * KEYPAD_REPEAT_DELAY_MS sonra her KEYPAD_REPEAT_INTERVAL_MS'de REPEAT üretilir.
+ *
+ * @param rt Tekrarlı zamanlayıcı
+ * @return bool Zamanlayıcının devam etmesi için true
+ */
+static bool scanner_timer_callback(repeating_timer_t *rt) {
+    uint64_t now = time_us_64();
+    char key;
+    if (!sample_stable_key(scan_key, &key)) {
+        scan_count = 0;
+        return true;
+    }
+
+    if (key != scan_candidate) {
+        scan_candidate = key;
+        scan_count = 1;
+    } else if (scan_count < KEYPAD_DEBOUNCE_SCANS) {
+        scan_count++;
+    }
+
+    if (scan_count >= KEYPAD_DEBOUNCE_SCANS && scan_candidate != scan_key) {
+        if (scan_key != 0) {
+            scanner_emit(KEYPAD_EVENT_RELEASE, scan_key, now);
+        }
+        scan_key = scan_candidate;
+        if (scan_key != 0) {
+            scanner_emit(KEYPAD_EVENT_PRESS, scan_key, now);
+            next_repeat_us = now + KEYPAD_REPEAT_DELAY_MS * 1000ull;
+        }
+    } else if (scan_key != 0 && now >= next_repeat_us) {
+        scanner_emit(KEYPAD_EVENT_REPEAT, scan_key, now);
+        next_repeat_us += KEYPAD_REPEAT_INTERVAL_MS * 1000ull;
+    }
+    return true;
+}
+
+/**
+ * @brief Arka plan tuş tarayıcısını başlatır
+ *
+ * Tarayıcı KEYPAD_SCAN_RATE_HZ hızında DMA tamponundaki son örnekleri çözer ve
+ * PRESS / RELEASE / REPEAT olaylarını zaman damgasıyla kuyruğa ekler.
+ *
+ * @return bool Tarayıcı çalışıyorsa true
+ */
+bool keypad_scanner_start(void) {
+    if (scanner_running) {
+        return true;
+    }
+    event_queue_init(&scanner_queue, scanner_storage, sizeof(scanner_storage[0]),
+                     KEYPAD_EVENT_QUEUE_LEN);
+    scan_key = scan_candidate = 0;
+    scan_count = 0;
+    scanner_running = add_repeating_timer_us(-(int64_t)(1000000 / KEYPAD_SCAN_RATE_HZ),
+                                             scanner_timer_callback, NULL, &scanner_timer);
+    return scanner_running;
+}
+
+/**
+ * @brief Arka plan tuş tarayıcısını durdurur
+ */
+void keypad_scanner_stop(void) {
+    if (scanner_running) {
+        cancel_repeating_timer(&scanner_timer);
+        scanner_running = false;
+    }
+}
+
+/**
+ * @brief Kuyruktaki en eski tuş olayını alır; beklemez
+ *
+ * @param ev Olayın yazılacağı yapı
+ * @return bool Olay alındıysa true, kuyruk boşsa false
+ *
+ * @code{.c}
+ * keypad_event_t ev;
+ * while (keypad_get_event(&ev)) {
+ *   if (ev.type == KEYPAD_EVENT_PRESS) {
+ *     printf("%c basildi (%llu us)\n", ev.key, ev.timestamp_us);
+ *   }
+ * }
+ * @endcode
+ */
+bool keypad_get_event(keypad_event_t *ev) {
+    if (!scanner_running && event_queue_count(&scanner_queue) == 0) {
+        return false;
+    }
+    return event_queue_pop(&scanner_queue, ev);
+}
+
+/**
+ * @brief Tuş takımının anlık durumunu ortak örnek kaydına yazar
+ *
+ * `value` son ham ADC örneği, `raw` kararlı tuş karakteridir (tarayıcı
+ * çalışıyorsa tarayıcının, değilse `keypadOku()`'nun son kararı).
+ *
+ * @param out Örneğin yazılacağı kayıt
+ * @return bool Her zaman true
+ */
+bool keypad_sample(sensor_sample_t *out) {
+    out->sensor = SENSOR_KEYPAD;
+    out->value = (float)read_analog(2);
+    out->timestamp_us = time_us_64();
+    out->raw = (uint8_t)(scanner_running ? scan_key : stable_key);
+    out->valid = true;
+    return true;
+}
+
+/**
+ * @brief KEYPAD kanalının ortalama seviyesini ölçer
+ *
+ * @return uint16_t Son ADC_STREAM_DEPTH örneğin ortalaması
+ */
+uint16_t keypad_capture_level(void) {
+    uint16_t samples[ADC_STREAM_DEPTH];
+    read_recent_samples(samples, ADC_STREAM_DEPTH);
+    uint32_t sum = 0;
+    for (uint i = 0; i < ADC_STREAM_DEPTH; i++) {
+        sum += samples[i];
+    }
+    return (uint16_t)(sum / ADC_STREAM_DEPTH);
+}
+
+/**
+ * @brief Kalibrasyon için bir tuşun (veya boşta durumunun) seviyesini kaydeder
+ *
+ * @param key Tuş karakteri; boşta (tuşa basılmamış) seviye için 0
+ * @param level Ölçülen ADC seviyesi (bkz. keypad_capture_level())
+ * @return bool Tuş geçerliyse true
+ */
+bool keypad_calibration_set_level(char key, uint16_t level) {
+    int idx = (key == 0) ? KEYPAD_KEY_COUNT : key_index(key);
+    if (idx < 0) {
+        return false;
+    }
+    captured_levels[idx] = level;
+    captured_mask |= (uint16_t)(1u << idx);
+    return true;
+}
+
+/**
+ * @brief Yakalanan seviyelerden eşik tablosunu hesaplar ve etkinleştirir
+ *
+ * Her eşik, komşu iki tuş seviyesinin orta noktasıdır; son eşik en düşük tuş
+ * ile boşta seviyesinin orta noktasıdır.
+ *
+ * @return bool Tüm seviyeler yakalandı ve kesin azalan sıradaysa true
+ */
+bool keypad_calibration_apply(void) {
+    if (captured_mask != (uint16_t)((1u << (KEYPAD_KEY_COUNT + 1)) - 1u)) {
+        return false;
+    }
+    uint16_t thresholds[KEYPAD_KEY_COUNT];
+    for (int i = 0; i < KEYPAD_KEY_COUNT; i++) {
+        if (captured_levels[i] <= captured_levels[i + 1]) {
+            return false;  // Seviyeler ayrışmıyor
+        }
+        thresholds[i] = (uint16_t)((captured_levels[i] + captured_levels[i + 1]) / 2);
+    }
+    memcpy(board_config.keypad_thresholds, thresholds, sizeof(thresholds));
+    stable_key = 0;
+    return true;
+}
+
+/**
+ * @brief Etkin eşik tablosunu kalıcı yapılandırmayla birlikte flash'a kaydeder
+ *
+ * @return bool Yazım başarılıysa true (motor dönerken false; bkz. config_save())
+ */
+bool keypad_calibration_save(void) {
+    return config_save();
+}
+
+/**
+ * @brief LCD ve TAMAM butonu ile etkileşimli kalibrasyon modu
+ *
+ * Önce tuşa basılmadan boşta seviyesi, ardından her tuş sırayla ölçülür.
+ * Her adımda istenen tuşa basılı tutulurken TAMAM butonuna basılır.
+ * Başarılı olursa tablo etkinleştirilir ve flash'a kaydedilir.
+ *
+ * @param timeout_ms Her adım için en uzun bekleme (milisaniye, 0 ise sonsuz)
+ * @return bool Kalibrasyon tamamlanıp kaydedildiyse true
+ */
+bool keypad_calibrate_interactive(uint32_t timeout_ms) {
+    char message[LCD_COLS + 1];
+    captured_mask = 0;
+
+    for (int i = KEYPAD_KEY_COUNT; i >= 0; i--) {
+        char key = (i == KEYPAD_KEY_COUNT) ? 0 : key_chars[i];
+        lcd_clear();
+        lcd_set_cursor(0, 0);
+        if (key) {
+            snprintf(message, sizeof(message), "Tus %c basili", key);
+        } else {
+            snprintf(message, sizeof(message), "Tusa basmayin");
+        }
+        lcd_string(message);
+        lcd_set_cursor(1, 0);
+        lcd_string("OK ile onayla");
+
+        if (wait_for_button_press(timeout_ms) != BUTTON_OK) {
+            return false;
+        }
+        keypad_calibration_set_level(key, keypad_capture_level());
+    }
+
+    lcd_clear();
+    lcd_set_cursor(0, 0);
+    bool ok = keypad_calibration_apply() && keypad_calibration_save();
+    lcd_string(ok ? "Kalibrasyon OK" : "Kalibrasyon HATA");
+    return ok;
+}
+
 /**
  * @brief Analog giriş kullanarak bir düğmeye basılıp basılmadığını kontrol eder
  * 
@@ -82,8 +436,7 @@ bool analog_button_pressed(uint gpio) {
     static absolute_time_t last_press_time = {0};
     const uint32_t DEBOUNCE_MS = 200;
     
-    adc_select_input(gpio);
-    uint16_t adc_value = adc_read();
+    uint16_t adc_value = read_analog(gpio);
     
     absolute_time_t current_time = get_absolute_time();
     
@@ -104,8 +457,15 @@ bool analog_button_pressed(uint gpio) {
  * 
  * @param pin Okunacak ADC pin numarası
  * @return uint16_t Okunan analog değer (0-4095 arası)
+ *
+ * @note Sürekli örnekleme (`adc_stream_start()`) çalışıyorsa ADC beklenmez;
+ *       DMA tamponundaki en son örnek döndürülür.
  */
 uint16_t read_analog(uint8_t pin) {
+    if (adc_stream_is_running() && pin < ADC_STREAM_CHANNELS) {
+        return adc_stream_latest(pin);
+    }
+
     // Verilen pin için ADC kanalını seç
     adc_select_input(pin);
     
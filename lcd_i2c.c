@@ -42,10 +42,12 @@ void lcd_send_byte(uint8_t val, int mode) {
     uint8_t high = mode | (val & 0xF0) | LCD_BACKLIGHT;
     uint8_t low = mode | ((val << 4) & 0xF0) | LCD_BACKLIGHT;
 
+    TRACE_BEGIN(TRACE_LCD_SEND_BYTE);
     i2c_write_byte(high);
     lcd_toggle_enable(high);
     i2c_write_byte(low);
     lcd_toggle_enable(low);
+    TRACE_END(TRACE_LCD_SEND_BYTE);
 }
 
 /**
@@ -81,9 +83,11 @@ static void lcd_char(char val) {
  * @param s Null ile sonlandırılmış gönderilecek metin
  */
 void lcd_string(const char *s) {
+    TRACE_BEGIN(TRACE_LCD_STRING);
     while (*s) {
         lcd_char(*s++);
     }
+    TRACE_END(TRACE_LCD_STRING);
 }
 
 /**
@@ -10,21 +10,47 @@
  * Tüm üç RGB LED kanalını PWM ile yapılandırır
  */
 void init_rgb_pwm(void) {
+    static const uint rgb_pins[] = {RGB_R, RGB_G, RGB_B};
+
     // Her RGB kanalını başlat
-    init_pwm_pin(RGB_R, PWM_FREQ, 0);
-    init_pwm_pin(RGB_G, PWM_FREQ, 0);
-    init_pwm_pin(RGB_B, PWM_FREQ, 0);
+    for (uint i = 0; i < count_of(rgb_pins); i++) {
+        if (pin_claim(rgb_pins[i], PIN_FUNC_PWM, "rgb") == PIN_CLAIM_NEW) {
+            init_pwm_pin(rgb_pins[i], PWM_FREQ, 0);
+        }
+    }
 }
 
+static const uint led_pins[] = {LED_RED, LED_YELLOW, LED_GREEN};
+
 /**
  * @brief Standart LED çıkışları için PWM'i başlatır
  * Kırmızı, Sarı ve Yeşil LED'ler için PWM'i yapılandırır
+ *
+ * @note LED'ler `init_leds()` ile SIO çıkışı olarak başlatılmışsa PWM'e
+ *       geçirilir; bu durumda `gpio_put()` artık LED'leri sürmez.
  */
 void init_led_pwm(void) {
     // Standart LED'leri başlat
-    init_pwm_pin(LED_RED, PWM_FREQ, 0);
-    init_pwm_pin(LED_YELLOW, PWM_FREQ, 0);
-    init_pwm_pin(LED_GREEN, PWM_FREQ, 0);
+    for (uint i = 0; i < count_of(led_pins); i++) {
+        if (pin_claim(led_pins[i], PIN_FUNC_PWM, "leds") == PIN_CLAIM_NEW) {
+            init_pwm_pin(led_pins[i], PWM_FREQ, 0);
+        }
+    }
+}
+
+/**
+ * @brief Standart LED'leri SIO çıkışı olarak başlatır ve söndürür
+ *
+ * `gpio_put()` ile açma/kapama için kullanılır; `init_board()` çağırır.
+ */
+void init_leds(void) {
+    for (uint i = 0; i < count_of(led_pins); i++) {
+        if (pin_claim(led_pins[i], PIN_FUNC_SIO_OUT, "leds") == PIN_CLAIM_NEW) {
+            gpio_init(led_pins[i]);
+            gpio_set_dir(led_pins[i], GPIO_OUT);
+            gpio_put(led_pins[i], LOW);
+        }
+    }
 }
 
 /**
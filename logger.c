@@ -0,0 +1,275 @@
+/**
+ * @file logger.c
+ * @brief Çekirdek başına günlük halka tamponu ve ertelenmiş biçimlendirici
+ * @see \ref howto_logger
+ *
+ * Her çekirdeğin tek üreticili/tek tüketicili bir halkası vardır. Üretici
+ * çağıran çekirdektir (ana kod ve o çekirdeğin kesmeleri); yuva ayırma ve
+ * yazma, aynı çekirdekteki kesmelere karşı kısa bir
+ * `save_and_disable_interrupts()` bölümünde yapılır. Çekirdekler arası kilit
+ * yoktur: tüketici yalnızca `tail`'i, üretici yalnızca `head`'i yazar.
+ *
+ * Tüketici Core 0'daki log_flush()'tır. İki halkadan zaman damgası eski olan
+ * kayıt önce yazılır, böylece çekirdeklerin satırları sıralı görünür.
+ */
+
+#include <stdarg.h>
+
+#include "pico_training_board.h"
+
+#define LOG_LINE_LEN 128  // Biçimlendirilmiş satır (zaman ve seviye dahil)
+
+/**
+ * @brief Bir çekirdeğin günlük halkası
+ */
+typedef struct {
+    log_record_t records[LOG_RING_LEN];
+    volatile uint32_t head;     ///< Üretici (kaydı yazan çekirdek)
+    volatile uint32_t tail;     ///< Tüketici (log_flush)
+    volatile uint32_t written;  ///< Tampona yazılan kayıt
+    volatile uint32_t dropped;  ///< Tampon doluyken düşen kayıt
+} log_ring_t;
+
+static log_ring_t log_rings[2];
+static uint32_t log_flushed;
+static uint32_t log_dropped_reported;
+
+/**
+ * @brief Çağıran çekirdeğin halkasına bir kayıt ekler (LOG_* makroları çağırır)
+ *
+ * Biçimlendirme yapılmaz; çağrı ~1 µs'nin altındadır. Halka doluysa kayıt
+ * düşer ve sayılır (eski kayıtların üstüne yazılmaz, tüketici okuyor olabilir).
+ *
+ * @param level LOG_LEVEL_*
+ * @param fmt Sabit biçim dizgesi
+ * @param nargs Argüman sayısı
+ * @param wide 64 bit argümanların maskesi (LOG_WIDE_MASK); bunlar iki sözcük saklanır
+ * @param ... nargs adet uint64_t (LOG_ARG ile çevrilmiş)
+ */
+void __not_in_flash_func(log_write)(uint8_t level, const char *fmt, uint nargs, uint wide, ...) {
+    log_ring_t *r = &log_rings[get_core_num()];
+    va_list ap;
+    va_start(ap, wide);
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t head = r->head;
+    if (head - r->tail >= LOG_RING_LEN) {
+        r->dropped++;
+    } else {
+        log_record_t *rec = &r->records[head & (LOG_RING_LEN - 1)];
+        rec->timestamp_us = time_us_64();
+        rec->fmt = fmt;
+        rec->level = level;
+        rec->core = (uint8_t)get_core_num();
+        // LOG_AT sözcük sayısını derleme zamanında denetler; sığmayan argümanlar atılır
+        uint words = 0;
+        uint i = 0;
+        for (; i < nargs; i++) {
+            bool is_wide = (wide >> i) & 1u;
+            if (words + (is_wide ? 2u : 1u) > LOG_MAX_ARGS) {
+                break;
+            }
+            uint64_t v = va_arg(ap, uint64_t);
+            if (is_wide) {
+                rec->args[words++] = (log_word_t)(uint32_t)v;
+                rec->args[words++] = (log_word_t)(uint32_t)(v >> 32);
+            } else {
+                rec->args[words++] = (log_word_t)v;
+            }
+        }
+        rec->nargs = (uint8_t)i;
+        rec->wide = (uint8_t)(wide & ((1u << i) - 1u));
+        __dmb();  // Kayıt, head ilerlemeden önce diğer çekirdekte görünür olmalı
+        r->head = head + 1;
+        r->written++;
+    }
+    restore_interrupts(irq_state);
+    va_end(ap);
+}
+
+/**
+ * @brief Kaydın biçim dizgesini saklanan argümanlarla açar
+ *
+ * Her dönüşüm ayrı bir snprintf() ile yapılır. Uzunluk belirteçleri (h, l,
+ * z ...) atılır; argüman 64 bit saklandıysa veya belirteç 64 bit istiyorsa
+ * (`ll`, `j`, 64 bit hedefte `l`/`z`/`t`) tamsayı dönüşümüne `ll` eklenir.
+ * `%s` işaretçisi kayıt anında değil boşaltmada okunur, bu yüzden yalnızca
+ * sabit dizgeler verilmelidir.
+ *
+ * @return size_t out'a yazılan karakter
+ */
+static size_t log_format(char *out, size_t size, const log_record_t *rec) {
+    const char *p = rec->fmt;
+    size_t n = 0;
+    uint arg = 0;
+    uint word = 0;
+
+    while (*p != '\0' && n < size - 1) {
+        if (*p != '%') {
+            out[n++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[n++] = '%';
+            p += 2;
+            continue;
+        }
+
+        char spec[16];
+        size_t k = 0;
+        uint longs = 0;
+        bool len64 = false;
+        spec[k++] = *p++;
+        while (*p != '\0' && strchr("-+ #0123456789.hlzjtL", *p) != NULL) {
+            if (*p == 'l') {
+                longs++;
+            } else if (*p == 'j' || ((*p == 'z' || *p == 't') && sizeof(size_t) > sizeof(uint32_t))) {
+                len64 = true;
+            }
+            if (strchr("hlzjtL", *p) == NULL && k < sizeof(spec) - 4) {
+                spec[k++] = *p;
+            }
+            p++;
+        }
+        char conv = *p;
+        if (conv == '\0') {
+            break;
+        }
+        p++;
+
+        uint64_t w = 0;
+        bool is_wide = false;
+        if (arg < rec->nargs) {
+            is_wide = (rec->wide >> arg) & 1u;
+            w = rec->args[word++];
+            if (is_wide) {
+                w = (uint32_t)w | (uint64_t)rec->args[word++] << 32;
+            }
+        }
+        arg++;
+        bool ll = is_wide || longs >= 2 || len64 || (longs == 1 && sizeof(long) > sizeof(uint32_t));
+        if (ll && strchr("diouxX", conv) != NULL) {
+            spec[k++] = 'l';
+            spec[k++] = 'l';
+        }
+        spec[k++] = conv;
+        spec[k] = '\0';
+        int r;
+        switch (conv) {
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+                uint32_t bits = (uint32_t)w;
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                r = snprintf(&out[n], size - n, spec, (double)f);
+                break;
+            }
+            case 's':
+                r = snprintf(&out[n], size - n, spec, w ? (const char *)(uintptr_t)w : "(null)");
+                break;
+            case 'p':
+                r = snprintf(&out[n], size - n, spec, (void *)(uintptr_t)w);
+                break;
+            case 'c':
+                r = snprintf(&out[n], size - n, spec, (int)w);
+                break;
+            case 'd': case 'i':
+                if (ll) {
+                    // Dar argüman işaretli 32 bit saklanmış olabilir; 64 bite işaret genişletilir
+                    int64_t sv = is_wide ? (int64_t)w : (int64_t)(intptr_t)(log_word_t)w;
+                    r = snprintf(&out[n], size - n, spec, (long long)sv);
+                } else {
+                    r = snprintf(&out[n], size - n, spec, (int)(intptr_t)(log_word_t)w);
+                }
+                break;
+            default:
+                if (ll) {
+                    r = snprintf(&out[n], size - n, spec, (unsigned long long)w);
+                } else {
+                    r = snprintf(&out[n], size - n, spec, (unsigned int)w);
+                }
+                break;
+        }
+        if (r < 0) {
+            break;
+        }
+        n += (size_t)r < size - n ? (size_t)r : size - n - 1;
+    }
+    out[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Bekleyen kayıtları biçimlendirip stdio'ya yazar (yalnızca Core 0)
+ *
+ * İki çekirdeğin kayıtları zaman sırasıyla birleştirilir. Satır biçimi:
+ * `[zaman_us] <seviye><çekirdek> ileti` (seviye: E, W, I, D).
+ *
+ * @param max Yazılacak en fazla kayıt (0: hepsi)
+ * @return uint Yazılan kayıt sayısı
+ */
+uint log_flush(uint max) {
+    static const char level_chars[] = "-EWID";
+    char line[LOG_LINE_LEN];
+    uint count = 0;
+
+    while (max == 0 || count < max) {
+        log_ring_t *pick = NULL;
+        for (uint core = 0; core < 2; core++) {
+            log_ring_t *r = &log_rings[core];
+            if (r->tail == r->head) {
+                continue;
+            }
+            __dmb();
+            if (pick == NULL || r->records[r->tail & (LOG_RING_LEN - 1)].timestamp_us <
+                                    pick->records[pick->tail & (LOG_RING_LEN - 1)].timestamp_us) {
+                pick = r;
+            }
+        }
+        if (pick == NULL) {
+            break;
+        }
+
+        log_record_t rec = pick->records[pick->tail & (LOG_RING_LEN - 1)];
+        __dmb();  // Kopya bitmeden yuva üreticiye bırakılmaz
+        pick->tail++;
+
+        int n = snprintf(line, sizeof(line), "[%10llu] %c%u ", (unsigned long long)rec.timestamp_us,
+                         level_chars[rec.level <= LOG_LEVEL_DEBUG ? rec.level : 0], rec.core);
+        log_format(&line[n], sizeof(line) - (size_t)n, &rec);
+        puts(line);
+        count++;
+        log_flushed++;
+    }
+
+    uint32_t dropped = log_rings[0].dropped + log_rings[1].dropped;
+    if (dropped != log_dropped_reported) {
+        printf("gunluk: %lu kayit dusuruldu\n", (unsigned long)(dropped - log_dropped_reported));
+        log_dropped_reported = dropped;
+    }
+    return count;
+}
+
+/**
+ * @brief Zamanlayıcı görevi: her çalışmada en çok LOG_FLUSH_MAX kayıt yazar
+ */
+void log_flush_task(void) {
+    log_flush(LOG_FLUSH_MAX);
+}
+
+/**
+ * @brief Bekleyen kayıtları yazmadan atar (yalnızca Core 0; ölçüm firmware'i)
+ */
+void log_discard(void) {
+    for (uint core = 0; core < 2; core++) {
+        log_rings[core].tail = log_rings[core].head;
+    }
+}
+
+/**
+ * @brief Günlük sayaçlarını doldurur
+ * @param out Sayaçların yazılacağı yapı
+ */
+void log_get_stats(log_stats_t *out) {
+    out->written = log_rings[0].written + log_rings[1].written;
+    out->flushed = log_flushed;
+    out->dropped = log_rings[0].dropped + log_rings[1].dropped;
+}
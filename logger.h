@@ -0,0 +1,172 @@
+/**
+ * @file logger.h
+ * @brief Ertelenmiş biçimlendirmeli, seviyeli ve beklemeyen günlük makroları
+ * @see \ref howto_logger
+ *
+ * `LOG_WARN("motor: %u adim", n)` biçimlendirme yapmaz: biçim dizgesinin
+ * adresi (dizge flash'ta kalır, kimlik olarak kullanılır) ve ham argümanlar
+ * çağıran çekirdeğin RAM halka tamponuna yazılır. Biçimlendirme ve stdio'ya
+ * yazma Core 0'da düşük öncelikli log_flush() görevinde yapılır; çağrı
+ * USB/UART'ta beklemez, kesme bağlamından ve Core 1'den güvenle yapılır.
+ *
+ * `RPPICODS_LOG_LEVEL` altındaki seviyeler derleme zamanında kaldırılır;
+ * argümanları da değerlendirilmez.
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @defgroup logger Günlük Ayarları
+ * @{
+ */
+#define LOG_LEVEL_NONE 0   /**< Günlük kapalı */
+#define LOG_LEVEL_ERROR 1  /**< Yalnızca hatalar */
+#define LOG_LEVEL_WARN 2   /**< Uyarılar ve hatalar */
+#define LOG_LEVEL_INFO 3   /**< Bilgi (varsayılan) */
+#define LOG_LEVEL_DEBUG 4  /**< Ayrıntılı izleme */
+
+#ifndef RPPICODS_LOG_LEVEL
+#define RPPICODS_LOG_LEVEL LOG_LEVEL_INFO /**< Derlenen en ayrıntılı seviye */
+#endif
+
+#define LOG_MAX_ARGS 4          /**< Kayıt başına en fazla argüman sözcüğü (64 bit argüman iki sözcük) */
+#define LOG_RING_LEN 64         /**< Çekirdek başına kayıt (2'nin kuvveti); doluysa yeni kayıt düşer */
+#define LOG_FLUSH_PERIOD_MS 50  /**< log_flush() görevinin periyodu */
+#define LOG_FLUSH_MAX 16        /**< log_flush() çağrısı başına en fazla yazılan kayıt */
+/** @} */
+
+/** @brief Halka tampondaki argüman sözcüğü (işaretçi %s için sığmalı) */
+typedef uintptr_t log_word_t;
+
+/**
+ * @brief Halka tampondaki tek kayıt
+ */
+typedef struct {
+    uint64_t timestamp_us;          /**< time_us_64() */
+    const char *fmt;                /**< Biçim dizgesi (sabit; kimlik) */
+    uint8_t level;                  /**< LOG_LEVEL_* */
+    uint8_t core;                   /**< Kaydı yazan çekirdek */
+    uint8_t nargs;                  /**< Geçerli argüman sayısı */
+    uint8_t wide;                   /**< 64 bit argümanlar (bit i → argüman i; alt, üst 32 bit iki sözcük) */
+    log_word_t args[LOG_MAX_ARGS];  /**< Ham argümanlar (float'lar bit deseni olarak) */
+} log_record_t;
+
+/**
+ * @brief Günlük sayaçları
+ */
+typedef struct {
+    uint32_t written;  /**< Tampona yazılan kayıt */
+    uint32_t flushed;  /**< Biçimlendirilip stdio'ya yazılan kayıt */
+    uint32_t dropped;  /**< Tampon dolu olduğu için düşen kayıt */
+} log_stats_t;
+
+static inline uint64_t log_arg_float(double v) {
+    float f = (float)v;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static inline uint64_t log_arg_ptr(const void *p) {
+    return (uintptr_t)p;
+}
+
+static inline uint64_t log_arg_int(uint64_t v) {
+    return v;
+}
+
+/**
+ * @brief Bir argümanı türüne göre 64 bit değere çevirir (float/double → float bitleri)
+ *
+ * Tüm argümanlar log_write()'a uint64_t olarak geçer; kaç sözcük
+ * saklanacağını LOG_WIDE() belirler.
+ */
+#define LOG_ARG(x) _Generic((x), \
+    float: log_arg_float, double: log_arg_float, \
+    char *: log_arg_ptr, const char *: log_arg_ptr, \
+    void *: log_arg_ptr, const void *: log_arg_ptr, \
+    default: log_arg_int)(x)
+
+/**
+ * @brief Argüman 32 bitten geniş bir tamsayıysa 1 (int64_t, uint64_t, long long ...)
+ *
+ * Geniş argümanlar iki sözcük saklanır. Argüman değerlendirilmez.
+ */
+#define LOG_WIDE(x) _Generic((x), \
+    float: 0, double: 0, \
+    char *: 0, const char *: 0, \
+    void *: 0, const void *: 0, \
+    default: sizeof(x) > sizeof(uint32_t))
+
+#define LOG_NARGS_(_0, _1, _2, _3, _4, _5, N, ...) N
+#define LOG_NARGS(...) LOG_NARGS_(_0, ##__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define LOG_CAT_(a, b) a##b
+#define LOG_CAT(a, b) LOG_CAT_(a, b)
+#define LOG_MAP0()
+#define LOG_MAP1(a) , LOG_ARG(a)
+#define LOG_MAP2(a, b) , LOG_ARG(a), LOG_ARG(b)
+#define LOG_MAP3(a, b, c) , LOG_ARG(a), LOG_ARG(b), LOG_ARG(c)
+#define LOG_MAP4(a, b, c, d) , LOG_ARG(a), LOG_ARG(b), LOG_ARG(c), LOG_ARG(d)
+#define LOG_MAP5(...) , LOG_MAX_ARGS_EXCEEDED  // Derleme hatası: en fazla LOG_MAX_ARGS argüman
+#define LOG_MAP(...) LOG_CAT(LOG_MAP, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define LOG_WMAP0() 0u
+#define LOG_WMAP1(a) (LOG_WIDE(a) ? 1u : 0u)
+#define LOG_WMAP2(a, b) (LOG_WMAP1(a) | LOG_WMAP1(b) << 1)
+#define LOG_WMAP3(a, b, c) (LOG_WMAP2(a, b) | LOG_WMAP1(c) << 2)
+#define LOG_WMAP4(a, b, c, d) (LOG_WMAP3(a, b, c) | LOG_WMAP1(d) << 3)
+#define LOG_WMAP5(...) 0u
+/** @brief Geniş argümanların bit maskesi (derleme zamanı sabiti) */
+#define LOG_WIDE_MASK(...) LOG_CAT(LOG_WMAP, LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+/** @brief Kaydın kullandığı sözcük: argüman sayısı + geniş argüman sayısı */
+#define LOG_WORDS(...) (LOG_NARGS(__VA_ARGS__) + ((LOG_WIDE_MASK(__VA_ARGS__) & 1u) + \
+    (LOG_WIDE_MASK(__VA_ARGS__) >> 1 & 1u) + (LOG_WIDE_MASK(__VA_ARGS__) >> 2 & 1u) + \
+    (LOG_WIDE_MASK(__VA_ARGS__) >> 3 & 1u)))
+
+void log_write(uint8_t level, const char *fmt, uint nargs, uint wide, ...);
+
+/**
+ * @brief Seviye derleniyorsa kaydı yazar; biçim dizgesi sabit olmalıdır
+ *
+ * Argümanlar LOG_MAX_ARGS sözcüğe sığmazsa (ör. iki 64 bit ve iki 32 bit
+ * argüman) derleme hatası verir.
+ */
+#define LOG_AT(level, fmt, ...) \
+    ((void)sizeof(struct { \
+        _Static_assert(LOG_WORDS(__VA_ARGS__) <= LOG_MAX_ARGS, \
+                       "LOG_*: argumanlar LOG_MAX_ARGS sozcuge sigmiyor (64 bit arguman iki sozcuk)"); \
+        int log_words_ok; \
+    }), \
+     log_write((level), "" fmt, LOG_NARGS(__VA_ARGS__), LOG_WIDE_MASK(__VA_ARGS__) LOG_MAP(__VA_ARGS__)))
+
+#if RPPICODS_LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+#if RPPICODS_LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(fmt, ...) ((void)0)
+#endif
+#if RPPICODS_LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) ((void)0)
+#endif
+#if RPPICODS_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+
+// Boşaltma ve denetim
+uint log_flush(uint max);
+void log_flush_task(void);
+void log_discard(void);
+void log_get_stats(log_stats_t *out);
+
+#endif // LOGGER_H
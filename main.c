@@ -14,142 +14,92 @@ static volatile bool motor_running = false;
 static volatile bool motor_command_pending = false;
 static volatile motor_direction_t current_direction = CW;
 static volatile motor_direction_t requested_direction = CW;
-// Oynatılacak melodi: her eleman { nota, oktav } biçiminde olmalı
-static const char *MELODY1[][2] = {
-    {"C", "4"}, {"D", "4"}, {"E", "4"}, {"F", "4"},
-    {"G", "4"}, {"A", "4"}, {"B", "4"}, {"C", "5"}
-};
-
-// IRQ anti-repeat gating için minimum aralık (mikrosaniye)
-static volatile uint32_t last_irq_time_us = 0;
-static const uint32_t IRQ_MIN_INTERVAL_US = 50000; // 50 ms
 
 /**
- * @brief Button interrupt callback function
+ * @brief Motor boştaysa komutu Core 1'e gönderir ve yön LED'ini yakar
  *
- *  FIXME: Birden fazla komut geliyor kontrolü yapılacak !!!!
- */
-/**
- * @brief Buton kesme geri çağrısı
- * @param gpio Tetikleyen GPIO pini
- * @param events IRQ olay bayrakları
+ * Motor çalışırken gelen yeni komutlar yok sayılır, böylece komut kutusuna
+ * birden fazla komut gitmez.
+ *
+ * @param direction Motor yönü (CW: yeşil, CCW: kırmızı LED)
+ * @param speed Adım/saniye
+ * @param revolutions Devir sayısı
+ * @return bool Komut gönderildiyse true, motor meşgulse false
  */
-void button_callback(uint gpio, uint32_t events)
+static bool start_motor(motor_direction_t direction, uint speed, float revolutions)
 {
-    // Anti-repeat: minimum aralık kontrolü
-    uint32_t now = time_us_32();
-    if ((now - last_irq_time_us) < IRQ_MIN_INTERVAL_US) {
-        return;
-    }
-    last_irq_time_us = now;
-
-    if (gpio == BUTTON_UP && button_pressed(BUTTON_UP))
-    {
-        gpio_put(LED_GREEN, HIGH);
-        gpio_put(LED_YELLOW, LOW);
-        send_motor_parameters(CW, 900, 100.0f);
-    }
-    else if (gpio == BUTTON_DOWN && button_pressed(BUTTON_DOWN))
+    if (motor_running)
     {
-        gpio_put(LED_RED, HIGH);
-        gpio_put(LED_YELLOW, LOW);
-        send_motor_parameters(CCW, 900, 300.0f);
-    }
-    else if (gpio == BUTTON_OK && button_pressed(BUTTON_OK))
-    {
-        gpio_put(LED_GREEN, LOW);
-        gpio_put(LED_RED, LOW);
-        gpio_put(LED_YELLOW, HIGH);
+        return false;
     }
+    gpio_put(direction == CW ? LED_GREEN : LED_RED, HIGH);
+    gpio_put(LED_YELLOW, LOW);
+    motor_running = true;
+    send_motor_parameters(direction, speed, revolutions);
+    return true;
 }
 
 /**
- * @brief Initialize button interrupts for motor control
- *
- * FIXME: buton callbak değişecek birden fazla komut gidiyor !!!
-*/
-/**
- * @brief Motor kontrolü için buton kesmelerini başlatır
+ * @brief Uzaktan motor komutu: yön u8, hız u16 (adım/s), devir f32
  */
-void init_motor_buttons(void)
+static remote_status_t on_remote_motor(remote_port_t port, const uint8_t *payload, size_t len)
 {
-    // Configure button GPIO interrupts
-    gpio_set_irq_enabled_with_callback(BUTTON_UP,
-                                       GPIO_IRQ_EDGE_RISE, // Only rising edge
-                                       true,
-                                       &button_callback);
-
-    gpio_set_irq_enabled_with_callback(BUTTON_DOWN,
-                                       GPIO_IRQ_EDGE_RISE, // Only rising edge
-                                       true,
-                                       &button_callback);
-
-    gpio_set_irq_enabled_with_callback(BUTTON_OK,
-                                       GPIO_IRQ_EDGE_RISE, // Only rising edge
-                                       true,
-                                       &button_callback);
+    (void)port;
+    float revs;
+    if (len != 7)
+    {
+        return REMOTE_INVALID;
+    }
+    uint speed = payload[1] | (payload[2] << 8);
+    memcpy(&revs, &payload[3], sizeof(revs));
+    if ((payload[0] != CW && payload[0] != CCW) || speed == 0 || !(revs > 0.0f && revs < 1e6f))
+    {
+        return REMOTE_INVALID;
+    }
+    return start_motor((motor_direction_t)payload[0], speed, revs) ? REMOTE_OK : REMOTE_BUSY;
 }
 
 /**
- * @brief Core 1'de çalışacak işlev
- *
- * Bu fonksiyon RP2040'ın Core 1'inde çalışır ve multicore FIFO üzerinden Core 0'dan
- * gelen adım motoru kontrol komutlarını işler. 
- * Üç parametre işler: 
- * yön, hız ve devir sayısı.
- *
- * Fonksiyon:
- * 1. Core 0'dan gelen verileri bekler
- * 2. FIFO'dan motor parametrelerini okur
- * 3. Motor hareketini yürütür
- * 4. Core 0'a tamamlanma sinyalini geri gönderir
+ * @brief Tek bir buton olayını işler (ana döngü bağlamında)
  *
- * @note Bu fonksiyon sonsuz bir döngüde çalışır ve Core 0'ın verileri doğru
- *       sırada göndermesini gerektirir: yön, hız, devir sayısı
+ * Kesme yalnızca olayı kuyruğa ekler; motor komutu ve LED güncellemesi burada
+ * yapılır.
  *
- * @see step_turn()
- * @see multicore_fifo_pop_blocking()
- * @see multicore_fifo_push_blocking()
+ * @param ev Buton olayı
  */
-/**
- * @brief Core1 ana döngüsü; FIFO üzerinden gelen step motor komutlarını işler
- */
-void core1_main()
+void handle_button_event(const button_event_t *ev)
 {
-    while (true)
+    if (ev->type != BUTTON_PRESSED)
     {
-        // Wait for data from Core 0
-        if (multicore_fifo_rvalid())
-        {
-            // Read motor parameters from FIFO
-            uint32_t direction = multicore_fifo_pop_blocking(); // Direction parameter
-            uint32_t speed = multicore_fifo_pop_blocking();     // Speed parameter
-            uint32_t temp = multicore_fifo_pop_blocking();
-            float revolutions = *(float *)&(temp); // Convert uint32_t to float for revolutions
-
-            // Execute motor movement
-            step_turn((motor_direction_t)direction, speed, revolutions);
+        return;
+    }
 
-            // Send completion signal back to Core 0
-            multicore_fifo_push_blocking(0xDEAD); // Completion signal
-        }
+    if (ev->gpio == BUTTON_UP)
+    {
+        start_motor(CW, board_config.motor_speed, 100.0f);
+    }
+    else if (ev->gpio == BUTTON_DOWN)
+    {
+        start_motor(CCW, board_config.motor_speed, 300.0f);
+    }
+    else if (ev->gpio == BUTTON_OK)
+    {
+        gpio_put(LED_GREEN, LOW);
+        gpio_put(LED_RED, LOW);
+        gpio_put(LED_YELLOW, HIGH);
     }
 }
 
-float revolutions;
-
 /**
- * @brief Step motor parametrelerini Core1'e gönderir (yön, hız, devir)
- * @param direction Motor yönü
- * @param speed Adım/saniye
- * @param revolutions Devir sayısı (float)
+ * @brief Bekleyen tüm buton olaylarını işler
  */
-void send_motor_parameters(motor_direction_t direction, uint speed, float revolutions)
+void handle_button_events(void)
 {
-    // Core1'e veri gönder
-    multicore_fifo_push_blocking((uint32_t)direction);
-    multicore_fifo_push_blocking(speed);
-    multicore_fifo_push_blocking(*(uint32_t *)&revolutions);
+    button_event_t ev;
+    while (button_get_event(&ev))
+    {
+        handle_button_event(&ev);
+    }
 }
 
 /**
@@ -165,27 +115,35 @@ void write_analog_to_lcd(char *component_name, float value)
     // LCD ekrana veri yaz
 
     lcd_string(message);
-    sleep_ms(100);
 }
 
 /**
- * @brief Keypad’den tuş okur ve LCD’ye gösterir
+ * @brief Tuş takımı olay kuyruğunu boşaltır ve son basılan tuşu LCD’ye yazar
+ *
+ * Olaylar arka plan tarayıcısından gelir; fonksiyon beklemez ve ana döngü
+ * yavaş çalışsa bile tuş basışları kaybolmaz.
  */
 void display_keypad_value()
 {
+    keypad_event_t ev;
+    char last_key = 0;
 
-    int key = keypadOku();
-    if (key != 0)
+    while (keypad_get_event(&ev))
+    {
+        if (ev.type == KEYPAD_EVENT_PRESS || ev.type == KEYPAD_EVENT_REPEAT)
+        {
+            buzzer_beep_async(NOTE_C4, 25); // Dokunsal geri bildirim
+            last_key = ev.key;
+        }
+    }
+
+    if (last_key != 0)
     {
         lcd_clear();
         lcd_set_cursor(0, 0);
-        char ascii_key;
-        ascii_key = (char)key;
         char message[16];
-        snprintf(message, sizeof(message), "Keypad:%c", ascii_key);
+        snprintf(message, sizeof(message), "Keypad:%c", last_key);
         lcd_string(message);
-        // write_analog_to_lcd("Keypad", key);
-        sleep_ms(300);
     }
 }
 
@@ -194,10 +152,11 @@ void display_keypad_value()
  */
 void display_potentiometer_value()
 {
-
+    TRACE_BEGIN(TRACE_DISPLAY);
     lcd_set_cursor(0, 0);
-    float pot_value = read_analog(1);
+    float pot_value = analog_filter_get(1);
     write_analog_to_lcd("POT_1", pot_value);
+    TRACE_END(TRACE_DISPLAY);
 }
 
 /**
@@ -205,98 +164,407 @@ void display_potentiometer_value()
  */
 void display_ldr_sensor_value()
 {
-
+    TRACE_BEGIN(TRACE_DISPLAY);
     lcd_set_cursor(1, 0);
-    float light_level = read_analog(0);
+    float light_level = analog_filter_get(0);
     write_analog_to_lcd("LDR_1", light_level);
+    TRACE_END(TRACE_DISPLAY);
 }
 
-// Hareket algılandığında melodiyi çalan fonksiyon
-// TODO: Fonksiyonu hareket algılandığında bir eylem yapacak hale getir.
-// LCD'e yazsın, mesafe sensorunu aktif hale getirsin ve buzzer'ı çalsın
-// LCD'e mesafe değerini yaz
+static presence_t presence;
+static bool presence_trace = false;
+
 /**
- * @brief Hareket algılandığında melodi çalar ve mesafeyi LCD'ye yazar
+ * @brief Varlık algılama görevi: PIR, mesafe ve LDR'yi birleştirir
+ *
+ * Her çalışmada tek örnek işlenir. Ultrasonik ölçüm yalnızca PIR etkinliği
+ * veya süren bir varlık varken açıktır. Girişte kısa bir bip ve (geçerliyse)
+ * mesafe, çıkışta kalış süresi yazılır. `presence trace` komutuyla girdiler
+ * tools/presence_replay.c'nin okuduğu CSV biçiminde stdio'ya dökülür.
  */
-void motion_detect(void)
+void presence_task()
 {
-    if (detect_motion()) {
-        // Her notayı 250 ms çal (gerektiğinde parametreleştirilebilir)
-        play_notes(MELODY1, (int)(sizeof(MELODY1) / sizeof(MELODY1[0])), 250);
+    TRACE_BEGIN(TRACE_PRESENCE);
+    presence_input_t in = {0};
+    distance_estimate_t d;
+    in.timestamp_us = time_us_64();
+    in.motion = detect_motion();
+    in.light = analog_filter_get(0);
+    if (distance_filter_get(&d) && !ultrasonic_is_paused() &&
+        in.timestamp_us - d.timestamp_us < PRESENCE_DISTANCE_MAX_AGE_US)
+    {
+        in.distance_valid = true;
+        in.distance_cm = d.distance_cm;
+        in.velocity_cm_s = d.velocity_cm_s;
+    }
+
+    presence_event_t ev = presence_update(&presence, &in);
+    ultrasonic_pause(!presence_wants_ranging(&presence, in.timestamp_us));
+    TRACE_COUNTER(TRACE_PRESENCE_CONFIDENCE, presence.confidence * 100.0f);
+    TRACE_END(TRACE_PRESENCE);
+
+    if (presence_trace)
+    {
+        printf("%llu,%d,%.1f,%.1f,%u\n", (unsigned long long)(in.timestamp_us / 1000), in.motion,
+               in.distance_valid ? in.distance_cm : -1.0f, in.velocity_cm_s, in.light);
+    }
+    if (ev == PRESENCE_ENTER)
+    {
+        buzzer_beep_async(NOTE_A4, 50);
+        if (in.distance_valid)
+        {
+            printf("varlik: giris, %.0f cm, guven %.2f\n", in.distance_cm, presence.confidence);
+        }
+        else
+        {
+            printf("varlik: giris, mesafe yok, guven %.2f\n", presence.confidence);
+        }
+    }
+    else if (ev == PRESENCE_LEAVE)
+    {
+        printf("varlik: cikis, kalis %llu s\n",
+               (unsigned long long)((in.timestamp_us - presence.entered_us) / 1000000));
     }
-    // LCD'e mesafe değerini yaz
-    lcd_clear();
-    init_ultrasonic();
-    float distance = measure_distance();
-    write_analog_to_lcd("Distance", distance);
+}
+
+/**
+ * @brief Core 1'den gelen mesajları işler (motor tamamlandı sinyali)
+ * @param events Bekleyen olay bitleri
+ */
+static void on_core1_message(uint32_t events)
+{
+    TRACE_BEGIN(TRACE_CORE1_MESSAGE);
+    uint32_t result;
+    while (event_loop_core1_pop(&result))
+    {
+        if (result == CORE1_MSG_MOTOR_DONE)
+        {
+            motor_running = false;
+            gpio_put(LED_GREEN, 0);
+            gpio_put(LED_RED, 0);
+            gpio_put(LED_YELLOW, 1);
+            printf("step_turn işlemi tamamlandı.\n");
+        }
+    }
+    TRACE_END(TRACE_CORE1_MESSAGE);
+}
+
+/**
+ * @brief Buton ve tuş takımı olaylarını işler
+ * @param events Bekleyen olay bitleri
+ */
+static void on_input_events(uint32_t events)
+{
+    TRACE_BEGIN(TRACE_INPUT_EVENTS);
+    if (events & EVENT_LOOP_BUTTON)
+    {
+        handle_button_events();
+    }
+    if (events & EVENT_LOOP_KEYPAD)
+    {
+        display_keypad_value();
+    }
+    TRACE_END(TRACE_INPUT_EVENTS);
+}
+
+static int counter = 0;
+
+/**
+ * @brief Çalışma sayacını LCD'nin ilk satırının sonuna yazar
+ */
+void display_counter()
+{
+    TRACE_BEGIN(TRACE_DISPLAY);
+    char buffer[16];
+    lcd_set_cursor(0, 11);
+    snprintf(buffer, sizeof(buffer), "C:%d", counter++);
+    lcd_string(buffer);
+    TRACE_END(TRACE_DISPLAY);
+}
+
+/**
+ * @brief stdio'dan gelen satır komutlarını işler (beklemez)
+ *
+ * Komutlar:
+ * - `stats`: görev başına CPU kullanımı, bitiş süresi kaçırma ve olay döngüsü istatistikleri
+ * - `stats reset`: görev istatistiklerini sıfırlar
+ * - `periph`: açılış süreleri ve pin sahipliği tablosu
+ * - `pir`: PIR doluluk istatistikleri
+ * - `presence`: varlık durumu ve güven skoru
+ * - `presence trace`: varlık girdilerinin CSV dökümünü açar/kapatır
+ * - `snap`: tüm sensörlerin eşzamanlı zaman damgalı görüntüsü
+ * - `trace`: iz tamponlarını döker ve boşaltır (RPPICODS_TRACE=1 derlemesinde)
+ * - `trace clear`: iz tamponlarını boşaltır
+ * - `load`: çekirdek yükü, yığın/heap tepe kullanımı ve buton kesmesi gecikmesi
+ * - `load reset`: yük penceresini ve kesme ölçümlerini sıfırlar
+ * - `bt`: Bluetooth UART sayaçları
+ * - `remote`: ikili protokol sayaçları
+ * - `log`: günlük tamponu sayaçları
+ *
+ * 0x00 ile başlayan baytlar ikili protokol çerçevesidir (bkz. remote.c) ve
+ * satıra eklenmez.
+ */
+void console_task()
+{
+    static char line[32];
+    static uint len = 0;
+    int c;
+
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        if (remote_feed(REMOTE_PORT_USB, (uint8_t)c))
+        {
+            continue;
+        }
+        if (c != '\r' && c != '\n')
+        {
+            if (len < sizeof(line) - 1)
+            {
+                line[len++] = (char)c;
+            }
+            continue;
+        }
+        line[len] = '\0';
+        len = 0;
+
+        if (strcmp(line, "stats") == 0)
+        {
+            event_loop_stats_t ev_stats;
+            event_loop_get_stats(&ev_stats);
+            scheduler_print_stats();
+            printf("bosta: %llu us, uyanma: %lu, en uzun gecikme: %lu us\n",
+                   (unsigned long long)ev_stats.idle_us,
+                   (unsigned long)ev_stats.wakeups,
+                   (unsigned long)ev_stats.max_latency_us);
+        }
+        else if (strcmp(line, "stats reset") == 0)
+        {
+            scheduler_reset_stats();
+        }
+        else if (strcmp(line, "periph") == 0)
+        {
+            peripherals_print_report();
+        }
+        else if (strcmp(line, "pir") == 0)
+        {
+            pir_stats_t pir;
+            pir_get_stats(&pir);
+            printf("hareket: %d, sure: %llu ms, son hareketten beri: %lld ms, son 1 dk: %lu, toplam: %lu\n",
+                   pir.motion,
+                   (unsigned long long)(pir.dwell_us / 1000),
+                   pir.since_last_motion_us == UINT64_MAX ? -1LL : (long long)(pir.since_last_motion_us / 1000),
+                   (unsigned long)pir.motion_events_last_min,
+                   (unsigned long)pir.total_motion_events);
+        }
+        else if (strcmp(line, "presence") == 0)
+        {
+            printf("varlik: %d, guven: %.2f, olcum: %s, giris: %lu, cikis: %lu\n",
+                   presence.present, presence.confidence,
+                   ultrasonic_is_paused() ? "durdu" : "acik",
+                   (unsigned long)presence.enters, (unsigned long)presence.leaves);
+        }
+        else if (strcmp(line, "presence trace") == 0)
+        {
+            presence_trace = !presence_trace;
+            if (presence_trace)
+            {
+                printf("t_ms,pir,distance_cm,velocity_cm_s,ldr\n");
+            }
+        }
+        else if (strcmp(line, "snap") == 0)
+        {
+            static const char *const names[SENSOR_COUNT] = {"ldr", "pot", "keypad", "mesafe", "pir", "buton"};
+            sensor_snapshot_t snap;
+            bool in_window = sensor_capture_sync(&snap, 0);
+            for (uint i = 0; i < SENSOR_COUNT; i++)
+            {
+                const sensor_sample_t *smp = &snap.samples[i];
+                printf("%-7s %d %12llu %9.1f %lu\n", names[i], smp->valid,
+                       (unsigned long long)smp->timestamp_us, smp->value, (unsigned long)smp->raw);
+            }
+            printf("pencere: %llu us%s\n", (unsigned long long)(snap.end_us - snap.start_us),
+                   in_window ? "" : " (asildi)");
+        }
+        else if (strcmp(line, "trace") == 0)
+        {
+            trace_dump();
+        }
+        else if (strcmp(line, "trace clear") == 0)
+        {
+            trace_clear();
+        }
+        else if (strcmp(line, "load") == 0)
+        {
+            sysmon_print_report();
+        }
+        else if (strcmp(line, "load reset") == 0)
+        {
+            sysmon_reset();
+        }
+        else if (strcmp(line, "bt") == 0)
+        {
+            bt_uart_stats_t bt;
+            bt_uart_get_stats(&bt);
+            printf("bt: %u baud %s, alinan %lu, gonderilen %lu, bekleyen %lu/%lu, tasma %lu, dolu %lu, bos hat %lu\n",
+                   bt.baud, bt.dma ? "dma" : "kesme",
+                   (unsigned long)bt.rx_bytes, (unsigned long)bt.tx_bytes,
+                   (unsigned long)bt.rx_pending, (unsigned long)bt.tx_pending,
+                   (unsigned long)bt.rx_overrun, (unsigned long)bt.tx_full,
+                   (unsigned long)bt.idle_events);
+        }
+        else if (strcmp(line, "remote") == 0)
+        {
+            remote_stats_t rs;
+            remote_get_stats(&rs);
+            printf("remote: alinan %lu, hatali %lu, gonderilen %lu, dusen %lu, ornek %lu\n",
+                   (unsigned long)rs.rx_frames, (unsigned long)rs.rx_errors,
+                   (unsigned long)rs.tx_frames, (unsigned long)rs.tx_dropped,
+                   (unsigned long)rs.samples);
+        }
+        else if (strcmp(line, "log") == 0)
+        {
+            log_stats_t ls;
+            log_get_stats(&ls);
+            printf("gunluk: yazilan %lu, bosaltilan %lu, dusen %lu\n", (unsigned long)ls.written,
+                   (unsigned long)ls.flushed, (unsigned long)ls.dropped);
+        }
+        else if (strcmp(line, "datalog") == 0)
+        {
+            datalog_stats_t ds;
+            datalog_get_stats(&ds);
+            printf("kayit: acilis %u, sayfa %lu/%u (+%lu ram), kayit %lu, dusen %lu, ertelenen %lu, silme %lu "
+                   "(bekleyen %lu), flash hatasi %lu\n",
+                   ds.boot, (unsigned long)ds.pages_used, (unsigned)DATALOG_PAGES,
+                   (unsigned long)ds.pages_ram, (unsigned long)ds.records, (unsigned long)ds.dropped,
+                   (unsigned long)ds.deferred, (unsigned long)ds.erases, (unsigned long)ds.erase_pending,
+                   (unsigned long)ds.flash_errors);
+        }
+        else if (strcmp(line, "datalog sync") == 0)
+        {
+            datalog_sync();
+        }
+        else if (strcmp(line, "datalog dump") == 0)
+        {
+            datalog_export();
+        }
+        else if (strcmp(line, "datalog erase") == 0)
+        {
+            datalog_erase_all();
+        }
+        else if (strcmp(line, "config") == 0)
+        {
+            config_status_t cs;
+            config_get_status(&cs);
+            printf("config: surum %u, nesil %lu, sektor %c%s%s\n", cs.version, (unsigned long)cs.seq,
+                   cs.slot < 0 ? '-' : 'A' + cs.slot, cs.legacy_keypad ? ", eski tus kalibrasyonu" : "",
+                   cs.dirty ? ", kaydedilmedi" : "");
+            for (uint i = 0; i < config_field_count(); i++)
+            {
+                const config_field_t *f = config_field(i);
+                printf("%2u %-20s %g%s\n", i, f->name, (double)config_get(i), f->reboot ? " (acilista)" : "");
+            }
+        }
+        else if (strncmp(line, "config set ", 11) == 0)
+        {
+            char name[24];
+            float value;
+            int idx;
+            if (sscanf(&line[11], "%23s %f", name, &value) != 2 || (idx = config_find(name)) < 0)
+            {
+                printf("kullanim: config set <alan> <deger>\n");
+            }
+            else if (!config_set((uint)idx, value))
+            {
+                const config_field_t *f = config_field((uint)idx);
+                printf("gecersiz: %s %g..%g araliginda olmali%s\n", f->name, (double)f->min, (double)f->max,
+                       idx < KEYPAD_KEY_COUNT ? " ve tus esikleri azalan kalmali" : "");
+            }
+        }
+        else if (strcmp(line, "config save") == 0)
+        {
+            if (!config_save())
+            {
+                printf("config: kaydedilemedi%s\n", get_motor_state() == MOTOR_RUNNING ? " (motor donuyor)" : "");
+            }
+        }
+        else if (strcmp(line, "config defaults") == 0)
+        {
+            config_defaults();
+        }
+        else if (line[0] != '\0')
+        {
+            printf("bilinmeyen komut: %s\n", line);
+        }
+    }
+}
+
+/**
+ * @brief USB'ye veri geldiğinde konsolu beklemeden çalıştırır
+ *
+ * Böylece ikili protokol isteklerinin cevabı konsol görevinin periyodunu
+ * beklemez.
+ *
+ * @param events Bekleyen olay bitleri
+ */
+static void on_stdio_input(uint32_t events)
+{
+    console_task();
 }
 
 /**
  *  Ana program, adım motoru kontrolü için Raspberry Pi Pico Eğitim Kartı'nı başlatır.
  *
  *  Bu program, adım motorunu kontrol etmek için gerekli olan 
- *  ilklendirmeleri gerçekleştirir ve ana döngüde 
- *  kullanıcıdan veya geri çağırma işlevlerinden veri alarak 
- *  adım motoru kontrolünü sağlar.
+ *  ilklendirmeleri gerçekleştirir ve olay döngüsünde 
+ *  butonlardan, tuş takımından ve Core 1'den gelen olaylarla 
+ *  adım motoru kontrolünü sağlar. Olay yokken Core 0 uyur.
  *
  *  @return 0 Program başarıyla tamamlandığında.
  */
 int main()
 {
-    // Initialize system
-    init_board();
-    init_motor_buttons();
+    // Initialize system (butonlar kesme ile init_board() içinde başlatılır)
+    init_board(); // LED'ler dahil; yeniden gpio_init PWM/SIO sahipliğini bozar
 
-    gpio_init(LED_GREEN);
-    gpio_init(LED_YELLOW);
-    gpio_init(LED_RED);
-    gpio_set_dir(LED_GREEN, GPIO_OUT);
-    gpio_set_dir(LED_YELLOW, GPIO_OUT);
-    gpio_set_dir(LED_RED, GPIO_OUT);
+    // Yığınlar Core 1 başlamadan boyanır (tepe kullanımı ölçümü)
+    sysmon_init();
 
+    // Core 1 tamamlanma mesajını olay döngüsünün kuyruğuna yazar; kuyruk önce kurulur
+    event_loop_init();
 
-    // Core1 başlat
+    // Core1 başlat (motor komut kutusu init_board() -> init_step_motor() ile kuruldu)
     multicore_launch_core1(core1_main);
+    event_loop_register(EVENT_LOOP_CORE1, on_core1_message);
+    event_loop_register(EVENT_LOOP_BUTTON | EVENT_LOOP_KEYPAD, on_input_events);
+
+    // İkili komut/telemetri protokolü: USB (konsolla paylaşılır) ve Bluetooth UART
+    remote_init();
+    remote_register(REMOTE_MSG_MOTOR, on_remote_motor);
+    event_loop_register(EVENT_LOOP_STDIO, on_stdio_input);
+    event_loop_register(EVENT_LOOP_BT, remote_on_bt_event);
+
+    // Her ekran alanı kendi hızında güncellenir; yavaş bir görev diğerlerini kaydırmaz
+    scheduler_add_task("pot", display_potentiometer_value, 200, 50);
+    scheduler_add_task("ldr", display_ldr_sensor_value, 500, 100);
+    scheduler_add_task("sayac", display_counter, 1000, 200);
+    scheduler_add_task("konsol", console_task, 100, 100);
+    presence_init(&presence);
+    scheduler_add_task("varlik", presence_task, 50, 20);
+    scheduler_add_task("uzaktan", remote_task, REMOTE_TASK_PERIOD_MS, REMOTE_TASK_PERIOD_MS);
+    // Sensör zaman serisi flash'a; silme (~45 ms) motor dönerken ertelenir
+    datalog_start(SENSOR_LDR, 1000);
+    datalog_start(SENSOR_POT, 1000);
+    datalog_start(SENSOR_DISTANCE, 1000);
+    datalog_start(SENSOR_PIR, 1000);
+    scheduler_add_task("kayit", datalog_task, DATALOG_TASK_PERIOD_MS, 100);
+    // Günlük boşaltma en uzun bitiş süresiyle en düşük önceliklidir
+    scheduler_add_task("gunluk", log_flush_task, LOG_FLUSH_PERIOD_MS, 4 * LOG_FLUSH_PERIOD_MS);
 
-    int counter = 0;
-    char buffer[16];
-
+    lcd_clear();
     while (true)
     {
-        // Kullanıcıdan veya bir callback fonksiyonundan veri al
-        // Example usage
-        lcd_clear();
-        lcd_set_cursor(1, 13);
-        sprintf(buffer, "%d", counter++);
-        lcd_string(buffer);
-        sleep_ms(1000);
-
-        // İş tamamlanmasını bekle
-        while (!multicore_fifo_rvalid())
-        {
-
-            display_keypad_value();
-            display_ldr_sensor_value();
-            display_potentiometer_value();
-            tight_loop_contents(); // Bekleme sırasında işlemciyi serbest bırak
-            //motion_detect(); // Hareket algılandığında melodi çal
-            lcd_set_cursor(0, 11);
-            sprintf(buffer, "C:%d", counter++);
-            lcd_string(buffer);
-            sleep_ms(1000);
-
-        }
-        uint32_t result = multicore_fifo_pop_blocking();
-        if (result == 0xDEAD)
-        {
-            gpio_put(LED_GREEN, 0);
-            gpio_put(LED_RED, 0);
-            gpio_put(LED_YELLOW, 1);
-            printf("step_turn işlemi tamamlandı.\n");
-        }
-
-        tight_loop_contents(); // Bekleme sırasında işlemciyi serbest bırak
+        // Görev yoksa bir sonraki çıkışa veya bir olaya kadar uyu
+        event_loop_poll(scheduler_run_due());
     }
-    
-
+    return 0;
 }
@@ -0,0 +1,153 @@
+/**
+ * @file peripherals.c
+ * @brief Pin sahipliği kaydı ve açılış süresi raporu
+ * @see \ref howto_peripherals
+ *
+ * Her modül bir pini yapılandırmadan önce `pin_claim()` ile sahiplenir.
+ * Kayıt, pinin hangi modül tarafından hangi işlev için ayarlandığını tutar:
+ * - Aynı modül aynı işlevi tekrar isterse yapılandırma atlanır (tek sefer başlatma)
+ * - Aynı modül işlevi değiştirirse (ör. ultrasonik tetikleme pini SIO -> PIO) izin verilir
+ * - Başka bir modül sahipli pini isterse çakışma kaydedilir ve istek reddedilir
+ *
+ * `init_board()` her alt sistemin başlatma süresini `peripherals_record_boot()`
+ * ile kaydeder; `peripherals_print_report()` ikisini birlikte yazar.
+ */
+
+#include "pico_training_board.h"
+
+#define PIN_COUNT 30
+#define BOOT_STEPS_MAX 24
+
+/**
+ * @brief Bir pinin kayıt bilgisi
+ */
+typedef struct {
+    const char *owner; ///< Sahip modül (NULL: sahipsiz)
+    pin_func_t func;   ///< Yapılandırılan işlev
+} pin_entry_t;
+
+/**
+ * @brief Bir açılış adımının süresi
+ */
+typedef struct {
+    const char *name;  ///< Adım adı
+    uint32_t us;       ///< Süre (µs)
+} boot_step_t;
+
+static pin_entry_t pins[PIN_COUNT];
+static uint32_t conflict_count = 0;
+
+static boot_step_t boot_steps[BOOT_STEPS_MAX];
+static uint boot_step_count = 0;
+
+static const char *const func_names[] = {
+    [PIN_FUNC_NONE] = "-",
+    [PIN_FUNC_SIO_IN] = "SIO giris",
+    [PIN_FUNC_SIO_OUT] = "SIO cikis",
+    [PIN_FUNC_PWM] = "PWM",
+    [PIN_FUNC_ADC] = "ADC",
+    [PIN_FUNC_I2C] = "I2C",
+    [PIN_FUNC_PIO] = "PIO",
+    [PIN_FUNC_UART] = "UART",
+};
+
+/**
+ * @brief Bir pini belirli bir işlev için sahiplenir
+ *
+ * @param gpio GPIO pini
+ * @param func İstenen işlev
+ * @param owner Sahip modül adı (statik dizgi; karşılaştırma işaretçi ile değil içerikle yapılır)
+ * @return pin_claim_t PIN_CLAIM_NEW ise çağıran pini yapılandırmalıdır;
+ *         PIN_CLAIM_ALREADY ise pin zaten aynı şekilde yapılandırılmıştır;
+ *         PIN_CLAIM_CONFLICT ise pin başka bir modüle aittir ve dokunulmamalıdır
+ *
+ * @code{.c}
+ * if (pin_claim(BUZZER_PIN, PIN_FUNC_PWM, "buzzer") == PIN_CLAIM_NEW) {
+ *   init_pwm_pin(BUZZER_PIN, PWM_FREQ, 0);
+ * }
+ * @endcode
+ */
+pin_claim_t pin_claim(uint gpio, pin_func_t func, const char *owner) {
+    if (gpio >= PIN_COUNT) {
+        return PIN_CLAIM_CONFLICT;
+    }
+    pin_entry_t *p = &pins[gpio];
+    if (p->owner == NULL) {
+        p->owner = owner;
+        p->func = func;
+        return PIN_CLAIM_NEW;
+    }
+    if (strcmp(p->owner, owner) == 0) {
+        if (p->func == func) {
+            return PIN_CLAIM_ALREADY;
+        }
+        p->func = func;
+        return PIN_CLAIM_NEW;
+    }
+    conflict_count++;
+    printf("pin cakismasi: GPIO%u %s (%s) istendi, %s (%s) kullaniyor\n",
+           gpio, owner, func_names[func], p->owner, func_names[p->func]);
+    return PIN_CLAIM_CONFLICT;
+}
+
+/**
+ * @brief Bir pinin sahipliğini bırakır; pin başka bir modüle verilebilir
+ * @param gpio GPIO pini
+ */
+void pin_release(uint gpio) {
+    if (gpio < PIN_COUNT) {
+        pins[gpio].owner = NULL;
+        pins[gpio].func = PIN_FUNC_NONE;
+    }
+}
+
+/**
+ * @brief Bir pinin sahibini döndürür
+ * @param gpio GPIO pini
+ * @return const char* Sahip modül adı, sahipsizse NULL
+ */
+const char *pin_owner(uint gpio) {
+    return gpio < PIN_COUNT ? pins[gpio].owner : NULL;
+}
+
+/**
+ * @brief Kayıt edilen pin çakışması sayısı
+ * @return uint32_t Reddedilen sahiplenme istekleri
+ */
+uint32_t pin_conflict_count(void) {
+    return conflict_count;
+}
+
+/**
+ * @brief Bir açılış adımının süresini kaydeder
+ * @param name Adım adı (statik dizgi)
+ * @param us Süre (µs)
+ */
+void peripherals_record_boot(const char *name, uint32_t us) {
+    if (boot_step_count < BOOT_STEPS_MAX) {
+        boot_steps[boot_step_count].name = name;
+        boot_steps[boot_step_count].us = us;
+        boot_step_count++;
+    }
+}
+
+/**
+ * @brief Açılış süreleri ve pin sahipliği tablosunu stdio'ya yazar
+ */
+void peripherals_print_report(void) {
+    uint32_t total = 0;
+    printf("%-16s %8s\n", "acilis adimi", "sure_us");
+    for (uint i = 0; i < boot_step_count; i++) {
+        printf("%-16s %8lu\n", boot_steps[i].name, (unsigned long)boot_steps[i].us);
+        total += boot_steps[i].us;
+    }
+    printf("%-16s %8lu\n\n", "toplam", (unsigned long)total);
+
+    printf("%-6s %-10s %s\n", "pin", "islev", "sahip");
+    for (uint gpio = 0; gpio < PIN_COUNT; gpio++) {
+        if (pins[gpio].owner) {
+            printf("GPIO%-2u %-10s %s\n", gpio, func_names[pins[gpio].func], pins[gpio].owner);
+        }
+    }
+    printf("cakisma: %lu\n", (unsigned long)conflict_count);
+}
@@ -18,10 +18,22 @@
 /* Pico-SDK kütüphaneleri */
 #include "hardware/gpio.h"
 #include "pico/multicore.h"
+#include "pico/util/queue.h"
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "hardware/adc.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "hardware/sync.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/uart.h"
+
+#include "presence.h"
+#include "trace.h"
+#include "logger.h"
 
 /**
  * @defgroup analog_inputs Analog Giriş Pin Tanımlamaları
@@ -32,6 +44,35 @@
 #define LDR_1 26  /**< Işık sensörü giriş pini */
 /** @} */
 
+/**
+ * @defgroup adc_stream Sürekli ADC Örnekleme (DMA)
+ * @{
+ */
+#define ADC_STREAM_CHANNELS 3    /**< Round-robin kanal sayısı (LDR_1, POT_1, KEYPAD) */
+#define ADC_STREAM_DEPTH 64      /**< Kanal başına halka tampon derinliği (örnek) */
+#define ADC_STREAM_RATE_HZ 10000 /**< Kanal başına örnekleme hızı (Hz) */
+#define ADC_STREAM_LEN (ADC_STREAM_CHANNELS * ADC_STREAM_DEPTH) /**< Tampondaki toplam örnek sayısı */
+/** @} */
+
+/**
+ * @defgroup analog_filter Analog Filtre Ayarları
+ * @details Her kanal için zincir: boxcar ondalama (2^DECIM_SHIFT örnek) -> kayan medyan
+ *          (MEDIAN_LEN örnek, tek sayı) -> üstel hareketli ortalama (alfa = 1/2^EMA_SHIFT).
+ *          Değerler derleme zamanı sabitleridir.
+ * @{
+ */
+#define ANALOG_FILTER_RATE_HZ 1000  /**< Filtrenin DMA tamponunu boşaltma hızı (Hz) */
+#define LDR_FILTER_DECIM_SHIFT 5    /**< LDR_1: 32 örnek ondalama (312 Hz çıkış) */
+#define LDR_FILTER_MEDIAN_LEN 5     /**< LDR_1: 5 örnek medyan */
+#define LDR_FILTER_EMA_SHIFT 4      /**< LDR_1: alfa = 1/16 */
+#define POT_FILTER_DECIM_SHIFT 4    /**< POT_1: 16 örnek ondalama (625 Hz çıkış) */
+#define POT_FILTER_MEDIAN_LEN 5     /**< POT_1: 5 örnek medyan */
+#define POT_FILTER_EMA_SHIFT 3      /**< POT_1: alfa = 1/8 */
+#define KEYPAD_FILTER_DECIM_SHIFT 3 /**< KEYPAD: 8 örnek ondalama (1250 Hz çıkış) */
+#define KEYPAD_FILTER_MEDIAN_LEN 3  /**< KEYPAD: 3 örnek medyan (sıçrama bastırma) */
+#define KEYPAD_FILTER_EMA_SHIFT 0   /**< KEYPAD: EMA yok (tuş geçişleri gecikmesin) */
+/** @} */
+
 /**
  * @defgroup button_inputs Buton Giriş Pin Tanımlamaları
  * @{
@@ -95,6 +136,9 @@ void step_turn(motor_direction_t direction, uint speed, float revolutions);
 void step_stop(void);
 void init_step_motor(void);
 void send_motor_parameters(motor_direction_t direction, uint speed, float revolutions);
+void core1_main(void);
+
+#define CORE1_MSG_MOTOR_DONE 0xDEADu /**< Core 1 motor komutunu bitirdi (event_loop_core1_pop()) */
 
 // Ultrasonik Sensör
 #define ULTRA_SONIC_TR 8 /**< Tetikleme pini */
@@ -104,6 +148,44 @@ void send_motor_parameters(motor_direction_t direction, uint speed, float revolu
 #define BLT_TX 0 /**< Bluetooth TX pini */
 #define BLT_RX 1 /**< Bluetooth RX pini */
 
+/**
+ * @defgroup bt_uart Bluetooth UART Ayarları
+ * @{
+ */
+#define BT_UART uart0                  /**< BLT_TX/BLT_RX'in bağlı olduğu UART (stdio'da kullanılmaz) */
+#define BT_UART_IRQ UART0_IRQ          /**< DMA'sız yolun kesmesi */
+#define BT_UART_BAUD 9600              /**< HC-05/HC-06 fabrika hızı; modül AT ile değiştirilirse güncelleyin */
+#define BT_UART_RX_RING_BITS 10        /**< Alma halka tamponu 2^bit bayt (DMA halka sarması) */
+#define BT_UART_RX_LEN (1u << BT_UART_RX_RING_BITS) /**< Alma tamponu (bayt) */
+#define BT_UART_TX_LEN 1024u           /**< Gönderme tamponu (bayt, 2'nin kuvveti) */
+#define BT_UART_IDLE_BITS 32           /**< Boş hat sayılan sessizlik (bit süresi, PL011 zaman aşımıyla aynı) */
+#define BT_UART_IDLE_MIN_US 1000       /**< Boş hat zamanlayıcısının en kısa periyodu */
+/** @} */
+
+/**
+ * @brief Bluetooth UART sürücü sayaçları
+ */
+typedef struct {
+    uint baud;             /**< uart_init()'in ayarladığı gerçek hız */
+    bool dma;              /**< DMA yolu mu (false: UART kesmesi) */
+    uint32_t rx_bytes;     /**< Tüketilen bayt */
+    uint32_t tx_bytes;     /**< Hatta gönderilen bayt */
+    uint32_t rx_pending;   /**< Okunmayı bekleyen bayt */
+    uint32_t tx_pending;   /**< Gönderilmeyi bekleyen bayt */
+    uint32_t rx_overrun;   /**< Okunmadan kaybolan bayt */
+    uint32_t tx_full;      /**< Tampon dolu olduğu için kısmen kabul edilen yazma */
+    uint32_t idle_events;  /**< Boş hat olayı sayısı */
+} bt_uart_stats_t;
+
+// Bluetooth UART fonksiyon prototipleri
+bool bt_uart_init(uint baud);
+size_t bt_uart_rx_peek(const uint8_t **data);
+void bt_uart_rx_consume(size_t len);
+size_t bt_uart_read(uint8_t *dst, size_t len);
+size_t bt_uart_write(const uint8_t *src, size_t len);
+size_t bt_uart_tx_free(void);
+void bt_uart_get_stats(bt_uart_stats_t *out);
+
 // PIR Sensör
 #define PIR_DETECTOR 19 /**< PIR hareket sensörü pini */
 
@@ -178,23 +260,554 @@ void send_motor_parameters(motor_direction_t direction, uint speed, float revolu
 #define NOTE_AS4 466.16 /**< La diyez notası frekansı */
 #define NOTE_B4 493.88 /**< Si notası frekansı */
 
+/**
+ * @defgroup keypad_decoder Tuş Takımı Çözücü Ayarları
+ * @{
+ */
+#define KEYPAD_KEY_COUNT 12      /**< Tuş sayısı */
+#define KEYPAD_HYSTERESIS 4      /**< Kararlı tuşun bandını genişleten ADC payı */
+#define KEYPAD_STABLE_SAMPLES 4  /**< Aynı tuşa çözülmesi gereken ardışık örnek sayısı */
+#define KEYPAD_SCAN_RATE_HZ 200  /**< Arka plan tarayıcı hızı (Hz) */
+#define KEYPAD_DEBOUNCE_SCANS 3  /**< Tuş değişimi için gereken art arda kararlı tarama sayısı */
+#define KEYPAD_REPEAT_DELAY_MS 500    /**< İlk REPEAT olayından önceki basılı tutma süresi */
+#define KEYPAD_REPEAT_INTERVAL_MS 150 /**< REPEAT olayları arası süre */
+#define KEYPAD_EVENT_QUEUE_LEN 16     /**< Tuş olay kuyruğu uzunluğu (2'nin kuvveti) */
+/** @} */
+
+/**
+ * @defgroup flash_layout Flash Yerleşimi
+ * @details Kalıcı veriler flash'ın sonundaki sektörlerde tutulur.
+ * @{
+ */
+#define CONFIG_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - 2 * FLASH_SECTOR_SIZE) /**< Yapılandırma sektörleri (A, ardından B) */
+#define KEYPAD_CAL_FLASH_OFFSET (CONFIG_FLASH_OFFSET + FLASH_SECTOR_SIZE) /**< Eski tuş takımı kalibrasyonu (B sektörü; config_load() taşır) */
+#define DATALOG_FLASH_SECTORS 64 /**< Veri kaydı bölgesi (sektör, 256 KB) */
+#define DATALOG_FLASH_OFFSET (CONFIG_FLASH_OFFSET - DATALOG_FLASH_SECTORS * FLASH_SECTOR_SIZE) /**< Veri kaydı bölgesinin başı */
+/** @} */
+
+/**
+ * @defgroup config Kalıcı Yapılandırma Ayarları
+ * @{
+ */
+#define CONFIG_MAGIC 0x31474643u          /**< Kayıt başlığı imzası ("CFG1") */
+#define CONFIG_VERSION 1                  /**< config_t şema sürümü (alan eklendikçe artar) */
+#define CONFIG_MOTOR_SPEED_DEFAULT 900    /**< Butonla başlatılan motorun varsayılan hızı (adım/s) */
+#define CONFIG_I2C_BAUD_DEFAULT 100000    /**< LCD I2C veri yolunun varsayılan hızı (Hz) */
+/** @} */
+
+/**
+ * @brief Kalıcı yapılandırma; RAM kopyası `board_config`
+ *
+ * Açılışta config_load() ile bir kez flash'tan okunur; sıcak yollar alanları
+ * doğrudan okur. Şema kuralları: alanlar 4 baytın katıdır, yalnızca sona
+ * eklenir, sırası ve türü değişmez; eklemede CONFIG_VERSION artırılır ve
+ * config.c'deki alan tablosuna satır eklenir. Eski kayıtta olmayan alanlar
+ * varsayılan değerini alır.
+ */
+typedef struct {
+    uint16_t keypad_thresholds[KEYPAD_KEY_COUNT]; /**< Tuş takımı alt eşikleri (azalan ADC; bkz. keypad.c) */
+    uint32_t button_debounce_us;  /**< Buton debounce süresi (µs; açılışta uygulanır) */
+    uint32_t pir_debounce_us;     /**< PIR debounce süresi (µs; açılışta uygulanır) */
+    float sound_speed;            /**< Ultrasonik ölçümde ses hızı (m/s) */
+    uint32_t i2c_baud;            /**< LCD I2C hızı (Hz; açılışta uygulanır) */
+    uint32_t motor_speed;         /**< Butonla başlatılan motor hızı (adım/s) */
+} config_t;
+
+/**
+ * @brief Yapılandırma alanının türü
+ */
+typedef enum {
+    CONFIG_U16,  /**< uint16_t */
+    CONFIG_U32,  /**< uint32_t */
+    CONFIG_F32   /**< float */
+} config_type_t;
+
+/**
+ * @brief Konsol ve protokolden adla/indeksle erişilen alan tanımı
+ */
+typedef struct {
+    const char *name;  /**< Alan adı (konsol) */
+    uint16_t offset;   /**< config_t içindeki konum */
+    uint8_t type;      /**< config_type_t */
+    bool reboot;       /**< Değişiklik yeniden açılışta etkinleşir */
+    float min;         /**< En küçük geçerli değer */
+    float max;         /**< En büyük geçerli değer */
+} config_field_t;
+
+/**
+ * @brief Yapılandırmanın kaynağı ve kayıt durumu
+ */
+typedef struct {
+    uint32_t seq;        /**< Etkin kaydın nesil numarası (0: kayıt yok) */
+    int8_t slot;         /**< Etkin sektör (0: A, 1: B, -1: yok) */
+    uint8_t version;     /**< Yüklenen kaydın şema sürümü (0: kayıt yok) */
+    bool legacy_keypad;  /**< Eşikler eski tuş takımı kalibrasyonundan taşındı */
+    bool dirty;          /**< RAM kopyası kaydedilmemiş değişiklik içeriyor */
+} config_status_t;
+
+extern config_t board_config;
+
+// Yapılandırma fonksiyon prototipleri
+bool config_load(void);
+bool config_save(void);
+void config_defaults(void);
+uint config_field_count(void);
+const config_field_t *config_field(uint index);
+int config_find(const char *name);
+float config_get(uint index);
+bool config_set(uint index, float value);
+void config_get_status(config_status_t *out);
+
+#define CRC16_INIT 0xFFFF /**< CRC-16/CCITT başlangıç değeri */
+uint16_t crc16_ccitt(const uint8_t *data, size_t len, uint16_t crc);
+
+/**
+ * @brief Kilitsiz tek üretici / tek tüketici olay kuyruğu
+ */
+typedef struct {
+    uint8_t *storage;           /**< Eleman depolama alanı */
+    uint16_t elem_size;         /**< Eleman boyutu (byte) */
+    uint16_t mask;              /**< Kapasite - 1 (kapasite 2'nin kuvveti) */
+    volatile uint16_t head;     /**< Üretici indeksi */
+    volatile uint16_t tail;     /**< Tüketici indeksi */
+    volatile uint32_t dropped;  /**< Kuyruk doluyken düşürülen eleman sayısı */
+} event_queue_t;
+
+// Olay kuyruğu fonksiyon prototipleri
+void event_queue_init(event_queue_t *q, void *storage, uint16_t elem_size, uint16_t capacity);
+bool event_queue_push(event_queue_t *q, const void *elem);
+bool event_queue_pop(event_queue_t *q, void *elem);
+uint event_queue_count(const event_queue_t *q);
+
+/**
+ * @defgroup sensor_sample Ortak Sensör Örneği
+ * @{
+ */
+#define SENSOR_SYNC_WINDOW_US 5000 /**< sensor_capture_sync() varsayılan eşzamanlılık penceresi */
+/** @} */
+
+/**
+ * @brief Ortak örnek kaydındaki sensör kimlikleri
+ */
+typedef enum {
+    SENSOR_LDR,      /**< Işık sensörü (ADC 0) */
+    SENSOR_POT,      /**< Potansiyometre (ADC 1) */
+    SENSOR_KEYPAD,   /**< Analog tuş takımı (ADC 2) */
+    SENSOR_DISTANCE, /**< Ultrasonik mesafe */
+    SENSOR_PIR,      /**< PIR hareket sensörü */
+    SENSOR_BUTTONS,  /**< Dijital butonlar */
+    SENSOR_COUNT     /**< Sensör sayısı */
+} sensor_id_t;
+
+/**
+ * @brief Tüm sensörler için zaman damgalı ortak örnek kaydı
+ *
+ * | Sensör | value | raw |
+ * |--------|-------|-----|
+ * | LDR, POT | Filtrelenmiş ADC değeri | Son ham ADC örneği |
+ * | KEYPAD | Son ham ADC örneği | Kararlı tuş karakteri (0: yok) |
+ * | DISTANCE | Mesafe (cm, zaman aşımında -1) | Yankı süresi (µs) |
+ * | PIR | 0 / 1 | Mevcut seviyenin başladığı zamandan beri geçen ms |
+ * | BUTTONS | Basılı buton sayısı | `buttons_pressed_mask()` |
+ */
+typedef struct {
+    uint64_t timestamp_us; /**< Değerin fiziksel olarak ölçüldüğü an (time_us_64) */
+    float value;           /**< Birincil değer (tabloya bakın) */
+    uint32_t raw;          /**< Ek ham değer (tabloya bakın) */
+    uint8_t sensor;        /**< sensor_id_t */
+    bool valid;            /**< Örnek geçerli mi (kaynak kapalıysa false) */
+} sensor_sample_t;
+
+/**
+ * @brief Tüm sensörlerin eşzamanlı anlık görüntüsü
+ */
+typedef struct {
+    uint64_t start_us;                      /**< Geçerli örneklerin en erken zaman damgası */
+    uint64_t end_us;                        /**< Geçerli örneklerin en geç zaman damgası */
+    sensor_sample_t samples[SENSOR_COUNT];  /**< sensor_id_t ile indekslenir */
+} sensor_snapshot_t;
+
+/**
+ * @brief Tuş takımı olay türleri
+ */
+typedef enum {
+    KEYPAD_EVENT_PRESS,   /**< Tuş basıldı */
+    KEYPAD_EVENT_RELEASE, /**< Tuş bırakıldı */
+    KEYPAD_EVENT_REPEAT   /**< Tuş basılı tutuluyor (otomatik tekrar) */
+} keypad_event_type_t;
+
+/**
+ * @brief Zaman damgalı tuş takımı olayı
+ */
+typedef struct {
+    uint64_t timestamp_us;     /**< Olay zamanı (time_us_64) */
+    char key;                  /**< Tuş karakteri */
+    keypad_event_type_t type;  /**< Olay türü */
+} keypad_event_t;
+
 // Fonksiyon prototipleri
 char keypadOku(void);
+char keypad_decode(uint16_t deger);
 bool analog_button_pressed(uint gpio);
 
+// Tuş takımı kalibrasyon fonksiyon prototipleri
+uint16_t keypad_capture_level(void);
+bool keypad_calibration_set_level(char key, uint16_t level);
+bool keypad_calibration_apply(void);
+bool keypad_calibration_save(void);
+bool keypad_calibrate_interactive(uint32_t timeout_ms);
+
+// Arka plan tuş tarayıcı fonksiyon prototipleri
+bool keypad_scanner_start(void);
+void keypad_scanner_stop(void);
+bool keypad_get_event(keypad_event_t *ev);
+bool keypad_sample(sensor_sample_t *out);
+
+/**
+ * @defgroup button_timing Buton Zamanlama Ayarları
+ * @{
+ */
+#define BUTTON_DEBOUNCE_US 20000        /**< Varsayılan buton debounce süresi (`board_config.button_debounce_us`) */
+#define BUTTON_POLL_INTERVAL_US 100000  /**< button_pressed() basılı tutmada tekrar aralığı */
+#define BUTTON_HOLD_MS 1000             /**< BUTTON_HELD için basılı tutma süresi */
+#define BUTTON_DOUBLE_MS 400            /**< BUTTON_DOUBLE için iki basış arası en uzun süre */
+#define BUTTON_EVENT_QUEUE_LEN 16       /**< Buton olay kuyruğu uzunluğu (2'nin kuvveti) */
+/** @} */
+
 // Buton olay türleri
 typedef enum
 {
     BUTTON_PRESSED, /**< Buton basıldı */
     BUTTON_RELEASED, /**< Buton bırakıldı */
-    BUTTON_HELD /**< Buton tutuldu */
+    BUTTON_HELD, /**< Buton tutuldu */
+    BUTTON_DOUBLE /**< Butona çift tıklandı */
 } ButtonEvent;
 
+/**
+ * @brief Zaman damgalı buton olayı
+ */
+typedef struct {
+    uint64_t timestamp_us;  /**< Kenar zamanı (time_us_64) */
+    uint8_t gpio;           /**< Butonun GPIO pini */
+    ButtonEvent type;       /**< Olay türü */
+    uint32_t duration_ms;   /**< Basılı kalma süresi (BUTTON_RELEASED / BUTTON_HELD) */
+} button_event_t;
+
+/**
+ * @defgroup input_pio PIO Giriş Debounce Ayarları
+ * @{
+ */
+#define PIR_DEBOUNCE_US 50000 /**< Varsayılan PIR debounce süresi (`board_config.pir_debounce_us`) */
+#define PIR_LOG_LEN 64        /**< PIR kenar kaydı uzunluğu */
+/** @} */
+
+/**
+ * @brief Zaman damgalı PIR kenarı
+ */
+typedef struct {
+    uint64_t timestamp_us; /**< Kenar zamanı (time_us_64) */
+    bool motion;           /**< true: hareket başladı, false: bitti */
+} pir_event_t;
+
+/**
+ * @brief PIR kenar kaydından hesaplanan doluluk istatistikleri
+ */
+typedef struct {
+    bool motion;                     /**< Şu anki PIR seviyesi */
+    uint64_t dwell_us;               /**< Şu anki seviyenin süresi */
+    uint64_t since_last_motion_us;   /**< Son hareket başlangıcından beri (hiç yoksa UINT64_MAX) */
+    uint32_t motion_events_last_min; /**< Son 60 s'deki hareket başlangıcı sayısı */
+    uint32_t total_motion_events;    /**< Açılıştan beri hareket başlangıcı sayısı */
+} pir_stats_t;
+
+/**
+ * @brief PIO debounce sürücüsünün temiz seviye değişiminde çağırdığı fonksiyon tipi
+ * @param gpio Seviyesi değişen pin
+ * @param level Yeni kararlı seviye
+ * @param timestamp_us Tahmini kenar zamanı (time_us_64)
+ */
+typedef void (*input_level_callback_t)(uint gpio, bool level, uint64_t timestamp_us);
+
+// PIO giriş debounce fonksiyon prototipleri
+bool input_pio_attach(uint gpio, uint32_t debounce_us, input_level_callback_t callback);
+
+/**
+ * @defgroup event_loop Olay Döngüsü Olay Bitleri
+ * @{
+ */
+#define EVENT_LOOP_BUTTON (1u << 0) /**< Buton olay kuyruğunda yeni olay var */
+#define EVENT_LOOP_KEYPAD (1u << 1) /**< Tuş takımı olay kuyruğunda yeni olay var */
+#define EVENT_LOOP_CORE1  (1u << 2) /**< Core 1 mesaj kuyruğunda mesaj var */
+#define EVENT_LOOP_PIR    (1u << 3) /**< PIR seviyesi değişti */
+#define EVENT_LOOP_TIMER  (1u << 4) /**< Kullanıcı zamanlayıcısı */
+#define EVENT_LOOP_BT     (1u << 5) /**< Bluetooth UART'ta boş hat veya yarı dolu alma tamponu */
+#define EVENT_LOOP_STDIO  (1u << 6) /**< USB stdio'ya okunacak veri geldi */
+#define EVENT_LOOP_USER   (1u << 8) /**< Uygulamaya ayrılmış ilk bit */
+/** @} */
+
+/**
+ * @brief Olay işleyici fonksiyon tipi
+ * @param events İşleyicinin maskesiyle kesişen bekleyen olay bitleri
+ */
+typedef void (*event_handler_t)(uint32_t events);
+
+/**
+ * @brief Olay döngüsü istatistikleri
+ */
+typedef struct {
+    uint64_t idle_us;        /**< __wfe içinde geçen toplam süre */
+    uint32_t wakeups;        /**< Uykudan uyanma sayısı */
+    uint32_t dispatches;     /**< Olay dağıtım turu sayısı */
+    uint32_t max_latency_us; /**< event_loop_post() ile dağıtım arasındaki en uzun süre */
+} event_loop_stats_t;
+
+// Olay döngüsü fonksiyon prototipleri
+void event_loop_init(void);
+bool event_loop_register(uint32_t mask, event_handler_t handler);
+void event_loop_post(uint32_t events);
+void event_loop_core1_post(uint32_t msg);
+bool event_loop_core1_pop(uint32_t *msg);
+bool event_loop_poll(absolute_time_t until);
+void event_loop_run(void);
+void event_loop_get_stats(event_loop_stats_t *out);
+
+/**
+ * @defgroup scheduler Görev Zamanlayıcı Ayarları
+ * @{
+ */
+#define SCHEDULER_MAX_TASKS 8 /**< En fazla periyodik görev sayısı */
+/** @} */
+
+/** @brief Periyodik görev fonksiyon tipi; bloklamamalıdır */
+typedef void (*task_fn_t)(void);
+
+// Görev zamanlayıcı fonksiyon prototipleri
+int scheduler_add_task(const char *name, task_fn_t fn, uint32_t period_ms, uint32_t deadline_ms);
+absolute_time_t scheduler_run_due(void);
+void scheduler_print_stats(void);
+void scheduler_reset_stats(void);
+
+/**
+ * @brief Çekirdek yükü ve bellek izleyicisi ölçümleri (bkz. sysmon_get())
+ */
+typedef struct {
+    uint64_t window_us;             /**< Son sıfırlamadan beri geçen süre */
+    uint64_t idle_us[2];            /**< Çekirdek başına bekleme noktalarında geçen süre */
+    uint32_t stack_used[2];         /**< Yığın tepe kullanımı (bayt; simülasyonda 0) */
+    uint32_t stack_size[2];         /**< Yığın boyutu (bayt; simülasyonda 0) */
+    uint32_t heap_used;             /**< malloc ile ayrılmış bayt */
+    uint32_t heap_size;             /**< Heap bölgesinin boyutu */
+    uint32_t button_latency_max_us; /**< Buton kesmesinin en uzun gecikmesi */
+    uint32_t button_irq_max_us;     /**< Buton kesme işleyicisinin en uzun süresi */
+} sysmon_stats_t;
+
+// İzleyici fonksiyon prototipleri
+void sysmon_init(void);
+void sysmon_idle_enter(void);
+void sysmon_idle_exit(void);
+void sysmon_button_irq(uint32_t latency_us, uint32_t handler_us);
+void sysmon_reset(void);
+void sysmon_get(sysmon_stats_t *out);
+void sysmon_print_report(void);
+
+/**
+ * @defgroup remote Uzaktan Komut/Telemetri Protokolü Ayarları
+ * @{
+ */
+#define REMOTE_MAX_PAYLOAD 48     /**< Çerçeve başına en fazla yük (bayt) */
+#define REMOTE_FRAME_MAX (REMOTE_MAX_PAYLOAD + 4) /**< Tür + sıra + yük + CRC16 */
+#define REMOTE_WIRE_MAX (REMOTE_FRAME_MAX + 4)    /**< COBS ek baytı ve iki ayraç dahil hat uzunluğu */
+#define REMOTE_TASK_PERIOD_MS 5   /**< Abonelik görevinin periyodu */
+#define REMOTE_MAX_RATE_HZ 200    /**< Akış başına en yüksek örnek hızı */
+/** @} */
+
+/**
+ * @brief Protokolün taşındığı bağlantılar
+ */
+typedef enum {
+    REMOTE_PORT_USB, /**< USB CDC (stdio ile paylaşılır) */
+    REMOTE_PORT_BT,  /**< Bluetooth UART (yalnızca ikili) */
+    REMOTE_PORT_COUNT
+} remote_port_t;
+
+/**
+ * @brief Mesaj türleri (çerçevenin ilk baytı)
+ *
+ * 0x80 altı bilgisayardan karta istekler, üstü karttan cevaplar ve
+ * telemetridir. Yük alanları little-endian'dır; yerleşim için bkz.
+ * \ref howto_remote.
+ */
+typedef enum {
+    REMOTE_MSG_PING = 0x01,      /**< Yankı: yük aynen REMOTE_MSG_PONG ile döner */
+    REMOTE_MSG_MOTOR = 0x02,     /**< Yön u8, hız u16 (adım/s), devir f32 */
+    REMOTE_MSG_LCD = 0x03,       /**< Bayrak u8 (bit0: temizle), satır u8, sütun u8, metin */
+    REMOTE_MSG_BEEP = 0x04,      /**< Frekans u16 (Hz), süre u16 (ms) */
+    REMOTE_MSG_SUBSCRIBE = 0x05, /**< Sensör u8 (sensor_id_t), hız u16 (Hz, 0: durdur) */
+    REMOTE_MSG_STATS = 0x06,     /**< Protokol sayaçlarını ister */
+    REMOTE_MSG_CONFIG_GET = 0x07,  /**< Alan u8; cevap REMOTE_MSG_CONFIG_VALUE */
+    REMOTE_MSG_CONFIG_SET = 0x08,  /**< Alan u8, değer (u32 veya f32; RAM'e uygulanır) */
+    REMOTE_MSG_CONFIG_SAVE = 0x09, /**< RAM yapılandırmasını flash'a yazar */
+    REMOTE_MSG_ACK = 0x80,       /**< İstek türü u8, durum u8 (remote_status_t) */
+    REMOTE_MSG_PONG = 0x81,      /**< REMOTE_MSG_PING cevabı */
+    REMOTE_MSG_STATS_REPLY = 0x82, /**< remote_stats_t alanları (u32) */
+    REMOTE_MSG_CONFIG_VALUE = 0x83, /**< Alan u8, tür u8, açılışta u8, değer, en az f32, en çok f32, ad */
+    REMOTE_MSG_SAMPLE = 0x90     /**< Sensör u8, geçerli u8, zaman u64 (µs), değer f32, ham u32 */
+} remote_msg_t;
+
+/**
+ * @brief İstek sonucu (REMOTE_MSG_ACK)
+ */
+typedef enum {
+    REMOTE_OK,          /**< Uygulandı */
+    REMOTE_BUSY,        /**< Kaynak meşgul (ör. motor dönüyor) */
+    REMOTE_INVALID,     /**< Yük uzunluğu veya değer geçersiz */
+    REMOTE_UNSUPPORTED  /**< Tür için işleyici yok */
+} remote_status_t;
+
+/**
+ * @brief İstek işleyici fonksiyon tipi (ana döngü bağlamında çağrılır)
+ * @param port İsteğin geldiği bağlantı
+ * @param payload Yük
+ * @param len Yük uzunluğu
+ * @return remote_status_t REMOTE_MSG_ACK ile dönen durum
+ */
+typedef remote_status_t (*remote_handler_t)(remote_port_t port, const uint8_t *payload, size_t len);
+
+/**
+ * @brief Protokol sayaçları
+ */
+typedef struct {
+    uint32_t rx_frames;  /**< CRC'si doğru alınan çerçeve */
+    uint32_t rx_errors;  /**< COBS, CRC veya uzunluk hatalı çerçeve */
+    uint32_t tx_frames;  /**< Gönderilen çerçeve */
+    uint32_t tx_dropped; /**< Gönderme tamponu dolu olduğu için düşürülen çerçeve */
+    uint32_t samples;    /**< Gönderilen telemetri örneği */
+} remote_stats_t;
+
+// Uzaktan protokol fonksiyon prototipleri
+void remote_init(void);
+bool remote_register(uint8_t type, remote_handler_t handler);
+bool remote_feed(remote_port_t port, uint8_t byte);
+void remote_on_bt_event(uint32_t events);
+void remote_task(void);
+bool remote_send(remote_port_t port, uint8_t type, uint8_t seq, const void *payload, size_t len);
+void remote_get_stats(remote_stats_t *out);
+
+/**
+ * @defgroup datalog Flash Veri Kaydı Ayarları
+ * @{
+ */
+#define DATALOG_MAGIC 0x44474C31u  /**< Sayfa başlığı imzası ("1LGD") */
+#define DATALOG_PAGES (DATALOG_FLASH_SECTORS * (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)) /**< Bölgedeki sayfa */
+#define DATALOG_RAM_PAGES 4        /**< Flash'a yazılmayı bekleyebilecek dolu sayfa (2'nin kuvveti) */
+#define DATALOG_TASK_PERIOD_MS 20  /**< datalog_task() periyodu */
+/** @} */
+
+/**
+ * @brief Flash sayfasının başlığı (24 bayt); ardından sıkıştırılmış kayıtlar gelir
+ */
+typedef struct {
+    uint32_t magic;       /**< DATALOG_MAGIC */
+    uint32_t seq;         /**< Sayfa sıra numarası (yazıldıkça artar) */
+    uint64_t base_ms;     /**< İlk kaydın zaman referansı (açılıştan beri ms) */
+    uint16_t boot;        /**< Açılış sayacı (her datalog_init() bir artırır) */
+    uint16_t len;         /**< Yük uzunluğu (bayt) */
+    uint16_t payload_crc; /**< Yükün CRC16'sı */
+    uint16_t header_crc;  /**< Bu alana kadar başlığın CRC16'sı */
+} datalog_page_header_t;
+
+#define DATALOG_PAGE_PAYLOAD (FLASH_PAGE_SIZE - sizeof(datalog_page_header_t)) /**< Sayfa başına kayıt alanı */
+
+/**
+ * @brief Çözülmüş tek kayıt
+ */
+typedef struct {
+    uint64_t timestamp_ms; /**< Kaydın açılıştan beri zamanı (ms) */
+    int32_t value;         /**< Değer (ADC sayımı, mesafe mm, PIR 0/1 ...) */
+    uint16_t boot;         /**< Kaydın alındığı açılış */
+    uint8_t sensor;        /**< sensor_id_t */
+} datalog_record_t;
+
+/**
+ * @brief Kayıtları eskiden yeniye gezen okuyucu (bkz. datalog_next())
+ */
+typedef struct {
+    uint32_t visited;            /**< Gezilen sayfa */
+    uint32_t page;               /**< Sıradaki sayfa indeksi */
+    const uint8_t *p;            /**< Geçerli sayfadaki okuma konumu */
+    const uint8_t *end;          /**< Geçerli sayfanın yük sonu */
+    uint64_t t_ms;               /**< Son kaydın zamanı */
+    int32_t prev[SENSOR_COUNT];  /**< Sensör başına son değer (fark çözümü) */
+    uint16_t boot;               /**< Geçerli sayfanın açılışı */
+} datalog_cursor_t;
+
+/**
+ * @brief Veri kaydı sayaçları
+ */
+typedef struct {
+    uint32_t pages_used;   /**< Flash'ta geçerli sayfa */
+    uint32_t pages_ram;    /**< Yazılmayı bekleyen dolu sayfa */
+    uint32_t records;      /**< Bu açılışta eklenen kayıt */
+    uint32_t dropped;      /**< RAM tamponu dolu olduğu için düşen kayıt */
+    uint32_t deferred;     /**< Motor döndüğü için ertelenen yazma denemesi */
+    uint32_t erases;       /**< Bu açılışta silinen sektör */
+    uint32_t erase_pending; /**< `datalog erase` sonrası silinmeyi bekleyen sektör */
+    uint32_t flash_errors; /**< Başarısız flash_safe_execute() (işlem yeniden denenir) */
+    uint32_t next_seq;     /**< Sıradaki sayfa numarası */
+    uint16_t boot;         /**< Geçerli açılış sayacı */
+} datalog_stats_t;
+
+// Veri kaydı fonksiyon prototipleri
+void datalog_init(void);
+bool datalog_start(sensor_id_t sensor, uint32_t period_ms);
+bool datalog_append(sensor_id_t sensor, uint64_t timestamp_us, int32_t value);
+void datalog_task(void);
+bool datalog_sync(void);
+void datalog_erase_all(void);
+void datalog_cursor_init(datalog_cursor_t *c);
+bool datalog_next(datalog_cursor_t *c, datalog_record_t *out);
+void datalog_export(void);
+void datalog_get_stats(datalog_stats_t *out);
+
 // Buton fonksiyon prototipleri
 bool button_pressed(uint gpio);
+bool button_get_event(button_event_t *ev);
+uint32_t buttons_pressed_mask(void);
 bool check_button_event(uint gpio, ButtonEvent event);
 uint32_t get_button_hold_duration(uint gpio);
 uint wait_for_button_press(uint32_t timeout_ms);
+bool buttons_sample(sensor_sample_t *out);
+
+/**
+ * @brief Pin sahipliği kaydında bir pinin işlevi
+ */
+typedef enum {
+    PIN_FUNC_NONE,    /**< Sahipsiz */
+    PIN_FUNC_SIO_IN,  /**< SIO giriş */
+    PIN_FUNC_SIO_OUT, /**< SIO çıkış */
+    PIN_FUNC_PWM,     /**< PWM */
+    PIN_FUNC_ADC,     /**< Analog giriş */
+    PIN_FUNC_I2C,     /**< I2C */
+    PIN_FUNC_PIO,     /**< PIO */
+    PIN_FUNC_UART     /**< UART */
+} pin_func_t;
+
+/**
+ * @brief pin_claim() sonucu
+ */
+typedef enum {
+    PIN_CLAIM_NEW,      /**< Pin sahiplenildi; çağıran yapılandırmalı */
+    PIN_CLAIM_ALREADY,  /**< Pin aynı sahip ve işlevle zaten yapılandırılmış */
+    PIN_CLAIM_CONFLICT  /**< Pin başka bir modüle ait; dokunulmamalı */
+} pin_claim_t;
+
+// Pin sahipliği ve açılış raporu fonksiyon prototipleri
+pin_claim_t pin_claim(uint gpio, pin_func_t func, const char *owner);
+void pin_release(uint gpio);
+const char *pin_owner(uint gpio);
+uint32_t pin_conflict_count(void);
+void peripherals_record_boot(const char *name, uint32_t us);
+void peripherals_print_report(void);
 
 // Ek fonksiyon prototipleri
 // PWM fonksiyon prototipleri
@@ -202,6 +815,7 @@ uint init_pwm_pin(uint gpio, float frequency, uint16_t duty);
 void init_buzzer_pwm(void);
 void init_rgb_pwm(void);
 void init_led_pwm(void);
+void init_leds(void);
 void init_board(void); // Tüm kart bileşenlerini başlat
 void init_adc(void);   // ADC'yi başlat
 void init_pwm(void);   // Tüm PWM'leri başlat
@@ -210,10 +824,27 @@ void init_buttons(void);
 
 uint16_t read_analog(uint8_t pin);
 
+// Sürekli ADC örnekleme fonksiyon prototipleri
+bool adc_stream_start(void);
+void adc_stream_stop(void);
+bool adc_stream_is_running(void);
+uint16_t adc_stream_latest(uint8_t channel);
+uint16_t adc_stream_average(uint8_t channel);
+uint adc_stream_position(void);
+uint adc_stream_recent(uint8_t channel, uint16_t *out, uint n);
+const uint16_t *adc_stream_buffer(void);
+
+// Analog filtre fonksiyon prototipleri
+bool analog_filter_start(void);
+void analog_filter_stop(void);
+uint16_t analog_filter_get(uint8_t channel);
+void analog_filter_feed(uint8_t channel, const uint16_t *samples, size_t count);
+
 void set_led_pwm(uint gpio, uint16_t duty); // LED PWM görev döngüsünü ayarla
 void set_pwm_frequency(uint slice_num, float frequency);
 double get_frequency(const char *note, int octave);
 void play_note(float frequency, int duration_ms);
+void buzzer_beep_async(float frequency, uint32_t duration_ms);
 void play_notes(const char *notes[][2], int num_notes, int duration);
 
 // LCD fonksiyon prototipleri
@@ -223,12 +854,78 @@ void lcd_clear(void);
 void lcd_set_cursor(int line, int position);
 void lcd_string(const char *s);
 
+/**
+ * @defgroup ultrasonic Ultrasonik Ölçüm Ayarları
+ * @{
+ */
+#define ULTRASONIC_SOUND_SPEED 343.0f /**< Varsayılan ses hızı (m/s, ~20 °C; `board_config.sound_speed`) */
+#define ULTRASONIC_TIMEOUT_US 26100   /**< Yankı bekleme ve yankı genişliği üst sınırı (~4.5 m menzil) */
+#define ULTRASONIC_RATE_HZ 40         /**< Varsayılan periyodik ölçüm hızı */
+#define ULTRASONIC_QUEUE_LEN 8        /**< Ölçüm örneği kuyruğu uzunluğu (2'nin kuvveti) */
+/** @} */
+
+/**
+ * @brief Tek bir ultrasonik ölçüm sonucu
+ */
+typedef struct {
+    uint64_t timestamp_us; /**< Tetikleme zamanı (time_us_64) */
+    float echo_us;         /**< Yankı darbesi genişliği (µs), zaman aşımında 0 */
+    float distance_cm;     /**< Mesafe (cm), zaman aşımında -1.0 */
+} ultrasonic_sample_t;
+
+/** @brief Her ölçüm örneğinde kesme bağlamında çağrılan fonksiyon tipi */
+typedef void (*ultrasonic_callback_t)(const ultrasonic_sample_t *sample);
+
+// Periyodik ultrasonik ölçüm fonksiyon prototipleri
+bool ultrasonic_start(uint rate_hz, ultrasonic_callback_t callback);
+void ultrasonic_stop(void);
+bool ultrasonic_is_running(void);
+void ultrasonic_pause(bool paused);
+bool ultrasonic_is_paused(void);
+bool ultrasonic_get_sample(ultrasonic_sample_t *out);
+bool ultrasonic_latest(ultrasonic_sample_t *out);
+uint32_t ultrasonic_skipped_count(void);
+bool ultrasonic_set_temperature(float celsius);
+float ultrasonic_sound_speed(void);
+
+/**
+ * @defgroup distance_filter Mesafe Filtresi Ayarları
+ * @{
+ */
+#define DISTANCE_MEDIAN_LEN 5       /**< Kayan medyan penceresi (geçerli ölçüm) */
+#define DISTANCE_FILTER_ALPHA 0.4f  /**< Alfa-beta konum kazancı */
+#define DISTANCE_FILTER_BETA 0.1f   /**< Alfa-beta hız kazancı */
+#define DISTANCE_GATE_CM 50.0f      /**< Tahminden bu kadar uzak ölçümler aykırı sayılır */
+#define DISTANCE_GATE_LIMIT 3       /**< Art arda bu kadar aykırı ölçümde filtre yeniden başlar */
+#define DISTANCE_TIMEOUT_LIMIT 5    /**< Art arda bu kadar zaman aşımında tahmin geçersizdir */
+/** @} */
+
+/**
+ * @brief Filtrelenmiş mesafe tahmini
+ */
+typedef struct {
+    uint64_t timestamp_us; /**< Son ölçümün tetikleme zamanı */
+    float distance_cm;     /**< Filtrelenmiş mesafe (cm) */
+    float velocity_cm_s;   /**< Tahmini hız (cm/s, uzaklaşma pozitif) */
+    float raw_cm;          /**< Son ham ölçüm (zaman aşımında -1.0) */
+    bool valid;            /**< Tahmin geçerli mi */
+} distance_estimate_t;
+
+// Mesafe filtresi fonksiyon prototipleri
+void distance_filter_update(const ultrasonic_sample_t *s);
+bool distance_filter_get(distance_estimate_t *out);
+void distance_filter_reset(void);
+
 // Sensör fonksiyon prototipleri
 void init_ultrasonic(void);
 void init_pir(void);
 float measure_distance(void);
 bool detect_motion(void);
+uint pir_history(pir_event_t *out, uint max);
+void pir_get_stats(pir_stats_t *out);
 bool wait_for_motion(uint32_t timeout_ms);
 float get_average_distance(uint8_t num_samples, uint32_t delay_ms);
+bool sensor_read(sensor_id_t id, sensor_sample_t *out);
+bool sensor_capture_sync(sensor_snapshot_t *out, uint32_t window_us);
 
 #endif // PICO_TRAINING_BOARD_H
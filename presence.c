@@ -0,0 +1,161 @@
+/**
+ * @file presence.c
+ * @brief PIR, ultrasonik mesafe ve LDR birleşimli varlık algılama motoru
+ * @see \ref howto_presence
+ *
+ * Her çağrıda tek bir girdi örneği işlenir; bekleme veya ölçüm patlaması yoktur.
+ * Güven skoru dört kanıtın ağırlıklı toplamıdır:
+ * - PIR: seviye yüksekse 1, düştükten sonra PRESENCE_PIR_HOLD_US içinde doğrusal olarak 0'a iner
+ * - Yakınlık: menzilin ilk yarısında 1, PRESENCE_RANGE_CM'de 0
+ * - Eğilim: yaklaşma +1, uzaklaşma -1 (|hız| > PRESENCE_APPROACH_CM_S)
+ * - Işık: LDR'nin yavaş taban çizgisinden sapması (gölge, ışığın yanması)
+ *
+ * ENTER, skor PRESENCE_ENTER_LEVEL üstünde PRESENCE_ENTER_HOLD_US boyunca
+ * kaldığında; LEAVE, PRESENCE_LEAVE_LEVEL altında PRESENCE_LEAVE_HOLD_US boyunca
+ * kaldığında üretilir. Yalnızca PIR (ısı kaynağı, güneş) giriş için yetmez;
+ * mesafe onayı gerekir. Hareketsiz oturan biri yakın menzilde kaldıkça varlık sürer.
+ *
+ * Dosya yalnızca standart C kullanır; SDK başlığı içermez.
+ */
+
+#include "presence.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define W_PIR 0.45f   // PIR kanıt ağırlığı
+#define W_NEAR 0.40f  // Yakınlık kanıt ağırlığı
+#define W_TREND 0.10f // Yaklaşma/uzaklaşma kanıt ağırlığı
+#define W_LIGHT 0.05f // Işık değişimi kanıt ağırlığı
+
+/**
+ * @brief Değeri [lo, hi] aralığına sıkıştırır
+ */
+static inline float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/**
+ * @brief Motor durumunu sıfırlar
+ * @param p Motor durumu
+ */
+void presence_init(presence_t *p) {
+    memset(p, 0, sizeof(*p));
+}
+
+/**
+ * @brief Girdilerden güven skorunu hesaplar ve LDR taban çizgisini günceller
+ * @param p Motor durumu
+ * @param in Sensör girdileri
+ * @return float Güven skoru (0-1)
+ */
+static float presence_score(presence_t *p, const presence_input_t *in) {
+    float pir = 0.0f;
+    if (in->motion) {
+        pir = 1.0f;
+    } else if (p->seen_motion && in->timestamp_us >= p->last_motion_us) {
+        float since = (float)(in->timestamp_us - p->last_motion_us);
+        pir = clampf(1.0f - since / (float)PRESENCE_PIR_HOLD_US, 0.0f, 1.0f);
+    }
+
+    float near = 0.0f;
+    float trend = 0.0f;
+    if (in->distance_valid && in->distance_cm >= 0.0f) {
+        near = clampf(2.0f * (1.0f - in->distance_cm / PRESENCE_RANGE_CM), 0.0f, 1.0f);
+        if (in->velocity_cm_s < -PRESENCE_APPROACH_CM_S) {
+            trend = 1.0f;
+        } else if (in->velocity_cm_s > PRESENCE_APPROACH_CM_S) {
+            trend = -1.0f;
+        }
+    }
+
+    if (!p->light_init) {
+        p->light_base = in->light;
+        p->light_init = true;
+    }
+    float light = clampf(fabsf((float)in->light - p->light_base) / PRESENCE_LDR_DELTA, 0.0f, 1.0f);
+    p->light_base += ((float)in->light - p->light_base) / (float)(1u << PRESENCE_LDR_BASE_SHIFT);
+
+    return clampf(W_PIR * pir + W_NEAR * near + W_TREND * trend + W_LIGHT * light, 0.0f, 1.0f);
+}
+
+/**
+ * @brief Motoru bir girdi örneğiyle ilerletir
+ *
+ * Zaman damgaları artan sırada verilmelidir; örnekler arası süre serbesttir.
+ *
+ * @param p Motor durumu
+ * @param in Sensör girdileri
+ * @return presence_event_t Onaylanmış durum değiştiyse ENTER/LEAVE, yoksa NONE
+ *
+ * @code{.c}
+ * presence_input_t in = { .timestamp_us = time_us_64(), .motion = detect_motion(), ... };
+ * if (presence_update(&presence, &in) == PRESENCE_ENTER) {
+ *   buzzer_beep_async(NOTE_A4, 50);
+ * }
+ * @endcode
+ */
+presence_event_t presence_update(presence_t *p, const presence_input_t *in) {
+    if (in->motion) {
+        p->seen_motion = true;
+        p->last_motion_us = in->timestamp_us;
+    }
+    p->confidence = presence_score(p, in);
+
+    bool crossing = p->present ? p->confidence <= PRESENCE_LEAVE_LEVEL
+                               : p->confidence >= PRESENCE_ENTER_LEVEL;
+    if (!crossing) {
+        p->candidate = false;
+        return PRESENCE_NONE;
+    }
+    if (!p->candidate) {
+        p->candidate = true;
+        p->candidate_since_us = in->timestamp_us;
+    }
+
+    uint64_t hold = p->present ? PRESENCE_LEAVE_HOLD_US : PRESENCE_ENTER_HOLD_US;
+    if (in->timestamp_us - p->candidate_since_us < hold) {
+        return PRESENCE_NONE;
+    }
+
+    p->candidate = false;
+    p->present = !p->present;
+    if (p->present) {
+        p->entered_us = in->timestamp_us;
+        p->enters++;
+        return PRESENCE_ENTER;
+    }
+    p->leaves++;
+    return PRESENCE_LEAVE;
+}
+
+/**
+ * @brief Ultrasonik ölçümün gerekip gerekmediğini döndürür
+ *
+ * Mesafe yalnızca PIR son PRESENCE_PIR_HOLD_US içinde hareket gördüyse veya
+ * varlık sürüyorsa ölçülür; boş odada sensör susar.
+ *
+ * @param p Motor durumu
+ * @param now_us Şimdiki zaman
+ * @return bool Ölçüm açık olmalıysa true
+ */
+bool presence_wants_ranging(const presence_t *p, uint64_t now_us) {
+    if (p->present) {
+        return true;
+    }
+    return p->seen_motion && now_us - p->last_motion_us < PRESENCE_PIR_HOLD_US;
+}
+
+/**
+ * @brief Olay adını döndürür (kayıt ve iz çıktısı için)
+ * @param ev Olay
+ * @return const char* "enter", "leave" veya "-"
+ */
+const char *presence_event_name(presence_event_t ev) {
+    switch (ev) {
+        case PRESENCE_ENTER: return "enter";
+        case PRESENCE_LEAVE: return "leave";
+        default: return "-";
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file presence.h
+ * @brief PIR, ultrasonik mesafe ve LDR birleşimli varlık algılama motoru
+ * @details Motor donanımdan bağımsızdır (yalnızca standart C); aynı kod kartta
+ *          ve bilgisayarda kayıtlı sensör izleriyle çalışır
+ *          (bkz. tools/presence_replay.c). Kart tarafındaki bağlantı
+ *          pico_training_board.h üzerinden yapılır.
+ */
+
+#ifndef PRESENCE_H
+#define PRESENCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup presence Varlık Algılama Ayarları
+ * @{
+ */
+#define PRESENCE_RANGE_CM 150.0f        /**< Bu mesafenin içindeki hedef varlık kanıtıdır */
+#define PRESENCE_APPROACH_CM_S 20.0f    /**< Bu hızdan hızlı yaklaşma/uzaklaşma eğilim sayılır */
+#define PRESENCE_PIR_HOLD_US 30000000u  /**< PIR düştükten sonra katkısının sıfıra inme süresi */
+#define PRESENCE_LDR_DELTA 400.0f       /**< Taban çizgisinden bu kadar sapma tam LDR katkısıdır */
+#define PRESENCE_LDR_BASE_SHIFT 8       /**< LDR taban çizgisi EMA katsayısı (1/2^n, örnek başına) */
+#define PRESENCE_ENTER_LEVEL 0.6f       /**< Giriş eşiği */
+#define PRESENCE_LEAVE_LEVEL 0.3f       /**< Çıkış eşiği (histerezis) */
+#define PRESENCE_ENTER_HOLD_US 500000u  /**< Girişin onaylanması için eşik üstünde kalma süresi */
+#define PRESENCE_LEAVE_HOLD_US 5000000u /**< Çıkışın onaylanması için eşik altında kalma süresi */
+#define PRESENCE_DISTANCE_MAX_AGE_US 250000u /**< Daha eski mesafe tahmini yok sayılır */
+/** @} */
+
+/**
+ * @brief Tek bir güncelleme için sensör girdileri
+ */
+typedef struct {
+    uint64_t timestamp_us;  /**< Girdilerin okunduğu zaman */
+    bool motion;            /**< PIR seviyesi */
+    bool distance_valid;    /**< Mesafe tahmini geçerli ve güncel mi */
+    float distance_cm;      /**< Filtrelenmiş mesafe (cm) */
+    float velocity_cm_s;    /**< Mesafe hızı (cm/s, uzaklaşma pozitif) */
+    uint16_t light;         /**< LDR ADC değeri (0-4095) */
+} presence_input_t;
+
+/**
+ * @brief presence_update() sonucu
+ */
+typedef enum {
+    PRESENCE_NONE,  /**< Durum değişmedi */
+    PRESENCE_ENTER, /**< Varlık onaylandı */
+    PRESENCE_LEAVE  /**< Varlık sona erdi */
+} presence_event_t;
+
+/**
+ * @brief Varlık algılama motorunun durumu
+ */
+typedef struct {
+    bool present;                /**< Onaylanmış durum */
+    float confidence;            /**< Son güven skoru (0-1) */
+    bool seen_motion;            /**< PIR en az bir kez yüksek görüldü mü */
+    uint64_t last_motion_us;     /**< Son PIR yüksek görülme zamanı */
+    float light_base;            /**< LDR taban çizgisi (yavaş EMA) */
+    bool light_init;             /**< Taban çizgisi başlatıldı mı */
+    bool candidate;              /**< Eşik aşıldı, onay süresi bekleniyor */
+    uint64_t candidate_since_us; /**< Eşik aşımının başladığı zaman */
+    uint64_t entered_us;         /**< Son ENTER zamanı */
+    uint32_t enters;             /**< Toplam ENTER sayısı */
+    uint32_t leaves;             /**< Toplam LEAVE sayısı */
+} presence_t;
+
+// Varlık algılama fonksiyon prototipleri
+void presence_init(presence_t *p);
+presence_event_t presence_update(presence_t *p, const presence_input_t *in);
+bool presence_wants_ranging(const presence_t *p, uint64_t now_us);
+const char *presence_event_name(presence_event_t ev);
+
+#endif // PRESENCE_H
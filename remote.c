@@ -0,0 +1,504 @@
+/**
+ * @file remote.c
+ * @brief USB CDC ve Bluetooth UART üzerinden ikili komut/telemetri protokolü
+ * @see \ref howto_remote
+ *
+ * Çerçeve: `tür u8 | sıra u8 | yük | CRC16 (little-endian)`. CRC,
+ * crc16_ccitt() ile tür, sıra ve yük üzerinden hesaplanır. Çerçeve COBS ile
+ * kodlanır; hatta `0x00 | COBS | 0x00` olarak gider. Baştaki ayraç USB'de
+ * metin konsolu ile ikili çerçeveyi ayırır: metin satırlarında 0x00 olmadığı
+ * için 0x00 görülene kadar gelen baytlar konsola, sonraki ayraca kadar
+ * olanlar protokole aittir. Bluetooth UART yalnızca ikili taşır.
+ *
+ * İstekler ana döngü bağlamında işlenir ve her birine (PING, STATS ve
+ * CONFIG_GET hariç) aynı sıra numarasıyla bir REMOTE_MSG_ACK döner. Abonelikler
+ * remote_task() ile sensor_read() örneklerini istenen hızda gönderir;
+ * SAMPLE çerçevelerinin sıra alanı akış başına artar, böylece karşı uç kaybı
+ * sayabilir.
+ */
+
+#include "pico_training_board.h"
+
+#define REMOTE_MAX_HANDLERS 0x10  // İstek türleri 0x01..0x0F
+#define REMOTE_SAMPLE_LEN 18      // SAMPLE yükü
+#define REMOTE_SAMPLE_WIRE (REMOTE_SAMPLE_LEN + 7)  // Hatta SAMPLE: yük + tür, sıra, CRC, COBS, iki ayraç
+#define REMOTE_BT_BYTES_PER_S (BT_UART_BAUD / 10)  // 8N1: bayt başına 10 bit
+#define REMOTE_REPLY_RESERVE (2 * REMOTE_WIRE_MAX)  // Bluetooth tamponunda cevaplara ayrılan yer
+
+/**
+ * @brief Bağlantı başına çerçeve çözücü durumu
+ */
+typedef struct {
+    uint8_t buf[REMOTE_WIRE_MAX]; ///< Ayraçlar arasındaki COBS baytları
+    uint16_t len;                 ///< buf içindeki bayt
+    bool in_frame;                ///< Baştaki ayraç görüldü
+    bool overflow;                ///< Çerçeve buf'a sığmadı; sonraki ayraçta atılır
+} remote_decoder_t;
+
+/**
+ * @brief Bir sensörün telemetri aboneliği
+ */
+typedef struct {
+    uint32_t period_us; ///< 0: abonelik yok
+    uint16_t rate_hz;   ///< İstenen hız (Bluetooth bütçesi için)
+    uint64_t next_us;   ///< Sonraki örneğin zamanı
+    uint8_t port;       ///< remote_port_t; son abone olan bağlantı
+    uint8_t seq;        ///< Akış sıra sayacı
+} remote_stream_t;
+
+static remote_decoder_t decoders[REMOTE_PORT_COUNT];
+static remote_handler_t handlers[REMOTE_MAX_HANDLERS];
+static remote_stream_t streams[SENSOR_COUNT];
+static remote_stats_t stats;
+
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint32_t get_u32(const uint8_t *p) {
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+/**
+ * @brief COBS kodlar
+ * @param in Veri
+ * @param len Veri uzunluğu (< 254)
+ * @param out Çıkış (en az len + 1 bayt)
+ * @return size_t Kodlanmış uzunluk (0x00 içermez)
+ */
+static size_t cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_pos = 0;
+    size_t o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[code_pos] = code;
+                code_pos = o++;
+                code = 1;
+            }
+        }
+    }
+    out[code_pos] = code;
+    return o;
+}
+
+/**
+ * @brief COBS çözer
+ * @param in Kodlanmış veri (ayraçsız)
+ * @param len Uzunluk
+ * @param out Çıkış (en az len bayt)
+ * @return size_t Çözülmüş uzunluk, bozuk kodlamada 0
+ */
+static size_t cobs_decode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) {
+            return 0;
+        }
+        for (uint8_t k = 1; k < code; k++) {
+            out[o++] = in[i++];
+        }
+        if (code != 0xFF && i < len) {
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+/**
+ * @brief Bir çerçeve gönderir
+ *
+ * Bluetooth tarafında çerçeve tampona sığmıyorsa hiç yazılmaz (yarım çerçeve
+ * karşı ucu bir sonraki ayraca kadar bozar). USB'de stdio kullanılır; CR/LF
+ * dönüşümü kapalıdır.
+ *
+ * @param port Hedef bağlantı
+ * @param type Mesaj türü
+ * @param seq Sıra numarası
+ * @param payload Yük
+ * @param len Yük uzunluğu (en çok REMOTE_MAX_PAYLOAD)
+ * @return bool Çerçeve gönderme tamponuna yazıldıysa true
+ */
+bool remote_send(remote_port_t port, uint8_t type, uint8_t seq, const void *payload, size_t len) {
+    uint8_t frame[REMOTE_FRAME_MAX];
+    uint8_t wire[REMOTE_WIRE_MAX];
+
+    if (len > REMOTE_MAX_PAYLOAD || port >= REMOTE_PORT_COUNT) {
+        return false;
+    }
+    frame[0] = type;
+    frame[1] = seq;
+    if (len != 0) {
+        memcpy(&frame[2], payload, len);
+    }
+    put_u16(&frame[2 + len], crc16_ccitt(frame, 2 + len, CRC16_INIT));
+
+    wire[0] = 0x00;
+    size_t n = 1 + cobs_encode(frame, len + 4, &wire[1]);
+    wire[n++] = 0x00;
+
+    if (port == REMOTE_PORT_BT) {
+        if (bt_uart_tx_free() < n) {
+            stats.tx_dropped++;
+            return false;
+        }
+        bt_uart_write(wire, n);
+    } else {
+        stdio_put_string((const char *)wire, (int)n, false, false);
+    }
+    stats.tx_frames++;
+    return true;
+}
+
+/**
+ * @brief İstek sonucunu bildirir
+ */
+static void send_ack(remote_port_t port, uint8_t type, uint8_t seq, remote_status_t status) {
+    uint8_t ack[2] = {type, (uint8_t)status};
+    remote_send(port, REMOTE_MSG_ACK, seq, ack, sizeof(ack));
+}
+
+/**
+ * @brief Yapılandırma alanını tanımıyla birlikte gönderir (CONFIG_GET cevabı)
+ *
+ * Yük: alan u8, tür u8 (config_type_t), açılışta u8, değer (tamsayılar u32,
+ * F32 alanlar f32), en az f32, en çok f32, ad. Alan numarası geçersizse
+ * REMOTE_INVALID ACK'i döner; istemci alanları 0'dan bu cevaba kadar sayar.
+ */
+static void send_config_value(remote_port_t port, uint8_t seq, const uint8_t *payload, size_t len) {
+    const config_field_t *f = len == 1 ? config_field(payload[0]) : NULL;
+    if (f == NULL) {
+        send_ack(port, REMOTE_MSG_CONFIG_GET, seq, REMOTE_INVALID);
+        return;
+    }
+    uint8_t out[REMOTE_MAX_PAYLOAD];
+    float value = config_get(payload[0]);
+    size_t name_len = strlen(f->name);
+    if (name_len > sizeof(out) - 15) {
+        name_len = sizeof(out) - 15;
+    }
+    out[0] = payload[0];
+    out[1] = f->type;
+    out[2] = f->reboot;
+    if (f->type == CONFIG_F32) {
+        memcpy(&out[3], &value, sizeof(float));
+    } else {
+        put_u32(&out[3], (uint32_t)value);
+    }
+    memcpy(&out[7], &f->min, sizeof(float));
+    memcpy(&out[11], &f->max, sizeof(float));
+    memcpy(&out[15], f->name, name_len);
+    remote_send(port, REMOTE_MSG_CONFIG_VALUE, seq, out, 15 + name_len);
+}
+
+/**
+ * @brief CRC'si doğrulanmış bir çerçeveyi işler
+ */
+static void dispatch(remote_port_t port, const uint8_t *frame, size_t len) {
+    uint8_t type = frame[0];
+    uint8_t seq = frame[1];
+    const uint8_t *payload = &frame[2];
+    size_t plen = len - 4;
+
+    if (type == REMOTE_MSG_PING) {
+        remote_send(port, REMOTE_MSG_PONG, seq, payload, plen);
+    } else if (type == REMOTE_MSG_STATS) {
+        uint8_t out[5 * 4];
+        put_u32(&out[0], stats.rx_frames);
+        put_u32(&out[4], stats.rx_errors);
+        put_u32(&out[8], stats.tx_frames);
+        put_u32(&out[12], stats.tx_dropped);
+        put_u32(&out[16], stats.samples);
+        remote_send(port, REMOTE_MSG_STATS_REPLY, seq, out, sizeof(out));
+    } else if (type == REMOTE_MSG_CONFIG_GET) {
+        send_config_value(port, seq, payload, plen);
+    } else if (type < REMOTE_MAX_HANDLERS && handlers[type] != NULL) {
+        send_ack(port, type, seq, handlers[type](port, payload, plen));
+    } else {
+        send_ack(port, type, seq, REMOTE_UNSUPPORTED);
+    }
+}
+
+/**
+ * @brief Ayraçlar arasında biriken baytları çözer ve doğrular
+ */
+static void finish_frame(remote_port_t port, remote_decoder_t *d) {
+    uint8_t frame[REMOTE_WIRE_MAX];
+    size_t n = d->overflow ? 0 : cobs_decode(d->buf, d->len, frame);
+    if (n >= 4 && n <= REMOTE_FRAME_MAX &&
+        crc16_ccitt(frame, n - 2, CRC16_INIT) == get_u16(&frame[n - 2])) {
+        stats.rx_frames++;
+        dispatch(port, frame, n);
+    } else {
+        stats.rx_errors++;
+    }
+}
+
+/**
+ * @brief Bağlantıdan gelen bir baytı çözücüye verir
+ *
+ * USB'de çerçeve dışındaki baytlar reddedilir ve konsola kalır; çerçeve
+ * tampona sığmazsa çözücü metin kipine döner, böylece ayraçsız kalmış bir
+ * çerçeve konsolu kalıcı olarak yutmaz. Bluetooth'ta her bayt protokole aittir.
+ *
+ * @param port Kaynak bağlantı
+ * @param byte Alınan bayt
+ * @return bool Bayt protokol tarafından tüketildiyse true
+ */
+bool remote_feed(remote_port_t port, uint8_t byte) {
+    remote_decoder_t *d = &decoders[port];
+    bool binary_only = port == REMOTE_PORT_BT;
+
+    if (byte == 0x00) {
+        if (d->in_frame && (d->len != 0 || d->overflow)) {
+            finish_frame(port, d);
+            d->in_frame = binary_only;  // USB'de sonraki çerçeve kendi baştaki ayracıyla başlar
+        } else {
+            d->in_frame = true;
+        }
+        d->len = 0;
+        d->overflow = false;
+        return true;
+    }
+    if (!d->in_frame && !binary_only) {
+        return false;
+    }
+    if (d->len < sizeof(d->buf)) {
+        d->buf[d->len++] = byte;
+    } else if (!binary_only) {
+        stats.rx_errors++;
+        d->in_frame = false;
+        d->len = 0;
+    } else {
+        d->overflow = true;
+    }
+    return true;
+}
+
+/**
+ * @brief EVENT_LOOP_BT işleyicisi: alınan baytları kopyalamadan çözer
+ * @param events Bekleyen olay bitleri
+ */
+void remote_on_bt_event(uint32_t events) {
+    (void)events;
+    const uint8_t *p;
+    size_t n;
+    while ((n = bt_uart_rx_peek(&p)) != 0) {
+        for (size_t i = 0; i < n; i++) {
+            remote_feed(REMOTE_PORT_BT, p[i]);
+        }
+        bt_uart_rx_consume(n);
+    }
+}
+
+/**
+ * @brief LCD isteği: bayrak, satır, sütun, metin (en çok 16 karakter)
+ */
+static remote_status_t on_lcd(remote_port_t port, const uint8_t *payload, size_t len) {
+    (void)port;
+    char text[17];
+    if (len < 3 || len > 3 + sizeof(text) - 1 || payload[1] > 1 || payload[2] > 15) {
+        return REMOTE_INVALID;
+    }
+    memcpy(text, &payload[3], len - 3);
+    text[len - 3] = '\0';
+    if (payload[0] & 0x01) {
+        lcd_clear();
+    }
+    lcd_set_cursor(payload[1], payload[2]);
+    lcd_string(text);
+    return REMOTE_OK;
+}
+
+/**
+ * @brief Buzzer isteği: frekans (Hz) ve süre (ms); beklemeden çalar
+ */
+static remote_status_t on_beep(remote_port_t port, const uint8_t *payload, size_t len) {
+    (void)port;
+    if (len != 4 || get_u16(&payload[0]) == 0) {
+        return REMOTE_INVALID;
+    }
+    buzzer_beep_async((float)get_u16(&payload[0]), get_u16(&payload[2]));
+    return REMOTE_OK;
+}
+
+/**
+ * @brief Abonelik isteği: sensör ve hız (0 Hz aboneliği kapatır)
+ *
+ * Bluetooth'ta tüm akışların SAMPLE bayt hızı hat hızını
+ * (`BT_UART_BAUD` / 10 bayt/s) aşacaksa abonelik REMOTE_BUSY ile reddedilir;
+ * aksi halde gönderme tamponu dolar ve örnekler düşer.
+ */
+static remote_status_t on_subscribe(remote_port_t port, const uint8_t *payload, size_t len) {
+    if (len != 3 || payload[0] >= SENSOR_COUNT || get_u16(&payload[1]) > REMOTE_MAX_RATE_HZ) {
+        return REMOTE_INVALID;
+    }
+    remote_stream_t *s = &streams[payload[0]];
+    uint16_t rate = get_u16(&payload[1]);
+    if (port == REMOTE_PORT_BT && rate != 0) {
+        uint32_t total_hz = rate;
+        for (uint i = 0; i < SENSOR_COUNT; i++) {
+            if (i != payload[0] && streams[i].period_us != 0 && streams[i].port == REMOTE_PORT_BT) {
+                total_hz += streams[i].rate_hz;
+            }
+        }
+        if (total_hz * REMOTE_SAMPLE_WIRE > REMOTE_BT_BYTES_PER_S) {
+            return REMOTE_BUSY;
+        }
+    }
+    s->period_us = rate ? 1000000u / rate : 0;
+    s->rate_hz = rate;
+    s->next_us = time_us_64();
+    s->port = (uint8_t)port;
+    s->seq = 0;
+    return REMOTE_OK;
+}
+
+/**
+ * @brief Yapılandırma alanını RAM'de değiştirir: alan u8, değer (u32 veya f32)
+ */
+static remote_status_t on_config_set(remote_port_t port, const uint8_t *payload, size_t len) {
+    (void)port;
+    const config_field_t *f = len == 5 ? config_field(payload[0]) : NULL;
+    if (f == NULL) {
+        return REMOTE_INVALID;
+    }
+    float value;
+    if (f->type == CONFIG_F32) {
+        memcpy(&value, &payload[1], sizeof(float));
+    } else {
+        value = (float)get_u32(&payload[1]);
+    }
+    return config_set(payload[0], value) ? REMOTE_OK : REMOTE_INVALID;
+}
+
+/**
+ * @brief Yapılandırmayı flash'a yazar; motor dönerken meşgul döner
+ */
+static remote_status_t on_config_save(remote_port_t port, const uint8_t *payload, size_t len) {
+    (void)port;
+    (void)payload;
+    if (len != 0) {
+        return REMOTE_INVALID;
+    }
+    if (get_motor_state() == MOTOR_RUNNING) {
+        return REMOTE_BUSY;
+    }
+    return config_save() ? REMOTE_OK : REMOTE_BUSY;
+}
+
+/**
+ * @brief Abonelik görevi: zamanı gelen akışların örneğini gönderir
+ *
+ * Görev geride kalırsa kaçırılan örnekler toplu gönderilmez; sonraki örnek
+ * bir periyot sonraya kurulur ve karşı uç bunu zaman damgalarından görür.
+ * Bluetooth gönderme tamponunda `REMOTE_REPLY_RESERVE` bayttan az yer
+ * kaldıysa örnek gönderilmez ve `tx_dropped` ile sayılır; ACK ve PONG gibi
+ * cevaplar böylece her zaman sığar.
+ */
+void remote_task(void) {
+    uint64_t now = time_us_64();
+    for (uint i = 0; i < SENSOR_COUNT; i++) {
+        remote_stream_t *s = &streams[i];
+        if (s->period_us == 0 || now < s->next_us) {
+            continue;
+        }
+        if (s->port == REMOTE_PORT_BT && bt_uart_tx_free() < REMOTE_REPLY_RESERVE) {
+            stats.tx_dropped++;
+            s->seq++;  // Karşı uç kaybı sıra boşluğundan görür
+        } else {
+            sensor_sample_t smp;
+            uint8_t out[REMOTE_SAMPLE_LEN];
+            sensor_read((sensor_id_t)i, &smp);
+            out[0] = smp.sensor;
+            out[1] = smp.valid;
+            put_u32(&out[2], (uint32_t)smp.timestamp_us);
+            put_u32(&out[6], (uint32_t)(smp.timestamp_us >> 32));
+            memcpy(&out[10], &smp.value, sizeof(float));
+            put_u32(&out[14], smp.raw);
+            if (remote_send((remote_port_t)s->port, REMOTE_MSG_SAMPLE, s->seq++, out, sizeof(out))) {
+                stats.samples++;
+            }
+        }
+
+        s->next_us += s->period_us;
+        if (s->next_us <= now) {
+            s->next_us = now + s->period_us;
+        }
+    }
+}
+
+/**
+ * @brief USB'ye veri geldiğinde (USB kesmesi bağlamında) konsolu uyandırır
+ */
+static void on_stdio_chars(void *param) {
+    (void)param;
+    event_loop_post(EVENT_LOOP_STDIO);
+}
+
+/**
+ * @brief İstek işleyicisi kaydeder
+ *
+ * LCD, buzzer, abonelik ve yapılandırma işleyicileri remote_init() ile
+ * kurulur; motor gibi uygulamaya ait komutlar uygulama tarafından kaydedilir.
+ *
+ * @param type İstek türü (0x01..0x0F; PING, STATS ve CONFIG_GET hariç)
+ * @param handler İşleyici (NULL: kaydı siler)
+ * @return bool Tür geçersizse false
+ */
+bool remote_register(uint8_t type, remote_handler_t handler) {
+    if (type == 0 || type >= REMOTE_MAX_HANDLERS || type == REMOTE_MSG_PING || type == REMOTE_MSG_STATS ||
+        type == REMOTE_MSG_CONFIG_GET) {
+        return false;
+    }
+    handlers[type] = handler;
+    return true;
+}
+
+/**
+ * @brief Protokolü başlatır
+ *
+ * Yerleşik işleyicileri kaydeder ve USB'ye veri geldiğinde EVENT_LOOP_STDIO
+ * gönderilmesini sağlar. Çağıran EVENT_LOOP_BT için remote_on_bt_event()'i,
+ * EVENT_LOOP_STDIO için konsolu kaydetmeli ve remote_task()'ı
+ * REMOTE_TASK_PERIOD_MS periyoduyla çalıştırmalıdır.
+ *
+ * @note event_loop_init() sonrasında çağrılmalıdır.
+ */
+void remote_init(void) {
+    memset(decoders, 0, sizeof(decoders));
+    memset(streams, 0, sizeof(streams));
+    memset(&stats, 0, sizeof(stats));
+    remote_register(REMOTE_MSG_LCD, on_lcd);
+    remote_register(REMOTE_MSG_BEEP, on_beep);
+    remote_register(REMOTE_MSG_SUBSCRIBE, on_subscribe);
+    remote_register(REMOTE_MSG_CONFIG_SET, on_config_set);
+    remote_register(REMOTE_MSG_CONFIG_SAVE, on_config_save);
+    stdio_set_chars_available_callback(on_stdio_chars, NULL);
+}
+
+/**
+ * @brief Protokol sayaçlarını kopyalar
+ * @param out Sayaçların yazılacağı yapı
+ */
+void remote_get_stats(remote_stats_t *out) {
+    *out = stats;
+}
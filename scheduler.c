@@ -0,0 +1,171 @@
+/**
+ * @file scheduler.c
+ * @brief Core 0 için süre sınırlı (deadline) işbirlikçi periyodik görev zamanlayıcısı
+ * @see \ref howto_scheduler
+ *
+ * Her görevin bir periyodu ve göreli bir bitiş süresi (deadline) vardır.
+ * `scheduler_run_due()` zamanı gelmiş görevlerden mutlak bitiş süresi en
+ * erken olanı çalıştırır (EDF) ve bir sonraki uyanma zamanını döndürür; olay
+ * döngüsü bu zamana kadar uyur. Görevler bloklamamalıdır: bir görev
+ * çalışırken diğerleri bekler.
+ *
+ * Görev başına çalışma süresi, en uzun çalışma, bitiş süresi kaçırma ve
+ * periyot aşımı (bir sonraki çıkış zamanı da geçmişte kalmış) sayılır.
+ */
+
+#include "pico_training_board.h"
+
+/**
+ * @brief Bir periyodik görevin durumu ve istatistikleri
+ */
+typedef struct {
+    const char *name;             ///< Rapor için görev adı
+    task_fn_t fn;                 ///< Görev fonksiyonu
+    uint32_t period_us;           ///< Çıkış periyodu
+    uint32_t deadline_us;         ///< Çıkıştan itibaren bitiş süresi
+    absolute_time_t release;      ///< Bir sonraki çıkış zamanı
+    uint64_t run_time_us;         ///< Toplam çalışma süresi
+    uint32_t runs;                ///< Çalışma sayısı
+    uint32_t max_run_us;          ///< En uzun tek çalışma
+    uint32_t deadline_misses;     ///< Bitiş süresinden sonra tamamlanan çalışmalar
+    uint32_t overruns;            ///< Atlanan çıkışlar (görev periyoduna yetişemedi)
+} sched_task_t;
+
+static sched_task_t tasks[SCHEDULER_MAX_TASKS];
+static uint task_count = 0;
+static absolute_time_t stats_start;
+
+/**
+ * @brief Periyodik bir görev ekler
+ *
+ * İlk çıkış hemen gerçekleşir.
+ *
+ * @param name Görev adı (statik dizgi)
+ * @param fn Görev fonksiyonu; bloklamamalıdır
+ * @param period_ms Periyot (ms)
+ * @param deadline_ms Çıkıştan itibaren bitiş süresi (ms); 0 ise periyot kullanılır
+ * @return int Görev kimliği, tablo doluysa -1
+ *
+ * @code{.c}
+ * scheduler_add_task("pot", display_potentiometer_value, 200, 50);
+ * @endcode
+ */
+int scheduler_add_task(const char *name, task_fn_t fn, uint32_t period_ms, uint32_t deadline_ms) {
+    if (task_count >= SCHEDULER_MAX_TASKS || period_ms == 0) {
+        return -1;
+    }
+    if (task_count == 0) {
+        stats_start = get_absolute_time();
+    }
+    sched_task_t *t = &tasks[task_count];
+    memset(t, 0, sizeof(*t));
+    t->name = name;
+    t->fn = fn;
+    t->period_us = period_ms * 1000u;
+    t->deadline_us = (deadline_ms ? deadline_ms : period_ms) * 1000u;
+    t->release = get_absolute_time();
+    return (int)task_count++;
+}
+
+/**
+ * @brief Zamanı gelmiş görevlerden bitiş süresi en erken olanı çalıştırır
+ *
+ * Olay işleyicileri görevler arasında çalışabilsin diye çağrı başına en çok
+ * bir görev çalıştırılır.
+ *
+ * @return absolute_time_t Bir sonraki çağrının yapılması gereken zaman
+ *         (başka görev hazırsa şimdiki zaman)
+ *
+ * @code{.c}
+ * while (true) {
+ *   event_loop_poll(scheduler_run_due());
+ * }
+ * @endcode
+ */
+absolute_time_t scheduler_run_due(void) {
+    absolute_time_t now = get_absolute_time();
+    sched_task_t *pick = NULL;
+    absolute_time_t pick_deadline = at_the_end_of_time;
+
+    for (uint i = 0; i < task_count; i++) {
+        sched_task_t *t = &tasks[i];
+        if (absolute_time_diff_us(t->release, now) >= 0) {
+            absolute_time_t d = delayed_by_us(t->release, t->deadline_us);
+            if (absolute_time_diff_us(d, pick_deadline) > 0) {
+                pick = t;
+                pick_deadline = d;
+            }
+        }
+    }
+
+    if (pick) {
+        uint64_t start = time_us_64();
+        pick->fn();
+        uint64_t end = time_us_64();
+
+        uint32_t run_us = (uint32_t)(end - start);
+        pick->run_time_us += run_us;
+        pick->runs++;
+        if (run_us > pick->max_run_us) {
+            pick->max_run_us = run_us;
+        }
+        if (end > to_us_since_boot(pick_deadline)) {
+            pick->deadline_misses++;
+        }
+
+        // Sabit hızda çıkış; kaçırılan periyotlar sayılır ve atlanır (patlama yok)
+        pick->release = delayed_by_us(pick->release, pick->period_us);
+        int64_t late_us = absolute_time_diff_us(pick->release, from_us_since_boot(end));
+        if (late_us >= 0) {
+            uint32_t skipped = (uint32_t)(late_us / pick->period_us) + 1u;
+            pick->overruns += skipped;
+            pick->release = delayed_by_us(pick->release, (uint64_t)skipped * pick->period_us);
+        }
+    }
+
+    absolute_time_t next = at_the_end_of_time;
+    for (uint i = 0; i < task_count; i++) {
+        next = absolute_time_min(next, tasks[i].release);
+    }
+    return next;
+}
+
+/**
+ * @brief Görev istatistiklerini stdio'ya yazar
+ *
+ * CPU yüzdesi, son sıfırlamadan beri geçen süreye göre hesaplanır.
+ */
+void scheduler_print_stats(void) {
+    int64_t elapsed_us = absolute_time_diff_us(stats_start, get_absolute_time());
+    if (elapsed_us <= 0) {
+        elapsed_us = 1;
+    }
+    printf("%-10s %8s %8s %7s %8s %6s %6s\n",
+           "gorev", "periyot", "calisma", "cpu%", "en_uzun", "kacan", "asim");
+    for (uint i = 0; i < task_count; i++) {
+        const sched_task_t *t = &tasks[i];
+        printf("%-10s %6lums %8lu %6.2f%% %6luus %6lu %6lu\n",
+               t->name,
+               (unsigned long)(t->period_us / 1000u),
+               (unsigned long)t->runs,
+               100.0 * (double)t->run_time_us / (double)elapsed_us,
+               (unsigned long)t->max_run_us,
+               (unsigned long)t->deadline_misses,
+               (unsigned long)t->overruns);
+    }
+}
+
+/**
+ * @brief Tüm görev istatistiklerini sıfırlar; periyotlar korunur
+ */
+void scheduler_reset_stats(void) {
+    for (uint i = 0; i < task_count; i++) {
+        sched_task_t *t = &tasks[i];
+        t->run_time_us = 0;
+        t->runs = 0;
+        t->max_run_us = 0;
+        t->deadline_misses = 0;
+        t->overruns = 0;
+    }
+    stats_start = get_absolute_time();
+}
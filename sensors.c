@@ -7,30 +7,200 @@
 #include "pico_training_board.h"
 
 
+// Kesme ile güncellenen PIR seviyesi ve kenar kaydı
+static volatile bool pir_level = false;
+static volatile uint64_t pir_level_since_us = 0;  // Mevcut seviyenin başladığı an
+static volatile uint64_t pir_last_motion_us = 0;  // Son yükselen kenar (0: hiç)
+static volatile uint32_t pir_motion_count = 0;    // Toplam yükselen kenar
+static pir_event_t pir_log[PIR_LOG_LEN];
+static volatile uint pir_log_head = 0;            // Toplam yazılan kayıt
+static uint64_t pir_edge_us = 0;                  // GPIO yolu: debounce penceresini açan kenar
+
+/**
+ * @brief Bir PIR kenarını kaydeder (kesme bağlamı)
+ * @param level Yeni seviye
+ * @param timestamp_us Kenar zamanı
+ */
+static void pir_record(bool level, uint64_t timestamp_us) {
+    if (level == pir_level) {
+        return;
+    }
+    pir_level = level;
+    pir_level_since_us = timestamp_us;
+    if (level) {
+        pir_last_motion_us = timestamp_us;
+        pir_motion_count++;
+    }
+    pir_event_t *ev = &pir_log[pir_log_head % PIR_LOG_LEN];
+    ev->timestamp_us = timestamp_us;
+    ev->motion = level;
+    __dmb();
+    pir_log_head++;
+    event_loop_post(EVENT_LOOP_PIR);
+}
+
+/**
+ * @brief PIO debounce sürücüsünden gelen temiz PIR seviye değişimi
+ * @param gpio PIR pini
+ * @param level Yeni kararlı seviye
+ * @param timestamp_us Tahmini kenar zamanı
+ */
+static void pir_pio_callback(uint gpio, bool level, uint64_t timestamp_us) {
+    pir_record(level, timestamp_us);
+}
+
+static int64_t pir_debounce_alarm_callback(alarm_id_t id, void *user_data);
+
+/**
+ * @brief GPIO yolunda debounce penceresini açar: PIR kesmesini kapatır ve örnekleme alarmı kurar
+ * @param now_us Kenar zamanı
+ */
+static void pir_start_debounce(uint64_t now_us) {
+    gpio_set_irq_enabled(PIR_DETECTOR, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    pir_edge_us = now_us;
+    if (add_alarm_in_us(board_config.pir_debounce_us, pir_debounce_alarm_callback, NULL, true) < 0) {
+        // Alarm havuzu dolu; kenar kesmesini geri aç ki PIR kilitlenmesin
+        gpio_set_irq_enabled(PIR_DETECTOR, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    }
+}
+
+/**
+ * @brief Debounce alarmı; pencere sonunda pini örnekler ve seviyeyi kaydeder
+ *
+ * PIO yoluyla aynı süre uygulanır: pir_debounce_us'den kısa darbeler ve
+ * parazit kayda geçmez, kayıttaki kenarlar en az bu kadar aralıklıdır.
+ *
+ * @param id Alarm kimliği
+ * @param user_data Kullanılmıyor
+ * @return int64_t 0 (tekrarlanmaz)
+ */
+static int64_t pir_debounce_alarm_callback(alarm_id_t id, void *user_data) {
+    pir_record(gpio_get(PIR_DETECTOR), pir_edge_us);
+
+    // Pencere sırasında biriken kenarları at ve kesmeyi yeniden aç
+    gpio_acknowledge_irq(PIR_DETECTOR, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+    gpio_set_irq_enabled(PIR_DETECTOR, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+
+    // Kesme kapalıyken seviye değiştiyse yeni bir pencere aç
+    if (gpio_get(PIR_DETECTOR) != pir_level) {
+        pir_start_debounce(time_us_64());
+    }
+    return 0;
+}
+
+/**
+ * @brief PIO bağlanamadığında PIR pini için ham GPIO kenar kesmesi
+ *
+ * Yalnızca kenarı onaylar ve debounce alarmını kurar; seviye alarmda kaydedilir.
+ */
+static void pir_gpio_irq_handler(void) {
+    uint32_t events = gpio_get_irq_event_mask(PIR_DETECTOR);
+    if (events & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL)) {
+        gpio_acknowledge_irq(PIR_DETECTOR, events);
+        pir_start_debounce(time_us_64());
+    }
+}
+
 /**
  * @brief PIR hareket sensörünü başlatır
  * 
- * PIR sensör pinini giriş olarak yapılandırır
+ * PIR sensör pinini giriş olarak yapılandırır ve PIO debounce durum
+ * makinesine bağlar; çıkıştaki kısa darbeler ve parazit PIR_DEBOUNCE_US
+ * süresince filtrelenir. Boş durum makinesi yoksa kenarlar GPIO kesmesi
+ * ile yakalanır ve aynı süre kesme + alarm ile uygulanır. Her kenar zaman
+ * damgasıyla kayda eklenir.
  */
 void init_pir(void) {
+    if (pin_claim(PIR_DETECTOR, PIN_FUNC_SIO_IN, "pir") != PIN_CLAIM_NEW) {
+        return;
+    }
     gpio_init(PIR_DETECTOR);
     gpio_set_dir(PIR_DETECTOR, GPIO_IN);
     gpio_pull_down(PIR_DETECTOR);  // Kararlı okuma için pull-down kullan
+    pir_level_since_us = time_us_64();
+
+    if (!input_pio_attach(PIR_DETECTOR, board_config.pir_debounce_us, pir_pio_callback)) {
+        gpio_add_raw_irq_handler_masked(1u << PIR_DETECTOR, pir_gpio_irq_handler);
+        gpio_set_irq_enabled(PIR_DETECTOR, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+        irq_set_enabled(IO_IRQ_BANK0, true);
+        pir_record(gpio_get(PIR_DETECTOR), time_us_64());
+    }
 }
 
 /**
  * @brief PIR sensörü tarafından hareket algılanıp algılanmadığını kontrol eder
  * 
  * @return Hareket algılandıysa true, aksi halde false
+ *
+ * @note Kesme ile güncellenen kararlı seviye döner (PIO ile gecikme PIR_DEBOUNCE_US).
  */
 bool detect_motion(void) {
-    return gpio_get(PIR_DETECTOR);
+    return pir_level;
+}
+
+/**
+ * @brief Son PIR kenarlarını kopyalar
+ *
+ * @param out Kenarların yazılacağı dizi; en yeni kenar `out[0]`
+ * @param max En çok kopyalanacak kayıt (en çok PIR_LOG_LEN)
+ * @return uint Kopyalanan kayıt sayısı
+ */
+uint pir_history(pir_event_t *out, uint max) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint head = pir_log_head;
+    uint n = head < PIR_LOG_LEN ? head : PIR_LOG_LEN;
+    if (max < n) {
+        n = max;
+    }
+    for (uint i = 0; i < n; i++) {
+        out[i] = pir_log[(head - 1 - i) % PIR_LOG_LEN];
+    }
+    restore_interrupts(irq_state);
+    return n;
+}
+
+/**
+ * @brief Kenar kaydından doluluk istatistiklerini hesaplar
+ *
+ * @param out İstatistiklerin yazılacağı yapı
+ *
+ * @code{.c}
+ * pir_stats_t st;
+ * pir_get_stats(&st);
+ * if (!st.motion && st.since_last_motion_us > 5 * 60 * 1000000ull) {
+ *   // 5 dakikadır hareket yok
+ * }
+ * @endcode
+ *
+ * @note Dakikadaki hareket sayısı kayıttaki kenarlarla sınırlıdır
+ *       (en çok PIR_LOG_LEN / 2 hareket).
+ */
+void pir_get_stats(pir_stats_t *out) {
+    uint64_t now = time_us_64();
+
+    // Halka yerinde, en yeniden geriye yürünür; kopya yok (çağıranın yığını küçük olabilir)
+    uint32_t irq_state = save_and_disable_interrupts();
+    out->motion = pir_level;
+    out->dwell_us = now - pir_level_since_us;
+    out->since_last_motion_us = pir_last_motion_us ? now - pir_last_motion_us : UINT64_MAX;
+    out->total_motion_events = pir_motion_count;
+    out->motion_events_last_min = 0;
+    uint head = pir_log_head;
+    uint n = head < PIR_LOG_LEN ? head : PIR_LOG_LEN;
+    for (uint i = 0; i < n; i++) {
+        const pir_event_t *ev = &pir_log[(head - 1 - i) % PIR_LOG_LEN];
+        if (now - ev->timestamp_us > 60000000ull) {
+            break;
+        }
+        if (ev->motion) {
+            out->motion_events_last_min++;
+        }
+    }
+    restore_interrupts(irq_state);
 }
 
-// Ultrasonik sensör hesaplamaları için sabitler
-#define SOUND_SPEED      343.0f     // Oda sıcaklığında ses hızı (m/s)
-#define SENSOR_TIMEOUT   26100      // Zaman aşımı süresi (mikrosaniye) (yaklaşık 4.5m menzil)
-#define TRIGGER_PULSE    10         // Tetikleme darbe genişliği (mikrosaniye)
+// Ultrasonik sensör tetikleme darbe genişliği (mikrosaniye)
+#define TRIGGER_PULSE    10
 
 /**
  * @brief Ultrasonik sensör pinlerini başlatır
@@ -39,13 +209,17 @@ bool detect_motion(void) {
  */
 void init_ultrasonic(void) {
     // Tetikleme pinini çıkış olarak yapılandır
-    gpio_init(ULTRA_SONIC_TR);
-    gpio_set_dir(ULTRA_SONIC_TR, GPIO_OUT);
-    gpio_put(ULTRA_SONIC_TR, 0);    // Tetiklemeyi düşük başlat
+    if (pin_claim(ULTRA_SONIC_TR, PIN_FUNC_SIO_OUT, "ultrasonic") == PIN_CLAIM_NEW) {
+        gpio_init(ULTRA_SONIC_TR);
+        gpio_set_dir(ULTRA_SONIC_TR, GPIO_OUT);
+        gpio_put(ULTRA_SONIC_TR, 0);    // Tetiklemeyi düşük başlat
+    }
 
     // Yankı pinini giriş olarak yapılandır
-    gpio_init(ULTRA_SONIC_EC);
-    gpio_set_dir(ULTRA_SONIC_EC, GPIO_IN);
+    if (pin_claim(ULTRA_SONIC_EC, PIN_FUNC_SIO_IN, "ultrasonic") == PIN_CLAIM_NEW) {
+        gpio_init(ULTRA_SONIC_EC);
+        gpio_set_dir(ULTRA_SONIC_EC, GPIO_IN);
+    }
 }
 
 /**
@@ -53,47 +227,53 @@ void init_ultrasonic(void) {
  * 
  * @return float Santimetre cinsinden mesafe veya ölçüm başarısız olursa -1.0
  *
+ * @note Periyodik ölçüm motoru (`ultrasonic_start()`) çalışıyorsa beklemeden
+ *       son örnek döner; tetikleme durdurulmuşsa veya örnek eskiyse -1.0. Aksi halde tek bir ölçüm yankı bitene kadar
+ *       (en çok ULTRASONIC_TIMEOUT_US) bloklar.
  * @note Ölçüm aralığı tipik olarak ~2 cm ile ~450 cm arasındadır. Zaman aşımlarında -1.0 döner.
- * @note Ölçüm öncesi `init_ultrasonic()` çağrılmış olmalıdır.
+ * @note Bloklu ölçüm öncesi `init_ultrasonic()` çağrılmış olmalıdır.
  */
 float measure_distance(void) {
-    uint64_t start_time, end_time;
-    float duration;
+    ultrasonic_sample_t sample;
+    if (ultrasonic_is_running()) {
+        // Tetikleme pini PIO'da; durdurulmuşken veya örnek eskiyse ölçüm yok
+        return ultrasonic_latest(&sample) ? sample.distance_cm : -1.0f;
+    }
 
+    TRACE_BEGIN(TRACE_MEASURE_DISTANCE);
     // Tetikleme darbesi gönder
     gpio_put(ULTRA_SONIC_TR, 1);
     sleep_us(TRIGGER_PULSE);
     gpio_put(ULTRA_SONIC_TR, 0);
 
     // Yankı pininin yüksek olmasını bekle
-    uint32_t timeout_start = time_us_32();
+    uint64_t timeout_start = time_us_64();
     while (!gpio_get(ULTRA_SONIC_EC)) {
-        if (time_us_32() - timeout_start > SENSOR_TIMEOUT) {
+        if (time_us_64() - timeout_start > ULTRASONIC_TIMEOUT_US) {
+            TRACE_END(TRACE_MEASURE_DISTANCE);
             return -1.0f;  // Zaman aşımı oluştu
         }
     }
 
     // Başlangıç zamanını al
-    start_time = time_us_64();
+    uint64_t start_time = time_us_64();
 
     // Yankı pininin düşük olmasını bekle
     while (gpio_get(ULTRA_SONIC_EC)) {
-        if (time_us_32() - timeout_start > SENSOR_TIMEOUT) {
+        if (time_us_64() - timeout_start > ULTRASONIC_TIMEOUT_US) {
+            TRACE_END(TRACE_MEASURE_DISTANCE);
             return -1.0f;  // Zaman aşımı oluştu
         }
     }
 
-    // Bitiş zamanını al
-    end_time = time_us_64();
-
     // Süreyi ve mesafeyi hesapla
-    duration = (float)(end_time - start_time);
-    float distance = (SOUND_SPEED * duration * 0.0001f) / 2.0f;  // Santimetre cinsinden mesafe
-
+    float duration = (float)(time_us_64() - start_time);
+    float distance = (ultrasonic_sound_speed() * duration * 0.0001f) / 2.0f;  // Santimetre cinsinden mesafe
+    TRACE_END(TRACE_MEASURE_DISTANCE);
+    TRACE_COUNTER(TRACE_DISTANCE_MM, distance * 10.0f);
     return distance;
 }
 
-
 /**
  * @brief Zaman aşımı ile hareket algılamayı bekler
  * 
@@ -109,14 +289,14 @@ float measure_distance(void) {
  * @endcode
  */
 bool wait_for_motion(uint32_t timeout_ms) {
-    absolute_time_t start_time = get_absolute_time();
+    absolute_time_t deadline = timeout_ms > 0 ? make_timeout_time_ms(timeout_ms)
+                                              : at_the_end_of_time;
     
     while (!detect_motion()) {
-        if (timeout_ms > 0 && 
-            absolute_time_diff_us(start_time, get_absolute_time()) > timeout_ms * 1000) {
+        // PIR kenar kesmesi çekirdeği uyandırır
+        if (best_effort_wfe_or_timeout(deadline)) {
             return false;  // Zaman aşımı oluştu
         }
-        tight_loop_contents();  // CPU kullanımını optimize et
     }
     
     return true;  // Hareket algılandı
@@ -129,9 +309,16 @@ bool wait_for_motion(uint32_t timeout_ms) {
  * @param delay_ms Örnekler arasındaki gecikme süresi (milisaniye)
  * @return float Santimetre cinsinden ortalama mesafe veya ölçümler başarısız olursa -1.0
  *
+ * @note Periyodik ölçüm motoru çalışıyorsa parametreler yok sayılır ve
+ *       beklemeden filtrelenmiş tahmin (medyan + alfa-beta) döner.
  * @note Negatif dönen ölçümler (zaman aşımı) ortalamaya dahil edilmez.
  */
 float get_average_distance(uint8_t num_samples, uint32_t delay_ms) {
+    if (ultrasonic_is_running()) {
+        distance_estimate_t d;
+        return distance_filter_get(&d) ? d.distance_cm : -1.0f;
+    }
+
     if (num_samples == 0) return -1.0f;
 
     float total = 0.0f;
@@ -150,3 +337,136 @@ float get_average_distance(uint8_t num_samples, uint32_t delay_ms) {
 
     return (valid_samples > 0) ? (total / valid_samples) : -1.0f;
 }
+
+/**
+ * @brief Bir sensörün anlık değerini zaman damgalı ortak kayda okur
+ *
+ * Zaman damgası değerin ölçüldüğü andır: ADC, PIR ve butonlar için okuma anı
+ * (DMA akışında son ham örnek en çok bir round-robin periyodu eskidir),
+ * mesafe için sesin hedefe ulaştığı an (tetikleme + yankı / 2).
+ *
+ * @param id Sensör
+ * @param out Örneğin yazılacağı kayıt
+ * @return bool Örnek geçerliyse true
+ *
+ * @code{.c}
+ * sensor_sample_t s;
+ * if (sensor_read(SENSOR_DISTANCE, &s)) {
+ *   printf("%.1f cm @ %llu us\n", s.value, s.timestamp_us);
+ * }
+ * @endcode
+ */
+bool sensor_read(sensor_id_t id, sensor_sample_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->sensor = (uint8_t)id;
+
+    switch (id) {
+        case SENSOR_LDR:
+        case SENSOR_POT:
+            out->raw = read_analog((uint8_t)id);
+            out->timestamp_us = time_us_64();
+            out->value = adc_stream_is_running() ? (float)analog_filter_get((uint8_t)id)
+                                                 : (float)out->raw;
+            out->valid = true;
+            break;
+
+        case SENSOR_KEYPAD:
+            return keypad_sample(out);
+
+        case SENSOR_DISTANCE: {
+            ultrasonic_sample_t s;
+            out->value = -1.0f;
+            if (ultrasonic_latest(&s)) {
+                out->timestamp_us = s.timestamp_us + (uint64_t)(s.echo_us / 2.0f);
+                out->value = s.distance_cm;
+                out->raw = (uint32_t)s.echo_us;
+                out->valid = true;
+            }
+            break;
+        }
+
+        case SENSOR_PIR:
+            out->timestamp_us = time_us_64();
+            out->value = pir_level ? 1.0f : 0.0f;
+            out->raw = (uint32_t)((out->timestamp_us - pir_level_since_us) / 1000);
+            out->valid = true;
+            break;
+
+        case SENSOR_BUTTONS:
+            return buttons_sample(out);
+
+        default:
+            return false;
+    }
+    return out->valid;
+}
+
+/**
+ * @brief Tüm sensörlerin eşzamanlı anlık görüntüsünü alır
+ *
+ * Periyodik ultrasonik ölçüm açıksa önce yeni bir yankının tamamlanması
+ * beklenir (en çok bir ölçüm periyodu + ULTRASONIC_TIMEOUT_US; çekirdek
+ * `__wfe` ile uyur). Ardından diğer tüm kanallar kesmeler kapalıyken art arda
+ * okunur, böylece aralarındaki fark birkaç mikrosaniyedir. Mesafe örneğinin
+ * zaman damgası yankının ortasıdır; pencere genişliği pratikte hedef
+ * mesafesiyle (1 m için ~3 ms) sınırlıdır.
+ *
+ * @param out Görüntünün yazılacağı yapı
+ * @param window_us Geçerli örnekler arasında izin verilen en büyük zaman farkı
+ *                  (0 ise SENSOR_SYNC_WINDOW_US)
+ * @return bool Tüm geçerli örnekler pencere içindeyse true
+ *
+ * @note En çok ~51 ms beklediği için sık çalışan görevlerde değil, seyrek
+ *       çağrılan kodda (ör. `snap` konsol komutu) kullanılmalıdır.
+ *
+ * @code{.c}
+ * sensor_snapshot_t snap;
+ * if (sensor_capture_sync(&snap, 0)) {
+ *   float d = snap.samples[SENSOR_DISTANCE].value;
+ *   float ldr = snap.samples[SENSOR_LDR].value;
+ * }
+ * @endcode
+ */
+bool sensor_capture_sync(sensor_snapshot_t *out, uint32_t window_us) {
+    if (window_us == 0) {
+        window_us = SENSOR_SYNC_WINDOW_US;
+    }
+
+    if (ultrasonic_is_running() && !ultrasonic_is_paused()) {
+        ultrasonic_sample_t s;
+        uint64_t previous = ultrasonic_latest(&s) ? s.timestamp_us : 0;
+        absolute_time_t deadline =
+            make_timeout_time_us(1000000u / ULTRASONIC_RATE_HZ + ULTRASONIC_TIMEOUT_US);
+        // Yankı kesmesi çekirdeği uyandırır
+        while (!ultrasonic_latest(&s) || s.timestamp_us == previous) {
+            if (best_effort_wfe_or_timeout(deadline)) {
+                break;
+            }
+        }
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    for (uint i = 0; i < SENSOR_COUNT; i++) {
+        sensor_read((sensor_id_t)i, &out->samples[i]);
+    }
+    restore_interrupts(irq_state);
+
+    out->start_us = UINT64_MAX;
+    out->end_us = 0;
+    for (uint i = 0; i < SENSOR_COUNT; i++) {
+        const sensor_sample_t *s = &out->samples[i];
+        if (!s->valid) {
+            continue;
+        }
+        if (s->timestamp_us < out->start_us) {
+            out->start_us = s->timestamp_us;
+        }
+        if (s->timestamp_us > out->end_us) {
+            out->end_us = s->timestamp_us;
+        }
+    }
+    if (out->end_us < out->start_us) {
+        out->start_us = out->end_us;  // Geçerli örnek yok
+    }
+    return out->end_us - out->start_us <= window_us;
+}
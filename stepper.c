@@ -41,6 +41,23 @@ static const uint motor_pins[4] = {
 static volatile motor_state_t motor_state = MOTOR_STOPPED;
 static volatile bool emergency_stop = false;
 
+/**
+ * @brief Core 0'dan Core 1'e giden motor komutu
+ */
+typedef struct {
+    motor_direction_t direction; ///< Dönüş yönü
+    uint speed;                  ///< Adım/saniye
+    float revolutions;           ///< Devir sayısı
+} motor_command_t;
+
+/**
+ * @brief Motor komut kutusu (Core 0 -> Core 1)
+ *
+ * SIO FIFO'su yerine kullanılır: Core 1 flash_safe_execute() kilit kurbanıdır
+ * ve SDK'nın kilit kesmesi FIFO'daki kilit dışı sözcükleri atar.
+ */
+static queue_t motor_commands;
+
 /**
  * @brief Step motor GPIO pinlerini başlatır
  * 
@@ -50,10 +67,14 @@ static volatile bool emergency_stop = false;
  * @note motor_pins[] dizisinin step motorunun 4 fazı için geçerli GPIO pin numaralarını içerdiği varsayılır
  */
 void init_step_motor(void) {
+    queue_init(&motor_commands, sizeof(motor_command_t), 1);
+
     // Motor kontrol pinlerini başlat
     for (int i = 0; i < 4; i++) {
-        gpio_init(motor_pins[i]);
-        gpio_set_dir(motor_pins[i], GPIO_OUT);
+        if (pin_claim(motor_pins[i], PIN_FUNC_SIO_OUT, "stepper") == PIN_CLAIM_NEW) {
+            gpio_init(motor_pins[i]);
+            gpio_set_dir(motor_pins[i], GPIO_OUT);
+        }
     }
 }
 
@@ -119,14 +140,14 @@ void step_stop(void) {
  */
 void step_turn(motor_direction_t direction, uint speed, float revolutions) {
     if (motor_state == MOTOR_RUNNING) {
-        printf("Motor zaten çalışıyor.\n");
+        LOG_WARN("Motor zaten çalışıyor.");
         return;
     }
 
-    init_step_motor();
-    // Motor durumunu güncelle
+    // Motor durumunu güncelle (pinler init_board() -> init_step_motor() ile bir kez ayarlanır)
     motor_state = MOTOR_RUNNING;
     emergency_stop = false;
+    TRACE_BEGIN(TRACE_STEP_TURN);
 
     // Toplam adım sayısını hesapla
     const int steps_per_revolution = 8; // Her bir tam tur için 8 adım (yarım adım modu)
@@ -139,7 +160,7 @@ void step_turn(motor_direction_t direction, uint speed, float revolutions) {
     // Döngü: Belirtilen adım sayısı boyunca motoru döndür
     for (int step = 0; step < total_steps; step++) {
         if (emergency_stop) {
-            printf("Acil durdurma tetiklendi.\n");
+            LOG_WARN("Acil durdurma tetiklendi (adim %d/%d).", step, total_steps);
             break;
         }
 
@@ -147,6 +168,7 @@ void step_turn(motor_direction_t direction, uint speed, float revolutions) {
         for (int i = 0; i < 4; i++) {
             gpio_put(motor_pins[i], step_sequence[step_index][i]);
         }
+        TRACE_COUNTER(TRACE_STEP_INDEX, step_index);
 
         // Yön belirle ve adım dizinini güncelle
         if (direction == CW) {
@@ -161,5 +183,49 @@ void step_turn(motor_direction_t direction, uint speed, float revolutions) {
 
     // Motoru durdur
     step_stop();
-    printf("Motor hareketi tamamlandı.\n");
+    TRACE_END(TRACE_STEP_TURN);
+    LOG_INFO("Motor hareketi tamamlandı.");
+}
+
+/**
+ * @brief Step motor komutunu Core 1'e gönderir (yön, hız, devir)
+ *
+ * Önceki komut Core 1 tarafından alınmadıysa bekler. Çağıran, tamamlanma
+ * mesajını (CORE1_MSG_MOTOR_DONE) beklemeden yeni komut göndermemelidir.
+ *
+ * @param direction Motor yönü
+ * @param speed Adım/saniye
+ * @param revolutions Devir sayısı
+ */
+void send_motor_parameters(motor_direction_t direction, uint speed, float revolutions) {
+    motor_command_t cmd = {direction, speed, revolutions};
+    TRACE_INSTANT(TRACE_MOTOR_COMMAND, speed);
+    queue_add_blocking(&motor_commands, &cmd);
+}
+
+/**
+ * @brief Core 1 ana döngüsü; motor komutlarını yürütür
+ *
+ * 1. Core 0 flash'a yazarken durdurulabilmek için kilit kurbanı olarak kaydolur
+ * 2. Komut kutusundan komut bekler (`__wfe` ile uyur)
+ * 3. step_turn() ile hareketi yürütür
+ * 4. event_loop_core1_post() ile Core 0'a CORE1_MSG_MOTOR_DONE gönderir
+ *
+ * SIO FIFO'su yalnızca kilit el sıkışmasına kalır.
+ *
+ * @note init_step_motor() ve event_loop_init() sonrasında başlatılmalıdır.
+ * @see send_motor_parameters()
+ */
+void core1_main(void) {
+    flash_safe_execute_core_init();
+
+    while (true) {
+        motor_command_t cmd;
+        sysmon_idle_enter();
+        queue_remove_blocking(&motor_commands, &cmd);
+        sysmon_idle_exit();
+
+        step_turn(cmd.direction, cmd.speed, cmd.revolutions);
+        event_loop_core1_post(CORE1_MSG_MOTOR_DONE);
+    }
 }
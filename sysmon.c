@@ -0,0 +1,198 @@
+/**
+ * @file sysmon.c
+ * @brief Çekirdek yükü, yığın/heap doluluğu ve buton kesmesi gecikmesi izleyicisi
+ * @see \ref howto_sysmon
+ *
+ * Yük, çekirdeklerin bekleme noktalarında geçirdiği süreden hesaplanır:
+ * Core 0 için olay döngüsünün `__wfe` uykusu, Core 1 için `motor_commands`
+ * kuyruğundan (`queue_remove_blocking()`) komut beklemesi. Bu noktalar
+ * `sysmon_idle_enter()` / `sysmon_idle_exit()` ile işaretlenir; her çekirdek
+ * yalnızca kendi sayaçlarına yazar, kilit yoktur.
+ *
+ * Yığın tepe kullanımı boyanmış yığınlardan okunur: açılışta boş yığın
+ * sözcükleri bilinen bir desenle doldurulur, raporda desenin bozulmadığı en
+ * derin noktaya kadar olan kısım kullanılmamış sayılır.
+ */
+
+#include "pico_training_board.h"
+
+#if PICO_ON_DEVICE
+#include <malloc.h>
+
+#define SYSMON_STACK_PAINT 0xC5C5C5C5u
+#define SYSMON_STACK_MARGIN 64  // Core 0 boyanırken canlı çerçevenin altında bırakılan pay (bayt)
+
+// SDK bağlayıcı betiği (memmap_default.ld) sembolleri
+extern uint32_t __StackBottom, __StackTop;        // Core 0 yığını (SCRATCH_Y)
+extern uint32_t __StackOneBottom, __StackOneTop;  // Core 1 yığını (SCRATCH_X)
+extern char __end__, __StackLimit;                // Heap: __end__ .. __StackLimit
+#endif
+
+static volatile uint64_t idle_us[2];
+static volatile uint64_t idle_since[2];  // 0: çekirdek şu an beklemede değil
+static uint64_t window_start_us;
+static volatile uint32_t button_latency_max_us;
+static volatile uint32_t button_irq_max_us;
+
+#if PICO_ON_DEVICE
+/**
+ * @brief Yığın bölgesini boyar
+ * @param from İlk sözcük
+ * @param to Son sözcükten sonraki adres
+ */
+static void paint_stack(uint32_t *from, uint32_t *to) {
+    while (from < to) {
+        *from++ = SYSMON_STACK_PAINT;
+    }
+}
+
+/**
+ * @brief Boyanmış bir yığının en derin kullanımını döndürür
+ * @param bottom Yığının en düşük adresi
+ * @param top Yığının tepesi (ilk itilen sözcüğün üstü)
+ * @return uint32_t Kullanılmış bayt sayısı
+ */
+static uint32_t stack_used(const uint32_t *bottom, const uint32_t *top) {
+    const uint32_t *p = bottom;
+    while (p < top && *p == SYSMON_STACK_PAINT) {
+        p++;
+    }
+    return (uint32_t)((const char *)top - (const char *)p);
+}
+#endif
+
+/**
+ * @brief Yığınları boyar ve ölçüm penceresini başlatır
+ *
+ * Core 1 yığını tamamen, Core 0 yığını ise çağıranın çerçevesinin altına
+ * kadar boyanır.
+ *
+ * @note `multicore_launch_core1()` öncesinde çağrılmalıdır.
+ */
+void sysmon_init(void) {
+#if PICO_ON_DEVICE
+    uint32_t marker;
+    paint_stack(&__StackOneBottom, &__StackOneTop);
+    paint_stack(&__StackBottom, (uint32_t *)((uintptr_t)&marker - SYSMON_STACK_MARGIN));
+#endif
+    sysmon_reset();
+}
+
+/**
+ * @brief Çağıran çekirdeğin bekleme noktasına girdiğini işaretler
+ */
+void __not_in_flash_func(sysmon_idle_enter)(void) {
+    idle_since[get_core_num()] = time_us_64();
+}
+
+/**
+ * @brief Çağıran çekirdeğin bekleme noktasından çıktığını işaretler
+ */
+void __not_in_flash_func(sysmon_idle_exit)(void) {
+    uint core = get_core_num();
+    uint64_t since = idle_since[core];
+    if (since != 0) {
+        idle_us[core] += time_us_64() - since;
+        idle_since[core] = 0;
+    }
+}
+
+/**
+ * @brief Buton kesmesi yolundan bir ölçüm bildirir
+ *
+ * @param latency_us Kesmenin planlanan zamanı ile işleyicinin başlaması arası
+ *                   (bilinmiyorsa 0)
+ * @param handler_us İşleyicinin kesme bağlamında çalıştığı süre
+ */
+void sysmon_button_irq(uint32_t latency_us, uint32_t handler_us) {
+    if (latency_us > button_latency_max_us) {
+        button_latency_max_us = latency_us;
+    }
+    if (handler_us > button_irq_max_us) {
+        button_irq_max_us = handler_us;
+    }
+}
+
+/**
+ * @brief Bekleme sürelerini ve kesme ölçümlerini sıfırlar; yeni pencere başlatır
+ *
+ * Yığın tepe kullanımı sıfırlanmaz (boya yeniden atılamaz).
+ */
+void sysmon_reset(void) {
+    uint64_t now = time_us_64();
+    uint32_t irq_state = save_and_disable_interrupts();
+    for (uint core = 0; core < 2; core++) {
+        idle_us[core] = 0;
+        if (idle_since[core] != 0) {
+            idle_since[core] = now;
+        }
+    }
+    window_start_us = now;
+    button_latency_max_us = 0;
+    button_irq_max_us = 0;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Anlık ölçümleri doldurur
+ *
+ * Süren bir bekleme de bekleme süresine eklenir; uzun süre komut beklemeyen
+ * Core 1 %0 yük gösterir. Diğer çekirdeğin 64 bit sayaçları yırtılmaya karşı
+ * iki kez okunur.
+ *
+ * @param out Ölçümlerin yazılacağı yapı
+ */
+void sysmon_get(sysmon_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    uint64_t now = time_us_64();
+    out->window_us = now - window_start_us;
+    for (uint core = 0; core < 2; core++) {
+        uint64_t idle, since;
+        do {
+            idle = idle_us[core];
+            since = idle_since[core];
+        } while (idle != idle_us[core] || since != idle_since[core]);
+        if (since != 0 && since < now) {
+            idle += now - since;
+        }
+        out->idle_us[core] = idle < out->window_us ? idle : out->window_us;
+    }
+#if PICO_ON_DEVICE
+    out->stack_size[0] = (uint32_t)((char *)&__StackTop - (char *)&__StackBottom);
+    out->stack_used[0] = stack_used(&__StackBottom, &__StackTop);
+    out->stack_size[1] = (uint32_t)((char *)&__StackOneTop - (char *)&__StackOneBottom);
+    out->stack_used[1] = stack_used(&__StackOneBottom, &__StackOneTop);
+    struct mallinfo mi = mallinfo();
+    out->heap_used = (uint32_t)mi.uordblks;
+    out->heap_size = (uint32_t)(&__StackLimit - &__end__);
+#endif
+    out->button_latency_max_us = button_latency_max_us;
+    out->button_irq_max_us = button_irq_max_us;
+}
+
+/**
+ * @brief Ölçümleri stdio'ya tablo olarak yazar (`load` konsol komutu)
+ */
+void sysmon_print_report(void) {
+    sysmon_stats_t s;
+    sysmon_get(&s);
+    printf("pencere: %llu ms\n", (unsigned long long)(s.window_us / 1000));
+    for (uint core = 0; core < 2; core++) {
+        uint32_t load_pm = s.window_us ? (uint32_t)(1000 - s.idle_us[core] * 1000 / s.window_us) : 0;
+        printf("core%u: yuk %%%lu.%lu, bosta %llu ms\n", core,
+               (unsigned long)(load_pm / 10), (unsigned long)(load_pm % 10),
+               (unsigned long long)(s.idle_us[core] / 1000));
+    }
+    if (s.stack_size[0] != 0) {
+        for (uint core = 0; core < 2; core++) {
+            printf("yigin core%u: %lu / %lu B (%%%lu)\n", core, (unsigned long)s.stack_used[core],
+                   (unsigned long)s.stack_size[core],
+                   (unsigned long)(s.stack_used[core] * 100 / s.stack_size[core]));
+        }
+        printf("heap: %lu / %lu B\n", (unsigned long)s.heap_used, (unsigned long)s.heap_size);
+    } else {
+        printf("yigin/heap: olculmuyor (simulasyon)\n");
+    }
+    printf("buton kesmesi: en uzun gecikme %lu us, en uzun isleyici %lu us\n",
+           (unsigned long)s.button_latency_max_us, (unsigned long)s.button_irq_max_us);
+}
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""adc_noise_bench çıktısını ayrıştırır ve kanal/yöntem başına özet yazar.
+
+Kullanım:
+    python3 tools/adc_noise_report.py capture.csv
+    python3 tools/adc_noise_report.py --port /dev/ttyACM0 --runs 3
+    cat capture.csv | python3 tools/adc_noise_report.py --histogram KEYPAD
+
+Firmware (bench/adc_noise_bench.c) şu satırları üretir:
+    summary,run,channel,mode,samples,elapsed_us,samples_per_s,mean,stddev,enob
+    hist,run,channel,mode,value,count
+'#' ile başlayan satırlar ve tanınmayan satırlar yok sayılır.
+"""
+
+import argparse
+import math
+import statistics
+import sys
+from collections import defaultdict
+
+SUMMARY_FIELDS = ("run", "channel", "mode", "samples", "elapsed_us",
+                  "samples_per_s", "mean", "stddev", "enob")
+
+
+def read_lines(args):
+    """Girdi satırlarını dosyadan, stdin'den veya seri porttan üretir."""
+    if args.port:
+        try:
+            import serial  # pyserial
+        except ImportError:
+            sys.exit("--port için pyserial gerekli: pip install pyserial")
+        runs_seen = 0
+        with serial.Serial(args.port, 115200, timeout=10) as port:
+            while runs_seen < args.runs:
+                raw = port.readline()
+                if not raw:
+                    sys.exit("seri porttan veri gelmedi (zaman aşımı)")
+                line = raw.decode("utf-8", "replace").strip()
+                if line.startswith("# end run="):
+                    runs_seen += 1
+                yield line
+        return
+
+    stream = sys.stdin if args.input in (None, "-") else open(args.input, encoding="utf-8")
+    with stream:
+        for line in stream:
+            yield line.strip()
+
+
+def parse(lines):
+    """Özet satırlarını ve histogramları toplar."""
+    summaries = []
+    histograms = defaultdict(lambda: defaultdict(int))
+    for line in lines:
+        if not line or line.startswith("#"):
+            continue
+        parts = line.split(",")
+        if parts[0] == "summary" and len(parts) == len(SUMMARY_FIELDS) + 1:
+            row = dict(zip(SUMMARY_FIELDS, parts[1:]))
+            for key in ("run", "samples", "elapsed_us"):
+                row[key] = int(row[key])
+            for key in ("samples_per_s", "mean", "stddev", "enob"):
+                row[key] = float(row[key])
+            summaries.append(row)
+        elif parts[0] == "hist" and len(parts) == 6:
+            _, _run, channel, mode, value, count = parts
+            histograms[(channel, mode)][int(value)] += int(count)
+    return summaries, histograms
+
+
+def print_summary(summaries):
+    """Kanal/yöntem başına tüm turların ortalamasını yazdırır."""
+    groups = defaultdict(list)
+    for row in summaries:
+        groups[(row["channel"], row["mode"])].append(row)
+
+    print(f"{'kanal':<8} {'yontem':<9} {'tur':>3} {'ornek/s':>10} {'ortalama':>9} "
+          f"{'std':>7} {'ENOB':>6}")
+    for (channel, mode), rows in sorted(groups.items()):
+        print(f"{channel:<8} {mode:<9} {len(rows):>3} "
+              f"{statistics.mean(r['samples_per_s'] for r in rows):>10.0f} "
+              f"{statistics.mean(r['mean'] for r in rows):>9.1f} "
+              f"{statistics.mean(r['stddev'] for r in rows):>7.2f} "
+              f"{statistics.mean(r['enob'] for r in rows):>6.2f}")
+
+    keypad = [r["stddev"] for r in summaries if r["channel"] == "KEYPAD"]
+    if keypad:
+        sigma = max(keypad)
+        print(f"\nKEYPAD en kötü std = {sigma:.2f} LSB; "
+              f"KEYPAD_HYSTERESIS >= {math.ceil(3 * sigma)} (3 sigma) önerilir")
+
+
+def print_histogram(histograms, channel, width=50):
+    """Bir kanalın histogramlarını metin grafiği olarak yazdırır."""
+    for (ch, mode), hist in sorted(histograms.items()):
+        if ch != channel:
+            continue
+        peak = max(hist.values())
+        print(f"\n{ch} / {mode}")
+        for value in sorted(hist):
+            bar = "#" * max(1, round(width * hist[value] / peak))
+            print(f"{value:>5} {hist[value]:>6} {bar}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="CSV dosyası (varsayılan: stdin)")
+    parser.add_argument("--port", help="Doğrudan okunacak seri port (pyserial)")
+    parser.add_argument("--runs", type=int, default=1, help="--port ile okunacak tur sayısı")
+    parser.add_argument("--histogram", metavar="KANAL", help="Kanal histogramını çiz (ör. KEYPAD)")
+    args = parser.parse_args()
+
+    summaries, histograms = parse(read_lines(args))
+    if not summaries:
+        sys.exit("özet satırı bulunamadı")
+    print_summary(summaries)
+    if args.histogram:
+        print_histogram(histograms, args.histogram)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""driver_bench JSON satırlarını kaydeder ve iki çalıştırmayı karşılaştırır.
+
+Kullanım:
+    python3 tools/bench_diff.py --port /dev/ttyACM0 --runs 3 -o once.jsonl
+    python3 tools/bench_diff.py once.jsonl sonra.jsonl
+    python3 tools/bench_diff.py once.jsonl sonra.jsonl --metric us_med --fail-above 5
+
+Firmware (bench/driver_bench.c) her ölçüm için bir JSON satırı üretir:
+    {"run":0,"name":"lcd_send_byte","n":32,"cycles_min":...,"cycles_med":...,...}
+'{' ile başlamayan satırlar ve "meta" satırları yok sayılır. Birden çok tur
+varsa her ölçümün metriği turların medyanıyla özetlenir.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+from collections import defaultdict
+
+METRICS = ("cycles_min", "cycles_med", "cycles_max", "us_min", "us_med", "us_max")
+
+
+def capture(port_name, runs, out_path):
+    """Seri porttan `runs` tur okur ve JSON satırlarını dosyaya yazar."""
+    try:
+        import serial  # pyserial
+    except ImportError:
+        sys.exit("--port için pyserial gerekli: pip install pyserial")
+    runs_seen = 0
+    with serial.Serial(port_name, 115200, timeout=30) as port, \
+            open(out_path, "w", encoding="utf-8") as out:
+        while runs_seen < runs:
+            raw = port.readline()
+            if not raw:
+                sys.exit("seri porttan veri gelmedi (zaman aşımı)")
+            line = raw.decode("utf-8", "replace").strip()
+            if line.startswith("# end run="):
+                runs_seen += 1
+            elif line.startswith("{"):
+                out.write(line + "\n")
+    print(f"{runs} tur {out_path} dosyasına yazıldı")
+
+
+def load(path, metric):
+    """Dosyadaki ölçümleri ad -> metrik (turların medyanı) olarak döndürür."""
+    values = defaultdict(list)
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                row = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+            if "meta" in row or metric not in row:
+                continue
+            values[row["name"]].append(row[metric])
+    return {name: statistics.median(v) for name, v in values.items()}
+
+
+def diff(base, new, threshold):
+    """Karşılaştırma tablosunu yazar; eşiği aşan değişimleri işaretler."""
+    names = list(base) + [n for n in new if n not in base]
+    print(f"{'olcum':<20} {'once':>12} {'sonra':>12} {'fark':>12} {'%':>8}")
+    for name in names:
+        a = base.get(name)
+        b = new.get(name)
+        if a is None or b is None:
+            print(f"{name:<20} {a if a is not None else '-':>12} {b if b is not None else '-':>12}")
+            continue
+        delta = b - a
+        pct = 100.0 * delta / a if a else 0.0
+        mark = ""
+        if pct > threshold:
+            mark = "  YAVAS"
+        elif pct < -threshold:
+            mark = "  hizli"
+        print(f"{name:<20} {a:>12.0f} {b:>12.0f} {delta:>+12.0f} {pct:>+7.1f}%{mark}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("files", nargs="*", help="Karşılaştırılacak iki JSON satırı dosyası")
+    parser.add_argument("--port", help="Seri porttan kaydet (pyserial)")
+    parser.add_argument("--runs", type=int, default=3, help="--port ile okunacak tur sayısı")
+    parser.add_argument("-o", "--output", help="--port kaydının yazılacağı dosya")
+    parser.add_argument("--metric", choices=METRICS, default="cycles_med",
+                        help="Karşılaştırılacak alan (varsayılan: cycles_med)")
+    parser.add_argument("--threshold", type=float, default=2.0,
+                        help="Değişim sayılacak en küçük yüzde (varsayılan: 2)")
+    parser.add_argument("--fail-above", type=float, metavar="YUZDE",
+                        help="Bu yüzdeden fazla yavaşlama varsa çıkış kodu 1")
+    args = parser.parse_args()
+
+    if args.port:
+        if not args.output:
+            sys.exit("--port ile -o DOSYA gerekli")
+        capture(args.port, args.runs, args.output)
+        return
+    if len(args.files) != 2:
+        parser.error("iki dosya gerekli: ONCE SONRA")
+
+    base = load(args.files[0], args.metric)
+    new = load(args.files[1], args.metric)
+    if not base or not new:
+        sys.exit("ölçüm satırı bulunamadı")
+    print(f"# metrik: {args.metric}")
+    diff(base, new, args.threshold)
+    if args.fail_above is not None:
+        worse = [n for n in base if n in new and base[n]
+                 and 100.0 * (new[n] - base[n]) / base[n] > args.fail_above]
+        if worse:
+            print(f"\n%{args.fail_above:g} üstü yavaşlama: {', '.join(worse)}")
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
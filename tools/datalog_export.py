@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Flash veri kaydını (datalog.c) çözer ve CSV olarak yazar.
+
+Kullanım:
+    python3 tools/datalog_export.py dump.bin > kayit.csv
+    python3 tools/datalog_export.py flash.bin            # simülasyon görüntüsü (2 MB)
+    python3 tools/datalog_export.py --port /dev/ttyACM0 -o kayit.csv
+
+Girdi üç biçimden biri olabilir:
+- `datalog dump` çıktısı: `# datalog v1 pages=N page=256` satırı, N ham
+  sayfa, `# datalog end` satırı (konsol metni önde/arkada olabilir),
+- flash görüntüsünün tamamı (rppicods_datalog --image),
+- yalnızca kayıt bölgesi (DATALOG_FLASH_SECTORS × 4096 bayt).
+`--port` verilirse komut karta gönderilir ve dökümü okunur.
+
+Sayfalar sıra numarasına göre dizilir; başlık veya yük CRC'si tutmayan
+sayfalar atlanır ve stderr'e yazılır. CSV sütunları:
+`boot,t_ms,sensor,value` (değer ölçekleri için docs/howto/datalog.md).
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import time
+
+from remote_client import SENSOR_NAMES, crc16_ccitt
+
+MAGIC = 0x44474C31
+PAGE_SIZE = 256
+SECTOR_SIZE = 4096
+FLASH_SIZE = 2 * 1024 * 1024
+REGION_SECTORS = 64
+REGION_OFFSET = FLASH_SIZE - 2 * SECTOR_SIZE - REGION_SECTORS * SECTOR_SIZE  # Yapılandırma A/B sektörlerinin önü
+HEADER = struct.Struct("<IIQHHHH")  # magic, seq, base_ms, boot, len, payload_crc, header_crc
+DUMP_START = b"# datalog v1"
+DUMP_END = b"# datalog end"
+
+
+def varint(buf, i):
+    value = shift = 0
+    while i < len(buf):
+        b = buf[i]
+        i += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, i
+        shift += 7
+    raise ValueError("yarim varint")
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def decode_page(page):
+    """Geçerli sayfanın (seq, kayıtlar) ikilisini, geçersizse None döndürür."""
+    magic, seq, base_ms, boot, length, payload_crc, header_crc = HEADER.unpack_from(page)
+    if magic != MAGIC or length > PAGE_SIZE - HEADER.size:
+        return None
+    if crc16_ccitt(page[:HEADER.size - 2]) != header_crc:
+        return None
+    payload = page[HEADER.size:HEADER.size + length]
+    if crc16_ccitt(payload) != payload_crc:
+        return None
+    records = []
+    prev = [0] * len(SENSOR_NAMES)
+    t_ms = base_ms
+    i = 0
+    try:
+        while i < len(payload):
+            sensor = payload[i]
+            dt, i = varint(payload, i + 1)
+            dv, i = varint(payload, i)
+            if sensor >= len(prev):
+                break
+            t_ms += dt
+            prev[sensor] += unzigzag(dv)
+            if prev[sensor] >= 1 << 31:
+                prev[sensor] -= 1 << 32
+            records.append((boot, t_ms, sensor, prev[sensor]))
+    except ValueError:
+        pass
+    return seq, records
+
+
+def split_pages(data):
+    """Girdiyi ham sayfalara böler (döküm, tam görüntü veya bölge)."""
+    start = data.find(DUMP_START)
+    if start >= 0:
+        line_end = data.index(b"\n", start) + 1
+        fields = dict(f.split(b"=") for f in data[start:line_end].split() if b"=" in f)
+        count = int(fields.get(b"pages", b"0"))
+        body = data[line_end:line_end + count * PAGE_SIZE]
+        if len(body) < count * PAGE_SIZE:
+            print("uyari: dokum eksik (%d/%d sayfa)" % (len(body) // PAGE_SIZE, count), file=sys.stderr)
+    elif len(data) == FLASH_SIZE:
+        body = data[REGION_OFFSET:REGION_OFFSET + REGION_SECTORS * SECTOR_SIZE]
+    else:
+        body = data
+    return [body[i:i + PAGE_SIZE] for i in range(0, len(body) - PAGE_SIZE + 1, PAGE_SIZE)]
+
+
+def read_port(path, baud, timeout):
+    try:
+        import serial  # pyserial
+        port = serial.Serial(path, baud, timeout=0.2)
+    except ImportError:
+        from remote_client import _PosixPort
+        port = _PosixPort(path, baud, 0.2)
+    try:
+        port.write(b"datalog dump\n")
+        data = bytearray()
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            data += port.read(4096)
+            start = data.find(DUMP_START)
+            if start >= 0 and data.find(DUMP_END, start) >= 0:
+                return bytes(data)
+        raise SystemExit("hata: %s: dokum %.0f s icinde bitmedi" % (path, timeout))
+    finally:
+        port.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("input", nargs="?", help="dokum veya goruntu dosyasi")
+    ap.add_argument("--port", help="karttan oku (ornek: /dev/ttyACM0)")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--timeout", type=float, default=30.0)
+    ap.add_argument("-o", "--output", help="CSV dosyasi (varsayilan: stdout)")
+    args = ap.parse_args()
+
+    if args.port:
+        data = read_port(args.port, args.baud, args.timeout)
+    elif args.input:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        ap.error("dosya veya --port gerekli")
+
+    pages = []
+    bad = 0
+    for page in split_pages(data):
+        if page.count(0xFF) == PAGE_SIZE:
+            continue
+        decoded = decode_page(page)
+        if decoded is None:
+            bad += 1
+        else:
+            pages.append(decoded)
+    pages.sort(key=lambda p: p[0])
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["boot", "t_ms", "sensor", "value"])
+    count = 0
+    for _, records in pages:
+        for boot, t_ms, sensor, value in records:
+            writer.writerow([boot, t_ms, SENSOR_NAMES[sensor], value])
+            count += 1
+    if out is not sys.stdout:
+        out.close()
+    print("%d sayfa, %d kayit, %d bozuk sayfa atlandi" % (len(pages), count, bad), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,421 @@
+#!/usr/bin/env python3
+"""Kartın ikili komut/telemetri protokolü (remote.c) için istemci kütüphanesi.
+
+Kullanım:
+    from remote_client import RemoteClient, SENSOR_POT
+    with RemoteClient.open("/dev/ttyACM0") as board:
+        print(board.ping())                 # gidiş-dönüş süresi (s)
+        board.lcd("Merhaba", row=0, col=0, clear=True)
+        board.beep(880, 100)
+        board.motor(CW, 900, 1.5)
+        board.subscribe(SENSOR_POT, 50)
+        sample = board.samples.get(timeout=1)
+        board.config_set("motor_speed", 600); board.config_save()
+
+Komut satırından tek komut:
+    python3 tools/remote_client.py /dev/ttyACM0 ping
+    python3 tools/remote_client.py /dev/rfcomm0 --baud 9600 watch pot 20
+    python3 tools/remote_client.py /dev/ttyACM0 config set sound_speed 346.5
+
+Çerçeve: tür u8 | sıra u8 | yük | CRC-16/CCITT (LE); COBS ile kodlanır ve
+hatta 0x00 | COBS | 0x00 olarak gider. USB'de aynı hatta metin konsolu da
+akar; çözülemeyen veya CRC'si tutmayan parçalar metin sayılır ve `on_text`
+ile verilir. pyserial varsa kullanılır, yoksa POSIX tty (veya pty) doğrudan
+açılır.
+"""
+
+import argparse
+import os
+import queue
+import struct
+import sys
+import threading
+import time
+from collections import namedtuple
+
+MSG_PING = 0x01
+MSG_MOTOR = 0x02
+MSG_LCD = 0x03
+MSG_BEEP = 0x04
+MSG_SUBSCRIBE = 0x05
+MSG_STATS = 0x06
+MSG_CONFIG_GET = 0x07
+MSG_CONFIG_SET = 0x08
+MSG_CONFIG_SAVE = 0x09
+MSG_ACK = 0x80
+MSG_PONG = 0x81
+MSG_STATS_REPLY = 0x82
+MSG_CONFIG_VALUE = 0x83
+MSG_SAMPLE = 0x90
+
+STATUS_NAMES = {0: "ok", 1: "mesgul", 2: "gecersiz", 3: "desteklenmiyor"}
+
+SENSOR_LDR, SENSOR_POT, SENSOR_KEYPAD, SENSOR_DISTANCE, SENSOR_PIR, SENSOR_BUTTONS = range(6)
+SENSOR_NAMES = ["ldr", "pot", "keypad", "mesafe", "pir", "buton"]
+CW, CCW = 0, 1
+
+MAX_PAYLOAD = 48
+SAMPLE = struct.Struct("<BBQfI")
+STATS = struct.Struct("<5I")
+CONFIG_VALUE = struct.Struct("<BBB4sff")  # id, tür, yeniden açılış, değer, en az, en çok; ardından ad
+CONFIG_U16, CONFIG_U32, CONFIG_F32 = range(3)
+
+Sample = namedtuple("Sample", "sensor seq valid timestamp_us value raw received")
+Stats = namedtuple("Stats", "rx_frames rx_errors tx_frames tx_dropped samples")
+ConfigField = namedtuple("ConfigField", "id name type reboot value min max")
+
+
+class RemoteError(Exception):
+    """Kart isteği reddetti veya cevap gelmedi."""
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    """crc16.c ile aynı CRC-16/CCITT (polinom 0x1021)."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos, code = 0, 1
+    for b in data:
+        if b == 0:
+            out[code_pos] = code
+            code_pos, code = len(out), 1
+            out.append(0)
+        else:
+            out.append(b)
+            code += 1
+            if code == 0xFF:
+                out[code_pos] = code
+                code_pos, code = len(out), 1
+                out.append(0)
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """Bozuk kodlamada None döndürür."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(msg_type, seq, payload=b""):
+    frame = bytes([msg_type, seq]) + bytes(payload)
+    frame += struct.pack("<H", crc16_ccitt(frame))
+    return b"\x00" + cobs_encode(frame) + b"\x00"
+
+
+def decode_frame(chunk):
+    """Ayraçsız bir parçayı (tür, sıra, yük) olarak çözer; çerçeve değilse None."""
+    frame = cobs_decode(chunk)
+    if frame is None or len(frame) < 4:
+        return None
+    if crc16_ccitt(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+        return None
+    return frame[0], frame[1], frame[2:-2]
+
+
+class _PosixPort:
+    """pyserial olmadan tty/pty: ham kip, okuma zaman aşımlı."""
+
+    def __init__(self, path, baud, timeout):
+        import termios
+        import tty
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is not None:
+            attrs[4] = attrs[5] = speed
+        attrs[3] &= ~termios.ECHO
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        self.timeout = timeout
+
+    def read(self, n):
+        import select
+        ready, _, _ = select.select([self.fd], [], [], self.timeout)
+        return os.read(self.fd, n) if ready else b""
+
+    def write(self, data):
+        return os.write(self.fd, data)
+
+    def close(self):
+        os.close(self.fd)
+
+
+class RemoteClient:
+    """Arka planda okuyan, istek/cevap eşleştiren istemci.
+
+    `samples` kuyruğuna SAMPLE çerçeveleri `Sample` olarak düşer. Metin
+    (USB konsol çıktısı) `on_text` çağrılabilirine satır satır verilir.
+    """
+
+    def __init__(self, port, timeout=1.0, on_text=None):
+        self.port = port
+        self.timeout = timeout
+        self.on_text = on_text
+        self.samples = queue.Queue()
+        self.rx_bytes = 0
+        self.bad_frames = 0
+        self._seq = 0
+        self._replies = {}
+        self._cond = threading.Condition()
+        self._write_lock = threading.Lock()
+        self._running = True
+        self._reader = threading.Thread(target=self._read_loop, daemon=True)
+        self._reader.start()
+
+    @classmethod
+    def open(cls, path, baud=115200, timeout=1.0, on_text=None):
+        try:
+            import serial  # pyserial
+            port = serial.Serial(path, baud, timeout=0.05)
+        except ImportError:
+            port = _PosixPort(path, baud, 0.05)
+        return cls(port, timeout, on_text)
+
+    def close(self):
+        self._running = False
+        self._reader.join(1.0)
+        self.port.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    # -- alma -------------------------------------------------------------
+
+    def _read_loop(self):
+        chunk = bytearray()
+        while self._running:
+            try:
+                data = self.port.read(4096)
+            except OSError:
+                break
+            self.rx_bytes += len(data)
+            for b in data:
+                if b != 0:
+                    chunk.append(b)
+                    continue
+                if chunk:
+                    self._handle_chunk(bytes(chunk))
+                    chunk.clear()
+
+    def _handle_chunk(self, chunk):
+        decoded = decode_frame(chunk)
+        if decoded is None:
+            if self.on_text:
+                for line in chunk.decode("utf-8", "replace").splitlines():
+                    if line.strip():
+                        self.on_text(line)
+            else:
+                self.bad_frames += 1
+            return
+        msg_type, seq, payload = decoded
+        if msg_type == MSG_SAMPLE and len(payload) == SAMPLE.size:
+            sensor, valid, ts, value, raw = SAMPLE.unpack(payload)
+            self.samples.put(Sample(sensor, seq, bool(valid), ts, value, raw, time.monotonic()))
+            return
+        with self._cond:
+            self._replies[seq] = (msg_type, payload, time.monotonic())
+            self._cond.notify_all()
+
+    # -- istekler ---------------------------------------------------------
+
+    def send(self, msg_type, payload=b""):
+        """İsteği gönderir; sıra numarasını ve gönderim zamanını döndürür."""
+        if len(payload) > MAX_PAYLOAD:
+            raise ValueError("yuk en cok %d bayt" % MAX_PAYLOAD)
+        with self._write_lock:
+            seq = self._seq
+            self._seq = (self._seq + 1) & 0xFF
+            with self._cond:
+                self._replies.pop(seq, None)
+            sent = time.monotonic()
+            self.port.write(encode_frame(msg_type, seq, payload))
+        return seq, sent
+
+    def wait_reply(self, seq, timeout=None):
+        deadline = time.monotonic() + (self.timeout if timeout is None else timeout)
+        with self._cond:
+            while seq not in self._replies:
+                left = deadline - time.monotonic()
+                if left <= 0:
+                    raise RemoteError("cevap yok (sira %d)" % seq)
+                self._cond.wait(left)
+            return self._replies.pop(seq)
+
+    def request(self, msg_type, payload=b""):
+        """İstek gönderir ve ACK durumunu bekler; hata durumunda RemoteError."""
+        seq, _ = self.send(msg_type, payload)
+        reply_type, reply, _ = self.wait_reply(seq)
+        if reply_type != MSG_ACK or len(reply) != 2 or reply[0] != msg_type:
+            raise RemoteError("beklenmeyen cevap 0x%02x" % reply_type)
+        if reply[1] != 0:
+            raise RemoteError(STATUS_NAMES.get(reply[1], str(reply[1])))
+
+    def ping(self, payload=b""):
+        """Gidiş-dönüş süresini saniye olarak döndürür."""
+        seq, sent = self.send(MSG_PING, payload)
+        reply_type, reply, received = self.wait_reply(seq)
+        if reply_type != MSG_PONG or reply != bytes(payload):
+            raise RemoteError("yanki bozuk")
+        return received - sent
+
+    def motor(self, direction, speed, revolutions):
+        self.request(MSG_MOTOR, struct.pack("<BHf", direction, speed, revolutions))
+
+    def lcd(self, text, row=0, col=0, clear=False):
+        data = text.encode("ascii", "replace")[:16]
+        self.request(MSG_LCD, bytes([1 if clear else 0, row, col]) + data)
+
+    def beep(self, frequency_hz, duration_ms):
+        self.request(MSG_BEEP, struct.pack("<HH", int(frequency_hz), duration_ms))
+
+    def play(self, notes, gap_ms=20):
+        """(frekans, süre_ms) dizisini sırayla çalar; kart tarafı beklemez."""
+        for frequency, duration in notes:
+            self.beep(frequency, duration)
+            time.sleep((duration + gap_ms) / 1000.0)
+
+    def subscribe(self, sensor, rate_hz):
+        self.request(MSG_SUBSCRIBE, struct.pack("<BH", sensor, rate_hz))
+
+    def unsubscribe(self, sensor):
+        self.subscribe(sensor, 0)
+
+    def stats(self):
+        seq, _ = self.send(MSG_STATS)
+        reply_type, reply, _ = self.wait_reply(seq)
+        if reply_type != MSG_STATS_REPLY or len(reply) != STATS.size:
+            raise RemoteError("beklenmeyen cevap 0x%02x" % reply_type)
+        return Stats(*STATS.unpack(reply))
+
+    def config_field(self, field_id):
+        """Bir yapılandırma alanını okur; kimlik yoksa None döndürür."""
+        seq, _ = self.send(MSG_CONFIG_GET, bytes([field_id]))
+        reply_type, reply, _ = self.wait_reply(seq)
+        if reply_type == MSG_ACK and len(reply) == 2 and reply[1] == 2:
+            return None
+        if reply_type != MSG_CONFIG_VALUE or len(reply) < CONFIG_VALUE.size:
+            raise RemoteError("beklenmeyen cevap 0x%02x" % reply_type)
+        fid, ftype, reboot, raw, lo, hi = CONFIG_VALUE.unpack_from(reply)
+        value = struct.unpack("<f" if ftype == CONFIG_F32 else "<I", raw)[0]
+        name = reply[CONFIG_VALUE.size:].decode("ascii", "replace")
+        return ConfigField(fid, name, ftype, bool(reboot), value, lo, hi)
+
+    def config_fields(self):
+        """Tüm yapılandırma alanlarını kimlik sırasıyla döndürür."""
+        fields = []
+        while True:
+            field = self.config_field(len(fields))
+            if field is None:
+                return fields
+            fields.append(field)
+
+    def config_set(self, field, value):
+        """Alanı RAM'de değiştirir (ad veya kimlik); kalıcı olması için config_save()."""
+        if isinstance(field, str):
+            matches = [f for f in self.config_fields() if f.name == field]
+            if not matches:
+                raise RemoteError("bilinmeyen alan: %s" % field)
+            field = matches[0]
+        else:
+            field = self.config_field(field)
+            if field is None:
+                raise RemoteError("bilinmeyen alan")
+        raw = struct.pack("<f", float(value)) if field.type == CONFIG_F32 else struct.pack("<I", int(value))
+        self.request(MSG_CONFIG_SET, bytes([field.id]) + raw)
+
+    def config_save(self):
+        """Yapılandırmayı flash'a yazar; motor dönerken RemoteError("mesgul")."""
+        self.request(MSG_CONFIG_SAVE)
+
+
+def sensor_id(name):
+    return int(name) if name.isdigit() else SENSOR_NAMES.index(name)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("port", help="seri port (/dev/ttyACM0, /dev/rfcomm0, pty)")
+    ap.add_argument("--baud", type=int, default=115200)
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    sub.add_parser("ping")
+    sub.add_parser("stats")
+    p = sub.add_parser("motor")
+    p.add_argument("direction", choices=["cw", "ccw"])
+    p.add_argument("speed", type=int)
+    p.add_argument("revolutions", type=float)
+    p = sub.add_parser("lcd")
+    p.add_argument("text")
+    p.add_argument("--row", type=int, default=0)
+    p.add_argument("--col", type=int, default=0)
+    p.add_argument("--clear", action="store_true")
+    p = sub.add_parser("beep")
+    p.add_argument("frequency", type=int)
+    p.add_argument("duration_ms", type=int)
+    p = sub.add_parser("watch")
+    p.add_argument("sensor", help=" / ".join(SENSOR_NAMES))
+    p.add_argument("rate", type=int, help="Hz")
+    p = sub.add_parser("config")
+    p.add_argument("action", nargs="?", choices=["list", "set", "save"], default="list")
+    p.add_argument("name", nargs="?")
+    p.add_argument("value", nargs="?", type=float)
+    args = ap.parse_args()
+
+    with RemoteClient.open(args.port, args.baud, on_text=lambda line: print("#", line)) as board:
+        try:
+            if args.cmd == "ping":
+                print("rtt: %.2f ms" % (board.ping() * 1000))
+            elif args.cmd == "stats":
+                print(board.stats())
+            elif args.cmd == "motor":
+                board.motor(CW if args.direction == "cw" else CCW, args.speed, args.revolutions)
+            elif args.cmd == "lcd":
+                board.lcd(args.text, args.row, args.col, args.clear)
+            elif args.cmd == "beep":
+                board.beep(args.frequency, args.duration_ms)
+            elif args.cmd == "watch":
+                sensor = sensor_id(args.sensor)
+                board.subscribe(sensor, args.rate)
+                try:
+                    while True:
+                        s = board.samples.get()
+                        print("%s %3d %d %12d %9.2f %d" % (SENSOR_NAMES[s.sensor], s.seq, s.valid,
+                                                          s.timestamp_us, s.value, s.raw))
+                except KeyboardInterrupt:
+                    board.unsubscribe(sensor)
+            elif args.cmd == "config":
+                if args.action == "set":
+                    if args.name is None or args.value is None:
+                        sys.exit("hata: config set ALAN DEGER")
+                    board.config_set(int(args.name) if args.name.isdigit() else args.name, args.value)
+                elif args.action == "save":
+                    board.config_save()
+                else:
+                    for f in board.config_fields():
+                        print("%2d %-20s %12g  [%g..%g]%s" % (f.id, f.name, f.value, f.min, f.max,
+                                                             " (yeniden acilista)" if f.reboot else ""))
+        except RemoteError as e:
+            sys.exit("hata: %s" % e)
+
+
+if __name__ == "__main__":
+    main()
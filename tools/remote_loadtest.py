@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""İkili protokolün gidiş-dönüş süresini ve sürekli telemetri verimini ölçer.
+
+Kullanım:
+    python3 tools/remote_loadtest.py /dev/ttyACM0
+    python3 tools/remote_loadtest.py /dev/rfcomm0 --baud 9600
+    python3 tools/remote_loadtest.py /dev/ttyACM0 --pings 1000 --size 48 \\
+        --sensors ldr,pot,mesafe,pir --rate 200 --duration 10
+
+İki aşama çalışır:
+1. RTT: `--pings` adet PING art arda (her biri cevabı bekleyerek) gönderilir;
+   en kısa, medyan, p95, p99 ve en uzun süre yazılır.
+2. Verim: `--sensors` akışlarına `--rate` Hz ile abone olunur, `--duration`
+   saniye örnekler sayılır. Varsayılan hız (8 Hz) dört akışta 9600 baud
+   Bluetooth hattına sığar; kart hat hızını aşan Bluetooth aboneliğini
+   BUSY ile reddeder. USB'de `--rate 200`'e kadar çıkılabilir. Akış
+   başına alınan örnek hızı, sıra
+   numarasındaki boşluklardan kayıp ve kart zaman damgalarından aralık
+   titreşimi hesaplanır. Sonda kartın protokol sayaçları (STATS) okunur;
+   `tx_dropped` gönderme tamponunun yetmediğini gösterir.
+
+Çıkış kodu: RTT cevapsız kaldıysa veya örnek kaybı `--max-loss` oranını
+aştıysa 1.
+"""
+
+import argparse
+import statistics
+import sys
+import time
+
+from remote_client import (RemoteClient, RemoteError, SAMPLE, SENSOR_NAMES, sensor_id)
+
+WIRE_OVERHEAD = 2 + 4 + 1  # İki ayraç, tür + sıra + CRC, COBS ek baytı
+
+
+def percentile(values, p):
+    values = sorted(values)
+    k = min(len(values) - 1, int(round(p / 100.0 * (len(values) - 1))))
+    return values[k]
+
+
+def run_rtt(board, count, size):
+    payload = bytes((i * 37) & 0xFF for i in range(size))
+    rtts = []
+    lost = 0
+    for _ in range(count):
+        try:
+            rtts.append(board.ping(payload) * 1000.0)
+        except RemoteError:
+            lost += 1
+    print("RTT (%d bayt yuk, %d ping):" % (size, count))
+    if rtts:
+        print("  en kisa %.2f  medyan %.2f  p95 %.2f  p99 %.2f  en uzun %.2f ms" % (
+            min(rtts), statistics.median(rtts), percentile(rtts, 95), percentile(rtts, 99), max(rtts)))
+    print("  cevapsiz: %d" % lost)
+    return lost == 0
+
+
+def run_throughput(board, sensors, rate, duration):
+    while not board.samples.empty():
+        board.samples.get_nowait()
+    for s in sensors:
+        board.subscribe(s, rate)
+    start = time.monotonic()
+    received = {s: [] for s in sensors}
+    while time.monotonic() - start < duration:
+        try:
+            smp = board.samples.get(timeout=0.1)
+        except Exception:
+            continue
+        if smp.sensor in received:
+            received[smp.sensor].append(smp)
+    elapsed = time.monotonic() - start
+    for s in sensors:
+        board.unsubscribe(s)
+
+    print("Verim (%d akis x %d Hz, %.1f s):" % (len(sensors), rate, elapsed))
+    total = 0
+    total_lost = 0
+    for s in sensors:
+        got = received[s]
+        lost = 0
+        for prev, cur in zip(got, got[1:]):
+            lost += (cur.seq - prev.seq - 1) & 0xFF
+        gaps = [(b.timestamp_us - a.timestamp_us) / 1000.0 for a, b in zip(got, got[1:])]
+        jitter = statistics.pstdev(gaps) if len(gaps) > 1 else 0.0
+        total += len(got)
+        total_lost += lost
+        print("  %-7s %6d ornek  %7.1f/s  kayip %d  aralik %.2f +/- %.2f ms" % (
+            SENSOR_NAMES[s], len(got), len(got) / elapsed, lost,
+            statistics.mean(gaps) if gaps else 0.0, jitter))
+    frame_bytes = SAMPLE.size + WIRE_OVERHEAD
+    print("  toplam %.1f ornek/s, ~%.0f B/s hat verisi" % (
+        total / elapsed, total * frame_bytes / elapsed))
+    return total, total_lost
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pings", type=int, default=200)
+    ap.add_argument("--size", type=int, default=16, help="PING yükü (bayt, en çok 48)")
+    ap.add_argument("--sensors", default="ldr,pot,mesafe,pir")
+    ap.add_argument("--rate", type=int, default=8,
+                    help="akış başına Hz (en çok 200; varsayılan 9600 baud Bluetooth'a sığar)")
+    ap.add_argument("--duration", type=float, default=5.0)
+    ap.add_argument("--max-loss", type=float, default=0.01, help="izin verilen kayıp oranı")
+    args = ap.parse_args()
+
+    sensors = [sensor_id(name) for name in args.sensors.split(",") if name]
+    with RemoteClient.open(args.port, args.baud) as board:
+        try:
+            before = board.stats()
+            ok = run_rtt(board, args.pings, args.size)
+            total, lost = run_throughput(board, sensors, args.rate, args.duration)
+            time.sleep(0.2)
+            after = board.stats()
+        except RemoteError as e:
+            sys.exit("hata: %s" % e)
+        delta = after._replace(**{f: getattr(after, f) - getattr(before, f) for f in after._fields})
+        print("Kart sayaclari (fark): %s" % (delta,))
+        print("Istemci: %d bayt alindi, %d bozuk parca" % (board.rx_bytes, board.bad_frames))
+
+    if total + lost and lost / float(total + lost) > args.max_loss:
+        ok = False
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
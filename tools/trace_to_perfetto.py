@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Firmware iz dökümünü Chrome/Perfetto JSON biçimine dönüştürür.
+
+Kullanım:
+    python3 tools/trace_to_perfetto.py capture.txt -o trace.json
+    python3 tools/trace_to_perfetto.py --port /dev/ttyACM0 -o trace.json
+
+Girdi, `trace` konsol komutunun çıktısıdır (bkz. trace.c):
+    # trace v1 cores=2 ring=256
+    N <id> <ad>
+    T <32 hex karakter>      trace_event_t: <QHBBi (little-endian, 16 bayt)
+    # trace end events=<n> lost=<n>
+Diğer satırlar yok sayılır. Çıktı https://ui.perfetto.dev veya
+chrome://tracing ile açılır; Core 0 ve Core 1 aynı zaman ekseninde iki iş
+parçacığı olarak görünür.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+EVENT = struct.Struct("<QHBBi")
+PHASES = {0: "B", 1: "E", 2: "C", 3: "i"}
+
+
+def read_lines(args):
+    """Girdi satırlarını dosyadan, stdin'den veya seri porttan üretir."""
+    if args.port:
+        try:
+            import serial  # pyserial
+        except ImportError:
+            sys.exit("--port için pyserial gerekli: pip install pyserial")
+        with serial.Serial(args.port, 115200, timeout=10) as port:
+            port.write(b"trace\n")
+            while True:
+                raw = port.readline()
+                if not raw:
+                    sys.exit("seri porttan veri gelmedi (zaman aşımı)")
+                line = raw.decode("utf-8", "replace").strip()
+                yield line
+                if line.startswith("# trace end"):
+                    return
+    stream = sys.stdin if args.input in (None, "-") else open(args.input, encoding="utf-8")
+    with stream:
+        for line in stream:
+            yield line.strip()
+
+
+def parse(lines):
+    """Ad tablosunu ve kayıtları (zamana göre sıralı) döndürür."""
+    names = {}
+    events = []
+    for line in lines:
+        if line.startswith("N "):
+            _, ident, name = line.split(" ", 2)
+            names[int(ident)] = name
+        elif line.startswith("T "):
+            try:
+                raw = bytes.fromhex(line[2:])
+            except ValueError:
+                continue
+            if len(raw) == EVENT.size:
+                events.append(EVENT.unpack(raw))
+    # Aynı zaman damgasında yazılış sırası korunur (sort kararlıdır)
+    events.sort(key=lambda e: e[0])
+    return names, events
+
+
+def convert(names, events):
+    """Kayıtları Chrome trace event listesine çevirir."""
+    out = []
+    for core in (0, 1):
+        out.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                    "args": {"name": f"Core {core}"}})
+    depth = {0: 0, 1: 0}
+    for ts, ident, kind, core, value in events:
+        name = names.get(ident, f"id{ident}")
+        phase = PHASES.get(kind)
+        if phase is None:
+            continue
+        if phase == "E":
+            # Halka taşınca başlangıcı silinmiş süreler atlanır
+            if depth[core] == 0:
+                continue
+            depth[core] -= 1
+        elif phase == "B":
+            depth[core] += 1
+        event = {"name": name, "ph": phase, "ts": ts, "pid": 0, "tid": core}
+        if phase == "C":
+            event["args"] = {name: value}
+        elif phase == "i":
+            event["s"] = "t"
+            event["args"] = {"value": value}
+        out.append(event)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="Döküm dosyası (varsayılan: stdin)")
+    parser.add_argument("--port", help="Seri porta `trace` gönder ve dökümü oku (pyserial)")
+    parser.add_argument("-o", "--output", help="JSON çıktı dosyası (varsayılan: stdout)")
+    args = parser.parse_args()
+
+    names, events = parse(read_lines(args))
+    if not events:
+        sys.exit("iz kaydı bulunamadı")
+    trace = {"traceEvents": convert(names, events), "displayTimeUnit": "ms"}
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(trace, f)
+        span = (events[-1][0] - events[0][0]) / 1000.0
+        print(f"{len(events)} kayıt, {span:.1f} ms -> {args.output}", file=sys.stderr)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,107 @@
+/**
+ * @file trace.c
+ * @brief Çekirdek başına iz halka tamponu ve stdio dökümü
+ * @see \ref howto_trace
+ *
+ * Her çekirdek yalnızca kendi tamponuna yazar; çekirdekler arası kilit yoktur.
+ * Aynı çekirdekteki kesmelere karşı yuva ayırma ve yazma kısa bir
+ * `save_and_disable_interrupts()` bölümünde yapılır.
+ *
+ * Döküm biçimi (tools/trace_to_perfetto.py okur):
+ * @code
+ * # trace v1 cores=2 ring=256
+ * N <id> <ad>                 (her olay kimliği için)
+ * T <32 hex karakter>         (her kayıt: trace_event_t ham baytları)
+ * # trace end events=<n> lost=<n>
+ * @endcode
+ */
+
+#include "pico_training_board.h"
+
+#if RPPICODS_TRACE
+
+_Static_assert(sizeof(trace_event_t) == 16, "döküm biçimi 16 baytlık kayıt bekler");
+
+static trace_event_t trace_ring[2][TRACE_RING_LEN];
+static uint32_t trace_head[2];
+static volatile bool trace_on = true;
+
+static const char *const trace_names[TRACE_ID_COUNT] = {
+#define TRACE_NAME(id, name) name,
+    TRACE_ID_LIST(TRACE_NAME)
+#undef TRACE_NAME
+};
+
+/**
+ * @brief Çağıran çekirdeğin tamponuna bir kayıt ekler (TRACE_* makroları çağırır)
+ * @param id Olay kimliği
+ * @param type Kayıt türü
+ * @param value Sayaç/anlık olay değeri
+ */
+void __not_in_flash_func(trace_record)(trace_id_t id, trace_type_t type, int32_t value) {
+    if (!trace_on) {
+        return;
+    }
+    uint core = get_core_num();
+    uint32_t irq_state = save_and_disable_interrupts();
+    trace_event_t *e = &trace_ring[core][trace_head[core]++ & (TRACE_RING_LEN - 1)];
+    e->timestamp_us = time_us_64();
+    e->id = (uint16_t)id;
+    e->type = (uint8_t)type;
+    e->core = (uint8_t)core;
+    e->value = value;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief İki tamponu da boşaltır
+ */
+void trace_clear(void) {
+    trace_on = false;
+    trace_head[0] = 0;
+    trace_head[1] = 0;
+    trace_on = true;
+}
+
+/**
+ * @brief Ad tablosunu ve iki tamponun içeriğini (eskiden yeniye) stdio'ya yazar
+ *
+ * Döküm sırasında kayıt durdurulur; ardından tamponlar boşaltılır.
+ */
+void trace_dump(void) {
+    trace_on = false;
+    printf("# trace v1 cores=2 ring=%u\n", TRACE_RING_LEN);
+    for (uint id = 0; id < TRACE_ID_COUNT; id++) {
+        printf("N %u %s\n", id, trace_names[id]);
+    }
+
+    uint32_t events = 0;
+    uint32_t lost = 0;
+    for (uint core = 0; core < 2; core++) {
+        uint32_t head = trace_head[core];
+        uint32_t count = head < TRACE_RING_LEN ? head : TRACE_RING_LEN;
+        lost += head - count;
+        for (uint32_t i = head - count; i != head; i++) {
+            const uint8_t *b = (const uint8_t *)&trace_ring[core][i & (TRACE_RING_LEN - 1)];
+            printf("T ");
+            for (uint k = 0; k < sizeof(trace_event_t); k++) {
+                printf("%02x", b[k]);
+            }
+            printf("\n");
+        }
+        events += count;
+        trace_head[core] = 0;
+    }
+    printf("# trace end events=%lu lost=%lu\n", (unsigned long)events, (unsigned long)lost);
+    trace_on = true;
+}
+
+#else
+
+void trace_clear(void) {}
+
+void trace_dump(void) {
+    printf("iz kapali: RPPICODS_TRACE=1 ile derleyin\n");
+}
+
+#endif
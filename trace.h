@@ -0,0 +1,96 @@
+/**
+ * @file trace.h
+ * @brief Derleme zamanında açılıp kapanan iz (trace) makroları
+ * @see \ref howto_trace
+ *
+ * `RPPICODS_TRACE=1` ile derlendiğinde her makro, çağıran çekirdeğin RAM
+ * halka tamponuna 64 bit zaman damgalı 16 baytlık bir kayıt ekler (onlarca
+ * çevrim). Kapalıyken makrolar boş ifadeye dönüşür; argümanlar da
+ * değerlendirilmez.
+ *
+ * Olay kimlikleri TRACE_ID_LIST'te tek yerde tanımlanır; döküm ad tablosunu
+ * da içerir, böylece tools/trace_to_perfetto.py firmware kaynağına bakmadan
+ * dönüştürür.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifndef RPPICODS_TRACE
+#define RPPICODS_TRACE 0
+#endif
+
+/**
+ * @defgroup trace İz Ayarları
+ * @{
+ */
+#define TRACE_RING_LEN 256  /**< Çekirdek başına kayıt sayısı (2'nin kuvveti); dolunca en eskinin üstüne yazılır */
+/** @} */
+
+/**
+ * @brief Olay kimlikleri ve dökümdeki adları
+ */
+#define TRACE_ID_LIST(X)                        \
+    X(TRACE_LCD_SEND_BYTE, "lcd_send_byte")     \
+    X(TRACE_LCD_STRING, "lcd_string")           \
+    X(TRACE_STEP_TURN, "step_turn")             \
+    X(TRACE_STEP_INDEX, "step_index")           \
+    X(TRACE_PLAY_NOTE, "play_note")             \
+    X(TRACE_BEEP, "beep")                       \
+    X(TRACE_MEASURE_DISTANCE, "measure_distance") \
+    X(TRACE_DISTANCE_MM, "distance_mm")         \
+    X(TRACE_INPUT_EVENTS, "input_events")       \
+    X(TRACE_CORE1_MESSAGE, "core1_message")     \
+    X(TRACE_MOTOR_COMMAND, "motor_command")     \
+    X(TRACE_DISPLAY, "display")                 \
+    X(TRACE_PRESENCE, "presence")               \
+    X(TRACE_PRESENCE_CONFIDENCE, "presence_confidence_pct")
+
+typedef enum {
+#define TRACE_ENUM(id, name) id,
+    TRACE_ID_LIST(TRACE_ENUM)
+#undef TRACE_ENUM
+    TRACE_ID_COUNT
+} trace_id_t;
+
+/**
+ * @brief Kayıt türü (Chrome/Perfetto "ph" alanına karşılık gelir)
+ */
+typedef enum {
+    TRACE_TYPE_BEGIN,    /**< Süre başlangıcı ("B") */
+    TRACE_TYPE_END,      /**< Süre bitişi ("E") */
+    TRACE_TYPE_COUNTER,  /**< Sayaç değeri ("C") */
+    TRACE_TYPE_INSTANT   /**< Anlık olay ("i") */
+} trace_type_t;
+
+/**
+ * @brief Halka tampondaki tek kayıt (16 bayt, little-endian dökülür)
+ */
+typedef struct {
+    uint64_t timestamp_us;  /**< time_us_64(); iki çekirdekte aynı saat */
+    uint16_t id;            /**< trace_id_t */
+    uint8_t type;           /**< trace_type_t */
+    uint8_t core;           /**< Kaydı yazan çekirdek */
+    int32_t value;          /**< Sayaç/anlık olay değeri */
+} trace_event_t;
+
+#if RPPICODS_TRACE
+void trace_record(trace_id_t id, trace_type_t type, int32_t value);
+#define TRACE_BEGIN(id) trace_record((id), TRACE_TYPE_BEGIN, 0)
+#define TRACE_END(id) trace_record((id), TRACE_TYPE_END, 0)
+#define TRACE_COUNTER(id, value) trace_record((id), TRACE_TYPE_COUNTER, (int32_t)(value))
+#define TRACE_INSTANT(id, value) trace_record((id), TRACE_TYPE_INSTANT, (int32_t)(value))
+#else
+#define TRACE_BEGIN(id) ((void)0)
+#define TRACE_END(id) ((void)0)
+#define TRACE_COUNTER(id, value) ((void)0)
+#define TRACE_INSTANT(id, value) ((void)0)
+#endif
+
+// Döküm ve denetim (iz kapalıyken de bağlanır; boş çalışır)
+void trace_clear(void);
+void trace_dump(void);
+
+#endif // TRACE_H
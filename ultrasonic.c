@@ -0,0 +1,272 @@
+/**
+ * @file ultrasonic.c
+ * @brief PIO tabanlı, bloklamayan ultrasonik mesafe ölçüm motoru
+ * @see \ref howto_sensors
+ *
+ * Tetikleme darbesi ve yankı süresi ölçümü pio1 üzerindeki bir durum
+ * makinesinde yapılır (bkz. ultrasonic_echo.pio). Tekrarlı bir zamanlayıcı
+ * `ULTRASONIC_RATE_HZ` hızında ölçüm başlatır; sonuç RX FIFO'ya geldiğinde
+ * PIO1_IRQ_0 onu örneğe çevirir, kuyruğa ekler ve varsa geri çağrıyı çalıştırır.
+ * Ölçüm sırasında CPU serbesttir; çözünürlük 0.2 µs'dir.
+ */
+
+#include "pico_training_board.h"
+#include "ultrasonic_echo.pio.h"
+
+#define ULTRASONIC_PIO pio1
+#define ULTRASONIC_PIO_IRQ PIO1_IRQ_0
+
+/** @brief Bir sayma adımının süresi (µs) */
+#define ULTRASONIC_STEP_US (2.0f * 1e6f / ULTRASONIC_PIO_CLOCK_HZ)
+
+/** @brief SM'ye yazılan zaman aşımı: yankı bekleme ve yankı genişliği üst sınırı (adım) */
+#define ULTRASONIC_TIMEOUT_STEPS ((uint32_t)(ULTRASONIC_TIMEOUT_US / ULTRASONIC_STEP_US))
+
+static int us_sm = -1;
+static int us_offset = -1;
+static repeating_timer_t us_timer;
+static volatile bool us_running = false;
+static volatile bool us_busy = false;             // SM bir ölçüm yürütüyor
+static volatile bool us_paused = false;           // Tetikleme geçici olarak durduruldu
+static volatile uint64_t us_trigger_time = 0;     // Yürütülen ölçümün başlangıcı
+static uint32_t us_period_us = 0;                 // Ölçüm periyodu
+static ultrasonic_callback_t us_callback = NULL;
+
+static ultrasonic_sample_t us_storage[ULTRASONIC_QUEUE_LEN];
+static event_queue_t us_queue;
+static volatile ultrasonic_sample_t us_latest = {.distance_cm = -1.0f};
+static volatile uint32_t us_skipped = 0;
+
+/**
+ * @brief Yankı süresini mesafeye çevirir
+ * @param echo_us Yankı darbesi genişliği (µs)
+ * @return float Santimetre cinsinden mesafe
+ */
+static inline float echo_to_cm(float echo_us) {
+    return (board_config.sound_speed * echo_us * 0.0001f) / 2.0f;
+}
+
+/**
+ * @brief RX FIFO kesmesi; ölçüm sonucunu örneğe çevirip dağıtır
+ */
+static void ultrasonic_irq_handler(void) {
+    while (!pio_sm_is_rx_fifo_empty(ULTRASONIC_PIO, (uint)us_sm)) {
+        uint32_t remaining = pio_sm_get(ULTRASONIC_PIO, (uint)us_sm);
+        ultrasonic_sample_t s = {.timestamp_us = us_trigger_time};
+        if (remaining == ULTRASONIC_PIO_TIMEOUT || remaining > ULTRASONIC_TIMEOUT_STEPS) {
+            // Yankı gelmedi veya ULTRASONIC_TIMEOUT_US'den uzun sürdü (takılı pin dahil)
+            s.echo_us = 0.0f;
+            s.distance_cm = -1.0f;
+        } else {
+            s.echo_us = (ULTRASONIC_TIMEOUT_STEPS - remaining) * ULTRASONIC_STEP_US;
+            s.distance_cm = echo_to_cm(s.echo_us);
+        }
+        us_busy = false;
+
+        us_latest = s;
+        event_queue_push(&us_queue, &s);
+        if (us_callback) {
+            us_callback(&s);
+        }
+    }
+}
+
+/**
+ * @brief Ölçüm zamanlayıcısı; SM boştaysa yeni bir ölçüm başlatır
+ * @param rt Tekrarlı zamanlayıcı
+ * @return bool Zamanlayıcının devam etmesi için true
+ */
+static bool ultrasonic_timer_callback(repeating_timer_t *rt) {
+    if (us_paused) {
+        return true;
+    }
+    if (us_busy) {
+        // Önceki yankı hâlâ sürüyor (ör. hedef yokken uzun darbe); bu periyodu atla
+        us_skipped++;
+        return true;
+    }
+    us_busy = true;
+    us_trigger_time = time_us_64();
+    pio_sm_put(ULTRASONIC_PIO, (uint)us_sm, ULTRASONIC_TIMEOUT_STEPS);
+    return true;
+}
+
+/**
+ * @brief Periyodik ultrasonik ölçümü başlatır
+ *
+ * Tetikleme pini PIO'ya devredilir; `measure_distance()` bu sürede son
+ * örneği döndürür.
+ *
+ * @param rate_hz Ölçüm hızı (0 ise ULTRASONIC_RATE_HZ)
+ * @param callback Her örnekte kesme bağlamında çağrılır (NULL olabilir)
+ * @return bool Motor çalışıyorsa true; PIO veya zamanlayıcı bulunamazsa false
+ *
+ * @code{.c}
+ * ultrasonic_start(40, NULL);
+ * ultrasonic_sample_t s;
+ * while (ultrasonic_get_sample(&s)) {
+ *   if (s.distance_cm > 0) { ... }
+ * }
+ * @endcode
+ */
+bool ultrasonic_start(uint rate_hz, ultrasonic_callback_t callback) {
+    if (us_running) {
+        return true;
+    }
+    if (rate_hz == 0) {
+        rate_hz = ULTRASONIC_RATE_HZ;
+    }
+    if (pin_claim(ULTRA_SONIC_TR, PIN_FUNC_PIO, "ultrasonic") == PIN_CLAIM_CONFLICT ||
+        !pio_can_add_program(ULTRASONIC_PIO, &ultrasonic_echo_program)) {
+        return false;
+    }
+    us_sm = pio_claim_unused_sm(ULTRASONIC_PIO, false);
+    if (us_sm < 0) {
+        return false;
+    }
+    us_offset = (int)pio_add_program(ULTRASONIC_PIO, &ultrasonic_echo_program);
+
+    event_queue_init(&us_queue, us_storage, sizeof(us_storage[0]), ULTRASONIC_QUEUE_LEN);
+    us_callback = callback;
+    us_busy = false;
+    us_skipped = 0;
+    us_period_us = 1000000u / rate_hz;
+
+    ultrasonic_echo_program_init(ULTRASONIC_PIO, (uint)us_sm, (uint)us_offset,
+                                 ULTRA_SONIC_TR, ULTRA_SONIC_EC);
+    irq_set_exclusive_handler(ULTRASONIC_PIO_IRQ, ultrasonic_irq_handler);
+    pio_set_irq0_source_enabled(ULTRASONIC_PIO,
+                                pio_get_rx_fifo_not_empty_interrupt_source((uint)us_sm), true);
+    irq_set_enabled(ULTRASONIC_PIO_IRQ, true);
+
+    if (!add_repeating_timer_us(-(int64_t)us_period_us, ultrasonic_timer_callback,
+                                NULL, &us_timer)) {
+        ultrasonic_stop();
+        return false;
+    }
+    us_running = true;
+    return true;
+}
+
+/**
+ * @brief Periyodik ölçümü durdurur ve tetikleme pinini SIO'ya geri verir
+ */
+void ultrasonic_stop(void) {
+    if (us_sm < 0) {
+        return;
+    }
+    if (us_running) {
+        cancel_repeating_timer(&us_timer);
+        us_running = false;
+    }
+    irq_set_enabled(ULTRASONIC_PIO_IRQ, false);
+    pio_set_irq0_source_enabled(ULTRASONIC_PIO,
+                                pio_get_rx_fifo_not_empty_interrupt_source((uint)us_sm), false);
+    pio_sm_set_enabled(ULTRASONIC_PIO, (uint)us_sm, false);
+    pio_remove_program(ULTRASONIC_PIO, &ultrasonic_echo_program, (uint)us_offset);
+    pio_sm_unclaim(ULTRASONIC_PIO, (uint)us_sm);
+    us_sm = us_offset = -1;
+    us_busy = false;
+
+    init_ultrasonic();
+}
+
+/**
+ * @brief Periyodik ölçümün çalışıp çalışmadığını döndürür
+ * @return bool Çalışıyorsa true
+ */
+bool ultrasonic_is_running(void) {
+    return us_running;
+}
+
+/**
+ * @brief Tetiklemeyi durdurur veya sürdürür; PIO ve zamanlayıcı ayrılmış kalır
+ *
+ * `ultrasonic_stop()`/`ultrasonic_start()` çiftinden farklı olarak program ve
+ * durum makinesi yerinde kalır, bu yüzden sık açıp kapatmak ucuzdur. Durdurulmuşken
+ * sensör darbe göndermez (güç ve akustik gürültü yok).
+ *
+ * Sürdürürken distance_filter_reset() çağrılır: ilk örneğin dt'si tüm
+ * duraklamayı kapsamaz ve medyan penceresinde duraklama öncesi mesafeler kalmaz.
+ *
+ * @param paused true ise yeni ölçüm başlatılmaz
+ */
+void ultrasonic_pause(bool paused) {
+    if (us_paused && !paused) {
+        distance_filter_reset();
+    }
+    us_paused = paused;
+}
+
+/**
+ * @brief Tetiklemenin durdurulup durdurulmadığını döndürür
+ * @return bool Durdurulmuşsa true
+ */
+bool ultrasonic_is_paused(void) {
+    return us_paused;
+}
+
+/**
+ * @brief Kuyruktaki en eski ölçüm örneğini alır; beklemez
+ * @param out Örneğin yazılacağı yapı
+ * @return bool Örnek alındıysa true
+ */
+bool ultrasonic_get_sample(ultrasonic_sample_t *out) {
+    return event_queue_pop(&us_queue, out);
+}
+
+/**
+ * @brief En son ölçüm örneğini kopyalar
+ *
+ * Örnek tetikleme durdurulmuşken veya bir periyot ve yankı süresinden
+ * (`ULTRASONIC_TIMEOUT_US`) eskiyse güncel sayılmaz; `out` yine de son
+ * örnekle doldurulur.
+ *
+ * @param out Örneğin yazılacağı yapı
+ * @return bool Motor çalışıyor, durdurulmamış ve son örnek güncelse true
+ */
+bool ultrasonic_latest(ultrasonic_sample_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    *out = us_latest;
+    restore_interrupts(irq_state);
+    if (!us_running || us_paused || out->timestamp_us == 0) {
+        return false;
+    }
+    return time_us_64() - out->timestamp_us <= (uint64_t)us_period_us + ULTRASONIC_TIMEOUT_US;
+}
+
+/**
+ * @brief Önceki yankı bitmediği için atlanan ölçüm periyodu sayısı
+ * @return uint32_t Atlanan periyotlar
+ */
+uint32_t ultrasonic_skipped_count(void) {
+    return us_skipped;
+}
+
+/**
+ * @brief Ses hızını hava sıcaklığından ayarlar
+ *
+ * c = 331.3 + 0.606 * T (m/s). Sonraki tüm ölçümler yeni hızla çevrilir.
+ * Değer config_set() ile `board_config.sound_speed`'e yazılır; alanın aralığı
+ * (300-380 m/s, yaklaşık -52..79 °C) dışındaki veya NaN sıcaklık reddedilir
+ * ve önceki hız korunur. config_save() ile kalıcı olur.
+ *
+ * @param celsius Hava sıcaklığı (°C)
+ * @return bool Uygulandıysa true
+ *
+ * @code{.c}
+ * ultrasonic_set_temperature(28.5f);  // Sıcak ortamda ~1.5 % daha uzun mesafe
+ * @endcode
+ */
+bool ultrasonic_set_temperature(float celsius) {
+    int index = config_find("sound_speed");
+    return index >= 0 && config_set((uint)index, 331.3f + 0.606f * celsius);
+}
+
+/**
+ * @brief Geçerli ses hızını döndürür
+ * @return float Ses hızı (m/s)
+ */
+float ultrasonic_sound_speed(void) {
+    return board_config.sound_speed;
+}